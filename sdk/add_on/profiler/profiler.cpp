@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <set>
+#include <algorithm>
+#include <sstream>
+#include <chrono>
+
+#include "profiler.h"
+
+using namespace std;
+
+BEGIN_AS_NAMESPACE
+
+CProfiler::CProfiler()
+{
+	sampleCount  = 0;
+	timerRunning = false;
+}
+
+CProfiler::~CProfiler()
+{
+	Stop();
+
+	for( size_t n = 0; n < contexts.size(); n++ )
+	{
+		SContextInfo *info = contexts[n];
+		if( info->prevCallback )
+			info->ctx->SetLineCallback(asFUNCTION(info->prevCallback), info->prevParam, asCALL_CDECL);
+		else
+			info->ctx->ClearLineCallback();
+		info->ctx->Release();
+		delete info;
+	}
+	contexts.clear();
+}
+
+int CProfiler::AddContext(asIScriptContext *ctx, LINECALLBACK_t prevCallback, void *prevParam)
+{
+	if( ctx == 0 )
+		return asINVALID_ARG;
+
+	lock_guard<mutex> lock(mtx);
+	for( size_t n = 0; n < contexts.size(); n++ )
+		if( contexts[n]->ctx == ctx )
+			return asALREADY_REGISTERED;
+
+	SContextInfo *info = new SContextInfo;
+	info->profiler     = this;
+	info->ctx          = ctx;
+	info->prevCallback = prevCallback;
+	info->prevParam    = prevParam;
+	info->executing    = false;
+	info->armed        = false;
+
+	// The line callback is set by the thread that executes the context, so
+	// there is no race with the context reading the callback while it runs
+	int r = ctx->SetLineCallback(asFUNCTION(LineCallback), info, asCALL_CDECL);
+	if( r < 0 )
+	{
+		delete info;
+		return r;
+	}
+
+	contexts.push_back(info);
+	ctx->AddRef();
+
+	return asSUCCESS;
+}
+
+void CProfiler::RemoveContext(asIScriptContext *ctx)
+{
+	lock_guard<mutex> lock(mtx);
+	for( size_t n = 0; n < contexts.size(); n++ )
+	{
+		SContextInfo *info = contexts[n];
+		if( info->ctx == ctx )
+		{
+			// Give the line callback back to the application
+			if( info->prevCallback )
+				ctx->SetLineCallback(asFUNCTION(info->prevCallback), info->prevParam, asCALL_CDECL);
+			else
+				ctx->ClearLineCallback();
+			ctx->Release();
+			delete info;
+			contexts.erase(contexts.begin() + n);
+			return;
+		}
+	}
+}
+
+int CProfiler::Start(asUINT intervalMicroSeconds)
+{
+	if( intervalMicroSeconds == 0 )
+		return asINVALID_ARG;
+
+	lock_guard<mutex> lock(mtx);
+	if( timerRunning )
+		return asERROR;
+
+	timerRunning = true;
+	timer = thread(&CProfiler::TimerThread, this, intervalMicroSeconds);
+
+	return asSUCCESS;
+}
+
+void CProfiler::Stop()
+{
+	{
+		lock_guard<mutex> lock(mtx);
+		if( !timerRunning )
+			return;
+		timerRunning = false;
+	}
+	timerCond.notify_all();
+	timer.join();
+}
+
+bool CProfiler::IsRunning() const
+{
+	lock_guard<mutex> lock(mtx);
+	return timerRunning;
+}
+
+void CProfiler::TimerThread(asUINT intervalMicroSeconds)
+{
+	unique_lock<mutex> lock(mtx);
+	while( timerRunning )
+	{
+		timerCond.wait_for(lock, chrono::microseconds(intervalMicroSeconds));
+		if( !timerRunning )
+			break;
+
+		lock.unlock();
+		RequestSample();
+		lock.lock();
+	}
+}
+
+void CProfiler::RequestSample()
+{
+	lock_guard<mutex> lock(mtx);
+	for( size_t n = 0; n < contexts.size(); n++ )
+	{
+		SContextInfo *info = contexts[n];
+
+		// Contexts that are not executing are not sampled, or else the first
+		// line of the next execution would get all the samples taken while idle.
+		// Only the flag is set here, the context itself takes the sample.
+		if( info->executing.load(memory_order_relaxed) )
+			info->armed.store(true, memory_order_relaxed);
+	}
+}
+
+void CProfiler::LineCallback(asIScriptContext *ctx, SContextInfo *info)
+{
+	if( ctx->GetState() == asEXECUTION_ACTIVE )
+	{
+		if( !info->executing.load(memory_order_relaxed) )
+			info->executing.store(true, memory_order_relaxed);
+
+		// Keep the common path to a single load when no sample has been requested
+		if( info->armed.load(memory_order_relaxed) && info->armed.exchange(false) )
+			info->profiler->TakeSample(ctx);
+	}
+	else
+	{
+		// The context calls the line callback one last time when the execution finishes
+		// or is suspended. Disarm it so no sample is taken while it is not executing.
+		info->executing.store(false, memory_order_relaxed);
+		info->armed.store(false, memory_order_relaxed);
+	}
+
+	if( info->prevCallback )
+		info->prevCallback(ctx, info->prevParam);
+}
+
+void CProfiler::TakeSample(asIScriptContext *ctx)
+{
+	// Gather the call stack from the innermost to the outermost function
+	vector<string> funcs;
+	vector<SLineKey> lines;
+	for( asUINT n = 0; n < ctx->GetCallstackSize(); n++ )
+	{
+		asIScriptFunction *func = ctx->GetFunction(n);
+		if( func == 0 )
+			continue;
+
+		SLineKey key;
+		const char *section = 0;
+		key.function = GetFunctionName(func);
+		key.line     = ctx->GetLineNumber(n, 0, &section);
+		key.section  = section ? section : "";
+		funcs.push_back(key.function);
+		lines.push_back(key);
+	}
+
+	if( funcs.size() == 0 )
+		return;
+
+	lock_guard<mutex> lock(mtx);
+
+	sampleCount++;
+
+	// Recursive functions must only be counted once per sample for the inclusive count
+	set<string> seenFuncs;
+	set<SLineKey> seenLines;
+	for( size_t n = 0; n < funcs.size(); n++ )
+	{
+		SCounts &fc = functionCounts[funcs[n]];
+		if( n == 0 )
+			fc.exclusive++;
+		if( seenFuncs.insert(funcs[n]).second )
+			fc.inclusive++;
+
+		SCounts &lc = lineCounts[lines[n]];
+		if( n == 0 )
+			lc.exclusive++;
+		if( seenLines.insert(lines[n]).second )
+			lc.inclusive++;
+	}
+
+	string stack;
+	for( size_t n = funcs.size(); n-- > 0; )
+	{
+		stack += funcs[n];
+		if( n > 0 )
+			stack += ";";
+	}
+	stackCounts[stack]++;
+}
+
+string CProfiler::GetFunctionName(asIScriptFunction *func)
+{
+	string name = func->GetDeclaration(true, true, false);
+
+	// The collapsed stack format uses ';' to separate the frames
+	replace(name.begin(), name.end(), ';', ':');
+	return name;
+}
+
+void CProfiler::Reset()
+{
+	lock_guard<mutex> lock(mtx);
+	sampleCount = 0;
+	functionCounts.clear();
+	lineCounts.clear();
+	stackCounts.clear();
+}
+
+asUINT CProfiler::GetSampleCount() const
+{
+	lock_guard<mutex> lock(mtx);
+	return sampleCount;
+}
+
+template<class T>
+static bool CompareCounts(const T &a, const T &b)
+{
+	if( a.exclusive != b.exclusive )
+		return a.exclusive > b.exclusive;
+	return a.inclusive > b.inclusive;
+}
+
+void CProfiler::GetFunctionStats(vector<SFunctionStats> &stats) const
+{
+	stats.clear();
+
+	lock_guard<mutex> lock(mtx);
+	for( map<string, SCounts>::const_iterator it = functionCounts.begin(); it != functionCounts.end(); ++it )
+	{
+		SFunctionStats s;
+		s.function  = it->first;
+		s.inclusive = it->second.inclusive;
+		s.exclusive = it->second.exclusive;
+		stats.push_back(s);
+	}
+	stable_sort(stats.begin(), stats.end(), CompareCounts<SFunctionStats>);
+}
+
+void CProfiler::GetLineStats(vector<SLineStats> &stats) const
+{
+	stats.clear();
+
+	lock_guard<mutex> lock(mtx);
+	for( map<SLineKey, SCounts>::const_iterator it = lineCounts.begin(); it != lineCounts.end(); ++it )
+	{
+		SLineStats s;
+		s.function  = it->first.function;
+		s.section   = it->first.section;
+		s.line      = it->first.line;
+		s.inclusive = it->second.inclusive;
+		s.exclusive = it->second.exclusive;
+		stats.push_back(s);
+	}
+	stable_sort(stats.begin(), stats.end(), CompareCounts<SLineStats>);
+}
+
+string CProfiler::GetCollapsedStacks() const
+{
+	stringstream s;
+
+	lock_guard<mutex> lock(mtx);
+	for( map<string, asUINT>::const_iterator it = stackCounts.begin(); it != stackCounts.end(); ++it )
+		s << it->first << " " << it->second << "\n";
+
+	return s.str();
+}
+
+int CProfiler::SaveCollapsedStacks(const char *filename) const
+{
+	if( filename == 0 )
+		return asINVALID_ARG;
+
+#if _MSC_VER >= 1500 && !defined(__S3E__)
+	FILE *f = 0;
+	fopen_s(&f, filename, "wb");
+#else
+	FILE *f = fopen(filename, "wb");
+#endif
+	if( f == 0 )
+		return asERROR;
+
+	string str = GetCollapsedStacks();
+	size_t written = fwrite(str.c_str(), 1, str.length(), f);
+	fclose(f);
+
+	return written == str.length() ? asSUCCESS : asERROR;
+}
+
+bool CProfiler::SLineKey::operator<(const SLineKey &o) const
+{
+	if( function != o.function )
+		return function < o.function;
+	if( section != o.section )
+		return section < o.section;
+	return line < o.line;
+}
+
+END_AS_NAMESPACE
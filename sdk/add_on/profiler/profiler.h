@@ -0,0 +1,159 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// The profiler periodically samples the call stack of the registered
+// contexts and aggregates the samples into per function and per line
+// counts. The result can also be exported as collapsed stacks, which
+// can be turned into a flame graph with tools like flamegraph.pl.
+
+// The profiler sets the line callback of the contexts when they are added,
+// which must be done by the thread that executes the context. Requesting a
+// sample only sets an atomic flag, and the sample is then taken by the
+// context's own thread at the next line cue, so the scripts must be compiled
+// with line cues, i.e. asEP_BUILD_WITHOUT_LINE_CUES must not be set. Between
+// the samples the line callback only checks the flag, so the scripts run with
+// very little overhead.
+
+// OBSERVATION: The profiler uses the line callback of the contexts, so
+//              it cannot be used together with the debugger on the same
+//              context. If the application has its own line callback it
+//              can be given to AddContext so the profiler calls it too.
+//              Time spent in application functions is attributed to the
+//              line that called the application function.
+
+#ifndef ANGELSCRIPT_H
+// Avoid having to inform include path if header is already include before
+#include <angelscript.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <map>
+
+#ifdef AS_CAN_USE_CPP11
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#else
+#error Sorry, this requires C++11 which your compiler doesnt appear to support
+#endif
+
+BEGIN_AS_NAMESPACE
+
+class CProfiler
+{
+public:
+	CProfiler();
+	virtual ~CProfiler();
+
+	// The signature of the application's own line callback, if it has one
+	typedef void (*LINECALLBACK_t)(asIScriptContext *ctx, void *param);
+
+	// Add a context that should be sampled. The profiler holds a reference to
+	// the context until it is removed. This must be called by the thread that
+	// executes the context, while the context is not executing, as it sets the
+	// line callback. If the application uses a line callback of its own, it
+	// must be given here so the profiler can call it on each line cue.
+	int  AddContext(asIScriptContext *ctx, LINECALLBACK_t prevCallback = 0, void *prevParam = 0);
+
+	// Remove a context from the profiler. The application's own line callback
+	// is restored. The same restrictions as for AddContext apply.
+	void RemoveContext(asIScriptContext *ctx);
+
+	// Start and stop the background thread that periodically requests samples.
+	// The interval is given in microseconds.
+	int  Start(asUINT intervalMicroSeconds = 1000);
+	void Stop();
+	bool IsRunning() const;
+
+	// Request a sample of each registered context that is currently executing. The
+	// sample is taken by the context at the next line cue. This is called by the
+	// background thread, but the application can call it too, e.g. once per frame.
+	// It is safe to call from any thread.
+	void RequestSample();
+
+	// Discard all samples taken so far
+	void Reset();
+
+	// The aggregated results. Inclusive counts are the number of samples where the
+	// function or line was anywhere in the call stack, exclusive counts are the
+	// number of samples where it was at the top of the call stack. The results
+	// are sorted by the exclusive count, then the inclusive count.
+	struct SFunctionStats
+	{
+		std::string function;
+		asUINT      inclusive;
+		asUINT      exclusive;
+	};
+	struct SLineStats
+	{
+		std::string function;
+		std::string section;
+		int         line;
+		asUINT      inclusive;
+		asUINT      exclusive;
+	};
+	asUINT GetSampleCount() const;
+	void   GetFunctionStats(std::vector<SFunctionStats> &stats) const;
+	void   GetLineStats(std::vector<SLineStats> &stats) const;
+
+	// Export the samples in the collapsed stack format, i.e. one line per unique
+	// call stack with the frames separated by ';' from the outermost to the
+	// innermost, followed by the number of samples.
+	std::string GetCollapsedStacks() const;
+	int         SaveCollapsedStacks(const char *filename) const;
+
+protected:
+	struct SContextInfo
+	{
+		CProfiler         *profiler;
+		asIScriptContext  *ctx;
+		LINECALLBACK_t     prevCallback;
+		void              *prevParam;
+
+		// Set by the context's own thread while it is executing scripts
+		std::atomic<bool>  executing;
+		// Set by RequestSample and cleared by the context's own thread when the sample is taken
+		std::atomic<bool>  armed;
+	};
+	struct SCounts
+	{
+		SCounts() : inclusive(0), exclusive(0) {}
+		asUINT inclusive;
+		asUINT exclusive;
+	};
+	struct SLineKey
+	{
+		std::string function;
+		std::string section;
+		int         line;
+		bool operator<(const SLineKey &o) const;
+	};
+
+	// The line callback that is set on the registered contexts
+	static void LineCallback(asIScriptContext *ctx, SContextInfo *info);
+
+	// Called by the context's own thread when a sample has been requested
+	virtual void TakeSample(asIScriptContext *ctx);
+
+	// Override to change how the functions are named in the results
+	virtual std::string GetFunctionName(asIScriptFunction *func);
+
+	void TimerThread(asUINT intervalMicroSeconds);
+
+	mutable std::mutex             mtx;
+	std::vector<SContextInfo*>     contexts;
+	asUINT                         sampleCount;
+	std::map<std::string, SCounts> functionCounts;
+	std::map<SLineKey, SCounts>    lineCounts;
+	std::map<std::string, asUINT>  stackCounts;
+
+	std::thread                    timer;
+	std::condition_variable        timerCond;
+	bool                           timerRunning;
+};
+
+END_AS_NAMESPACE
+
+#endif
@@ -20,6 +20,32 @@ BEGIN_AS_NAMESPACE
 // Helper functions
 static string GetCurrentDir();
 static string GetAbsolutePath(const string &path);
+static asQWORD HashData(asQWORD hash, const void *data, size_t size);
+static asQWORD HashString(asQWORD hash, const char *str);
+
+// Binary stream for saving the cached bytecode
+class CBytecodeFileStream : public asIBinaryStream
+{
+public:
+	CBytecodeFileStream(FILE *fp) : file(fp) {}
+
+	int Write(const void *ptr, asUINT size)
+	{
+		if( size == 0 ) return 0;
+		return fwrite(ptr, size, 1, file) == 1 ? 0 : -1;
+	}
+	int Read(void *ptr, asUINT size)
+	{
+		if( size == 0 ) return 0;
+		return fread(ptr, size, 1, file) == 1 ? 0 : -1;
+	}
+
+protected:
+	FILE *file;
+};
+
+// The cache file starts with this identifier followed by the cache key
+static const char CACHE_FILE_ID[4] = {'A', 'S', 'B', 'C'};
 
 
 CScriptBuilder::CScriptBuilder()
@@ -32,6 +58,9 @@ CScriptBuilder::CScriptBuilder()
 
 	pragmaCallback = 0;
 	pragmaParam = 0;
+
+	sourceHash = 0;
+	loadedFromCache = false;
 }
 
 void CScriptBuilder::SetIncludeCallback(INCLUDECALLBACK_t callback, void *userParam)
@@ -140,10 +169,24 @@ void CScriptBuilder::DefineWord(const char *word)
 	}
 }
 
+void CScriptBuilder::SetBytecodeCacheDirectory(const char *directory)
+{
+	cacheDirectory = directory ? directory : "";
+}
+
+bool CScriptBuilder::WasLoadedFromCache() const
+{
+	return loadedFromCache;
+}
+
 void CScriptBuilder::ClearAll()
 {
 	includedScripts.clear();
 
+	pendingSections.clear();
+	sourceHash = HashData(0, 0, 0);
+	loadedFromCache = false;
+
 #if AS_PROCESS_METADATA == 1
 	currentClass = "";
 	currentNamespace = "";
@@ -500,8 +543,19 @@ int CScriptBuilder::ProcessScriptSection(const char *script, unsigned int length
 	}
 
 	// Build the actual script
-	engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
-	module->AddScriptSection(sectionname, modifiedScript.c_str(), modifiedScript.size(), lineOffset);
+	if( cacheDirectory.length() )
+	{
+		// The section is only compiled if the cached bytecode cannot be used
+		sourceHash = HashString(sourceHash, sectionname);
+		sourceHash = HashData(sourceHash, &lineOffset, sizeof(lineOffset));
+		sourceHash = HashData(sourceHash, modifiedScript.c_str(), modifiedScript.size());
+		pendingSections.push_back(SScriptSection(sectionname, modifiedScript, lineOffset));
+	}
+	else
+	{
+		engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
+		module->AddScriptSection(sectionname, modifiedScript.c_str(), modifiedScript.size(), lineOffset);
+	}
 
 	if( includes.size() > 0 )
 	{
@@ -550,7 +604,12 @@ int CScriptBuilder::ProcessScriptSection(const char *script, unsigned int length
 
 int CScriptBuilder::Build()
 {
-	int r = module->Build();
+	int r = 0;
+	loadedFromCache = false;
+	if( cacheDirectory.length() )
+		r = BuildFromCache();
+	else
+		r = module->Build();
 	if( r < 0 )
 		return r;
 
@@ -741,6 +800,128 @@ int CScriptBuilder::Build()
 	return 0;
 }
 
+// Loads the bytecode from the cache file if it was stored for the same script
+// and application interface, else compiles the script and updates the cache
+int CScriptBuilder::BuildFromCache()
+{
+	engine->SetEngineProperty(asEP_COPY_SCRIPT_SECTIONS, true);
+
+	asQWORD key = GetCacheKey();
+	string filename = GetCacheFileName();
+
+#if _MSC_VER >= 1500 && !defined(__S3E__)
+	FILE *f = 0;
+	fopen_s(&f, filename.c_str(), "rb");
+#else
+	FILE *f = fopen(filename.c_str(), "rb");
+#endif
+	if( f )
+	{
+		char id[sizeof(CACHE_FILE_ID)];
+		asQWORD storedKey = 0;
+		bool match = fread(id, sizeof(id), 1, f) == 1 &&
+		             memcmp(id, CACHE_FILE_ID, sizeof(id)) == 0 &&
+		             fread(&storedKey, sizeof(storedKey), 1, f) == 1 &&
+		             storedKey == key;
+
+		int r = -1;
+		if( match )
+		{
+			// Read the rest of the file in one go and load the bytecode from memory
+			long start = ftell(f);
+			fseek(f, 0, SEEK_END);
+			long len = ftell(f) - start;
+			fseek(f, start, SEEK_SET);
+
+			string data;
+			if( len > 0 )
+			{
+				data.resize(len);
+				if( fread(&data[0], len, 1, f) == 1 )
+					r = module->LoadByteCodeFromMemory(data.c_str(), data.size());
+			}
+		}
+		fclose(f);
+
+		if( r >= 0 )
+		{
+			pendingSections.clear();
+			loadedFromCache = true;
+			return r;
+		}
+	}
+
+	// The cached bytecode couldn't be used so the script must be compiled
+	for( size_t n = 0; n < pendingSections.size(); n++ )
+		module->AddScriptSection(pendingSections[n].name.c_str(), pendingSections[n].code.c_str(), pendingSections[n].code.size(), pendingSections[n].lineOffset);
+	pendingSections.clear();
+
+	int r = module->Build();
+	if( r < 0 )
+		return r;
+
+	// Update the cache. Failing to do so doesn't fail the build, the
+	// script will just be compiled again the next time
+#if _MSC_VER >= 1500 && !defined(__S3E__)
+	f = 0;
+	fopen_s(&f, filename.c_str(), "wb");
+#else
+	f = fopen(filename.c_str(), "wb");
+#endif
+	if( f )
+	{
+		CBytecodeFileStream stream(f);
+		bool ok = stream.Write(CACHE_FILE_ID, sizeof(CACHE_FILE_ID)) >= 0 &&
+		          stream.Write(&key, sizeof(key)) >= 0 &&
+		          module->SaveByteCode(&stream) >= 0;
+		fclose(f);
+
+		// Don't leave an incomplete file behind
+		if( !ok )
+			remove(filename.c_str());
+	}
+
+	return r;
+}
+
+// The cache file is named after the module so rebuilding the
+// same module replaces the previously cached bytecode
+string CScriptBuilder::GetCacheFileName()
+{
+	string name = module->GetName();
+	for( size_t n = 0; n < name.length(); n++ )
+	{
+		char c = name[n];
+		if( !((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_') )
+			name[n] = '_';
+	}
+
+	string filename = cacheDirectory;
+	if( filename[filename.length()-1] != '/' && filename[filename.length()-1] != '\\' )
+		filename += "/";
+	return filename + name + ".asbc";
+}
+
+// The key identifies everything that affects the compiled bytecode, i.e. the
+// pre-processed script sections, the library and its options, the engine
+// properties, and the registered application interface
+asQWORD CScriptBuilder::GetCacheKey()
+{
+	asQWORD hash = sourceHash;
+
+	hash = HashString(hash, asGetLibraryVersion());
+	hash = HashString(hash, asGetLibraryOptions());
+	for( int n = asEP_ALLOW_UNSAFE_REFERENCES; n < asEP_LAST_PROPERTY; n++ )
+	{
+		asPWORD value = engine->GetEngineProperty(asEEngineProp(n));
+		hash = HashData(hash, &value, sizeof(value));
+	}
+	hash = HashString(hash, module->GetDefaultNamespace());
+
+	asQWORD fingerprint = engine->GetInterfaceFingerprint();
+	return HashData(hash, &fingerprint, sizeof(fingerprint));
+}
+
 int CScriptBuilder::SkipStatement(int pos)
 {
 	asUINT len = 0;
@@ -1109,6 +1290,29 @@ string GetAbsolutePath(const string &file)
 	return str;
 }
 
+// 64bit FNV-1a
+asQWORD HashData(asQWORD hash, const void *data, size_t size)
+{
+	if( hash == 0 )
+		hash = 14695981039346656037ULL;
+
+	const unsigned char *p = (const unsigned char *)data;
+	for( size_t n = 0; n < size; n++ )
+	{
+		hash ^= p[n];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+asQWORD HashString(asQWORD hash, const char *str)
+{
+	// Include the null terminator so consecutive strings can't be confused
+	if( str == 0 ) str = "";
+	return HashData(hash, str, strlen(str) + 1);
+}
+
 string GetCurrentDir()
 {
 	char buffer[1024];
@@ -95,6 +95,16 @@ public:
 	// Add a pre-processor define for conditional compilation
 	void DefineWord(const char *word);
 
+	// Set the directory where the compiled bytecode is cached between builds.
+	// When set, BuildModule loads the bytecode from the cache instead of
+	// compiling the script if neither the pre-processed script nor the
+	// application interface has changed since it was stored.
+	// An empty string or null turns off the cache, which is the default.
+	void SetBytecodeCacheDirectory(const char *directory);
+
+	// Returns true if the last call to BuildModule loaded the bytecode from the cache
+	bool WasLoadedFromCache() const;
+
 	// Enumerate included script sections
 	unsigned int GetSectionCount() const;
 	std::string  GetSectionName(unsigned int idx) const;
@@ -128,6 +138,10 @@ protected:
 	int  ExcludeCode(int start);
 	void OverwriteCode(int start, int len);
 
+	int  BuildFromCache();
+	std::string GetCacheFileName();
+	asQWORD GetCacheKey();
+
 	asIScriptEngine           *engine;
 	asIScriptModule           *module;
 	std::string                modifiedScript;
@@ -138,6 +152,20 @@ protected:
 	PRAGMACALLBACK_t  pragmaCallback;
 	void             *pragmaParam;
 
+	// When the cache is used the sections are only given to the
+	// module if the bytecode must be compiled again
+	struct SScriptSection
+	{
+		SScriptSection(const std::string &n, const std::string &c, int l) : name(n), code(c), lineOffset(l) {}
+		std::string name;
+		std::string code;
+		int         lineOffset;
+	};
+	std::string                 cacheDirectory;
+	std::vector<SScriptSection> pendingSections;
+	asQWORD                     sourceHash;
+	bool                        loadedFromCache;
+
 #if AS_PROCESS_METADATA == 1
 	int  ExtractMetadata(int pos, std::vector<std::string> &outMetadata);
 	int  ExtractDeclaration(int pos, std::string &outName, std::string &outDeclaration, int &outType);
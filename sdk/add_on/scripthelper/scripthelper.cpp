@@ -639,6 +639,16 @@ int ConfigEngineFromStream(asIScriptEngine *engine, istream &strm, const char *c
 			// Only set properties that affect the compiler
 			if( ep != asEP_COPY_SCRIPT_SECTIONS &&
 				ep != asEP_MAX_STACK_SIZE &&
+				ep != asEP_INIT_STACK_SIZE &&
+				ep != asEP_STACK_BLOCK_POOL_SIZE &&
+				ep != asEP_PROFILE_FUNCTIONS &&
+				ep != asEP_USE_BUILD_ARENA &&
+				ep != asEP_COMPILE_THREADS &&
+				ep != asEP_LAZY_LOAD_FUNCTIONS &&
+				ep != asEP_BACKGROUND_GARBAGE_COLLECT &&
+				ep != asEP_GC_PROMOTION_AGE &&
+				ep != asEP_GC_TENURE_AGE &&
+				ep != asEP_GC_TENURED_SCAN_INTERVAL &&
 				ep != asEP_INIT_GLOBAL_VARS_AFTER_BUILD &&
 				ep != asEP_EXPAND_DEF_ARRAY_TO_TMPL &&
 				ep != asEP_AUTO_GARBAGE_COLLECT )
@@ -143,6 +143,17 @@ enum asEEngineProp
 	asEP_HEREDOC_TRIM_MODE                  = 26,
 	asEP_MAX_NESTED_CALLS                   = 27,
 	asEP_GENERIC_CALL_MODE                  = 28,
+	asEP_INIT_STACK_SIZE                    = 29,
+	asEP_STACK_BLOCK_POOL_SIZE              = 30,
+	asEP_PROFILE_FUNCTIONS                  = 31,
+	asEP_USE_BUILD_ARENA                    = 32,
+	asEP_COMPILE_THREADS                    = 33,
+	asEP_LAZY_LOAD_FUNCTIONS                = 34,
+	asEP_BACKGROUND_GARBAGE_COLLECT         = 35,
+	asEP_GC_PROMOTION_AGE                   = 36,
+	asEP_GC_TENURE_AGE                      = 37,
+	asEP_GC_TENURED_SCAN_INTERVAL           = 38,
+	asEP_REORDER_CLASS_PROPERTIES           = 39,
 
 	asEP_LAST_PROPERTY
 };
@@ -271,7 +282,23 @@ enum asEGCFlags
 	asGC_FULL_CYCLE      = 1,
 	asGC_ONE_STEP        = 2,
 	asGC_DESTROY_GARBAGE = 4,
-	asGC_DETECT_GARBAGE  = 8
+	asGC_DETECT_GARBAGE  = 8,
+	asGC_TIME_BUDGET     = 16
+};
+
+// Garbage collector phases
+enum asEGCPhase
+{
+	asGC_PHASE_DESTROY_NEW      = 0,
+	asGC_PHASE_DESTROY_OLD      = 1,
+	asGC_PHASE_CLEAR_COUNTERS   = 2,
+	asGC_PHASE_BUILD_MAP        = 3,
+	asGC_PHASE_COUNT_REFERENCES = 4,
+	asGC_PHASE_DETECT_GARBAGE   = 5,
+	asGC_PHASE_VERIFY_UNMARKED  = 6,
+	asGC_PHASE_BREAK_CIRCLES    = 7,
+
+	asGC_PHASE_LAST
 };
 
 // Token classes
@@ -570,6 +597,8 @@ extern "C"
 
 	// Auxiliary
 	AS_API asILockableSharedBool *asCreateLockableSharedBool();
+	AS_API asIJITCompiler        *asCreateJITCompiler();
+	AS_API void                   asDestroyJITCompiler(asIJITCompiler *jit);
 }
 #endif // ANGELSCRIPT_DLL_MANUAL_IMPORT
 
@@ -715,6 +744,7 @@ public:
 	virtual int         BeginConfigGroup(const char *groupName) = 0;
 	virtual int         EndConfigGroup() = 0;
 	virtual int         RemoveConfigGroup(const char *groupName) = 0;
+	virtual asQWORD     GetInterfaceFingerprint(const char *groupName = 0) const = 0;
 	virtual asDWORD     SetDefaultAccessMask(asDWORD defaultMask) = 0;
 	virtual int         SetDefaultNamespace(const char *nameSpace) = 0;
 	virtual const char *GetDefaultNamespace() const = 0;
@@ -724,9 +754,11 @@ public:
 	virtual int              DiscardModule(const char *module) = 0;
 	virtual asUINT           GetModuleCount() const = 0;
 	virtual asIScriptModule *GetModuleByIndex(asUINT index) const = 0;
+	virtual int              LoadByteCodeForModules(asIScriptModule **modules, asIBinaryStream **streams, asUINT count, asUINT numThreads = 0, int *results = 0) = 0;
 
 	// Script functions
 	virtual asIScriptFunction *GetFunctionById(int funcId) const = 0;
+	virtual void               ResetProfileData() = 0;
 
 	// Type identification
 	virtual int            GetTypeIdByDecl(const char *decl) const = 0;
@@ -752,6 +784,7 @@ public:
 	virtual asIScriptContext      *RequestContext() = 0;
 	virtual void                   ReturnContext(asIScriptContext *ctx) = 0;
 	virtual int                    SetContextCallbacks(asREQUESTCONTEXTFUNC_t requestCtx, asRETURNCONTEXTFUNC_t returnCtx, void *param = 0) = 0;
+	virtual void                   GetContextStackStatistics(asUINT *totalAllocated, asUINT *totalReused = 0, asUINT *currentlyPooled = 0) const = 0;
 
 	// String interpretation
 	virtual asETokenClass ParseToken(const char *string, size_t stringLength = 0, asUINT *tokenLength = 0) const = 0;
@@ -759,6 +792,8 @@ public:
 	// Garbage collection
 	virtual int  GarbageCollect(asDWORD flags = asGC_FULL_CYCLE, asUINT numIterations = 1) = 0;
 	virtual void GetGCStatistics(asUINT *currentSize, asUINT *totalDestroyed = 0, asUINT *totalDetected = 0, asUINT *newObjects = 0, asUINT *totalNewDestroyed = 0) const = 0;
+	virtual int  GetGCGenerationStatistics(asUINT generation, asUINT *currentSize, asUINT *totalDestroyed = 0, asUINT *totalPromoted = 0, asUINT *totalScans = 0) const = 0;
+	virtual int  GetGCPhaseStatistics(asEGCPhase phase, double *totalTime, double *maxStepTime = 0, asQWORD *totalSteps = 0) const = 0;
 	virtual int  NotifyGarbageCollectorOfNewObject(void *obj, asITypeInfo *type) = 0;
 	virtual int  GetObjectInGC(asUINT idx, asUINT *seqNbr = 0, void **obj = 0, asITypeInfo **type = 0) = 0;
 	virtual void GCEnumCallback(void *reference) = 0;
@@ -811,6 +846,7 @@ public:
 	// Compilation
 	virtual int         AddScriptSection(const char *name, const char *code, size_t codeLength = 0, int lineOffset = 0) = 0;
 	virtual int         Build() = 0;
+	virtual int         BuildIncremental() = 0;
 	virtual int         CompileFunction(const char *sectionName, const char *code, int lineOffset, asDWORD compileFlags, asIScriptFunction **outFunc) = 0;
 	virtual int         CompileGlobalVar(const char *sectionName, const char *code, int lineOffset) = 0;
 	virtual asDWORD     SetAccessMask(asDWORD accessMask) = 0;
@@ -862,6 +898,7 @@ public:
 	// Byte code saving and loading
 	virtual int SaveByteCode(asIBinaryStream *out, bool stripDebugInfo = false) const = 0;
 	virtual int LoadByteCode(asIBinaryStream *in, bool *wasDebugInfoStripped = 0) = 0;
+	virtual int LoadByteCodeFromMemory(const void *data, size_t size, bool *wasDebugInfoStripped = 0) = 0;
 
 	// User data
 	virtual void *SetUserData(void *data, asPWORD type = 0) = 0;
@@ -1143,6 +1180,7 @@ public:
 	virtual int              GetVar(asUINT index, const char **name, int *typeId = 0) const = 0;
 	virtual const char      *GetVarDecl(asUINT index, bool includeNamespace = false) const = 0;
 	virtual int              FindNextLineWithCode(int line) const = 0;
+	virtual void             GetProfileData(asQWORD *callCount, double *totalTime = 0) const = 0;
 
 	// For JIT compilation
 	virtual asDWORD         *GetByteCode(asUINT *length = 0) = 0;
@@ -1578,7 +1616,15 @@ enum asEBCInstr
 	asBC_POWi64			= 198,
 	asBC_POWu64			= 199,
 	asBC_Thiscall1		= 200,
-	asBC_MAXBYTECODE	= 201,
+	asBC_CMPIiJZ		= 201,
+	asBC_CMPIiJNZ		= 202,
+	asBC_CMPIiJS		= 203,
+	asBC_CMPIiJNS		= 204,
+	asBC_CMPIiJP		= 205,
+	asBC_CMPIiJNP		= 206,
+	asBC_CpyThisToV4	= 207,
+	asBC_CpyVtoThis4	= 208,
+	asBC_MAXBYTECODE	= 209,
 
 	// Temporary tokens. Can't be output to the final program
 	asBC_VarDecl		= 251,
@@ -1873,15 +1919,15 @@ const asSBCInfo asBCInfo[256] =
 	asBCINFO(POWi64,	wW_rW_rW_ARG,	0),
 	asBCINFO(POWu64,	wW_rW_rW_ARG,	0),
 	asBCINFO(Thiscall1, DW_ARG,			-AS_PTR_SIZE-1),
+	asBCINFO(CMPIiJZ,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJNZ,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJS,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJNS,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJP,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJNP,	rW_DW_DW_ARG,	0),
+	asBCINFO(CpyThisToV4, rW_W_DW_ARG,	0),
+	asBCINFO(CpyVtoThis4, rW_W_DW_ARG,	0),
 
-	asBCINFO_DUMMY(201),
-	asBCINFO_DUMMY(202),
-	asBCINFO_DUMMY(203),
-	asBCINFO_DUMMY(204),
-	asBCINFO_DUMMY(205),
-	asBCINFO_DUMMY(206),
-	asBCINFO_DUMMY(207),
-	asBCINFO_DUMMY(208),
 	asBCINFO_DUMMY(209),
 	asBCINFO_DUMMY(210),
 	asBCINFO_DUMMY(211),
@@ -73,6 +73,7 @@ SOURCES += ../../source/as_atomic.cpp \
            ../../source/as_gc.cpp \
            ../../source/as_generic.cpp \
            ../../source/as_globalproperty.cpp \
+           ../../source/as_jit_x64_gcc.cpp \
            ../../source/as_memory.cpp \
            ../../source/as_module.cpp \
            ../../source/as_objecttype.cpp \
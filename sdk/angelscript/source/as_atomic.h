@@ -44,6 +44,10 @@
 
 #include "as_config.h"
 
+#if defined(_MSC_VER) && !defined(AS_NO_THREADS) && !defined(AS_NO_ATOMIC)
+#include <intrin.h>
+#endif
+
 BEGIN_AS_NAMESPACE
 
 class asCAtomic
@@ -64,6 +68,93 @@ protected:
 	asDWORD value;
 };
 
+// Reads and writes of a pointer that is used to publish data to other threads.
+// A thread that sees the value stored with asAtomicStoreRelease also sees
+// everything that the storing thread wrote to memory before the store
+template<class T>
+inline T *asAtomicLoadAcquire(T *const &ptr)
+{
+#if defined(AS_NO_THREADS) || defined(AS_NO_ATOMIC)
+	return ptr;
+#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+	return __atomic_load_n(&ptr, __ATOMIC_ACQUIRE);
+#elif defined(__GNUC__)
+	T *val = *(T *volatile const *)&ptr;
+	__sync_synchronize();
+	return val;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	// MSVC gives volatile accesses acquire and release semantics on x86
+	T *val = *(T *volatile const *)&ptr;
+	_ReadWriteBarrier();
+	return val;
+#elif defined(_MSC_VER)
+	return (T*)_InterlockedCompareExchangePointer((void *volatile *)&ptr, 0, 0);
+#else
+	return *(T *volatile const *)&ptr;
+#endif
+}
+
+template<class T>
+inline void asAtomicStoreRelease(T *&ptr, T *val)
+{
+#if defined(AS_NO_THREADS) || defined(AS_NO_ATOMIC)
+	ptr = val;
+#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+	__atomic_store_n(&ptr, val, __ATOMIC_RELEASE);
+#elif defined(__GNUC__)
+	__sync_synchronize();
+	*(T *volatile *)&ptr = val;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	_ReadWriteBarrier();
+	*(T *volatile *)&ptr = val;
+#elif defined(_MSC_VER)
+	_InterlockedExchangePointer((void *volatile *)&ptr, val);
+#else
+	*(T *volatile *)&ptr = val;
+#endif
+}
+
+// The same for an int that is set once by one thread and read by others
+inline int asAtomicLoadAcquire(const int &var)
+{
+#if defined(AS_NO_THREADS) || defined(AS_NO_ATOMIC)
+	return var;
+#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+	return __atomic_load_n(&var, __ATOMIC_ACQUIRE);
+#elif defined(__GNUC__)
+	int val = *(const volatile int *)&var;
+	__sync_synchronize();
+	return val;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	int val = *(const volatile int *)&var;
+	_ReadWriteBarrier();
+	return val;
+#elif defined(_MSC_VER)
+	return (int)_InterlockedCompareExchange((volatile long *)&var, 0, 0);
+#else
+	return *(const volatile int *)&var;
+#endif
+}
+
+inline void asAtomicStoreRelease(int &var, int val)
+{
+#if defined(AS_NO_THREADS) || defined(AS_NO_ATOMIC)
+	var = val;
+#elif defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7)))
+	__atomic_store_n(&var, val, __ATOMIC_RELEASE);
+#elif defined(__GNUC__)
+	__sync_synchronize();
+	*(volatile int *)&var = val;
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+	_ReadWriteBarrier();
+	*(volatile int *)&var = val;
+#elif defined(_MSC_VER)
+	_InterlockedExchange((volatile long *)&var, val);
+#else
+	*(volatile int *)&var = val;
+#endif
+}
+
 END_AS_NAMESPACE
 
 #endif
@@ -46,6 +46,7 @@
 #include "as_texts.h"
 #include "as_scriptobject.h"
 #include "as_debug.h"
+#include "as_thread.h"
 
 BEGIN_AS_NAMESPACE
 
@@ -85,6 +86,12 @@ asCBuilder::asCBuilder(asCScriptEngine *_engine, asCModule *_module)
 	this->engine = _engine;
 	this->module = _module;
 	silent = false;
+
+#ifndef AS_NO_COMPILER
+	isCompilingInParallel = false;
+	compileJobs = 0;
+	nextCompileJob = 0;
+#endif
 }
 
 asCBuilder::~asCBuilder()
@@ -106,6 +113,22 @@ asCBuilder::~asCBuilder()
 		functions[n] = 0;
 	}
 
+	// Free the overload cache
+	asSMapNode<asUINT, sOverloadCacheEntry*> *cursor = 0;
+	overloadCache.MoveFirst(&cursor);
+	while( cursor )
+	{
+		sOverloadCacheEntry *entry = overloadCache.GetValue(cursor);
+		while( entry )
+		{
+			sOverloadCacheEntry *next = entry->next;
+			asDELETE(entry, sOverloadCacheEntry);
+			entry = next;
+		}
+		overloadCache.MoveNext(&cursor, cursor);
+	}
+	overloadCache.EraseAll();
+
 	// Free all global variables
 	asCSymbolTable<sGlobalVariableDescription>::iterator it = globVariables.List();
 	while( it )
@@ -326,6 +349,405 @@ int asCBuilder::Build()
 	return asSUCCESS;
 }
 
+// Finds the statement blocks of the functions, and the declarations whose
+// position is also compiled into the bytecode of other functions
+static void FindIncrementalNodes(asCScriptNode *node, asCArray<asCScriptNode*> &bodies, asCArray<asCScriptNode*> &fixed)
+{
+	for( asCScriptNode *n = node->firstChild; n; n = n->next )
+	{
+		if( n->nodeType == snStatementBlock )
+			bodies.PushLast(n);
+		else
+		{
+			if( n->nodeType == snDeclaration || n->nodeType == snClass )
+				fixed.PushLast(n);
+			FindIncrementalNodes(n, bodies, fixed);
+		}
+	}
+}
+
+// Returns true if the code may declare a lambda function. The lambda functions get new
+// ids when they are compiled, so the function declaring them must be part of a full build
+static bool MayDeclareLambda(asCScriptEngine *engine, asCScriptCode *script, size_t pos, size_t length)
+{
+	size_t end = pos + length;
+	while( pos < end )
+	{
+		size_t len;
+		eTokenType t = engine->tok.GetToken(&script->code[pos], end - pos, &len);
+		if( t == ttIdentifier && script->TokenEquals(pos, len, FUNCTION_TOKEN) )
+			return true;
+		pos += len;
+	}
+
+	return false;
+}
+
+// Returns the index of the first function body that ends after the position in the old code
+static asUINT FindIncrementalBody(const asCArray<sIncrementalBody> &bodies, size_t pos)
+{
+	asUINT lo = 0, hi = bodies.GetLength();
+	while( lo < hi )
+	{
+		asUINT mid = (lo + hi) / 2;
+		if( bodies[mid].oldPos + bodies[mid].oldLength <= pos )
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+// Returns the position in the new code of a position in the old code that hasn't been modified
+static size_t MapIncrementalPos(const asCArray<sIncrementalBody> &bodies, size_t pos, size_t oldLength, size_t newLength)
+{
+	asUINT k = FindIncrementalBody(bodies, pos);
+	if( k < bodies.GetLength() )
+		return pos - bodies[k].oldPos + bodies[k].newPos;
+	return pos - oldLength + newLength;
+}
+
+// Compiles only the functions that have been modified since the previous incremental build.
+// Returns 1 if the modifications cannot be compiled without building the whole module
+int asCBuilder::BuildIncremental()
+{
+	Reset();
+
+	// Only the code of the sections may have changed
+	asCArray<sIncrementalSection*> &sections = module->incrementalSections;
+	if( sections.GetLength() == 0 ||
+		sections.GetLength() != scripts.GetLength() ||
+		module->incrementalNameSpace != module->defaultNamespace )
+		return 1;
+
+	int r = 0;
+	asCArray<sIncrementalSectionUpdate*> updates;
+	for( asUINT n = 0; n < sections.GetLength() && r == 0; n++ )
+	{
+		sIncrementalSection *section = sections[n];
+		asCScriptCode *script = scripts[n];
+		if( section->name != script->name || section->lineOffset != script->lineOffset )
+		{
+			r = 1;
+			break;
+		}
+
+		if( section->code.GetLength() == script->codeLength &&
+			memcmp(section->code.AddressOf(), script->code, script->codeLength) == 0 )
+			continue;
+
+		sIncrementalSectionUpdate *update = asNEW(sIncrementalSectionUpdate);
+		if( update == 0 )
+		{
+			r = asOUT_OF_MEMORY;
+			break;
+		}
+
+		update->section = n;
+		update->parser  = 0;
+		updates.PushLast(update);
+
+		r = FindIncrementalUpdates(n, update);
+	}
+
+	// Nothing is modified until it is known that all the sections can be updated
+	if( r == 0 )
+		r = ApplyIncrementalUpdates(updates);
+
+	for( asUINT n = 0; n < updates.GetLength(); n++ )
+	{
+		if( updates[n]->parser )
+			asDELETE(updates[n]->parser, asCParser);
+		asDELETE(updates[n], sIncrementalSectionUpdate);
+	}
+
+	return r;
+}
+
+// Determines which functions in the modified section must be compiled again and which only have been moved
+int asCBuilder::FindIncrementalUpdates(asUINT sectionIdx, sIncrementalSectionUpdate *update)
+{
+	sIncrementalSection *section = module->incrementalSections[sectionIdx];
+	asCScriptCode *script = scripts[sectionIdx];
+
+	asCScriptCode oldScript;
+	oldScript.SetCode(section->name.AddressOf(), section->code.AddressOf(), section->code.GetLength(), false);
+	oldScript.lineOffset = section->lineOffset;
+	oldScript.idx        = script->idx;
+
+	// The new code is kept parsed, as the function nodes will be compiled
+	update->parser = asNEW(asCParser)(this);
+	if( update->parser == 0 )
+		return asOUT_OF_MEMORY;
+	if( update->parser->ParseScript(script) < 0 )
+		return asERROR;
+
+	asCParser oldParser(this);
+	if( oldParser.ParseScript(&oldScript) < 0 )
+		return 1;
+
+	asCArray<asCScriptNode*> oldBodies, newBodies, oldFixed, newFixed;
+	FindIncrementalNodes(oldParser.GetScriptNode(), oldBodies, oldFixed);
+	FindIncrementalNodes(update->parser->GetScriptNode(), newBodies, newFixed);
+	if( oldBodies.GetLength() != newBodies.GetLength() || oldFixed.GetLength() != newFixed.GetLength() )
+		return 1;
+
+	// The code outside the function bodies must be exactly the same
+	size_t oldPos = 0, newPos = 0;
+	for( asUINT n = 0; n <= oldBodies.GetLength(); n++ )
+	{
+		size_t oldEnd = n < oldBodies.GetLength() ? oldBodies[n]->tokenPos : oldScript.codeLength;
+		size_t newEnd = n < newBodies.GetLength() ? newBodies[n]->tokenPos : script->codeLength;
+		if( oldEnd - oldPos != newEnd - newPos ||
+			memcmp(&oldScript.code[oldPos], &script->code[newPos], oldEnd - oldPos) != 0 )
+			return 1;
+
+		if( n < oldBodies.GetLength() )
+		{
+			sIncrementalBody body;
+			body.oldPos     = oldBodies[n]->tokenPos;
+			body.oldLength  = oldBodies[n]->tokenLength;
+			body.newPos     = newBodies[n]->tokenPos;
+			body.newNode    = newBodies[n];
+			body.isModified = oldBodies[n]->tokenLength != newBodies[n]->tokenLength ||
+			                  memcmp(&oldScript.code[body.oldPos], &script->code[body.newPos], body.oldLength) != 0;
+			update->bodies.PushLast(body);
+
+			oldPos = body.oldPos + body.oldLength;
+			newPos = body.newPos + newBodies[n]->tokenLength;
+		}
+	}
+
+	// The variables and classes must stay where they are, since their position is
+	// also stored in the initialization functions and the class constructors
+	for( asUINT n = 0; n < oldFixed.GetLength(); n++ )
+	{
+		int oldRow, oldCol, newRow, newCol;
+		oldScript.ConvertPosToRowCol(oldFixed[n]->tokenPos, &oldRow, &oldCol);
+		script->ConvertPosToRowCol(newFixed[n]->tokenPos, &newRow, &newCol);
+		if( oldRow != newRow || oldCol != newCol )
+			return 1;
+	}
+
+	// Each modified function body must belong to a function that can be compiled again
+	asCArray<bool> hasFunction;
+	hasFunction.SetLength(update->bodies.GetLength());
+	for( asUINT n = 0; n < hasFunction.GetLength(); n++ )
+		hasFunction[n] = false;
+
+	for( asUINT n = 0; n < section->functions.GetLength(); n++ )
+	{
+		sIncrementalFunction *func = &section->functions[n];
+
+		// Functions declared outside the function bodies have not been moved
+		asUINT k = FindIncrementalBody(update->bodies, func->bodyPos);
+		if( k >= update->bodies.GetLength() || func->bodyPos < update->bodies[k].oldPos )
+			continue;
+
+		sIncrementalBody &body = update->bodies[k];
+		bool isOwner = func->bodyPos == body.oldPos;
+		if( isOwner )
+			hasFunction[k] = true;
+
+		int oldRow, oldCol, newRow, newCol;
+		oldScript.ConvertPosToRowCol(body.oldPos, &oldRow, &oldCol);
+		script->ConvertPosToRowCol(body.newPos, &newRow, &newCol);
+
+		sIncrementalUpdate funcUpdate;
+		funcUpdate.func     = func;
+		funcUpdate.node     = 0;
+		funcUpdate.rowDelta = 0;
+
+		if( body.isModified || oldCol != newCol )
+		{
+			if( !isOwner || !func->canRecompile ||
+				MayDeclareLambda(engine, &oldScript, body.oldPos, body.oldLength) ||
+				MayDeclareLambda(engine, script, body.newPos, body.newNode->tokenLength) )
+				return 1;
+
+			// Virtual property accessors are compiled from the statement block
+			funcUpdate.node = func->declaredAtPos == func->bodyPos ? body.newNode : body.newNode->parent;
+		}
+		else if( oldRow != newRow )
+		{
+			if( !func->canMove )
+				return 1;
+
+			funcUpdate.rowDelta = newRow - oldRow;
+		}
+		else
+			continue;
+
+		update->functions.PushLast(funcUpdate);
+	}
+
+	for( asUINT n = 0; n < hasFunction.GetLength(); n++ )
+		if( update->bodies[n].isModified && !hasFunction[n] )
+			return 1;
+
+	return 0;
+}
+
+// Compiles the modified functions and moves the line numbers of the others
+int asCBuilder::ApplyIncrementalUpdates(asCArray<sIncrementalSectionUpdate*> &updates)
+{
+	// The compiler must see the same global constants as in a full build
+	bool needsCompile = false;
+	for( asUINT n = 0; n < updates.GetLength() && !needsCompile; n++ )
+		for( asUINT f = 0; f < updates[n]->functions.GetLength(); f++ )
+			if( updates[n]->functions[f].node )
+				needsCompile = true;
+
+	for( asUINT n = 0; needsCompile && n < module->incrementalConstants.GetLength(); n++ )
+	{
+		asCGlobalProperty *prop = module->incrementalConstants[n].property;
+
+		sGlobalVariableDescription *gvar = asNEW(sGlobalVariableDescription);
+		if( gvar == 0 )
+			return asOUT_OF_MEMORY;
+
+		gvar->script             = 0;
+		gvar->declaredAtNode     = 0;
+		gvar->initializationNode = 0;
+		gvar->name               = prop->name;
+		gvar->property           = prop;
+		gvar->datatype           = prop->type;
+		gvar->ns                 = prop->nameSpace;
+		gvar->index              = 0;
+		gvar->isCompiled         = true;
+		gvar->isPureConstant     = true;
+		gvar->isEnumValue        = false;
+		gvar->constantValue      = module->incrementalConstants[n].value;
+		globVariables.Put(gvar);
+	}
+
+	for( asUINT n = 0; n < updates.GetLength(); n++ )
+	{
+		sIncrementalSectionUpdate *update = updates[n];
+		sIncrementalSection *section = module->incrementalSections[update->section];
+		asCScriptCode *script = scripts[update->section];
+
+		for( asUINT f = 0; f < update->functions.GetLength(); f++ )
+		{
+			sIncrementalUpdate &funcUpdate = update->functions[f];
+			asCScriptFunction *func = engine->scriptFunctions[funcUpdate.func->funcId];
+			if( funcUpdate.node )
+			{
+				func->ResetScriptFunctionData();
+
+				sFunctionDescription *funcDesc = asNEW(sFunctionDescription);
+				if( funcDesc == 0 )
+					return asOUT_OF_MEMORY;
+
+				functions.PushLast(funcDesc);
+				funcDesc->script           = script;
+				funcDesc->node             = funcUpdate.node->CreateCopy(engine);
+				funcDesc->name             = func->name;
+				funcDesc->objType          = func->objectType;
+				funcDesc->funcId           = func->id;
+				funcDesc->paramNames       = func->parameterNames;
+				funcDesc->isExistingShared = false;
+			}
+			else
+			{
+				asCArray<int> &lineNumbers = func->scriptData->lineNumbers;
+				for( asUINT l = 1; l < lineNumbers.GetLength(); l += 2 )
+					lineNumbers[l] = (lineNumbers[l] & ~0xFFFFF) | ((lineNumbers[l] + funcUpdate.rowDelta) & 0xFFFFF);
+			}
+		}
+
+		// Update the positions of all the functions declared in the section
+		for( asUINT f = 0; f < section->functions.GetLength(); f++ )
+		{
+			sIncrementalFunction &incrFunc = section->functions[f];
+			incrFunc.bodyPos       = MapIncrementalPos(update->bodies, incrFunc.bodyPos, section->code.GetLength(), script->codeLength);
+			incrFunc.declaredAtPos = MapIncrementalPos(update->bodies, incrFunc.declaredAtPos, section->code.GetLength(), script->codeLength);
+
+			int row, col;
+			script->ConvertPosToRowCol(incrFunc.declaredAtPos, &row, &col);
+			engine->scriptFunctions[incrFunc.funcId]->scriptData->declaredAt = (row & 0xFFFFF)|((col & 0xFFF)<<20);
+		}
+
+		section->code.Assign(script->code, script->codeLength);
+	}
+
+	CompileFunctions();
+
+	if( numWarnings > 0 && engine->ep.compilerWarnings == 2 )
+		WriteError(TXT_WARNINGS_TREATED_AS_ERROR, 0, 0);
+
+	if( numErrors > 0 )
+		return asERROR;
+
+	for( asUINT n = 0; n < functions.GetLength(); n++ )
+		engine->scriptFunctions[functions[n]->funcId]->JITCompile();
+
+	return asSUCCESS;
+}
+
+// Remembers the code and the position of the compiled functions for the next incremental build
+void asCBuilder::SaveIncrementalBuild()
+{
+	module->ResetIncrementalBuild();
+
+	for( asUINT n = 0; n < scripts.GetLength(); n++ )
+	{
+		sIncrementalSection *section = asNEW(sIncrementalSection);
+		if( section == 0 )
+		{
+			module->ResetIncrementalBuild();
+			return;
+		}
+
+		section->name       = scripts[n]->name;
+		section->code.Assign(scripts[n]->code, scripts[n]->codeLength);
+		section->lineOffset = scripts[n]->lineOffset;
+		module->incrementalSections.PushLast(section);
+	}
+
+	for( asUINT n = 0; n < functions.GetLength(); n++ )
+	{
+		sFunctionDescription *desc = functions[n];
+		if( desc == 0 || desc->node == 0 || desc->isExistingShared )
+			continue;
+
+		asCScriptNode *body = desc->node->nodeType == snStatementBlock ? desc->node : desc->node->lastChild;
+		if( body == 0 || body->nodeType != snStatementBlock )
+			continue;
+
+		int s = scripts.IndexOf(desc->script);
+		if( s < 0 )
+			continue;
+
+		// Constructors also hold the initialization of the members, shared functions may be used
+		// by other modules, and the lambda functions are compiled with the function declaring them
+		bool isConstructor = desc->objType && desc->name == desc->objType->name;
+		bool isLambda      = desc->name.GetLength() && desc->name[0] == '$';
+
+		sIncrementalFunction func;
+		func.funcId        = desc->funcId;
+		func.declaredAtPos = desc->node->tokenPos;
+		func.bodyPos       = body->tokenPos;
+		func.canRecompile  = !isConstructor && !isLambda && !engine->scriptFunctions[desc->funcId]->IsShared();
+		func.canMove       = !isConstructor;
+		module->incrementalSections[s]->functions.PushLast(func);
+	}
+
+	asCSymbolTable<sGlobalVariableDescription>::iterator it = globVariables.List();
+	for( ; it; it++ )
+	{
+		if( (*it)->isEnumValue || !(*it)->isPureConstant || (*it)->property == 0 )
+			continue;
+
+		sIncrementalConstant constant;
+		constant.property = (*it)->property;
+		constant.value    = (*it)->constantValue;
+		module->incrementalConstants.PushLast(constant);
+	}
+
+	module->incrementalNameSpace = module->defaultNamespace;
+}
+
 int asCBuilder::CompileGlobalVar(const char *sectionName, const char *code, int lineOffset)
 {
 	Reset();
@@ -864,6 +1286,14 @@ void asCBuilder::RegisterNonTypesFromScript(asCScriptNode *node, asCScriptCode *
 
 void asCBuilder::CompileFunctions()
 {
+#ifndef AS_NO_THREADS
+	if( engine->ep.compileThreads > 1 )
+	{
+		CompileFunctionsInParallel(engine->ep.compileThreads);
+		return;
+	}
+#endif
+
 	// Compile each function
 	for( asUINT n = 0; n < functions.GetLength(); n++ )
 	{
@@ -877,62 +1307,284 @@ void asCBuilder::CompileFunctions()
 		if (current->node && !(current->node->nodeType == snStatementBlock || current->node->lastChild->nodeType == snStatementBlock))
 			continue;
 
-		asCCompiler compiler(engine);
-		asCScriptFunction *func = engine->scriptFunctions[current->funcId];
+		CompileFunctionBody(current);
+	}
+}
+
+void asCBuilder::CompileFunctionBody(sFunctionDescription *current)
+{
+	asCCompiler compiler(engine);
+	asCScriptFunction *func = engine->scriptFunctions[current->funcId];
 
-		// Find the class declaration for constructors
-		sClassDeclaration *classDecl = 0;
-		if( current->objType && current->name == current->objType->name )
+	// Find the class declaration for constructors
+	sClassDeclaration *classDecl = 0;
+	if( current->objType && current->name == current->objType->name )
+	{
+		for( asUINT c = 0; c < classDeclarations.GetLength(); c++ )
 		{
-			for( asUINT c = 0; c < classDeclarations.GetLength(); c++ )
+			if( classDeclarations[c]->typeInfo == current->objType )
 			{
-				if( classDeclarations[c]->typeInfo == current->objType )
-				{
-					classDecl = classDeclarations[c];
-					break;
-				}
+				classDecl = classDeclarations[c];
+				break;
 			}
-
-			asASSERT( classDecl );
 		}
 
-		if( current->node )
-		{
-			int r, c;
-			current->script->ConvertPosToRowCol(current->node->tokenPos, &r, &c);
+		asASSERT( classDecl );
+	}
+
+	if( current->node )
+	{
+		int r, c;
+		current->script->ConvertPosToRowCol(current->node->tokenPos, &r, &c);
 
-			asCString str = func->GetDeclarationStr();
-			str.Format(TXT_COMPILING_s, str.AddressOf());
-			WriteInfo(current->script->name, str, r, c, true);
+		asCString str = func->GetDeclarationStr();
+		str.Format(TXT_COMPILING_s, str.AddressOf());
+		WriteInfo(current->script->name, str, r, c, true);
 
-			// When compiling a constructor need to pass the class declaration for member initializations
-			compiler.CompileFunction(this, current->script, current->paramNames, current->node, func, classDecl);
+		// When compiling a constructor need to pass the class declaration for member initializations
+		compiler.CompileFunction(this, current->script, current->paramNames, current->node, func, classDecl);
 
+		if( GetCompileJob() == 0 )
 			engine->preMessage.isSet = false;
+	}
+	else if( current->objType && current->name == current->objType->name )
+	{
+		asCScriptNode *node = classDecl->node;
+
+		int r = 0, c = 0;
+		if( node )
+			current->script->ConvertPosToRowCol(node->tokenPos, &r, &c);
+
+		asCString str = func->GetDeclarationStr();
+		str.Format(TXT_COMPILING_s, str.AddressOf());
+		WriteInfo(current->script->name, str, r, c, true);
+
+		// This is the default constructor that is generated
+		// automatically if not implemented by the user.
+		compiler.CompileDefaultConstructor(this, current->script, node, func, classDecl);
+
+		if( GetCompileJob() == 0 )
+			engine->preMessage.isSet = false;
+	}
+	else
+	{
+		asASSERT( false );
+	}
+}
+
+// The function bodies are compiled by the given number of threads, including the calling thread. Whatever
+// the compiler needs that is shared between the threads is either protected by the compile lock, or is only
+// read, e.g. the engine's and the module's tables. A function that would have to modify the tables, e.g. to
+// create a new template instance or register a lambda function, is not compiled by the threads. It is instead
+// compiled by the calling thread afterwards, in the declared order, so the function ids are the same as when
+// compiling with a single thread. The messages are kept until then so they are written in the same order too.
+void asCBuilder::CompileFunctionsInParallel(asUINT numThreads)
+{
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+
+	// The lambda functions are added to the end of the list when their
+	// outer function is compiled, so they are compiled in the next round
+	asUINT first = 0;
+	while( first < functions.GetLength() )
+	{
+		asCArray<sCompileJob*> jobs;
+		asUINT last = functions.GetLength();
+		for( asUINT n = first; n < last; n++ )
+		{
+			sFunctionDescription *current = functions[n];
+			if( current == 0 ) continue;
+			if( current->isExistingShared ) continue;
+			if (current->node && !(current->node->nodeType == snStatementBlock || current->node->lastChild->nodeType == snStatementBlock))
+				continue;
+
+			sCompileJob *job = asNEW(sCompileJob);
+			if( job == 0 )
+				continue;
+			job->func      = current;
+			job->numErrors = 0;
+			job->deferred  = false;
+			jobs.PushLast(job);
 		}
-		else if( current->objType && current->name == current->objType->name )
+		first = last;
+
+		if( tld && jobs.GetLength() > 1 )
 		{
-			asCScriptNode *node = classDecl->node;
+			// The parser caches the known types on first use, so this must be done before the threads start
+			DoesTypeExist("");
 
-			int r = 0, c = 0;
-			if( node )
-				current->script->ConvertPosToRowCol(node->tokenPos, &r, &c);
+			compileJobs    = &jobs;
+			nextCompileJob = 0;
+			isCompilingInParallel = true;
 
-			asCString str = func->GetDeclarationStr();
-			str.Format(TXT_COMPILING_s, str.AddressOf());
-			WriteInfo(current->script->name, str, r, c, true);
+			asCArray<void*> threads;
+			for( asUINT t = 1; t < numThreads && t < jobs.GetLength(); t++ )
+			{
+				void *thread = asStartThread(CompileFunctionsThread, this);
+				if( thread == 0 )
+					break;
+				threads.PushLast(thread);
+			}
 
-			// This is the default constructor that is generated
-			// automatically if not implemented by the user.
-			compiler.CompileDefaultConstructor(this, current->script, node, func, classDecl);
+			// The calling thread compiles its share of the functions too
+			CompileJobs();
 
-			engine->preMessage.isSet = false;
+			for( asUINT t = 0; t < threads.GetLength(); t++ )
+				asJoinThread(threads[t]);
+
+			isCompilingInParallel = false;
+			compileJobs = 0;
 		}
 		else
 		{
-			asASSERT( false );
+			for( asUINT n = 0; n < jobs.GetLength(); n++ )
+				jobs[n]->deferred = true;
+		}
+
+		for( asUINT n = 0; n < jobs.GetLength(); n++ )
+		{
+			sCompileJob *job = jobs[n];
+			if( job->deferred )
+			{
+				// Forget what the compiler had stored in the function before it gave up
+				engine->scriptFunctions[job->func->funcId]->ResetScriptFunctionData();
+
+				// The messages are written directly, as the messages
+				// of all the previous functions have been written already
+				CompileFunctionBody(job->func);
+			}
+			else
+				WriteJobMessages(job);
+
+			asDELETE(job, sCompileJob);
+		}
+	}
+}
+
+void asCBuilder::CompileFunctionsThread(void *param)
+{
+	asCBuilder *builder = reinterpret_cast<asCBuilder*>(param);
+	builder->CompileJobs();
+
+	// Free the thread local data, including the memory blocks cached for the thread
+	asCThreadManager::CleanupLocalData();
+}
+
+void asCBuilder::CompileJobs()
+{
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+	if( tld == 0 )
+		return;
+
+	for(;;)
+	{
+		ENTERCRITICALSECTION(compileLock);
+		asUINT n = nextCompileJob++;
+		LEAVECRITICALSECTION(compileLock);
+
+		if( n >= compileJobs->GetLength() )
+			break;
+
+		tld->compileJob = (*compileJobs)[n];
+		CompileFunctionBody(tld->compileJob->func);
+		tld->compileJob = 0;
+	}
+}
+
+void asCBuilder::WriteJobMessages(sCompileJob *job)
+{
+	for( asUINT n = 0; n < job->messages.GetLength(); n++ )
+	{
+		sBuildMessage &msg = job->messages[n];
+		if( msg.type == asMSGTYPE_ERROR )
+			WriteError(msg.section, msg.message, msg.r, msg.c);
+		else if( msg.type == asMSGTYPE_WARNING )
+			WriteWarning(msg.section, msg.message, msg.r, msg.c);
+		else
+			WriteInfo(msg.section, msg.message, msg.r, msg.c, msg.isPreMessage);
+	}
+
+	engine->preMessage.isSet = false;
+}
+
+// Returns the function the current thread is compiling while compiling with multiple threads
+sCompileJob *asCBuilder::GetCompileJob()
+{
+	if( !isCompilingInParallel )
+		return 0;
+
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+	return tld ? tld->compileJob : 0;
+}
+
+// Called before the compiler does something that would modify the engine or the module. While compiling
+// with multiple threads, the current function is then marked to be compiled later by the building thread.
+// The compilation of the function fails, so it doesn't matter what the compiler does in the meantime.
+bool asCBuilder::DeferToSerialCompilation()
+{
+	sCompileJob *job = GetCompileJob();
+	if( job == 0 )
+		return false;
+
+	job->deferred = true;
+	job->numErrors++;
+	return true;
+}
+
+// While compiling with multiple threads the template instances can only
+// be used if nothing needs to be updated when they are referenced again
+bool asCBuilder::DeferTemplateInstance(asCObjectType *templateType, const asCArray<asCDataType> &subTypes, bool needsDeclaredAt)
+{
+	if( !isCompilingInParallel )
+		return false;
+
+	for( asUINT n = 0; n < engine->templateInstanceTypes.GetLength(); n++ )
+	{
+		asCObjectType *type = engine->templateInstanceTypes[n];
+		if( type &&
+			type->name == templateType->name &&
+			type->nameSpace == templateType->nameSpace &&
+			type->templateSubTypes == subTypes )
+		{
+			if( needsDeclaredAt && type->scriptSectionIdx < 0 )
+				break;
+			if( module && engine->generatedTemplateTypes.Exists(type) &&
+				(type->module == 0 || !module->templateInstances.Exists(type)) )
+				break;
+			return false;
 		}
 	}
+
+	return DeferToSerialCompilation();
+}
+
+asCObjectType *asCBuilder::GetListPatternType(int listPatternFuncId)
+{
+	// The list pattern types don't have ids, so the order
+	// in which they are created by the threads doesn't matter
+	EnterCompileLock();
+	asCObjectType *listPatternType = engine->GetListPatternType(listPatternFuncId);
+	LeaveCompileLock();
+
+	return listPatternType;
+}
+
+// The number of errors so far, or only those for the current function when compiling with multiple threads
+int asCBuilder::GetErrorCount()
+{
+	sCompileJob *job = GetCompileJob();
+	return job ? job->numErrors : numErrors;
+}
+
+void asCBuilder::EnterCompileLock()
+{
+	if( isCompilingInParallel )
+		ENTERCRITICALSECTION(compileLock);
+}
+
+void asCBuilder::LeaveCompileLock()
+{
+	if( isCompilingInParallel )
+		LEAVECRITICALSECTION(compileLock);
 }
 #endif
 
@@ -2001,6 +2653,7 @@ int asCBuilder::RegisterClass(asCScriptNode *node, asCScriptCode *file, asSNameS
 		st->name = name;
 		st->nameSpace = ns;
 		st->module = module;
+		st->propertiesReordered = engine->ep.reorderClassProperties;
 		module->classTypes.PushLast(st);
 		if (isShared)
 		{
@@ -2981,10 +3634,8 @@ void asCBuilder::CompileClasses(asUINT numTempl)
 			// Copy properties from base class to derived class
 			for( asUINT p = 0; p < baseType->properties.GetLength(); p++ )
 			{
-				asCObjectProperty *prop = AddPropertyToClass(decl, baseType->properties[p]->name, baseType->properties[p]->type, baseType->properties[p]->isPrivate, baseType->properties[p]->isProtected, true);
-
-				// The properties must maintain the same offset
-				asASSERT(prop && prop->byteOffset == baseType->properties[p]->byteOffset); UNUSED_VAR(prop);
+				// The properties will be given the same offset as in the base class by LayoutProperties
+				AddPropertyToClass(decl, baseType->properties[p]->name, baseType->properties[p]->type, baseType->properties[p]->isPrivate, baseType->properties[p]->isProtected, true);
 			}
 
 			// Copy methods from base class to derived class
@@ -3215,7 +3866,12 @@ void asCBuilder::CompileClasses(asUINT numTempl)
 		IncludePropertiesFromMixins(decl);
 
 		if( !decl->isExistingShared )
+		{
+			// Determine the offsets of the properties now that all of them are known
+			ot->LayoutProperties();
+
 			toValidate.PushLast(decl);
+		}
 
 		asASSERT( ot->interfaces.GetLength() == ot->interfaceVFTOffsets.GetLength() );
 	}
@@ -4431,6 +5087,10 @@ int asCBuilder::RegisterScriptFunctionFromNode(asCScriptNode *node, asCScriptCod
 
 asCScriptFunction *asCBuilder::RegisterLambda(asCScriptNode *node, asCScriptCode *file, asCScriptFunction *funcDef, const asCString &name, asSNameSpace *ns)
 {
+	// The lambda function must get its id in the same order as when compiling with a single thread
+	if( DeferToSerialCompilation() )
+		return 0;
+
 	// Get the parameter names from the node
 	asCArray<asCString> parameterNames;
 	asCArray<asCString*> defaultArgs;
@@ -5052,6 +5712,68 @@ asCScriptFunction *asCBuilder::GetFunctionDescription(int id)
 		return engine->importedFunctions[id & ~FUNC_IMPORTED]->importedFunctionSignature;
 }
 
+sOverloadCacheEntry *asCBuilder::FindOverloadCache(const sOverloadCacheEntry &key)
+{
+	// The entries are never modified once added, so they can
+	// be used without holding the lock once they are found
+	EnterCompileLock();
+
+	sOverloadCacheEntry *entry = 0;
+	asSMapNode<asUINT, sOverloadCacheEntry*> *cursor = 0;
+	if( overloadCache.MoveTo(&cursor, key.hash) )
+		entry = overloadCache.GetValue(cursor);
+
+	for( ; entry; entry = entry->next )
+	{
+		if( entry->objectType != key.objectType ||
+			entry->allowObjectConstruct != key.allowObjectConstruct ||
+			entry->candidates != key.candidates ||
+			entry->args.GetLength() != key.args.GetLength() )
+			continue;
+
+		asUINT n;
+		for( n = 0; n < key.args.GetLength(); n++ )
+		{
+			const sOverloadCacheArg &a = entry->args[n];
+			const sOverloadCacheArg &b = key.args[n];
+			if( a.flags != b.flags || a.constantValue != b.constantValue || a.type != b.type )
+				break;
+		}
+		if( n == key.args.GetLength() )
+			break;
+	}
+
+	LeaveCompileLock();
+
+	return entry;
+}
+
+void asCBuilder::AddOverloadCache(const sOverloadCacheEntry &key)
+{
+	sOverloadCacheEntry *entry = asNEW(sOverloadCacheEntry)(key);
+	if( entry == 0 )
+	{
+		// Out of memory. The result is simply not cached
+		return;
+	}
+
+	EnterCompileLock();
+
+	asSMapNode<asUINT, sOverloadCacheEntry*> *cursor = 0;
+	if( overloadCache.MoveTo(&cursor, key.hash) )
+	{
+		entry->next = overloadCache.GetValue(cursor);
+		overloadCache.GetValue(cursor) = entry;
+	}
+	else
+	{
+		entry->next = 0;
+		overloadCache.Insert(key.hash, entry);
+	}
+
+	LeaveCompileLock();
+}
+
 void asCBuilder::GetFunctionDescriptions(const char *name, asCArray<int> &funcs, asSNameSpace *ns)
 {
 	asUINT n;
@@ -5158,8 +5880,32 @@ void asCBuilder::GetObjectMethodDescriptions(const char *name, asCObjectType *ob
 }
 #endif
 
+#ifndef AS_NO_COMPILER
+// Keeps the message until all the threads are done compiling
+static void AddJobMessage(sCompileJob *job, asEMsgType type, const asCString &scriptname, const asCString &message, int r, int c, bool pre)
+{
+	sBuildMessage msg;
+	msg.type         = type;
+	msg.section      = scriptname;
+	msg.r            = r;
+	msg.c            = c;
+	msg.message      = message;
+	msg.isPreMessage = pre;
+	job->messages.PushLast(msg);
+}
+#endif
+
 void asCBuilder::WriteInfo(const asCString &scriptname, const asCString &message, int r, int c, bool pre)
 {
+#ifndef AS_NO_COMPILER
+	sCompileJob *job = GetCompileJob();
+	if( job )
+	{
+		AddJobMessage(job, asMSGTYPE_INFORMATION, scriptname, message, r, c, pre);
+		return;
+	}
+#endif
+
 	// Need to store the pre message in a structure
 	if( pre )
 	{
@@ -5198,6 +5944,16 @@ void asCBuilder::WriteError(const asCString &message, asCScriptCode *file, asCSc
 
 void asCBuilder::WriteError(const asCString &scriptname, const asCString &message, int r, int c)
 {
+#ifndef AS_NO_COMPILER
+	sCompileJob *job = GetCompileJob();
+	if( job )
+	{
+		job->numErrors++;
+		AddJobMessage(job, asMSGTYPE_ERROR, scriptname, message, r, c, false);
+		return;
+	}
+#endif
+
 	numErrors++;
 
 	if( !silent )
@@ -5206,6 +5962,15 @@ void asCBuilder::WriteError(const asCString &scriptname, const asCString &messag
 
 void asCBuilder::WriteWarning(const asCString &scriptname, const asCString &message, int r, int c)
 {
+#ifndef AS_NO_COMPILER
+	sCompileJob *job = GetCompileJob();
+	if( job )
+	{
+		AddJobMessage(job, asMSGTYPE_WARNING, scriptname, message, r, c, false);
+		return;
+	}
+#endif
+
 	if( engine->ep.compilerWarnings )
 	{
 		numWarnings++;
@@ -5605,6 +6370,22 @@ asCDataType asCBuilder::CreateDataTypeFromNode(asCScriptNode *node, asCScriptCod
 					*isValid = false;
 			}
 
+#ifndef AS_NO_COMPILER
+			// Creating the array instance would modify the engine
+			if( isCompilingInParallel && engine->defaultArrayObjectType )
+			{
+				asCArray<asCDataType> subTypes;
+				subTypes.PushLast(dt);
+				subTypes[0].MakeReadOnly(false);
+				if( DeferTemplateInstance(engine->defaultArrayObjectType, subTypes, false) )
+				{
+					if (isValid)
+						*isValid = false;
+					break;
+				}
+			}
+#endif
+
 			// Make the type an array (or multidimensional array)
 			if( dt.MakeArray(engine, module) < 0 )
 			{
@@ -5710,6 +6491,12 @@ asCObjectType *asCBuilder::GetTemplateInstanceFromNode(asCScriptNode *node, asCS
 
 	if (isDifferent)
 	{
+#ifndef AS_NO_COMPILER
+		// Creating the template instance would modify the engine
+		if( DeferTemplateInstance(templateType, subTypes, true) )
+			return 0;
+#endif
+
 		// This is a template instance
 		// Need to find the correct object type
 		asCObjectType *otInstance = engine->GetTemplateInstanceType(templateType, subTypes, module);
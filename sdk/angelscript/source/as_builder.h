@@ -58,6 +58,8 @@ struct sGlobalVariableDescription;
 
 #ifndef AS_NO_COMPILER
 
+class asCParser;
+
 struct sFunctionDescription
 {
 	asCScriptCode       *script;
@@ -128,6 +130,75 @@ struct sMixinClass
 	asSNameSpace  *ns;
 };
 
+// An argument as seen by the overload resolution
+struct sOverloadCacheArg
+{
+	asCDataType type;
+	asDWORD     flags;
+	asQWORD     constantValue;
+};
+
+// The overloads chosen by asCCompiler::MatchFunctions for a set of candidates and arguments
+struct sOverloadCacheEntry
+{
+	asUINT                      hash;
+	asCArray<int>               candidates;
+	asCArray<sOverloadCacheArg> args;
+	asCObjectType              *objectType;
+	bool                        allowObjectConstruct;
+	asCArray<int>               matches;
+	asUINT                      cost;
+	sOverloadCacheEntry        *next;
+};
+
+// A message written while compiling a function body with multiple threads. The
+// messages are kept until all threads are done so they can be written in order
+struct sBuildMessage
+{
+	asEMsgType type;
+	asCString  section;
+	int        r;
+	int        c;
+	asCString  message;
+	bool       isPreMessage;
+};
+
+// A function body to be compiled when compiling with multiple threads
+struct sCompileJob
+{
+	sFunctionDescription   *func;
+	asCArray<sBuildMessage> messages;
+	int                     numErrors;
+	bool                    deferred;
+};
+
+// A function body in a script section that has been modified since the previous incremental build
+struct sIncrementalBody
+{
+	size_t         oldPos;
+	size_t         oldLength;
+	size_t         newPos;
+	asCScriptNode *newNode;
+	bool           isModified;
+};
+
+// A function that must be compiled again, or only moved, by an incremental build
+struct sIncrementalUpdate
+{
+	sIncrementalFunction *func;
+	asCScriptNode        *node;
+	int                   rowDelta;
+};
+
+// A script section that has been modified since the previous incremental build
+struct sIncrementalSectionUpdate
+{
+	asUINT                       section;
+	asCParser                   *parser;
+	asCArray<sIncrementalBody>   bodies;
+	asCArray<sIncrementalUpdate> functions;
+};
+
 #endif // AS_NO_COMPILER
 
 class asCBuilder
@@ -148,6 +219,8 @@ public:
 #ifndef AS_NO_COMPILER
 	int AddCode(const char *name, const char *code, int codeLength, int lineOffset, int sectionIdx, bool makeCopy);
 	int Build();
+	int BuildIncremental();
+	void SaveIncrementalBuild();
 
 	int CompileFunction(const char *sectionName, const char *code, int lineOffset, asDWORD compileFlags, asCScriptFunction **outFunc);
 	int CompileGlobalVar(const char *sectionName, const char *code, int lineOffset);
@@ -238,6 +311,26 @@ protected:
 	void               GetFunctionDescriptions(const char *name, asCArray<int> &funcs, asSNameSpace *ns);
 	void               GetObjectMethodDescriptions(const char *name, asCObjectType *objectType, asCArray<int> &methods, bool objIsConst, const asCString &scope = "", asCScriptNode *errNode = 0, asCScriptCode *script = 0);
 	void               EvaluateTemplateInstances(asUINT startIdx, bool keepSilent);
+	sOverloadCacheEntry *FindOverloadCache(const sOverloadCacheEntry &key);
+	void               AddOverloadCache(const sOverloadCacheEntry &entry);
+
+	// Compiling the function bodies with multiple threads
+	void               CompileFunctionBody(sFunctionDescription *func);
+	void               CompileFunctionsInParallel(asUINT numThreads);
+	static void        CompileFunctionsThread(void *param);
+	void               CompileJobs();
+	void               WriteJobMessages(sCompileJob *job);
+	sCompileJob       *GetCompileJob();
+	bool               DeferToSerialCompilation();
+	bool               DeferTemplateInstance(asCObjectType *templateType, const asCArray<asCDataType> &subTypes, bool needsDeclaredAt);
+	asCObjectType     *GetListPatternType(int listPatternFuncId);
+	int                GetErrorCount();
+	void               EnterCompileLock();
+	void               LeaveCompileLock();
+
+	// Compiling only the modified functions
+	int                FindIncrementalUpdates(asUINT sectionIdx, sIncrementalSectionUpdate *update);
+	int                ApplyIncrementalUpdates(asCArray<sIncrementalSectionUpdate*> &updates);
 
 	asCArray<asCScriptCode *>                  scripts;
 	asCArray<sFunctionDescription *>           functions;
@@ -251,6 +344,16 @@ protected:
 	// For use with the DoesTypeExists() method
 	bool                    hasCachedKnownTypes;
 	asCMap<asCString, bool> knownTypes;
+
+	// The overloads chosen by the compiler so far in this build. The entries with the same hash are linked
+	asCMap<asUINT, sOverloadCacheEntry*> overloadCache;
+
+	// Set while the function bodies are compiled by multiple threads. The lock
+	// serializes the threads' access to what is shared, e.g. the overload cache
+	bool                    isCompilingInParallel;
+	asCArray<sCompileJob*> *compileJobs;
+	asUINT                  nextCompileJob;
+	DECLARECRITICALSECTION(compileLock)
 #endif
 };
 
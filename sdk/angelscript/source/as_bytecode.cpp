@@ -1183,6 +1183,48 @@ void asCByteCode::Optimize()
 					instr = GoBack(DeleteInstruction(curr));
 				}
 			}
+			// CMPIi x, y; J** +z -> CMPIiJ** x, y, +z
+			else if( currOp == asBC_CMPIi && instrOp >= asBC_JZ && instrOp <= asBC_JNP )
+			{
+				// The compare and the conditional jump are combined into a single
+				// instruction as this sequence is very common in loops and if-statements
+				asEBCInstr bc = asBC_CMPIiJZ;
+				switch( instrOp )
+				{
+				case asBC_JZ:  bc = asBC_CMPIiJZ;  break;
+				case asBC_JNZ: bc = asBC_CMPIiJNZ; break;
+				case asBC_JS:  bc = asBC_CMPIiJS;  break;
+				case asBC_JNS: bc = asBC_CMPIiJNS; break;
+				case asBC_JP:  bc = asBC_CMPIiJP;  break;
+				case asBC_JNP: bc = asBC_CMPIiJNP; break;
+				default: asASSERT( false );
+				}
+
+				curr->op = bc;
+				curr->size = asBCTypeSize[asBCInfo[bc].type];
+				curr->stackInc = asBCInfo[bc].stackInc;
+				// The label to jump to is stored in the second dword argument
+				*(ARG_DW(curr->arg)+1) = *ARG_DW(instr->arg);
+				DeleteInstruction(instr);
+				instr = curr->next;
+			}
+			// LoadThisR y; RDR4 x -> CpyThisToV4 x, y
+			// LoadThisR y; WRTV4 x -> CpyVtoThis4 x, y
+			else if( currOp == asBC_LoadThisR && (instrOp == asBC_RDR4 || instrOp == asBC_WRTV4) &&
+					 !IsTempRegUsed(instr) )
+			{
+				// The combined instruction copies the value directly between the variable and the
+				// property without going through the value register, so it can only be used when
+				// the address in the register isn't needed by any of the following instructions
+				asEBCInstr bc = instrOp == asBC_RDR4 ? asBC_CpyThisToV4 : asBC_CpyVtoThis4;
+				curr->op = bc;
+				curr->size = asBCTypeSize[asBCInfo[bc].type];
+				curr->stackInc = asBCInfo[bc].stackInc;
+				curr->wArg[1] = curr->wArg[0];
+				curr->wArg[0] = instr->wArg[0];
+				DeleteInstruction(instr);
+				instr = curr->next;
+			}
 			// JMP +0 -> remove
 			else if( currOp == asBC_JMP && instrOp == asBC_LABEL && *(int*)&curr->arg == instr->wArg[0] )
 				instr = GoBack(DeleteInstruction(curr));
@@ -1229,7 +1271,8 @@ bool asCByteCode::IsInstrJmpOrLabel(asCByteInstruction *curr)
 		curr->op == asBC_JNZ     ||
 		curr->op == asBC_JLowZ   ||
 		curr->op == asBC_JLowNZ  ||
-		curr->op == asBC_LABEL   )
+		curr->op == asBC_LABEL   ||
+		(curr->op >= asBC_CMPIiJZ && curr->op <= asBC_CMPIiJNP) )
 		return true;
 
 	return false;
@@ -1309,6 +1352,17 @@ bool asCByteCode::IsTempVarRead(asCByteInstruction *curr, int offset)
 					!openPaths.Exists(dest) )
 					openPaths.PushLast(dest);
 			}
+			else if( curr->op >= asBC_CMPIiJZ && curr->op <= asBC_CMPIiJNP )
+			{
+				// The fused compare and jump instructions store the label in the second dword argument
+				asCByteInstruction *dest = 0;
+				int label = *((int*)ARG_DW(curr->arg)+1);
+				int r = FindLabel(label, curr, &dest, 0);
+				if( r >= 0 &&
+					!closedPaths.Exists(dest) &&
+					!openPaths.Exists(dest) )
+					openPaths.PushLast(dest);
+			}
 			else if( curr->op == asBC_JMPP )
 			{
 				// A JMPP instruction is always followed by a series of JMP instructions
@@ -1426,6 +1480,7 @@ bool asCByteCode::IsTempRegUsed(asCByteInstruction *curr)
 			curr->op == asBC_CMPIi     ||
 			curr->op == asBC_CMPIu     ||
 			curr->op == asBC_CMPIf     ||
+			(curr->op >= asBC_CMPIiJZ && curr->op <= asBC_CMPIiJNP) ||
 			curr->op == asBC_LABEL     ||
 			curr->op == asBC_LoadThisR ||
 			curr->op == asBC_LoadRObjR ||
@@ -1860,6 +1915,17 @@ int asCByteCode::ResolveJumpAddresses()
 			else
 				return -1;
 		}
+		else if( instr->op >= asBC_CMPIiJZ && instr->op <= asBC_CMPIiJNP )
+		{
+			// The label is stored in the second dword argument
+			int label = *((int*) ARG_DW(instr->arg) + 1);
+			int labelPosOffset;
+			int r = FindLabel(label, instr, 0, &labelPosOffset);
+			if( r == 0 )
+				*((int*) ARG_DW(instr->arg) + 1) = labelPosOffset;
+			else
+				return -1;
+		}
 
 		instr = instr->next;
 	}
@@ -2023,6 +2089,18 @@ void asCByteCode::PostProcess()
 
 				break;
 			}
+			else if( instr->op >= asBC_CMPIiJZ && instr->op <= asBC_CMPIiJNP )
+			{
+				// The fused compare and jump instructions store the label in the second dword argument
+				int label = *((int*) ARG_DW(instr->arg) + 1);
+				asCByteInstruction *dest = 0;
+				int r = FindLabel(label, instr, &dest, 0); asASSERT( r == 0 ); UNUSED_VAR(r);
+
+				AddPath(paths, dest, stackSize);
+				AddPath(paths, instr->next, stackSize);
+
+				break;
+			}
 			else if( instr->op == asBC_JMPP )
 			{
 				// I need to know the largest value possible
@@ -2385,7 +2463,10 @@ void asCByteCode::DebugOutput(const char *name, asCScriptFunction *func)
 			break;
 
 		case asBCTYPE_rW_DW_DW_ARG:
-			fprintf(file, "   %-8s v%d, %u, %u\n", asBCInfo[instr->op].name, instr->wArg[0], *(int*)ARG_DW(instr->arg), *(int*)(ARG_DW(instr->arg)+1));
+			if( instr->op >= asBC_CMPIiJZ && instr->op <= asBC_CMPIiJNP )
+				fprintf(file, "   %-8s v%d, %d, %+d              (d:%d)\n", asBCInfo[instr->op].name, instr->wArg[0], *(int*)ARG_DW(instr->arg), *(int*)(ARG_DW(instr->arg)+1), pos+*(int*)(ARG_DW(instr->arg)+1));
+			else
+				fprintf(file, "   %-8s v%d, %u, %u\n", asBCInfo[instr->op].name, instr->wArg[0], *(int*)ARG_DW(instr->arg), *(int*)(ARG_DW(instr->arg)+1));
 			break;
 
 		case asBCTYPE_QW_DW_ARG:
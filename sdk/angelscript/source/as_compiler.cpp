@@ -99,9 +99,14 @@ asCCompiler::~asCCompiler()
 
 	// Clean up all the string constants that were allocated. By now the script 
 	// functions that were compiled successfully already holds their own references
-	for (asUINT n = 0; n < usedStringConstants.GetLength(); n++)
-		engine->stringFactory->ReleaseStringConstant(usedStringConstants[n]);
-	usedStringConstants.SetLength(0);
+	if( usedStringConstants.GetLength() )
+	{
+		builder->EnterCompileLock();
+		for (asUINT n = 0; n < usedStringConstants.GetLength(); n++)
+			engine->stringFactory->ReleaseStringConstant(usedStringConstants[n]);
+		builder->LeaveCompileLock();
+		usedStringConstants.SetLength(0);
+	}
 }
 
 void asCCompiler::Reset(asCBuilder *in_builder, asCScriptCode *in_script, asCScriptFunction *in_outFunc)
@@ -110,6 +115,7 @@ void asCCompiler::Reset(asCBuilder *in_builder, asCScriptCode *in_script, asCScr
 	this->engine = in_builder->engine;
 	this->script = in_script;
 	this->outFunc = in_outFunc;
+	m_nameSpace = in_outFunc->nameSpace;
 
 	hasCompileErrors = false;
 
@@ -130,6 +136,7 @@ void asCCompiler::Reset(asCBuilder *in_builder, asCScriptCode *in_script, asCScr
 int asCCompiler::CompileDefaultConstructor(asCBuilder *in_builder, asCScriptCode *in_script, asCScriptNode *in_node, asCScriptFunction *in_outFunc, sClassDeclaration *in_classDecl)
 {
 	Reset(in_builder, in_script, in_outFunc);
+	int buildErrors = builder->GetErrorCount();
 
 	m_classDecl = in_classDecl;
 
@@ -164,7 +171,7 @@ int asCCompiler::CompileDefaultConstructor(asCBuilder *in_builder, asCScriptCode
 	byteCode.OptimizeLocally(tempVariableOffsets);
 
 	// If there are compile errors, there is no reason to build the final code
-	if( hasCompileErrors )
+	if( hasCompileErrors || builder->GetErrorCount() != buildErrors )
 		return -1;
 
 	// Pop the object pointer from the stack
@@ -178,7 +185,9 @@ int asCCompiler::CompileDefaultConstructor(asCBuilder *in_builder, asCScriptCode
 
 #ifdef AS_DEBUG
 	// DEBUG: output byte code
+	builder->EnterCompileLock();
 	byteCode.DebugOutput(("__" + outFunc->objectType->name + "_" + outFunc->name + "__defconstr.txt").AddressOf(), in_outFunc);
+	builder->LeaveCompileLock();
 #endif
 
 	return 0;
@@ -301,7 +310,12 @@ void asCCompiler::FinalizeFunction()
 	asASSERT( outFunc->scriptData->byteCode.GetLength() == 0 );
 	outFunc->scriptData->byteCode.SetLength(byteCode.GetSize());
 	byteCode.Output(outFunc->scriptData->byteCode.AddressOf());
+
+	// The references are added to objects shared by all the functions,
+	// and the string constants may be recreated by the string factory
+	builder->EnterCompileLock();
 	outFunc->AddReferences();
+	builder->LeaveCompileLock();
 	outFunc->scriptData->stackNeeded = byteCode.largestStackUsed + outFunc->scriptData->variableSpace;
 	outFunc->scriptData->lineNumbers = byteCode.lineNumbers;
 
@@ -340,9 +354,13 @@ int asCCompiler::SetupParametersAndReturnVariable(asCArray<asCString> &parameter
 	// Check if this is a constructor or destructor
 	if( returnType.GetTokenType() == ttVoid && outFunc->objectType )
 	{
-		if( outFunc->name[0] == '~' )
+		// The function name is interned and may be read by other threads when compiling
+		// in parallel, so it must only be accessed through a const reference. The non-const
+		// accessors would unshare it
+		const asCString &funcName = outFunc->name;
+		if( funcName[0] == '~' )
 			isDestructor = true;
-		else if( outFunc->objectType->name == outFunc->name )
+		else if( outFunc->objectType->name == funcName )
 			m_isConstructor = true;
 	}
 
@@ -352,7 +370,7 @@ int asCCompiler::SetupParametersAndReturnVariable(asCArray<asCString> &parameter
 	{
 		// TODO: Hasn't this been validated by the builder already?
 		asCString str;
-		str.Format(TXT_RETURN_CANT_BE_s, returnType.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_RETURN_CANT_BE_s, returnType.Format(m_nameSpace).AddressOf());
 		Error(str, func);
 	}
 
@@ -377,7 +395,7 @@ int asCCompiler::SetupParametersAndReturnVariable(asCArray<asCString> &parameter
 		if( (type.IsReference() && inoutFlag != asTM_INOUTREF && !type.CanBeInstantiated()) ||
 			(!type.IsReference() && !type.CanBeInstantiated()) )
 		{
-			asCString parm = type.Format(outFunc->nameSpace);
+			asCString parm = type.Format(m_nameSpace);
 			if( inoutFlag == asTM_INREF )
 				parm += "in";
 			else if( inoutFlag == asTM_OUTREF )
@@ -524,7 +542,7 @@ int asCCompiler::CompileFunction(asCBuilder *in_builder, asCScriptCode *in_scrip
 	TimeIt("asCCompiler::CompileFunction");
 
 	Reset(in_builder, in_script, in_outFunc);
-	int buildErrors = builder->numErrors;
+	int buildErrors = builder->GetErrorCount();
 
 	int stackPos = SetupParametersAndReturnVariable(in_parameterNames, in_func);
 
@@ -663,7 +681,7 @@ int asCCompiler::CompileFunction(asCBuilder *in_builder, asCScriptCode *in_scrip
 		Error(TXT_TOO_MANY_JUMP_LABELS, in_func);
 
 	// If there are compile errors, there is no reason to build the final code
-	if( hasCompileErrors || builder->numErrors != buildErrors )
+	if( hasCompileErrors || builder->GetErrorCount() != buildErrors )
 		return -1;
 
 	// At this point there should be no variables allocated
@@ -678,10 +696,12 @@ int asCCompiler::CompileFunction(asCBuilder *in_builder, asCScriptCode *in_scrip
 
 #ifdef AS_DEBUG
 	// DEBUG: output byte code
+	builder->EnterCompileLock();
 	if( outFunc->objectType )
 		byteCode.DebugOutput(("__" + outFunc->objectType->name + "_" + outFunc->name + ".txt").AddressOf(), in_outFunc);
 	else
 		byteCode.DebugOutput(("__" + outFunc->name + ".txt").AddressOf(), in_outFunc);
+	builder->LeaveCompileLock();
 #endif
 
 	return 0;
@@ -1349,6 +1369,13 @@ void asCCompiler::DetermineSingleFunc(asCExprContext *ctx, asCScriptNode *node)
 		// Fall through so the compiler can continue anyway
 	}
 
+	// Finding the matching funcdef may register a new one
+	if( builder->DeferToSerialCompilation() )
+	{
+		ctx->type.SetDummy();
+		return;
+	}
+
 	// Push the function pointer on the stack
 	ctx->bc.InstrPTR(asBC_FuncPtr, builder->GetFunctionDescription(funcs[0]));
 	ctx->type.Set(asCDataType::CreateType(engine->FindMatchingFuncdef(builder->GetFunctionDescription(funcs[0]), builder->module), false));
@@ -1505,7 +1532,7 @@ int asCCompiler::PrepareArgument(asCDataType *paramType, asCExprContext *ctx, as
 				if( !dt.SupportHandles() && !dt.IsObjectHandle() )
 				{
 					asCString str;
-					str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), param.Format(outFunc->nameSpace).AddressOf());
+					str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(m_nameSpace).AddressOf(), param.Format(m_nameSpace).AddressOf());
 					Error(str, node);
 
 					ctx->type.Set(param);
@@ -1568,7 +1595,7 @@ int asCCompiler::PrepareArgument(asCDataType *paramType, asCExprContext *ctx, as
 					if( !ctx->type.dataType.IsEqualExceptRefAndConst(param) )
 					{
 						asCString str;
-						str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), param.Format(outFunc->nameSpace).AddressOf());
+						str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(m_nameSpace).AddressOf(), param.Format(m_nameSpace).AddressOf());
 						Error(str, node);
 
 						ctx->type.Set(param);
@@ -1884,7 +1911,7 @@ int asCCompiler::PrepareArgument(asCDataType *paramType, asCExprContext *ctx, as
 			if( !ctx->type.dataType.IsEqualExceptRef(dt) )
 			{
 				asCString str;
-				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), dt.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(m_nameSpace).AddressOf(), dt.Format(m_nameSpace).AddressOf());
 				Error(str, node);
 
 				ctx->type.Set(dt);
@@ -2254,16 +2281,17 @@ int asCCompiler::CompileDefaultAndNamedArgs(asCScriptNode *node, asCArray<asCExp
 		// Don't allow the expression to access local variables
 		isCompilingDefaultArg = true;
 
-		// Temporarily set the namespace in the output function to the namespace of the called
-		// function so that the default arguments are evaluated in the correct namespace
-		asSNameSpace *origNameSpace = outFunc->nameSpace;
-		outFunc->nameSpace = func->nameSpace;
+		// Temporarily set the namespace to the namespace of the called function so that the default
+		// arguments are evaluated in the correct namespace. The output function itself isn't modified
+		// as other threads may be reading it when the functions are compiled in parallel
+		asSNameSpace *origNameSpace = m_nameSpace;
+		m_nameSpace = func->nameSpace;
 
 		asCExprContext expr(engine);
 		r = CompileExpression(arg, &expr);
 
 		// Restore the namespace
-		outFunc->nameSpace = origNameSpace;
+		m_nameSpace = origNameSpace;
 
 		// Don't allow address of class method
 		if( expr.IsClassMethod() )
@@ -2314,13 +2342,75 @@ int asCCompiler::CompileDefaultAndNamedArgs(asCScriptNode *node, asCArray<asCExp
 	return anyErrors ? -1 : 0;
 }
 
+// Returns false if the overload resolution with these arguments cannot be cached
+bool asCCompiler::GetOverloadCacheKey(const asCArray<int> &funcs, asCArray<asCExprContext*> &args, asCObjectType *objectType, bool allowObjectConstruct, sOverloadCacheEntry &key)
+{
+	asUINT hash = 2166136261u;
+	for( asUINT n = 0; n < funcs.GetLength(); n++ )
+		hash = (hash ^ asUINT(funcs[n])) * 16777619u;
+
+	key.args.SetLength(args.GetLength());
+	for( asUINT n = 0; n < args.GetLength(); n++ )
+	{
+		asCExprContext *arg = args[n];
+
+		// The match of these depend on more than the type of the expression
+		if( arg->IsVoidExpression() || arg->IsAnonymousInitList() || arg->IsLambda() ||
+			arg->methodName != "" || arg->enumValue != "" )
+			return false;
+
+		// MatchArgument only looks at the value of the expression, so that is what must be equal
+		sOverloadCacheArg &a = key.args[n];
+		a.type          = arg->type.dataType;
+		a.flags         = (arg->type.isLValue         ? 1  : 0) |
+		                  (arg->type.isTemporary      ? 2  : 0) |
+		                  (arg->type.isConstant       ? 4  : 0) |
+		                  (arg->type.isVariable       ? 8  : 0) |
+		                  (arg->type.isExplicitHandle ? 16 : 0) |
+		                  (arg->type.isRefToLocal     ? 32 : 0) |
+		                  (arg->type.isRefSafe        ? 64 : 0);
+		a.constantValue = arg->type.isConstant ? arg->type.GetConstantData() : 0;
+
+		hash = (hash ^ asUINT(asPWORD(a.type.GetTypeInfo()))) * 16777619u;
+		hash = (hash ^ asUINT(a.type.GetTokenType())) * 16777619u;
+		hash = (hash ^ a.flags) * 16777619u;
+		hash = (hash ^ asUINT(a.constantValue)) * 16777619u;
+	}
+
+	key.hash                 = hash;
+	key.candidates           = funcs;
+	key.objectType           = objectType;
+	key.allowObjectConstruct = allowObjectConstruct;
+	key.cost                 = 0;
+	key.next                 = 0;
+
+	return true;
+}
+
 asUINT asCCompiler::MatchFunctions(asCArray<int> &funcs, asCArray<asCExprContext*> &args, asCScriptNode *node, const char *name, asCArray<asSNamedArgument> *namedArgs, asCObjectType *objectType, bool isConstMethod, bool silent, bool allowObjectConstruct, const asCString &scope)
 {
 	asCArray<int> origFuncs = funcs; // Keep the original list for error message
 	asUINT cost = 0;
 	asUINT n;
 
-	if( funcs.GetLength() > 0 )
+	// The same candidates with the same arguments always resolve to the same overloads, so the
+	// result is cached for the rest of the build. Calls with named arguments are not cached.
+	sOverloadCacheEntry cacheKey;
+	sOverloadCacheEntry *cached = 0;
+	bool useCache = false;
+	if( funcs.GetLength() > 0 && (namedArgs == 0 || namedArgs->GetLength() == 0) )
+	{
+		useCache = GetOverloadCacheKey(funcs, args, objectType, allowObjectConstruct, cacheKey);
+		if( useCache )
+			cached = builder->FindOverloadCache(cacheKey);
+	}
+
+	if( cached )
+	{
+		funcs = cached->matches;
+		cost  = cached->cost;
+	}
+	else if( funcs.GetLength() > 0 )
 	{
 		// Check the number of parameters in the found functions
 		asUINT totalArgs = (asUINT)args.GetLength();
@@ -2509,6 +2599,13 @@ asUINT asCCompiler::MatchFunctions(asCArray<int> &funcs, asCArray<asCExprContext
 
 		// Cost returned is equivalent to the best cost discovered
 		cost = bestCost;
+
+		if( useCache )
+		{
+			cacheKey.matches = funcs;
+			cacheKey.cost    = cost;
+			builder->AddOverloadCache(cacheKey);
+		}
 	}
 
 	if( !isConstMethod )
@@ -2542,7 +2639,7 @@ asUINT asCCompiler::MatchFunctions(asCArray<int> &funcs, asCArray<asCExprContext
 				str += "{...}";
 			}
 			else
-				str += args[n]->type.dataType.Format(outFunc->nameSpace);
+				str += args[n]->type.dataType.Format(m_nameSpace);
 		}
 		if( namedArgs != 0 )
 		{
@@ -2557,7 +2654,7 @@ asUINT asCCompiler::MatchFunctions(asCArray<int> &funcs, asCArray<asCExprContext
 				if( named.ctx->methodName != "" )
 					str += named.ctx->methodName;
 				else
-					str += named.ctx->type.dataType.Format(outFunc->nameSpace);
+					str += named.ctx->type.dataType.Format(m_nameSpace);
 			}
 		}
 		str += ")";
@@ -2683,7 +2780,7 @@ bool asCCompiler::CompileAutoType(asCDataType &type, asCExprContext &compiledCtx
 void asCCompiler::CompileDeclaration(asCScriptNode *decl, asCByteCode *bc)
 {
 	// Get the data type
-	asCDataType type = builder->CreateDataTypeFromNode(decl->firstChild, script, outFunc->nameSpace, false, outFunc->objectType);
+	asCDataType type = builder->CreateDataTypeFromNode(decl->firstChild, script, m_nameSpace, false, outFunc->objectType);
 
 	// Declare all variables in this declaration
 	asCScriptNode *node = decl->firstChild->next;
@@ -2709,12 +2806,12 @@ void asCCompiler::CompileDeclaration(asCScriptNode *decl, asCByteCode *bc)
 		{
 			asCString str;
 			if( type.IsAbstractClass() )
-				str.Format(TXT_ABSTRACT_CLASS_s_CANNOT_BE_INSTANTIATED, type.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_ABSTRACT_CLASS_s_CANNOT_BE_INSTANTIATED, type.Format(m_nameSpace).AddressOf());
 			else if( type.IsInterface() )
-				str.Format(TXT_INTERFACE_s_CANNOT_BE_INSTANTIATED, type.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_INTERFACE_s_CANNOT_BE_INSTANTIATED, type.Format(m_nameSpace).AddressOf());
 			else
 				// TODO: Improve error message to explain why
-				str.Format(TXT_DATA_TYPE_CANT_BE_s, type.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_DATA_TYPE_CANT_BE_s, type.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 
 			// Don't continue, as it will most likely lead to further
@@ -2739,7 +2836,7 @@ void asCCompiler::CompileDeclaration(asCScriptNode *decl, asCByteCode *bc)
 
 		// Verify that the name isn't used by a dynamic data type
 		// TODO: Must check against registered funcdefs too
-		if( engine->GetRegisteredType(name.AddressOf(), outFunc->nameSpace) != 0 )
+		if( engine->GetRegisteredType(name.AddressOf(), m_nameSpace) != 0 )
 		{
 			asCString str;
 			str.Format(TXT_ILLEGAL_VARIABLE_NAME_s, name.AddressOf());
@@ -2834,7 +2931,7 @@ bool asCCompiler::CompileInitialization(asCScriptNode *node, asCByteCode *bc, co
 						funcs = beh->constructors;
 				}
 
-				asCString str = type.Format(outFunc->nameSpace);
+				asCString str = type.Format(m_nameSpace);
 				MatchFunctions(funcs, args, node, str.AddressOf(), &namedArgs);
 
 				if( funcs.GetLength() == 1 )
@@ -3009,7 +3106,7 @@ bool asCCompiler::CompileInitialization(asCScriptNode *node, asCByteCode *bc, co
 					funcs = beh->constructors;
 			}
 
-			asCString str = type.Format(outFunc->nameSpace);
+			asCString str = type.Format(m_nameSpace);
 			args.PushLast(expr);
 			MatchFunctions(funcs, args, node, str.AddressOf(), 0, 0, 0, true);
 
@@ -3342,7 +3439,7 @@ void asCCompiler::CompileInitList(asCExprValue *var, asCScriptNode *node, asCByt
 		var->dataType.GetBehaviour()->listFactory == 0 )
 	{
 		asCString str;
-		str.Format(TXT_INIT_LIST_CANNOT_BE_USED_WITH_s, var->dataType.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_INIT_LIST_CANNOT_BE_USED_WITH_s, var->dataType.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 		return;
 	}
@@ -3358,7 +3455,7 @@ void asCCompiler::CompileInitList(asCExprValue *var, asCScriptNode *node, asCByt
 
 	// Create a new special object type for the lists. Both asCRestore and the
 	// context exception handler will need this to know how to parse the buffer.
-	asCObjectType *listPatternType = engine->GetListPatternType(funcId);
+	asCObjectType *listPatternType = builder->GetListPatternType(funcId);
 
 	// Allocate a temporary variable to hold the pointer to the buffer
 	int bufferVar = AllocateVariable(asCDataType::CreateType(listPatternType, false), true);
@@ -3374,7 +3471,7 @@ void asCCompiler::CompileInitList(asCExprValue *var, asCScriptNode *node, asCByt
 	if (r < 0)
 	{
 		asCString msg;
-		msg.Format(TXT_PREV_ERROR_WHILE_COMP_LIST_FOR_TYPE_s, var->dataType.Format(outFunc->nameSpace).AddressOf());
+		msg.Format(TXT_PREV_ERROR_WHILE_COMP_LIST_FOR_TYPE_s, var->dataType.Format(m_nameSpace).AddressOf());
 		Error(msg, node);
 	}
 
@@ -4891,7 +4988,7 @@ void asCCompiler::CompileReturnStatement(asCScriptNode *rnode, asCByteCode *bc)
 				// Clean up the potential deferred parameters
 				ProcessDeferredParams(&expr);
 				asCString str;
-				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, expr.type.dataType.Format(outFunc->nameSpace).AddressOf(), v->type.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, expr.type.dataType.Format(m_nameSpace).AddressOf(), v->type.Format(m_nameSpace).AddressOf());
 				Error(str, rnode);
 				return;
 			}
@@ -4975,7 +5072,7 @@ void asCCompiler::CompileReturnStatement(asCScriptNode *rnode, asCByteCode *bc)
 				if( expr.type.dataType != v->type )
 				{
 					asCString str;
-					str.Format(TXT_NO_CONVERSION_s_TO_s, expr.type.dataType.Format(outFunc->nameSpace).AddressOf(), v->type.Format(outFunc->nameSpace).AddressOf());
+					str.Format(TXT_NO_CONVERSION_s_TO_s, expr.type.dataType.Format(m_nameSpace).AddressOf(), v->type.Format(m_nameSpace).AddressOf());
 					Error(str, rnode);
 					return;
 				}
@@ -5011,7 +5108,7 @@ void asCCompiler::CompileReturnStatement(asCScriptNode *rnode, asCByteCode *bc)
 						if( !v->type.IsEqualExceptRefAndConst(expr.type.dataType) )
 						{
 							asCString str;
-							str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, expr.type.dataType.Format(outFunc->nameSpace).AddressOf(), v->type.Format(outFunc->nameSpace).AddressOf());
+							str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, expr.type.dataType.Format(m_nameSpace).AddressOf(), v->type.Format(m_nameSpace).AddressOf());
 							Error(str, rnode->firstChild);
 							return;
 						}
@@ -5455,7 +5552,7 @@ void asCCompiler::PrepareForAssignment(asCDataType *lvalue, asCExprContext *rctx
 		if( !lvalue->IsEqualExceptRefAndConst(rctx->type.dataType) )
 		{
 			asCString str;
-			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), lvalue->Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), lvalue->Format(m_nameSpace).AddressOf());
 			Error(str, node);
 
 			rctx->type.SetDummy();
@@ -5491,7 +5588,7 @@ void asCCompiler::PrepareForAssignment(asCDataType *lvalue, asCExprContext *rctx
 		if( !lvalue->IsEqualExceptRefAndConst(rctx->type.dataType) )
 		{
 			asCString str;
-			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), lvalue->Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), lvalue->Format(m_nameSpace).AddressOf());
 			Error(str, node);
 		}
 		else
@@ -6354,7 +6451,7 @@ asUINT asCCompiler::ImplicitConvLambdaToFunc(asCExprContext *ctx, const asCDataT
 		// Check if the specified parameter types match the funcdef
 		if (argNode->nodeType == snDataType)
 		{
-			asCDataType dt = builder->CreateDataTypeFromNode(argNode, script, outFunc->nameSpace, false, outFunc->objectType);
+			asCDataType dt = builder->CreateDataTypeFromNode(argNode, script, m_nameSpace, false, outFunc->objectType);
 			asETypeModifiers inOutFlag;
 			dt = builder->ModifyDataTypeFromNode(dt, argNode->next, script, &inOutFlag, 0);
 
@@ -6389,7 +6486,7 @@ asUINT asCCompiler::ImplicitConvLambdaToFunc(asCExprContext *ctx, const asCDataT
 			name.Format("$%s$%d", outFunc->GetDeclaration(), numLambdas++);
 
 		// Register the lambda with the builder for later compilation
-		asCScriptFunction *func = builder->RegisterLambda(ctx->exprNode, script, funcDef, name, outFunc->nameSpace);
+		asCScriptFunction *func = builder->RegisterLambda(ctx->exprNode, script, funcDef, name, m_nameSpace);
 		asASSERT( func == 0 || funcDef->IsSignatureExceptNameEqual(func) );
 		ctx->bc.InstrPTR(asBC_FuncPtr, func);
 
@@ -6466,7 +6563,7 @@ asUINT asCCompiler::ImplicitConvObjectToPrimitive(asCExprContext *ctx, const asC
 		if( convType != asIC_IMPLICIT_CONV && node )
 		{
 			asCString str;
-			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 		}
 		return asCC_NO_CONV;
@@ -6481,7 +6578,7 @@ asUINT asCCompiler::ImplicitConvObjectToPrimitive(asCExprContext *ctx, const asC
 		if( convType != asIC_IMPLICIT_CONV && node )
 		{
 			asCString str;
-			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 		}
 		return asCC_NO_CONV;
@@ -6676,7 +6773,7 @@ asUINT asCCompiler::ImplicitConvObjectToPrimitive(asCExprContext *ctx, const asC
 	if( convType != asIC_IMPLICIT_CONV && node )
 	{
 		asCString str;
-		str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 	}
 
@@ -7127,7 +7224,7 @@ asUINT asCCompiler::ImplicitConvObjectToObject(asCExprContext *ctx, const asCDat
 			{
 				asASSERT(node);
 				asCString str;
-				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, ctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 				Error(str, node);
 			}
 		}
@@ -8194,7 +8291,7 @@ int asCCompiler::DoAssignment(asCExprContext *ctx, asCExprContext *lctx, asCExpr
 		if( op != ttAssignment )
 		{
 			asCString str;
-			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(str, lexpr);
 			return -1;
 		}
@@ -8218,7 +8315,7 @@ int asCCompiler::DoAssignment(asCExprContext *ctx, asCExprContext *lctx, asCExpr
 					if( !dt.IsEqualExceptRefAndConst(rctx->type.dataType) )
 					{
 						asCString str;
-						str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+						str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), lctx->type.dataType.Format(m_nameSpace).AddressOf());
 						Error(str, rexpr);
 						return -1;
 					}
@@ -8238,7 +8335,7 @@ int asCCompiler::DoAssignment(asCExprContext *ctx, asCExprContext *lctx, asCExpr
 
 			// The object must implement the opAssign method
 			asCString msg;
-			msg.Format(TXT_NO_APPROPRIATE_OPHNDLASSIGN_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			msg.Format(TXT_NO_APPROPRIATE_OPHNDLASSIGN_s, lctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(msg.AddressOf(), opNode);
 			return -1;
 		}
@@ -8251,7 +8348,7 @@ int asCCompiler::DoAssignment(asCExprContext *ctx, asCExprContext *lctx, asCExpr
 			if( !dt.IsEqualExceptRefAndConst(rctx->type.dataType) )
 			{
 				asCString str;
-				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), lctx->type.dataType.Format(m_nameSpace).AddressOf());
 				Error(str, rexpr);
 				return -1;
 			}
@@ -8301,7 +8398,7 @@ int asCCompiler::DoAssignment(asCExprContext *ctx, asCExprContext *lctx, asCExpr
 		if( op != ttAssignment )
 		{
 			asCString str;
-			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(str, lexpr);
 			return -1;
 		}
@@ -8334,7 +8431,7 @@ int asCCompiler::DoAssignment(asCExprContext *ctx, asCExprContext *lctx, asCExpr
 			if( !dt.IsEqualExceptRefAndConst(rctx->type.dataType) )
 			{
 				asCString str;
-				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_CANT_IMPLICITLY_CONVERT_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), lctx->type.dataType.Format(m_nameSpace).AddressOf());
 				Error(str, rexpr);
 				return -1;
 			}
@@ -8904,7 +9001,7 @@ int asCCompiler::CompileExpressionTerm(asCScriptNode *node, asCExprContext *ctx)
 		if (node->firstChild->nodeType == snDataType)
 		{
 			// Determine the type of the temporary object
-			asCDataType dt = builder->CreateDataTypeFromNode(node->firstChild, script, outFunc->nameSpace);
+			asCDataType dt = builder->CreateDataTypeFromNode(node->firstChild, script, m_nameSpace);
 
 			return CompileAnonymousInitList(node->lastChild, ctx, dt);
 		}
@@ -9663,7 +9760,7 @@ int asCCompiler::CompileVariableAccess(const asCString &name, const asCString &s
 			if (!isCompiled)
 			{
 				asCString str;
-				str.Format(TXT_UNINITIALIZED_GLOBAL_VAR_s, prop->name.AddressOf());
+				str.Format(TXT_UNINITIALIZED_GLOBAL_VAR_s, name.AddressOf());
 				Error(str, errNode);
 				return -1;
 			}
@@ -9683,7 +9780,7 @@ int asCCompiler::CompileVariableAccess(const asCString &name, const asCString &s
 					if (!isAppProp)
 					{
 						asCString str;
-						str.Format(TXT_SHARED_CANNOT_ACCESS_NON_SHARED_VAR_s, prop->name.AddressOf());
+						str.Format(TXT_SHARED_CANNOT_ACCESS_NON_SHARED_VAR_s, name.AddressOf());
 						Error(str, errNode);
 
 						// Allow the compilation to continue to catch other problems
@@ -9988,7 +10085,9 @@ int asCCompiler::CompileExpressionValue(asCScriptNode *node, asCExprContext *ctx
 				}
 				else
 				{
+					builder->EnterCompileLock();
 					void *strPtr = const_cast<void*>(engine->stringFactory->GetStringConstant(str.AddressOf(), (asUINT)str.GetLength()));
+					builder->LeaveCompileLock();
 					if (strPtr == 0)
 					{
 						// TODO: A better message is needed
@@ -10363,7 +10462,7 @@ int asCCompiler::CompileConversion(asCScriptNode *node, asCExprContext *ctx)
 		}
 
 		// Determine the requested type
-		to = builder->CreateDataTypeFromNode(node->firstChild, script, outFunc->nameSpace);
+		to = builder->CreateDataTypeFromNode(node->firstChild, script, m_nameSpace);
 		to.MakeReadOnly(true); // Default to const
 		asASSERT(to.IsPrimitive());
 	}
@@ -10377,7 +10476,7 @@ int asCCompiler::CompileConversion(asCScriptNode *node, asCExprContext *ctx)
 			anyErrors = true;
 
 		// Determine the requested type
-		to = builder->CreateDataTypeFromNode(node->firstChild, script, outFunc->nameSpace);
+		to = builder->CreateDataTypeFromNode(node->firstChild, script, m_nameSpace);
 
 		// If the type support object handles, then use it
 		if( to.SupportHandles() )
@@ -10478,8 +10577,8 @@ int asCCompiler::CompileConversion(asCScriptNode *node, asCExprContext *ctx)
 
 	asCString strTo, strFrom;
 
-	strTo = to.Format(outFunc->nameSpace);
-	strFrom = expr.type.dataType.Format(outFunc->nameSpace);
+	strTo = to.Format(m_nameSpace);
+	strFrom = expr.type.dataType.Format(m_nameSpace);
 
 	asCString msg;
 	msg.Format(TXT_NO_CONVERSION_s_TO_s, strFrom.AddressOf(), strTo.AddressOf());
@@ -10646,7 +10745,7 @@ int asCCompiler::CompileConstructCall(asCScriptNode *node, asCExprContext *ctx)
 
 	// It is possible that the name is really a constructor
 	asCDataType dt;
-	dt = builder->CreateDataTypeFromNode(node->firstChild, script, outFunc->nameSpace);
+	dt = builder->CreateDataTypeFromNode(node->firstChild, script, m_nameSpace);
 	if( dt.IsPrimitive() )
 	{
 		// This is a cast to a primitive type
@@ -10663,7 +10762,7 @@ int asCCompiler::CompileConstructCall(asCScriptNode *node, asCExprContext *ctx)
 	if( dt.IsObjectHandle() )
 	{
 		asCString str;
-		str.Format(TXT_CANT_CONSTRUCT_s_USE_REF_CAST, dt.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_CANT_CONSTRUCT_s_USE_REF_CAST, dt.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 		ctx->type.SetDummy();
 		return -1;
@@ -10676,12 +10775,12 @@ int asCCompiler::CompileConstructCall(asCScriptNode *node, asCExprContext *ctx)
 	{
 		asCString str;
 		if( dt.IsAbstractClass() )
-			str.Format(TXT_ABSTRACT_CLASS_s_CANNOT_BE_INSTANTIATED, dt.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_ABSTRACT_CLASS_s_CANNOT_BE_INSTANTIATED, dt.Format(m_nameSpace).AddressOf());
 		else if( dt.IsInterface() )
-			str.Format(TXT_INTERFACE_s_CANNOT_BE_INSTANTIATED, dt.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_INTERFACE_s_CANNOT_BE_INSTANTIATED, dt.Format(m_nameSpace).AddressOf());
 		else
 			// TODO: Improve error message to explain why
-			str.Format(TXT_DATA_TYPE_CANT_BE_s, dt.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_DATA_TYPE_CANT_BE_s, dt.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 		ctx->type.SetDummy();
 		return -1;
@@ -10732,7 +10831,7 @@ int asCCompiler::CompileConstructCall(asCScriptNode *node, asCExprContext *ctx)
 		}
 
 		// Check for possible constructor/factory
-		name = dt.Format(outFunc->nameSpace);
+		name = dt.Format(m_nameSpace);
 
 		asSTypeBehaviour *beh = dt.GetBehaviour();
 
@@ -11002,7 +11101,7 @@ int asCCompiler::CompileFunctionCall(asCScriptNode *node, asCExprContext *ctx, a
 		{
 			// The variable is not a function or object with opCall
 			asCString msg;
-			msg.Format(TXT_NOT_A_FUNC_s_IS_TYPE_s, name.AddressOf(), lookupResult.type.dataType.Format(outFunc->nameSpace).AddressOf());
+			msg.Format(TXT_NOT_A_FUNC_s_IS_TYPE_s, name.AddressOf(), lookupResult.type.dataType.Format(m_nameSpace).AddressOf());
 			Error(msg, node);
 			return -1;
 		}
@@ -11143,7 +11242,7 @@ int asCCompiler::CompileFunctionCall(asCScriptNode *node, asCExprContext *ctx, a
 	if (symbolType == SL_CLASSTYPE || symbolType == SL_GLOBALTYPE)
 	{
 		bool isValid = false;
-		asCDataType dt = builder->CreateDataTypeFromNode(node->firstChild, script, outFunc->nameSpace, false, 0, false, &isValid);
+		asCDataType dt = builder->CreateDataTypeFromNode(node->firstChild, script, m_nameSpace, false, 0, false, &isValid);
 		if (isValid)
 			return CompileConstructCall(node, ctx);
 	}
@@ -11268,8 +11367,8 @@ asSNameSpace *asCCompiler::DetermineNameSpace(const asCString &scope)
 	if( scope == "" )
 	{
 		// When compiling default argument expression the correct namespace is stored in the outFunc even for objects
-		if( outFunc->nameSpace->name != "" || isCompilingDefaultArg )
-			ns = outFunc->nameSpace;
+		if( m_nameSpace->name != "" || isCompilingDefaultArg )
+			ns = m_nameSpace;
 		else if( outFunc->objectType && outFunc->objectType->nameSpace->name != "" )
 			ns = outFunc->objectType->nameSpace;
 		else
@@ -12582,7 +12681,7 @@ int asCCompiler::CompileExpressionPostOp(asCScriptNode *node, asCExprContext *ct
 					else
 					{
 						asCString str;
-						str.Format(TXT_s_NOT_MEMBER_OF_s, name.AddressOf(), ctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+						str.Format(TXT_s_NOT_MEMBER_OF_s, name.AddressOf(), ctx->type.dataType.Format(m_nameSpace).AddressOf());
 						Error(str, node);
 						return -1;
 					}
@@ -12591,7 +12690,7 @@ int asCCompiler::CompileExpressionPostOp(asCScriptNode *node, asCExprContext *ct
 			else
 			{
 				asCString str;
-				str.Format(TXT_s_NOT_MEMBER_OF_s, name.AddressOf(), ctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_s_NOT_MEMBER_OF_s, name.AddressOf(), ctx->type.dataType.Format(m_nameSpace).AddressOf());
 				Error(str, node);
 				return -1;
 			}
@@ -12602,7 +12701,7 @@ int asCCompiler::CompileExpressionPostOp(asCScriptNode *node, asCExprContext *ct
 			if( !ctx->type.dataType.IsObject() )
 			{
 				asCString str;
-				str.Format(TXT_ILLEGAL_OPERATION_ON_s, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_ILLEGAL_OPERATION_ON_s, ctx->type.dataType.Format(m_nameSpace).AddressOf());
 				Error(str, node);
 				return -1;
 			}
@@ -12663,7 +12762,7 @@ int asCCompiler::CompileExpressionPostOp(asCScriptNode *node, asCExprContext *ct
 			if( !ctx->type.dataType.IsObject() )
 			{
 				asCString str;
-				str.Format(TXT_OBJECT_DOESNT_SUPPORT_INDEX_OP, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+				str.Format(TXT_OBJECT_DOESNT_SUPPORT_INDEX_OP, ctx->type.dataType.Format(m_nameSpace).AddressOf());
 				Error(str, node);
 				return -1;
 			}
@@ -12730,7 +12829,7 @@ int asCCompiler::CompileExpressionPostOp(asCScriptNode *node, asCExprContext *ct
 					if (r == 0)
 					{
 						asCString str;
-						str.Format(TXT_OBJECT_DOESNT_SUPPORT_INDEX_OP, ctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+						str.Format(TXT_OBJECT_DOESNT_SUPPORT_INDEX_OP, ctx->type.dataType.Format(m_nameSpace).AddressOf());
 						Error(str, node);
 						isOK = false;
 					}
@@ -13549,7 +13648,7 @@ int asCCompiler::CompileOperator(asCScriptNode *node, asCExprContext *lctx, asCE
 		if( lctx->type.dataType.IsObject() && rctx->type.dataType.IsObject() )
 		{
 			asCString str;
-			str.Format(TXT_NO_MATCHING_OP_FOUND_FOR_TYPES_s_AND_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), rctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_NO_MATCHING_OP_FOUND_FOR_TYPES_s_AND_s, lctx->type.dataType.Format(m_nameSpace).AddressOf(), rctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 			ctx->type.SetDummy();
 			return -1;
@@ -13913,7 +14012,7 @@ void asCCompiler::CompileMathOperator(asCScriptNode *node, asCExprContext *lctx,
 		!lctx->type.dataType.IsDoubleType() )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_MATH_TYPE, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_NO_CONVERSION_s_TO_MATH_TYPE, lctx->type.dataType.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 
 		ctx->type.SetDummy();
@@ -13926,7 +14025,7 @@ void asCCompiler::CompileMathOperator(asCScriptNode *node, asCExprContext *lctx,
 		!rctx->type.dataType.IsDoubleType() )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_MATH_TYPE, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_NO_CONVERSION_s_TO_MATH_TYPE, rctx->type.dataType.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 
 		ctx->type.SetDummy();
@@ -14304,7 +14403,7 @@ void asCCompiler::CompileBitwiseOperator(asCScriptNode *node, asCExprContext *lc
 		if (lctx->type.dataType.IsFloatType() || lctx->type.dataType.IsDoubleType())
 		{
 			asCString str;
-			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 
 			// Set an integer value and allow the compiler to continue
@@ -14314,7 +14413,7 @@ void asCCompiler::CompileBitwiseOperator(asCScriptNode *node, asCExprContext *lc
 		if (rctx->type.dataType.IsFloatType() || rctx->type.dataType.IsDoubleType())
 		{
 			asCString str;
-			str.Format(TXT_ILLEGAL_OPERATION_ON_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_ILLEGAL_OPERATION_ON_s, rctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 
 			// Set an integer value and allow the compiler to continue
@@ -14344,7 +14443,7 @@ void asCCompiler::CompileBitwiseOperator(asCScriptNode *node, asCExprContext *lc
 		if( lctx->type.dataType != to )
 		{
 			asCString str;
-			str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 		}
 
@@ -14360,7 +14459,7 @@ void asCCompiler::CompileBitwiseOperator(asCScriptNode *node, asCExprContext *lc
 		if( rctx->type.dataType != to )
 		{
 			asCString str;
-			str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), lctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 		}
 
@@ -14454,7 +14553,7 @@ void asCCompiler::CompileBitwiseOperator(asCScriptNode *node, asCExprContext *lc
 		if( lctx->type.dataType.IsObject() || lctx->type.dataType.IsFloatType() || lctx->type.dataType.IsDoubleType() )
 		{
 			asCString str;
-			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_ILLEGAL_OPERATION_ON_s, lctx->type.dataType.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 
 			// Set an integer value and allow the compiler to continue
@@ -14488,7 +14587,7 @@ void asCCompiler::CompileBitwiseOperator(asCScriptNode *node, asCExprContext *lc
 		if( lctx->type.dataType != to )
 		{
 			asCString str;
-			str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+			str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 			Error(str, node);
 		}
 
@@ -14500,7 +14599,7 @@ void asCCompiler::CompileBitwiseOperator(asCScriptNode *node, asCExprContext *lc
 		if( !rctx->type.dataType.IsUnsignedType() )
 		{
 			asCString str;
-			str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), "uint");
+			str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), "uint");
 			Error(str, node);
 		}
 
@@ -14710,7 +14809,7 @@ void asCCompiler::CompileComparisonOperator(asCScriptNode *node, asCExprContext
 	if( !lctx->type.dataType.IsEqualExceptConst(to) )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 		ok = false;
 	}
@@ -14718,7 +14817,7 @@ void asCCompiler::CompileComparisonOperator(asCScriptNode *node, asCExprContext
 	if( !rctx->type.dataType.IsEqualExceptConst(to) )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 		ok = false;
 	}
@@ -14983,7 +15082,7 @@ void asCCompiler::CompileBooleanOperator(asCScriptNode *node, asCExprContext *lc
 	if( !lctx->type.dataType.IsBooleanType() )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), "bool");
+		str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(m_nameSpace).AddressOf(), "bool");
 		Error(str, node);
 		// Force the conversion to allow compilation to proceed
 		lctx->type.SetConstantB(asCDataType::CreatePrimitive(ttBool, true), true);
@@ -14992,7 +15091,7 @@ void asCCompiler::CompileBooleanOperator(asCScriptNode *node, asCExprContext *lc
 	if( !rctx->type.dataType.IsBooleanType() )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), "bool");
+		str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), "bool");
 		Error(str, node);
 		// Force the conversion to allow compilation to proceed
 		rctx->type.SetConstantB(asCDataType::CreatePrimitive(ttBool, true), true);
@@ -15250,14 +15349,14 @@ void asCCompiler::CompileOperatorOnHandles(asCScriptNode *node, asCExprContext *
 	if( !lctx->type.dataType.IsEqualExceptConst(to) )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_NO_CONVERSION_s_TO_s, lctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 	}
 
 	if( !rctx->type.dataType.IsEqualExceptConst(to) )
 	{
 		asCString str;
-		str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(outFunc->nameSpace).AddressOf(), to.Format(outFunc->nameSpace).AddressOf());
+		str.Format(TXT_NO_CONVERSION_s_TO_s, rctx->type.dataType.Format(m_nameSpace).AddressOf(), to.Format(m_nameSpace).AddressOf());
 		Error(str, node);
 	}
 
@@ -270,6 +270,7 @@ protected:
 	void CallDestructor(asCDataType &type, int offset, bool isObjectOnHeap, asCByteCode *bc);
 	int  CompileArgumentList(asCScriptNode *node, asCArray<asCExprContext *> &args, asCArray<asSNamedArgument> &namedArgs);
 	int  CompileDefaultAndNamedArgs(asCScriptNode *node, asCArray<asCExprContext*> &args, int funcId, asCObjectType *type, asCArray<asSNamedArgument> *namedArgs = 0);
+	bool   GetOverloadCacheKey(const asCArray<int> &funcs, asCArray<asCExprContext*> &args, asCObjectType *objectType, bool allowObjectConstruct, sOverloadCacheEntry &key);
 	asUINT MatchFunctions(asCArray<int> &funcs, asCArray<asCExprContext*> &args, asCScriptNode *node, const char *name, asCArray<asSNamedArgument> *namedArgs = NULL, asCObjectType *objectType = NULL, bool isConstMethod = false, bool silent = false, bool allowObjectConstruct = true, const asCString &scope = "");
 	int  CompileVariableAccess(const asCString &name, const asCString &scope, asCExprContext *ctx, asCScriptNode *errNode, bool isOptional = false, asCObjectType *objType = 0);
 	void CompileMemberInitialization(asCByteCode *bc, bool onlyDefaults);
@@ -383,6 +384,7 @@ protected:
 	bool                        m_isConstructorCalled;
 	sClassDeclaration          *m_classDecl;
 	sGlobalVariableDescription *m_globalVar;
+	asSNameSpace               *m_nameSpace; // Where the symbols are looked up, normally the namespace of outFunc
 
 	asCArray<int> breakLabels;
 	asCArray<int> continueLabels;
@@ -104,6 +104,16 @@
 // AS_USE_NAMESPACE
 // Adds the AngelScript namespace on the declarations.
 
+// AS_NO_THREADED_DISPATCH
+// Turns off the threaded dispatch in the bytecode interpreter, even though the
+// compiler supports labels as values. The interpreter will then use a single
+// switch to dispatch each instruction.
+
+// AS_NO_JIT
+// Excludes the built-in JIT compiler from the library. asCreateJITCompiler
+// will then return null, as it does on platforms where there is no built-in
+// JIT compiler.
+
 
 
 //
@@ -1205,6 +1215,18 @@
 	#define AS_NO_THREADS
 #endif
 
+// Threaded dispatch in the bytecode interpreter relies on the labels
+// as values extension. It is not used in debug mode as the debug
+// statistics are gathered in the common path of the switch
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(AS_NO_THREADED_DISPATCH) && !defined(AS_DEBUG)
+	#define AS_USE_COMPUTED_GOTO
+#endif
+
+// The built-in JIT compiler emits native code for 64bit Linux, Mac OS X and BSD
+#if defined(AS_X64_GCC) && !defined(AS_MAX_PORTABILITY) && !defined(AS_NO_JIT)
+	#define AS_JIT_X64_GCC
+#endif
+
 // If the form of threads to use hasn't been chosen
 // then the library will be compiled without support
 // for multithreading
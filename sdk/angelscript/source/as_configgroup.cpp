@@ -41,12 +41,14 @@
 #include "as_configgroup.h"
 #include "as_scriptengine.h"
 #include "as_texts.h"
+#include "as_string_util.h"
 
 BEGIN_AS_NAMESPACE
 
 asCConfigGroup::asCConfigGroup()
 {
 	refCount = 0;
+	fingerprint = 0;
 }
 
 asCConfigGroup::~asCConfigGroup()
@@ -107,6 +109,99 @@ void asCConfigGroup::AddReferencesForType(asCScriptEngine *engine, asCTypeInfo *
 		generatedTemplateInstances.PushLast(CastToObjectType(type));
 }
 
+// The values are hashed byte by byte so the digest is the same on all platforms
+static asQWORD HashValue(asQWORD hash, asQWORD value)
+{
+	char bytes[8];
+	for( int n = 0; n < 8; n++ )
+		bytes[n] = char(value >> (n*8));
+	return asStringHash64(bytes, 8, hash);
+}
+
+static asQWORD HashString(asQWORD hash, const asCString &str)
+{
+	// Include the null terminator so that consecutive strings can't be confused
+	return asStringHash64(str.AddressOf(), str.GetLength() + 1, hash);
+}
+
+static asQWORD HashFunction(asQWORD hash, asCScriptFunction *func)
+{
+	// The id is included so a matching fingerprint also means that
+	// the functions can be referred to by id, see asCReader
+	hash = HashValue(hash, asQWORD(func->id));
+	return HashString(hash, func->GetDeclarationStr(true, true, true));
+}
+
+// Calculates a digest of everything that has been registered in the group.
+// Only the declarations are included, not the addresses or sizes of the
+// application's implementation, so the digest can be compared between processes
+void asCConfigGroup::CalculateFingerprint(asCScriptEngine *engine)
+{
+	asSNameSpace *ns = engine->nameSpaces[0];
+	asQWORD hash = HashString(asStringHash64(0, 0), groupName);
+
+	for( asUINT n = 0; n < types.GetLength(); n++ )
+	{
+		asCTypeInfo *type = types[n];
+		hash = HashString(hash, type->nameSpace ? type->nameSpace->name : asCString());
+		hash = HashString(hash, type->name);
+		hash = HashValue(hash, type->flags);
+
+		asCObjectType *ot = CastToObjectType(type);
+		if( ot )
+		{
+			asUINT m;
+			for( m = 0; m < ot->properties.GetLength(); m++ )
+			{
+				hash = HashString(hash, ot->properties[m]->name);
+				hash = HashString(hash, ot->properties[m]->type.Format(ns, true));
+			}
+			for( m = 0; m < ot->GetBehaviourCount(); m++ )
+			{
+				asEBehaviours beh;
+				asCScriptFunction *func = static_cast<asCScriptFunction*>(ot->GetBehaviourByIndex(m, &beh));
+				hash = HashValue(hash, beh);
+				hash = HashFunction(hash, func);
+			}
+			for( m = 0; m < ot->beh.factories.GetLength(); m++ )
+				hash = HashFunction(hash, engine->scriptFunctions[ot->beh.factories[m]]);
+			for( m = 0; m < ot->methods.GetLength(); m++ )
+				hash = HashFunction(hash, engine->scriptFunctions[ot->methods[m]]);
+		}
+
+		asCEnumType *et = CastToEnumType(type);
+		if( et )
+		{
+			for( asUINT m = 0; m < et->enumValues.GetLength(); m++ )
+			{
+				hash = HashString(hash, et->enumValues[m]->name);
+				hash = HashValue(hash, asQWORD(et->enumValues[m]->value));
+			}
+		}
+
+		asCTypedefType *td = CastToTypedefType(type);
+		if( td )
+			hash = HashString(hash, td->aliasForType.Format(ns, true));
+
+		asCFuncdefType *fd = CastToFuncdefType(type);
+		if( fd )
+			hash = HashFunction(hash, fd->funcdef);
+	}
+
+	for( asUINT n = 0; n < scriptFunctions.GetLength(); n++ )
+		hash = HashFunction(hash, scriptFunctions[n]);
+
+	for( asUINT n = 0; n < globalProps.GetLength(); n++ )
+	{
+		asCGlobalProperty *prop = globalProps[n];
+		hash = HashString(hash, prop->nameSpace ? prop->nameSpace->name : asCString());
+		hash = HashString(hash, prop->name);
+		hash = HashString(hash, prop->type.Format(ns, true));
+	}
+
+	fingerprint = hash;
+}
+
 bool asCConfigGroup::HasLiveObjects()
 {
 	for( asUINT n = 0; n < types.GetLength(); n++ )
@@ -66,9 +66,15 @@ public:
 	void AddReferencesForFunc(asCScriptEngine *engine, asCScriptFunction *func);
 	void AddReferencesForType(asCScriptEngine *engine, asCTypeInfo *type);
 
+	void CalculateFingerprint(asCScriptEngine *engine);
+
 	asCString groupName;
 	int refCount;
 
+	// Digest of the declarations in the group. It is only up to
+	// date while the engine's interface fingerprint is valid
+	asQWORD fingerprint;
+
 	asCArray<asCTypeInfo*>       types;
 	asCArray<asCScriptFunction*> scriptFunctions;
 	asCArray<asCGlobalProperty*> globalProps;
@@ -47,6 +47,7 @@
 #include "as_debug.h" // mkdir()
 #include "as_bytecode.h"
 #include "as_scriptobject.h"
+#include "as_thread.h"
 
 #ifdef _MSC_VER
 #pragma warning(disable:4702) // unreachable code
@@ -61,6 +62,19 @@ const int RESERVE_STACK = 2*AS_PTR_SIZE;
 // For each script function call we push 9 PTRs on the call stack
 const int CALLSTACK_FRAME_SIZE = 9;
 
+// With threaded dispatch each instruction handler jumps directly to the
+// handler of the next instruction through a table of label addresses,
+// instead of going back to the common switch. This gives the branch
+// predictor a separate indirect branch for each instruction. Without
+// support for labels as values the plain switch is used.
+#ifdef AS_USE_COMPUTED_GOTO
+	#define asVM_OP(op) op_##op:
+	#define asVM_NEXT   goto *dispatchTable[*(asBYTE*)l_bc]
+#else
+	#define asVM_OP(op)
+	#define asVM_NEXT   break
+#endif
+
 #if defined(AS_DEBUG)
 
 class asCDebugStats
@@ -271,17 +285,11 @@ void asCContext::DetachEngine()
 	}
 	while( IsNested() );
 
-	// Free the stack blocks
+	// Return the stack blocks to the engine so they can be reused by other contexts
 	for( asUINT n = 0; n < m_stackBlocks.GetLength(); n++ )
 	{
 		if( m_stackBlocks[n] )
-		{
-#ifndef WIP_16BYTE_ALIGN
-			asDELETEARRAY(m_stackBlocks[n]);
-#else
-			asDELETEARRAYALIGNED(m_stackBlocks[n]);
-#endif
-		}
+			m_engine->memoryMgr.FreeStackBlock(m_stackBlocks[n], m_stackBlockSize << n);
 	}
 	m_stackBlocks.SetLength(0);
 	m_stackBlockSize = 0;
@@ -458,6 +466,15 @@ int asCContext::Prepare(asIScriptFunction *func)
 		else
 			m_returnValueSize = 0;
 
+		// The stack needed by the function isn't known until it has been loaded
+		if( m_currentFunction->LoadDeferredByteCode() < 0 )
+		{
+			asCString str;
+			str.Format(TXT_FAILED_IN_FUNC_s_WITH_s_s_d, "Prepare", func->GetDeclaration(true, true), errorNames[-asERROR], asERROR);
+			m_engine->WriteMessage("", 0, 0, asMSGTYPE_ERROR, str.AddressOf());
+			return asERROR;
+		}
+
 		// Determine the minimum stack size needed
 		int stackSize = m_argumentsSize + m_returnValueSize;
 		if( m_currentFunction->scriptData )
@@ -1209,6 +1226,10 @@ int asCContext::Execute()
 
 	asCThreadLocalData *tld = asPushActiveContext((asIScriptContext *)this);
 
+	// Let the garbage collector know that a script is executing in this 
+	// thread, so the background thread can pause it at a safe point
+	bool canBePausedByGC = m_engine->gc.EnterScriptExecution(this, tld);
+
 	// Make sure there are not too many nested calls, as it could crash the application 
 	// by filling up the thread call stack
 	if (tld->activeContexts.GetLength() > m_engine->ep.maxNestedCalls)
@@ -1282,10 +1303,16 @@ int asCContext::Execute()
 				SetInternalException(TXT_UNBOUND_FUNCTION);
 		}
 
-		if( m_currentFunction->funcType == asFUNC_SCRIPT )
+		// The real function of a virtual method or delegate may not have been loaded yet
+		if( m_currentFunction->funcType == asFUNC_SCRIPT && m_currentFunction->LoadDeferredByteCode() < 0 )
+			SetInternalException(TXT_FUNCTION_NOT_LOADED);
+		else if( m_currentFunction->funcType == asFUNC_SCRIPT )
 		{
 			m_regs.programPointer = m_currentFunction->scriptData->byteCode.AddressOf();
 
+			if( m_engine->ep.profileFunctions )
+				ProfileFunctionEntry();
+
 			// Set up the internal registers for executing the script function
 			PrepareScriptFunction();
 		}
@@ -1345,6 +1372,9 @@ int asCContext::Execute()
 		}
 	}
 
+	if( canBePausedByGC )
+		m_engine->gc.LeaveScriptExecution(this, tld);
+
 	// Pop the active context
 	asPopActiveContext(tld, this);
 
@@ -1605,11 +1635,7 @@ bool asCContext::ReserveStackSpace(asUINT size)
 		m_stackBlockSize = m_engine->initialContextStackSize;
 		asASSERT( m_stackBlockSize > 0 );
 
-#ifndef WIP_16BYTE_ALIGN
-		asDWORD *stack = asNEWARRAY(asDWORD,m_stackBlockSize);
-#else
-		asDWORD *stack = asNEWARRAYALIGNED(asDWORD, m_stackBlockSize, MAX_TYPE_ALIGNMENT);
-#endif
+		asDWORD *stack = m_engine->memoryMgr.AllocStackBlock(m_stackBlockSize);
 		if( stack == 0 )
 		{
 			// Out of memory
@@ -1656,11 +1682,7 @@ bool asCContext::ReserveStackSpace(asUINT size)
 		if( m_stackBlocks.GetLength() == m_stackIndex )
 		{
 			// Allocate the new stack block, with twice the size of the previous
-#ifndef WIP_16BYTE_ALIGN
-			asDWORD *stack = asNEWARRAY(asDWORD, (m_stackBlockSize << m_stackIndex));
-#else
-			asDWORD *stack = asNEWARRAYALIGNED(asDWORD, (m_stackBlockSize << m_stackIndex), MAX_TYPE_ALIGNMENT);
-#endif
+			asDWORD *stack = m_engine->memoryMgr.AllocStackBlock(m_stackBlockSize << m_stackIndex);
 			if( stack == 0 )
 			{
 				// Out of memory
@@ -1704,6 +1726,13 @@ void asCContext::CallScriptFunction(asCScriptFunction *func)
 {
 	asASSERT( func->scriptData );
 
+	// Functions loaded with asEP_LAZY_LOAD_FUNCTIONS are translated on the first call
+	if( asAtomicLoadAcquire(func->scriptData->deferredLoader) && func->LoadDeferredByteCode() < 0 )
+	{
+		SetInternalException(TXT_FUNCTION_NOT_LOADED);
+		return;
+	}
+
 	// Push the framepointer, function id and programCounter on the stack
 	PushCallState();
 
@@ -1712,9 +1741,49 @@ void asCContext::CallScriptFunction(asCScriptFunction *func)
 	m_currentFunction = func;
 	m_regs.programPointer = m_currentFunction->scriptData->byteCode.AddressOf();
 
+	if( m_engine->ep.profileFunctions )
+		ProfileFunctionEntry();
+
 	PrepareScriptFunction();
 }
 
+// internal
+void asCContext::ProfileFunctionEntry()
+{
+	asUINT depth = m_callStack.GetLength();
+
+	// Discard the entries of functions that didn't return normally
+	while( m_profileStack.GetLength() && m_profileStack[m_profileStack.GetLength()-1].depth >= depth )
+		m_profileStack.PopLast();
+
+	SProfileEntry entry;
+	entry.func  = m_currentFunction;
+	entry.depth = depth;
+	entry.start = asGetTimerTicks();
+	m_profileStack.PushLast(entry);
+
+	m_currentFunction->profileCallCount++;
+}
+
+// internal
+void asCContext::ProfileFunctionExit()
+{
+	asUINT depth = m_callStack.GetLength();
+
+	// Discard the entries of functions that didn't return normally
+	while( m_profileStack.GetLength() && m_profileStack[m_profileStack.GetLength()-1].depth > depth )
+		m_profileStack.PopLast();
+
+	// If the profiling was turned on while the function was executing there may not be an entry for it
+	if( m_profileStack.GetLength() && m_profileStack[m_profileStack.GetLength()-1].depth == depth )
+	{
+		SProfileEntry &entry = m_profileStack[m_profileStack.GetLength()-1];
+		if( entry.func == m_currentFunction )
+			m_currentFunction->profileTime += asGetTimerTicks() - entry.start;
+		m_profileStack.PopLast();
+	}
+}
+
 void asCContext::PrepareScriptFunction()
 {
 	asASSERT( m_currentFunction->scriptData );
@@ -1757,6 +1826,8 @@ void asCContext::PrepareScriptFunction()
 			CallLineCallback();
 		if( m_doSuspend )
 			m_status = asEXECUTION_SUSPENDED;
+		else if( !m_lineCallback || m_engine->gc.IsPauseRequested() )
+			m_engine->gc.PauseAtSafePoint(this);
 	}
 }
 
@@ -1828,6 +1899,78 @@ void asCContext::ExecuteNext()
 	asDWORD *l_sp = m_regs.stackPointer;
 	asDWORD *l_fp = m_regs.stackFramePointer;
 
+#ifdef AS_USE_COMPUTED_GOTO
+	// The labels must be listed in the same order as the byte codes so
+	// that the byte code value can be used directly as index in the table
+	static const void *const dispatchTable[256] =
+	{
+		&&op_asBC_PopPtr, &&op_asBC_PshGPtr, &&op_asBC_PshC4, &&op_asBC_PshV4,
+		&&op_asBC_PSF, &&op_asBC_SwapPtr, &&op_asBC_NOT, &&op_asBC_PshG4,
+		&&op_asBC_LdGRdR4, &&op_asBC_CALL, &&op_asBC_RET, &&op_asBC_JMP,
+		&&op_asBC_JZ, &&op_asBC_JNZ, &&op_asBC_JS, &&op_asBC_JNS,
+		&&op_asBC_JP, &&op_asBC_JNP, &&op_asBC_TZ, &&op_asBC_TNZ,
+		&&op_asBC_TS, &&op_asBC_TNS, &&op_asBC_TP, &&op_asBC_TNP,
+		&&op_asBC_NEGi, &&op_asBC_NEGf, &&op_asBC_NEGd, &&op_asBC_INCi16,
+		&&op_asBC_INCi8, &&op_asBC_DECi16, &&op_asBC_DECi8, &&op_asBC_INCi,
+		&&op_asBC_DECi, &&op_asBC_INCf, &&op_asBC_DECf, &&op_asBC_INCd,
+		&&op_asBC_DECd, &&op_asBC_IncVi, &&op_asBC_DecVi, &&op_asBC_BNOT,
+		&&op_asBC_BAND, &&op_asBC_BOR, &&op_asBC_BXOR, &&op_asBC_BSLL,
+		&&op_asBC_BSRL, &&op_asBC_BSRA, &&op_asBC_COPY, &&op_asBC_PshC8,
+		&&op_asBC_PshVPtr, &&op_asBC_RDSPtr, &&op_asBC_CMPd, &&op_asBC_CMPu,
+		&&op_asBC_CMPf, &&op_asBC_CMPi, &&op_asBC_CMPIi, &&op_asBC_CMPIf,
+		&&op_asBC_CMPIu, &&op_asBC_JMPP, &&op_asBC_PopRPtr, &&op_asBC_PshRPtr,
+		&&op_asBC_STR, &&op_asBC_CALLSYS, &&op_asBC_CALLBND, &&op_asBC_SUSPEND,
+		&&op_asBC_ALLOC, &&op_asBC_FREE, &&op_asBC_LOADOBJ, &&op_asBC_STOREOBJ,
+		&&op_asBC_GETOBJ, &&op_asBC_REFCPY, &&op_asBC_CHKREF, &&op_asBC_GETOBJREF,
+		&&op_asBC_GETREF, &&op_asBC_PshNull, &&op_asBC_ClrVPtr, &&op_asBC_OBJTYPE,
+		&&op_asBC_TYPEID, &&op_asBC_SetV4, &&op_asBC_SetV8, &&op_asBC_ADDSi,
+		&&op_asBC_CpyVtoV4, &&op_asBC_CpyVtoV8, &&op_asBC_CpyVtoR4, &&op_asBC_CpyVtoR8,
+		&&op_asBC_CpyVtoG4, &&op_asBC_CpyRtoV4, &&op_asBC_CpyRtoV8, &&op_asBC_CpyGtoV4,
+		&&op_asBC_WRTV1, &&op_asBC_WRTV2, &&op_asBC_WRTV4, &&op_asBC_WRTV8,
+		&&op_asBC_RDR1, &&op_asBC_RDR2, &&op_asBC_RDR4, &&op_asBC_RDR8,
+		&&op_asBC_LDG, &&op_asBC_LDV, &&op_asBC_PGA, &&op_asBC_CmpPtr,
+		&&op_asBC_VAR, &&op_asBC_iTOf, &&op_asBC_fTOi, &&op_asBC_uTOf,
+		&&op_asBC_fTOu, &&op_asBC_sbTOi, &&op_asBC_swTOi, &&op_asBC_ubTOi,
+		&&op_asBC_uwTOi, &&op_asBC_dTOi, &&op_asBC_dTOu, &&op_asBC_dTOf,
+		&&op_asBC_iTOd, &&op_asBC_uTOd, &&op_asBC_fTOd, &&op_asBC_ADDi,
+		&&op_asBC_SUBi, &&op_asBC_MULi, &&op_asBC_DIVi, &&op_asBC_MODi,
+		&&op_asBC_ADDf, &&op_asBC_SUBf, &&op_asBC_MULf, &&op_asBC_DIVf,
+		&&op_asBC_MODf, &&op_asBC_ADDd, &&op_asBC_SUBd, &&op_asBC_MULd,
+		&&op_asBC_DIVd, &&op_asBC_MODd, &&op_asBC_ADDIi, &&op_asBC_SUBIi,
+		&&op_asBC_MULIi, &&op_asBC_ADDIf, &&op_asBC_SUBIf, &&op_asBC_MULIf,
+		&&op_asBC_SetG4, &&op_asBC_ChkRefS, &&op_asBC_ChkNullV, &&op_asBC_CALLINTF,
+		&&op_asBC_iTOb, &&op_asBC_iTOw, &&op_asBC_SetV1, &&op_asBC_SetV2,
+		&&op_asBC_Cast, &&op_asBC_i64TOi, &&op_asBC_uTOi64, &&op_asBC_iTOi64,
+		&&op_asBC_fTOi64, &&op_asBC_dTOi64, &&op_asBC_fTOu64, &&op_asBC_dTOu64,
+		&&op_asBC_i64TOf, &&op_asBC_u64TOf, &&op_asBC_i64TOd, &&op_asBC_u64TOd,
+		&&op_asBC_NEGi64, &&op_asBC_INCi64, &&op_asBC_DECi64, &&op_asBC_BNOT64,
+		&&op_asBC_ADDi64, &&op_asBC_SUBi64, &&op_asBC_MULi64, &&op_asBC_DIVi64,
+		&&op_asBC_MODi64, &&op_asBC_BAND64, &&op_asBC_BOR64, &&op_asBC_BXOR64,
+		&&op_asBC_BSLL64, &&op_asBC_BSRL64, &&op_asBC_BSRA64, &&op_asBC_CMPi64,
+		&&op_asBC_CMPu64, &&op_asBC_ChkNullS, &&op_asBC_ClrHi, &&op_asBC_JitEntry,
+		&&op_asBC_CallPtr, &&op_asBC_FuncPtr, &&op_asBC_LoadThisR, &&op_asBC_PshV8,
+		&&op_asBC_DIVu, &&op_asBC_MODu, &&op_asBC_DIVu64, &&op_asBC_MODu64,
+		&&op_asBC_LoadRObjR, &&op_asBC_LoadVObjR, &&op_asBC_RefCpyV, &&op_asBC_JLowZ,
+		&&op_asBC_JLowNZ, &&op_asBC_AllocMem, &&op_asBC_SetListSize, &&op_asBC_PshListElmnt,
+		&&op_asBC_SetListType, &&op_asBC_POWi, &&op_asBC_POWu, &&op_asBC_POWf,
+		&&op_asBC_POWd, &&op_asBC_POWdi, &&op_asBC_POWi64, &&op_asBC_POWu64,
+		&&op_asBC_Thiscall1, &&op_asBC_CMPIiJZ, &&op_asBC_CMPIiJNZ, &&op_asBC_CMPIiJS,
+		&&op_asBC_CMPIiJNS, &&op_asBC_CMPIiJP, &&op_asBC_CMPIiJNP, &&op_asBC_CpyThisToV4,
+		&&op_asBC_CpyVtoThis4, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid,
+		&&op_invalid, &&op_invalid, &&op_invalid, &&op_invalid
+	};
+#endif
+
 	for(;;)
 	{
 
@@ -1850,52 +1993,52 @@ void asCContext::ExecuteNext()
 //--------------
 // memory access functions
 
-	case asBC_PopPtr:
+	case asBC_PopPtr: asVM_OP(asBC_PopPtr)
 		// Pop a pointer from the stack
 		l_sp += AS_PTR_SIZE;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_PshGPtr:
+	case asBC_PshGPtr: asVM_OP(asBC_PshGPtr)
 		// Replaces PGA + RDSPtr
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = *(asPWORD*)asBC_PTRARG(l_bc);
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
 	// Push a dword value on the stack
-	case asBC_PshC4:
+	case asBC_PshC4: asVM_OP(asBC_PshC4)
 		--l_sp;
 		*l_sp = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Push the dword value of a variable on the stack
-	case asBC_PshV4:
+	case asBC_PshV4: asVM_OP(asBC_PshV4)
 		--l_sp;
 		*l_sp = *(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Push the address of a variable on the stack
-	case asBC_PSF:
+	case asBC_PSF: asVM_OP(asBC_PSF)
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asPWORD(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Swap the top 2 pointers on the stack
-	case asBC_SwapPtr:
+	case asBC_SwapPtr: asVM_OP(asBC_SwapPtr)
 		{
 			asPWORD p = *(asPWORD*)l_sp;
 			*(asPWORD*)l_sp = *(asPWORD*)(l_sp+AS_PTR_SIZE);
 			*(asPWORD*)(l_sp+AS_PTR_SIZE) = p;
 			l_bc++;
 		}
-		break;
+		asVM_NEXT;
 
 	// Do a boolean not operation, modifying the value of the variable
-	case asBC_NOT:
+	case asBC_NOT: asVM_OP(asBC_NOT)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is equal to 0
@@ -1914,28 +2057,28 @@ void asCContext::ExecuteNext()
 		*(l_fp - asBC_SWORDARG0(l_bc)) = (*(l_fp - asBC_SWORDARG0(l_bc)) == 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Push the dword value of a global variable on the stack
-	case asBC_PshG4:
+	case asBC_PshG4: asVM_OP(asBC_PshG4)
 		--l_sp;
 		*l_sp = *(asDWORD*)asBC_PTRARG(l_bc);
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
 	// Load the address of a global variable in the register, then
 	// copy the value of the global variable into a local variable
-	case asBC_LdGRdR4:
+	case asBC_LdGRdR4: asVM_OP(asBC_LdGRdR4)
 		*(void**)&m_regs.valueRegister = (void*)asBC_PTRARG(l_bc);
 		*(l_fp - asBC_SWORDARG0(l_bc)) = **(asDWORD**)&m_regs.valueRegister;
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
 //----------------
 // path control instructions
 
 	// Begin execution of a script function
-	case asBC_CALL:
+	case asBC_CALL: asVM_OP(asBC_CALL)
 		{
 			int i = asBC_INTARG(l_bc);
 			l_bc += 2;
@@ -1959,11 +2102,14 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		asVM_NEXT;
 
 	// Return to the caller, and remove the arguments from the stack
-	case asBC_RET:
+	case asBC_RET: asVM_OP(asBC_RET)
 		{
+			if( m_engine->ep.profileFunctions )
+				ProfileFunctionExit();
+
 			// Return if this was the first function, or a nested execution
 			if( m_callStack.GetLength() == 0 ||
 				m_callStack[m_callStack.GetLength() - CALLSTACK_FRAME_SIZE] == 0 )
@@ -1985,68 +2131,68 @@ void asCContext::ExecuteNext()
 			// Pop arguments from stack
 			l_sp += w;
 		}
-		break;
+		asVM_NEXT;
 
 	// Jump to a relative position
-	case asBC_JMP:
+	case asBC_JMP: asVM_OP(asBC_JMP)
 		l_bc += 2 + asBC_INTARG(l_bc);
-		break;
+		asVM_NEXT;
 
 //----------------
 // Conditional jumps
 
 	// Jump to a relative position if the value in the register is 0
-	case asBC_JZ:
+	case asBC_JZ: asVM_OP(asBC_JZ)
 		if( *(int*)&m_regs.valueRegister == 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Jump to a relative position if the value in the register is not 0
-	case asBC_JNZ:
+	case asBC_JNZ: asVM_OP(asBC_JNZ)
 		if( *(int*)&m_regs.valueRegister != 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Jump to a relative position if the value in the register is negative
-	case asBC_JS:
+	case asBC_JS: asVM_OP(asBC_JS)
 		if( *(int*)&m_regs.valueRegister < 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Jump to a relative position if the value in the register it not negative
-	case asBC_JNS:
+	case asBC_JNS: asVM_OP(asBC_JNS)
 		if( *(int*)&m_regs.valueRegister >= 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Jump to a relative position if the value in the register is greater than 0
-	case asBC_JP:
+	case asBC_JP: asVM_OP(asBC_JP)
 		if( *(int*)&m_regs.valueRegister > 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Jump to a relative position if the value in the register is not greater than 0
-	case asBC_JNP:
+	case asBC_JNP: asVM_OP(asBC_JNP)
 		if( *(int*)&m_regs.valueRegister <= 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 //--------------------
 // test instructions
 
 	// If the value in the register is 0, then set the register to 1, else to 0
-	case asBC_TZ:
+	case asBC_TZ: asVM_OP(asBC_TZ)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is equal to 0
@@ -2070,10 +2216,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister == 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// If the value in the register is not 0, then set the register to 1, else to 0
-	case asBC_TNZ:
+	case asBC_TNZ: asVM_OP(asBC_TNZ)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is not equal to 0
@@ -2097,10 +2243,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister == 0 ? 0 : VALUE_OF_BOOLEAN_TRUE);
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// If the value in the register is negative, then set the register to 1, else to 0
-	case asBC_TS:
+	case asBC_TS: asVM_OP(asBC_TS)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is less than 0
@@ -2124,10 +2270,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister < 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// If the value in the register is not negative, then set the register to 1, else to 0
-	case asBC_TNS:
+	case asBC_TNS: asVM_OP(asBC_TNS)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is not less than 0
@@ -2151,10 +2297,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister < 0 ? 0 : VALUE_OF_BOOLEAN_TRUE);
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// If the value in the register is greater than 0, then set the register to 1, else to 0
-	case asBC_TP:
+	case asBC_TP: asVM_OP(asBC_TP)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is greater than 0
@@ -2178,10 +2324,10 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister > 0 ? VALUE_OF_BOOLEAN_TRUE : 0);
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// If the value in the register is not greater than 0, then set the register to 1, else to 0
-	case asBC_TNP:
+	case asBC_TNP: asVM_OP(asBC_TNP)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Set the value to true if it is not greater than 0
@@ -2205,150 +2351,150 @@ void asCContext::ExecuteNext()
 		*(int*)&m_regs.valueRegister = (*(int*)&m_regs.valueRegister > 0 ? 0 : VALUE_OF_BOOLEAN_TRUE);
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 //--------------------
 // negate value
 
 	// Negate the integer value in the variable
-	case asBC_NEGi:
+	case asBC_NEGi: asVM_OP(asBC_NEGi)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asDWORD(-int(*(l_fp - asBC_SWORDARG0(l_bc))));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Negate the float value in the variable
-	case asBC_NEGf:
+	case asBC_NEGf: asVM_OP(asBC_NEGf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = -*(float*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Negate the double value in the variable
-	case asBC_NEGd:
+	case asBC_NEGd: asVM_OP(asBC_NEGd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = -*(double*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 //-------------------------
 // Increment value pointed to by address in register
 
 	// Increment the short value pointed to by the register
-	case asBC_INCi16:
+	case asBC_INCi16: asVM_OP(asBC_INCi16)
 		(**(short**)&m_regs.valueRegister)++;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Increment the byte value pointed to by the register
-	case asBC_INCi8:
+	case asBC_INCi8: asVM_OP(asBC_INCi8)
 		(**(char**)&m_regs.valueRegister)++;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Decrement the short value pointed to by the register
-	case asBC_DECi16:
+	case asBC_DECi16: asVM_OP(asBC_DECi16)
 		(**(short**)&m_regs.valueRegister)--;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Decrement the byte value pointed to by the register
-	case asBC_DECi8:
+	case asBC_DECi8: asVM_OP(asBC_DECi8)
 		(**(char**)&m_regs.valueRegister)--;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Increment the integer value pointed to by the register
-	case asBC_INCi:
+	case asBC_INCi: asVM_OP(asBC_INCi)
 		++(**(int**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Decrement the integer value pointed to by the register
-	case asBC_DECi:
+	case asBC_DECi: asVM_OP(asBC_DECi)
 		--(**(int**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Increment the float value pointed to by the register
-	case asBC_INCf:
+	case asBC_INCf: asVM_OP(asBC_INCf)
 		++(**(float**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Decrement the float value pointed to by the register
-	case asBC_DECf:
+	case asBC_DECf: asVM_OP(asBC_DECf)
 		--(**(float**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Increment the double value pointed to by the register
-	case asBC_INCd:
+	case asBC_INCd: asVM_OP(asBC_INCd)
 		++(**(double**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Decrement the double value pointed to by the register
-	case asBC_DECd:
+	case asBC_DECd: asVM_OP(asBC_DECd)
 		--(**(double**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Increment the local integer variable
-	case asBC_IncVi:
+	case asBC_IncVi: asVM_OP(asBC_IncVi)
 		(*(int*)(l_fp - asBC_SWORDARG0(l_bc)))++;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Decrement the local integer variable
-	case asBC_DecVi:
+	case asBC_DecVi: asVM_OP(asBC_DecVi)
 		(*(int*)(l_fp - asBC_SWORDARG0(l_bc)))--;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 //--------------------
 // bits instructions
 
 	// Do a bitwise not on the value in the variable
-	case asBC_BNOT:
+	case asBC_BNOT: asVM_OP(asBC_BNOT)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = ~*(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	// Do a bitwise and of two variables and store the result in a third variable
-	case asBC_BAND:
+	case asBC_BAND: asVM_OP(asBC_BAND)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) & *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Do a bitwise or of two variables and store the result in a third variable
-	case asBC_BOR:
+	case asBC_BOR: asVM_OP(asBC_BOR)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) | *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Do a bitwise xor of two variables and store the result in a third variable
-	case asBC_BXOR:
+	case asBC_BXOR: asVM_OP(asBC_BXOR)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) ^ *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Do a logical shift left of two variables and store the result in a third variable
-	case asBC_BSLL:
+	case asBC_BSLL: asVM_OP(asBC_BSLL)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) << *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Do a logical shift right of two variables and store the result in a third variable
-	case asBC_BSRL:
+	case asBC_BSRL: asVM_OP(asBC_BSRL)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc)) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	// Do an arithmetic shift right of two variables and store the result in a third variable
-	case asBC_BSRA:
+	case asBC_BSRA: asVM_OP(asBC_BSRA)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(l_fp - asBC_SWORDARG1(l_bc))) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_COPY:
+	case asBC_COPY: asVM_OP(asBC_COPY)
 		{
 			void *d = (void*)*(asPWORD*)l_sp; l_sp += AS_PTR_SIZE;
 			void *s = (void*)*(asPWORD*)l_sp;
@@ -2369,21 +2515,21 @@ void asCContext::ExecuteNext()
 			*(asPWORD**)l_sp = (asPWORD*)d;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_PshC8:
+	case asBC_PshC8: asVM_OP(asBC_PshC8)
 		l_sp -= 2;
 		*(asQWORD*)l_sp = asBC_QWORDARG(l_bc);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_PshVPtr:
+	case asBC_PshVPtr: asVM_OP(asBC_PshVPtr)
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = *(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_RDSPtr:
+	case asBC_RDSPtr: asVM_OP(asBC_RDSPtr)
 		{
 			// The pointer must not be null
 			asPWORD a = *(asPWORD*)l_sp;
@@ -2400,11 +2546,11 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)l_sp = *(asPWORD*)a;
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	//----------------------------
 	// Comparisons
-	case asBC_CMPd:
+	case asBC_CMPd: asVM_OP(asBC_CMPd)
 		{
 			// Do a comparison of the values, rather than a subtraction
 			// in order to get proper behaviour for infinity values.
@@ -2415,9 +2561,9 @@ void asCContext::ExecuteNext()
 			else                   *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CMPu:
+	case asBC_CMPu: asVM_OP(asBC_CMPu)
 		{
 			asDWORD d1 = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 			asDWORD d2 = *(asDWORD*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -2426,9 +2572,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CMPf:
+	case asBC_CMPf: asVM_OP(asBC_CMPf)
 		{
 			// Do a comparison of the values, rather than a subtraction
 			// in order to get proper behaviour for infinity values.
@@ -2439,9 +2585,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CMPi:
+	case asBC_CMPi: asVM_OP(asBC_CMPi)
 		{
 			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
 			int i2 = *(int*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -2450,11 +2596,11 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
 	//----------------------------
 	// Comparisons with constant value
-	case asBC_CMPIi:
+	case asBC_CMPIi: asVM_OP(asBC_CMPIi)
 		{
 			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
 			int i2 = asBC_INTARG(l_bc);
@@ -2463,9 +2609,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CMPIf:
+	case asBC_CMPIf: asVM_OP(asBC_CMPIf)
 		{
 			// Do a comparison of the values, rather than a subtraction
 			// in order to get proper behaviour for infinity values.
@@ -2476,9 +2622,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CMPIu:
+	case asBC_CMPIu: asVM_OP(asBC_CMPIu)
 		{
 			asDWORD d1 = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 			asDWORD d2 = asBC_DWORDARG(l_bc);
@@ -2487,31 +2633,31 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_JMPP:
+	case asBC_JMPP: asVM_OP(asBC_JMPP)
 		l_bc += 1 + (*(int*)(l_fp - asBC_SWORDARG0(l_bc)))*2;
-		break;
+		asVM_NEXT;
 
-	case asBC_PopRPtr:
+	case asBC_PopRPtr: asVM_OP(asBC_PopRPtr)
 		*(asPWORD*)&m_regs.valueRegister = *(asPWORD*)l_sp;
 		l_sp += AS_PTR_SIZE;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_PshRPtr:
+	case asBC_PshRPtr: asVM_OP(asBC_PshRPtr)
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = *(asPWORD*)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_STR:
+	case asBC_STR: asVM_OP(asBC_STR)
 		// TODO: NEWSTRING: Deprecate this instruction
 		asASSERT(false);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_CALLSYS:
+	case asBC_CALLSYS: asVM_OP(asBC_CALLSYS)
 		{
 			// Get function ID from the argument
 			int i = asBC_INTARG(l_bc);
@@ -2550,9 +2696,9 @@ void asCContext::ExecuteNext()
 				}
 			}
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CALLBND:
+	case asBC_CALLBND: asVM_OP(asBC_CALLBND)
 		{
 			// TODO: Clean-up: This code is very similar to asBC_CallPtr. Create a shared method for them
 			// Get the function ID from the stack
@@ -2631,9 +2777,9 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_SUSPEND:
+	case asBC_SUSPEND: asVM_OP(asBC_SUSPEND)
 		if( m_regs.doProcessSuspend )
 		{
 			if( m_lineCallback )
@@ -2656,12 +2802,16 @@ void asCContext::ExecuteNext()
 				m_status = asEXECUTION_SUSPENDED;
 				return;
 			}
+
+			// The background garbage collector may be waiting for the script to pause
+			if( !m_lineCallback || m_engine->gc.IsPauseRequested() )
+				m_engine->gc.PauseAtSafePoint(this);
 		}
 
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_ALLOC:
+	case asBC_ALLOC: asVM_OP(asBC_ALLOC)
 		{
 			asCObjectType *objType = (asCObjectType*)asBC_PTRARG(l_bc);
 			int func = asBC_INTARG(l_bc+AS_PTR_SIZE);
@@ -2757,9 +2907,9 @@ void asCContext::ExecuteNext()
 				}
 			}
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_FREE:
+	case asBC_FREE: asVM_OP(asBC_FREE)
 		{
 			// Get the variable that holds the object handle/reference
 			asPWORD *a = (asPWORD*)asPWORD(l_fp - asBC_SWORDARG0(l_bc));
@@ -2795,9 +2945,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_LOADOBJ:
+	case asBC_LOADOBJ: asVM_OP(asBC_LOADOBJ)
 		{
 			// Move the object pointer from the object variable into the object register
 			void **a = (void**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -2806,16 +2956,16 @@ void asCContext::ExecuteNext()
 			*a = 0;
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_STOREOBJ:
+	case asBC_STOREOBJ: asVM_OP(asBC_STOREOBJ)
 		// Move the object pointer from the object register to the object variable
 		*(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asPWORD(m_regs.objectRegister);
 		m_regs.objectRegister = 0;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_GETOBJ:
+	case asBC_GETOBJ: asVM_OP(asBC_GETOBJ)
 		{
 			// Read variable index from location on stack
 			asPWORD *a = (asPWORD*)(l_sp + asBC_WORDARG0(l_bc));
@@ -2827,9 +2977,9 @@ void asCContext::ExecuteNext()
 			*v = 0;
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_REFCPY:
+	case asBC_REFCPY: asVM_OP(asBC_REFCPY)
 		{
 			asCObjectType *objType = (asCObjectType*)asBC_PTRARG(l_bc);
 			asSTypeBehaviour *beh = &objType->beh;
@@ -2861,9 +3011,9 @@ void asCContext::ExecuteNext()
 			*d = s;
 		}
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_CHKREF:
+	case asBC_CHKREF: asVM_OP(asBC_CHKREF)
 		{
 			// Verify if the pointer on the stack is null
 			// This is used when validating a pointer that an operator will work on
@@ -2879,9 +3029,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_GETOBJREF:
+	case asBC_GETOBJREF: asVM_OP(asBC_GETOBJREF)
 		{
 			// Get the location on the stack where the reference will be placed
 			asPWORD *a = (asPWORD*)(l_sp + asBC_WORDARG0(l_bc));
@@ -2890,9 +3040,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD**)a = *(asPWORD**)(l_fp - *a);
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_GETREF:
+	case asBC_GETREF: asVM_OP(asBC_GETREF)
 		{
 			// Get the location on the stack where the reference will be placed
 			asPWORD *a = (asPWORD*)(l_sp + asBC_WORDARG0(l_bc));
@@ -2901,49 +3051,49 @@ void asCContext::ExecuteNext()
 			*(asPWORD**)a = (asPWORD*)(l_fp - (int)*a);
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_PshNull:
+	case asBC_PshNull: asVM_OP(asBC_PshNull)
 		// Push a null pointer on the stack
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = 0;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_ClrVPtr:
+	case asBC_ClrVPtr: asVM_OP(asBC_ClrVPtr)
 		// TODO: runtime optimize: Is this instruction really necessary?
 		//                         CallScriptFunction() can clear the null handles upon entry, just as is done for
 		//                         all other object variables
 		// Clear pointer variable
 		*(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = 0;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_OBJTYPE:
+	case asBC_OBJTYPE: asVM_OP(asBC_OBJTYPE)
 		// Push the object type on the stack
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_TYPEID:
+	case asBC_TYPEID: asVM_OP(asBC_TYPEID)
 		// Equivalent to PshC4, but kept as separate instruction for bytecode serialization
 		--l_sp;
 		*l_sp = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SetV4:
+	case asBC_SetV4: asVM_OP(asBC_SetV4)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SetV8:
+	case asBC_SetV8: asVM_OP(asBC_SetV8)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asBC_QWORDARG(l_bc);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_ADDSi:
+	case asBC_ADDSi: asVM_OP(asBC_ADDSi)
 		{
 			// The pointer must not be null
 			asPWORD a = *(asPWORD*)l_sp;
@@ -2960,71 +3110,71 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)l_sp = a + asBC_SWORDARG0(l_bc);
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyVtoV4:
+	case asBC_CpyVtoV4: asVM_OP(asBC_CpyVtoV4)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(l_fp - asBC_SWORDARG1(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyVtoV8:
+	case asBC_CpyVtoV8: asVM_OP(asBC_CpyVtoV8)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyVtoR4:
+	case asBC_CpyVtoR4: asVM_OP(asBC_CpyVtoR4)
 		*(asDWORD*)&m_regs.valueRegister = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyVtoR8:
+	case asBC_CpyVtoR8: asVM_OP(asBC_CpyVtoR8)
 		*(asQWORD*)&m_regs.valueRegister = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyVtoG4:
+	case asBC_CpyVtoG4: asVM_OP(asBC_CpyVtoG4)
 		*(asDWORD*)asBC_PTRARG(l_bc) = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyRtoV4:
+	case asBC_CpyRtoV4: asVM_OP(asBC_CpyRtoV4)
 		*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asDWORD*)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyRtoV8:
+	case asBC_CpyRtoV8: asVM_OP(asBC_CpyRtoV8)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = m_regs.valueRegister;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_CpyGtoV4:
+	case asBC_CpyGtoV4: asVM_OP(asBC_CpyGtoV4)
 		*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asDWORD*)asBC_PTRARG(l_bc);
 		l_bc += 1 + AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_WRTV1:
+	case asBC_WRTV1: asVM_OP(asBC_WRTV1)
 		// The pointer in the register points to a byte, and *(l_fp - offset) too
 		**(asBYTE**)&m_regs.valueRegister = *(asBYTE*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_WRTV2:
+	case asBC_WRTV2: asVM_OP(asBC_WRTV2)
 		// The pointer in the register points to a word, and *(l_fp - offset) too
 		**(asWORD**)&m_regs.valueRegister = *(asWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_WRTV4:
+	case asBC_WRTV4: asVM_OP(asBC_WRTV4)
 		**(asDWORD**)&m_regs.valueRegister = *(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_WRTV8:
+	case asBC_WRTV8: asVM_OP(asBC_WRTV8)
 		**(asQWORD**)&m_regs.valueRegister = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_RDR1:
+	case asBC_RDR1: asVM_OP(asBC_RDR1)
 		{
 			// The pointer in the register points to a byte, and *(l_fp - offset) will also point to a byte
 			asBYTE *bPtr = (asBYTE*)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3034,9 +3184,9 @@ void asCContext::ExecuteNext()
 			bPtr[3] = 0;
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_RDR2:
+	case asBC_RDR2: asVM_OP(asBC_RDR2)
 		{
 			// The pointer in the register points to a word, and *(l_fp - offset) will also point to a word
 			asWORD *wPtr = (asWORD*)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3044,35 +3194,35 @@ void asCContext::ExecuteNext()
 			wPtr[1] = 0;                      // 0 the rest of the DWORD
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_RDR4:
+	case asBC_RDR4: asVM_OP(asBC_RDR4)
 		*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = **(asDWORD**)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_RDR8:
+	case asBC_RDR8: asVM_OP(asBC_RDR8)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = **(asQWORD**)&m_regs.valueRegister;
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_LDG:
+	case asBC_LDG: asVM_OP(asBC_LDG)
 		*(asPWORD*)&m_regs.valueRegister = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_LDV:
+	case asBC_LDV: asVM_OP(asBC_LDV)
 		*(asDWORD**)&m_regs.valueRegister = (l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_PGA:
+	case asBC_PGA: asVM_OP(asBC_PGA)
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_CmpPtr:
+	case asBC_CmpPtr: asVM_OP(asBC_CmpPtr)
 		{
 			// TODO: runtime optimize: This instruction should really just be an equals, and return true or false.
 			//                         The instruction is only used for is and !is tests anyway.
@@ -3083,110 +3233,110 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_VAR:
+	case asBC_VAR: asVM_OP(asBC_VAR)
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = (asPWORD)asBC_SWORDARG0(l_bc);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
 	//----------------------------
 	// Type conversions
-	case asBC_iTOf:
+	case asBC_iTOf: asVM_OP(asBC_iTOf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(int*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_fTOi:
+	case asBC_fTOi: asVM_OP(asBC_fTOi)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(float*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_uTOf:
+	case asBC_uTOf: asVM_OP(asBC_uTOf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_fTOu:
+	case asBC_fTOu: asVM_OP(asBC_fTOu)
 		// We must cast to int first, because on some compilers the cast of a negative float value to uint result in 0
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asUINT(int(*(float*)(l_fp - asBC_SWORDARG0(l_bc))));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_sbTOi:
+	case asBC_sbTOi: asVM_OP(asBC_sbTOi)
 		// *(l_fp - offset) points to a char, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(signed char*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_swTOi:
+	case asBC_swTOi: asVM_OP(asBC_swTOi)
 		// *(l_fp - offset) points to a short, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(short*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_ubTOi:
+	case asBC_ubTOi: asVM_OP(asBC_ubTOi)
 		// (l_fp - offset) points to a byte, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(asBYTE*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_uwTOi:
+	case asBC_uwTOi: asVM_OP(asBC_uwTOi)
 		// *(l_fp - offset) points to a word, and will point to an int afterwards
 		*(l_fp - asBC_SWORDARG0(l_bc)) = *(asWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_dTOi:
+	case asBC_dTOi: asVM_OP(asBC_dTOi)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(double*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_dTOu:
+	case asBC_dTOu: asVM_OP(asBC_dTOu)
 		// We must cast to int first, because on some compilers the cast of a negative float value to uint result in 0
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asUINT(int(*(double*)(l_fp - asBC_SWORDARG1(l_bc))));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_dTOf:
+	case asBC_dTOf: asVM_OP(asBC_dTOf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(double*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_iTOd:
+	case asBC_iTOd: asVM_OP(asBC_iTOd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(int*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_uTOd:
+	case asBC_uTOd: asVM_OP(asBC_uTOd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_fTOd:
+	case asBC_fTOd: asVM_OP(asBC_fTOd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(float*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
 	//------------------------------
 	// Math operations
-	case asBC_ADDi:
+	case asBC_ADDi: asVM_OP(asBC_ADDi)
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) + *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SUBi:
+	case asBC_SUBi: asVM_OP(asBC_SUBi)
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) - *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MULi:
+	case asBC_MULi: asVM_OP(asBC_MULi)
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) * *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_DIVi:
+	case asBC_DIVi: asVM_OP(asBC_DIVi)
 		{
 			int divider = *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3219,9 +3369,9 @@ void asCContext::ExecuteNext()
 			*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MODi:
+	case asBC_MODi: asVM_OP(asBC_MODi)
 		{
 			int divider = *(int*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3254,24 +3404,24 @@ void asCContext::ExecuteNext()
 			*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_ADDf:
+	case asBC_ADDf: asVM_OP(asBC_ADDf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) + *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SUBf:
+	case asBC_SUBf: asVM_OP(asBC_SUBf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) - *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MULf:
+	case asBC_MULf: asVM_OP(asBC_MULf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) * *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_DIVf:
+	case asBC_DIVf: asVM_OP(asBC_DIVf)
 		{
 			float divider = *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3288,9 +3438,9 @@ void asCContext::ExecuteNext()
 			*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MODf:
+	case asBC_MODf: asVM_OP(asBC_MODf)
 		{
 			float divider = *(float*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3307,24 +3457,24 @@ void asCContext::ExecuteNext()
 			*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = fmodf(*(float*)(l_fp - asBC_SWORDARG1(l_bc)), divider);
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_ADDd:
+	case asBC_ADDd: asVM_OP(asBC_ADDd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) + *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SUBd:
+	case asBC_SUBd: asVM_OP(asBC_SUBd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) - *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MULd:
+	case asBC_MULd: asVM_OP(asBC_MULd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) * *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_DIVd:
+	case asBC_DIVd: asVM_OP(asBC_DIVd)
 		{
 			double divider = *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3342,9 +3492,9 @@ void asCContext::ExecuteNext()
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = *(double*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_MODd:
+	case asBC_MODd: asVM_OP(asBC_MODd)
 		{
 			double divider = *(double*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3362,47 +3512,47 @@ void asCContext::ExecuteNext()
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = fmod(*(double*)(l_fp - asBC_SWORDARG1(l_bc)), divider);
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
 	//------------------------------
 	// Math operations with constant value
-	case asBC_ADDIi:
+	case asBC_ADDIi: asVM_OP(asBC_ADDIi)
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) + asBC_INTARG(l_bc+1);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_SUBIi:
+	case asBC_SUBIi: asVM_OP(asBC_SUBIi)
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) - asBC_INTARG(l_bc+1);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_MULIi:
+	case asBC_MULIi: asVM_OP(asBC_MULIi)
 		*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = *(int*)(l_fp - asBC_SWORDARG1(l_bc)) * asBC_INTARG(l_bc+1);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_ADDIf:
+	case asBC_ADDIf: asVM_OP(asBC_ADDIf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) + asBC_FLOATARG(l_bc+1);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_SUBIf:
+	case asBC_SUBIf: asVM_OP(asBC_SUBIf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) - asBC_FLOATARG(l_bc+1);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_MULIf:
+	case asBC_MULIf: asVM_OP(asBC_MULIf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = *(float*)(l_fp - asBC_SWORDARG1(l_bc)) * asBC_FLOATARG(l_bc+1);
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
 	//-----------------------------------
-	case asBC_SetG4:
+	case asBC_SetG4: asVM_OP(asBC_SetG4)
 		*(asDWORD*)asBC_PTRARG(l_bc) = asBC_DWORDARG(l_bc+AS_PTR_SIZE);
 		l_bc += 2 + AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_ChkRefS:
+	case asBC_ChkRefS: asVM_OP(asBC_ChkRefS)
 		{
 			// Verify if the pointer on the stack refers to a non-null value
 			// This is used to validate a reference to a handle
@@ -3418,9 +3568,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_ChkNullV:
+	case asBC_ChkNullV: asVM_OP(asBC_ChkNullV)
 		{
 			// Verify if variable (on the stack) is not null
 			asDWORD *a = *(asDWORD**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3435,9 +3585,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_CALLINTF:
+	case asBC_CALLINTF: asVM_OP(asBC_CALLINTF)
 		{
 			int i = asBC_INTARG(l_bc);
 			l_bc += 2;
@@ -3461,9 +3611,9 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_iTOb:
+	case asBC_iTOb: asVM_OP(asBC_iTOb)
 		{
 			// *(l_fp - offset) points to an int, and will point to a byte afterwards
 
@@ -3477,9 +3627,9 @@ void asCContext::ExecuteNext()
 			bPtr[3] = 0;
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_iTOw:
+	case asBC_iTOw: asVM_OP(asBC_iTOw)
 		{
 			// *(l_fp - offset) points to an int, and will point to word afterwards
 
@@ -3491,9 +3641,9 @@ void asCContext::ExecuteNext()
 			wPtr[1] = 0;           // 0 the rest of the DWORD
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_SetV1:
+	case asBC_SetV1: asVM_OP(asBC_SetV1)
 		// TODO: This is exactly the same as SetV4. This is a left over from the time
 		//       when the bytecode instructions were more tightly packed. It can now
 		//       be removed. When removing it, make sure the value is correctly converted
@@ -3502,9 +3652,9 @@ void asCContext::ExecuteNext()
 		// The byte is already stored correctly in the argument
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SetV2:
+	case asBC_SetV2: asVM_OP(asBC_SetV2)
 		// TODO: This is exactly the same as SetV4. This is a left over from the time
 		//       when the bytecode instructions were more tightly packed. It can now
 		//       be removed. When removing it, make sure the value is correctly converted
@@ -3513,9 +3663,9 @@ void asCContext::ExecuteNext()
 		// The word is already stored correctly in the argument
 		*(l_fp - asBC_SWORDARG0(l_bc)) = asBC_DWORDARG(l_bc);
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_Cast:
+	case asBC_Cast: asVM_OP(asBC_Cast)
 		// Cast the handle at the top of the stack to the type in the argument
 		{
 			asDWORD **a = (asDWORD**)*(asPWORD*)l_sp;
@@ -3547,49 +3697,49 @@ void asCContext::ExecuteNext()
 			l_sp += AS_PTR_SIZE;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_i64TOi:
+	case asBC_i64TOi: asVM_OP(asBC_i64TOi)
 		*(l_fp - asBC_SWORDARG0(l_bc)) = int(*(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_uTOi64:
+	case asBC_uTOi64: asVM_OP(asBC_uTOi64)
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_iTOi64:
+	case asBC_iTOi64: asVM_OP(asBC_iTOi64)
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(int*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_fTOi64:
+	case asBC_fTOi64: asVM_OP(asBC_fTOi64)
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(float*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_dTOi64:
+	case asBC_dTOi64: asVM_OP(asBC_dTOi64)
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = asINT64(*(double*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_fTOu64:
+	case asBC_fTOu64: asVM_OP(asBC_fTOu64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asQWORD(asINT64(*(float*)(l_fp - asBC_SWORDARG1(l_bc))));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_dTOu64:
+	case asBC_dTOu64: asVM_OP(asBC_dTOu64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = asQWORD(asINT64(*(double*)(l_fp - asBC_SWORDARG0(l_bc))));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_i64TOf:
+	case asBC_i64TOf: asVM_OP(asBC_i64TOf)
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_u64TOf:
+	case asBC_u64TOf: asVM_OP(asBC_u64TOf)
 #if defined(_MSC_VER) && _MSC_VER <= 1200 // MSVC6
 		{
 			// MSVC6 doesn't permit UINT64 to double
@@ -3603,14 +3753,14 @@ void asCContext::ExecuteNext()
 		*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = float(*(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)));
 #endif
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_i64TOd:
+	case asBC_i64TOd: asVM_OP(asBC_i64TOd)
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_u64TOd:
+	case asBC_u64TOd: asVM_OP(asBC_u64TOd)
 #if defined(_MSC_VER) && _MSC_VER <= 1200 // MSVC6
 		{
 			// MSVC6 doesn't permit UINT64 to double
@@ -3624,44 +3774,44 @@ void asCContext::ExecuteNext()
 		*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = double(*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)));
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_NEGi64:
+	case asBC_NEGi64: asVM_OP(asBC_NEGi64)
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = -*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_INCi64:
+	case asBC_INCi64: asVM_OP(asBC_INCi64)
 		++(**(asQWORD**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_DECi64:
+	case asBC_DECi64: asVM_OP(asBC_DECi64)
 		--(**(asQWORD**)&m_regs.valueRegister);
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_BNOT64:
+	case asBC_BNOT64: asVM_OP(asBC_BNOT64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = ~*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_ADDi64:
+	case asBC_ADDi64: asVM_OP(asBC_ADDi64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) + *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SUBi64:
+	case asBC_SUBi64: asVM_OP(asBC_SUBi64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) - *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MULi64:
+	case asBC_MULi64: asVM_OP(asBC_MULi64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) * *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_DIVi64:
+	case asBC_DIVi64: asVM_OP(asBC_DIVi64)
 		{
 			asINT64 divider = *(asINT64*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3695,9 +3845,9 @@ void asCContext::ExecuteNext()
 			*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MODi64:
+	case asBC_MODi64: asVM_OP(asBC_MODi64)
 		{
 			asINT64 divider = *(asINT64*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3730,39 +3880,39 @@ void asCContext::ExecuteNext()
 			*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_BAND64:
+	case asBC_BAND64: asVM_OP(asBC_BAND64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) & *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_BOR64:
+	case asBC_BOR64: asVM_OP(asBC_BOR64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) | *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_BXOR64:
+	case asBC_BXOR64: asVM_OP(asBC_BXOR64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) ^ *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_BSLL64:
+	case asBC_BSLL64: asVM_OP(asBC_BSLL64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) << *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_BSRL64:
+	case asBC_BSRL64: asVM_OP(asBC_BSRL64)
 		*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_BSRA64:
+	case asBC_BSRA64: asVM_OP(asBC_BSRA64)
 		*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)) >> *(l_fp - asBC_SWORDARG2(l_bc));
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_CMPi64:
+	case asBC_CMPi64: asVM_OP(asBC_CMPi64)
 		{
 			asINT64 i1 = *(asINT64*)(l_fp - asBC_SWORDARG0(l_bc));
 			asINT64 i2 = *(asINT64*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -3771,9 +3921,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CMPu64:
+	case asBC_CMPu64: asVM_OP(asBC_CMPu64)
 		{
 			asQWORD d1 = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 			asQWORD d2 = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc));
@@ -3782,9 +3932,9 @@ void asCContext::ExecuteNext()
 			else               *(int*)&m_regs.valueRegister =  1;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_ChkNullS:
+	case asBC_ChkNullS: asVM_OP(asBC_ChkNullS)
 		{
 			// Verify if the pointer on the stack is null
 			// This is used for example when validating handles passed as function arguments
@@ -3800,9 +3950,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_ClrHi:
+	case asBC_ClrHi: asVM_OP(asBC_ClrHi)
 #if AS_SIZEOF_BOOL == 1
 		{
 			// Clear the upper bytes, so that trash data don't interfere with boolean operations
@@ -3819,9 +3969,9 @@ void asCContext::ExecuteNext()
 		// We don't have anything to do here
 #endif
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_JitEntry:
+	case asBC_JitEntry: asVM_OP(asBC_JitEntry)
 		{
 			if( m_currentFunction->scriptData->jitFunction )
 			{
@@ -3844,16 +3994,16 @@ void asCContext::ExecuteNext()
 					if( m_status != asEXECUTION_ACTIVE )
 						return;
 
-					break;
+					asVM_NEXT;
 				}
 			}
 
 			// Not a JIT resume point, treat as nop
 			l_bc += 1+AS_PTR_SIZE;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_CallPtr:
+	case asBC_CallPtr: asVM_OP(asBC_CallPtr)
 		{
 			// Get the function pointer from the local variable
 			asCScriptFunction *func = *(asCScriptFunction**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -3928,16 +4078,16 @@ void asCContext::ExecuteNext()
 			if( m_status != asEXECUTION_ACTIVE )
 				return;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_FuncPtr:
+	case asBC_FuncPtr: asVM_OP(asBC_FuncPtr)
 		// Push the function pointer on the stack. The pointer is in the argument
 		l_sp -= AS_PTR_SIZE;
 		*(asPWORD*)l_sp = asBC_PTRARG(l_bc);
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_LoadThisR:
+	case asBC_LoadThisR: asVM_OP(asBC_LoadThisR)
 		{
 			// PshVPtr 0
 			asPWORD tmp = *(asPWORD*)l_fp;
@@ -3962,16 +4112,16 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)&m_regs.valueRegister = tmp;
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
 	// Push the qword value of a variable on the stack
-	case asBC_PshV8:
+	case asBC_PshV8: asVM_OP(asBC_PshV8)
 		l_sp -= 2;
 		*(asQWORD*)l_sp = *(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc));
 		l_bc++;
-		break;
+		asVM_NEXT;
 
-	case asBC_DIVu:
+	case asBC_DIVu: asVM_OP(asBC_DIVu)
 		{
 			asUINT divider = *(asUINT*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -3988,9 +4138,9 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MODu:
+	case asBC_MODu: asVM_OP(asBC_MODu)
 		{
 			asUINT divider = *(asUINT*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -4007,9 +4157,9 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asUINT*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_DIVu64:
+	case asBC_DIVu64: asVM_OP(asBC_DIVu64)
 		{
 			asQWORD divider = *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -4026,9 +4176,9 @@ void asCContext::ExecuteNext()
 			*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) / divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_MODu64:
+	case asBC_MODu64: asVM_OP(asBC_MODu64)
 		{
 			asQWORD divider = *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc));
 			if( divider == 0 )
@@ -4045,9 +4195,9 @@ void asCContext::ExecuteNext()
 			*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)) % divider;
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_LoadRObjR:
+	case asBC_LoadRObjR: asVM_OP(asBC_LoadRObjR)
 		{
 			// PshVPtr x
 			asPWORD tmp = *(asPWORD*)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4072,9 +4222,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)&m_regs.valueRegister = tmp;
 			l_bc += 3;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_LoadVObjR:
+	case asBC_LoadVObjR: asVM_OP(asBC_LoadVObjR)
 		{
 			// PSF x
 			asPWORD tmp = (asPWORD)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4086,9 +4236,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)&m_regs.valueRegister = tmp;
 			l_bc += 3;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_RefCpyV:
+	case asBC_RefCpyV: asVM_OP(asBC_RefCpyV)
 		// Same as PSF v, REFCPY
 		{
 			asCObjectType *objType = (asCObjectType*)asBC_PTRARG(l_bc);
@@ -4120,23 +4270,23 @@ void asCContext::ExecuteNext()
 			*d = s;
 		}
 		l_bc += 1+AS_PTR_SIZE;
-		break;
+		asVM_NEXT;
 
-	case asBC_JLowZ:
+	case asBC_JLowZ: asVM_OP(asBC_JLowZ)
 		if( *(asBYTE*)&m_regs.valueRegister == 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_JLowNZ:
+	case asBC_JLowNZ: asVM_OP(asBC_JLowNZ)
 		if( *(asBYTE*)&m_regs.valueRegister != 0 )
 			l_bc += asBC_INTARG(l_bc) + 2;
 		else
 			l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_AllocMem:
+	case asBC_AllocMem: asVM_OP(asBC_AllocMem)
 		// Allocate a buffer and store the pointer in the local variable
 		{
 			// TODO: runtime optimize: As the list buffers are going to be short lived, it may be interesting
@@ -4154,9 +4304,9 @@ void asCContext::ExecuteNext()
 			memset(*var, 0, size);
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SetListSize:
+	case asBC_SetListSize: asVM_OP(asBC_SetListSize)
 		{
 			// Set the size element in the buffer
 			asBYTE *var = *(asBYTE**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4168,9 +4318,9 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(var+off) = size;
 		}
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
-	case asBC_PshListElmnt:
+	case asBC_PshListElmnt: asVM_OP(asBC_PshListElmnt)
 		{
 			// Push the pointer to the list element on the stack
 			// In essence it does the same as PSF, RDSPtr, ADDSi
@@ -4183,9 +4333,9 @@ void asCContext::ExecuteNext()
 			*(asPWORD*)l_sp = asPWORD(var+off);
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_SetListType:
+	case asBC_SetListType: asVM_OP(asBC_SetListType)
 		{
 			// Set the type id in the buffer
 			asBYTE *var = *(asBYTE**)(l_fp - asBC_SWORDARG0(l_bc));
@@ -4197,11 +4347,11 @@ void asCContext::ExecuteNext()
 			*(asUINT*)(var+off) = type;
 		}
 		l_bc += 3;
-		break;
+		asVM_NEXT;
 
 	//------------------------------
 	// Exponent operations
-	case asBC_POWi:
+	case asBC_POWi: asVM_OP(asBC_POWi)
 		{
 			bool isOverflow;
 			*(int*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powi(*(int*)(l_fp - asBC_SWORDARG1(l_bc)), *(int*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4218,9 +4368,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_POWu:
+	case asBC_POWu: asVM_OP(asBC_POWu)
 		{
 			bool isOverflow;
 			*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powu(*(asDWORD*)(l_fp - asBC_SWORDARG1(l_bc)), *(asDWORD*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4237,9 +4387,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_POWf:
+	case asBC_POWf: asVM_OP(asBC_POWf)
 		{
 			float r = powf(*(float*)(l_fp - asBC_SWORDARG1(l_bc)), *(float*)(l_fp - asBC_SWORDARG2(l_bc)));
 			*(float*)(l_fp - asBC_SWORDARG0(l_bc)) = r;
@@ -4256,9 +4406,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_POWd:
+	case asBC_POWd: asVM_OP(asBC_POWd)
 		{
 			double r = pow(*(double*)(l_fp - asBC_SWORDARG1(l_bc)), *(double*)(l_fp - asBC_SWORDARG2(l_bc)));
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = r;
@@ -4275,9 +4425,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_POWdi:
+	case asBC_POWdi: asVM_OP(asBC_POWdi)
 		{
 			double r = pow(*(double*)(l_fp - asBC_SWORDARG1(l_bc)), *(int*)(l_fp - asBC_SWORDARG2(l_bc)));
 			*(double*)(l_fp - asBC_SWORDARG0(l_bc)) = r;
@@ -4294,9 +4444,9 @@ void asCContext::ExecuteNext()
 			}
 			l_bc += 2;
 		}
-		break;
+		asVM_NEXT;
 
-	case asBC_POWi64:
+	case asBC_POWi64: asVM_OP(asBC_POWi64)
 		{
 			bool isOverflow;
 			*(asINT64*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powi64(*(asINT64*)(l_fp - asBC_SWORDARG1(l_bc)), *(asINT64*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4313,9 +4463,9 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
+		asVM_NEXT;
 
-	case asBC_POWu64:
+	case asBC_POWu64: asVM_OP(asBC_POWu64)
 		{
 			bool isOverflow;
 			*(asQWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = as_powu64(*(asQWORD*)(l_fp - asBC_SWORDARG1(l_bc)), *(asQWORD*)(l_fp - asBC_SWORDARG2(l_bc)), isOverflow);
@@ -4332,8 +4482,8 @@ void asCContext::ExecuteNext()
 			}
 		}
 		l_bc += 2;
-		break;
-	case asBC_Thiscall1:
+		asVM_NEXT;
+	case asBC_Thiscall1: asVM_OP(asBC_Thiscall1)
 		// This instruction is a faster version of asBC_CALLSYS. It is faster because
 		// it has much less runtime overhead with determining the calling convention 
 		// and no dynamic code for loading the parameters. The instruction can only
@@ -4400,18 +4550,156 @@ void asCContext::ExecuteNext()
 				}
 			}
 		}
-		break;
+		asVM_NEXT;
+
+	// Compare an int variable with a constant, then jump to a
+	// relative position depending on the result. The result of
+	// the comparison is also stored in the value register, just
+	// as the separate CMPIi instruction would have done
+	case asBC_CMPIiJZ: asVM_OP(asBC_CMPIiJZ)
+		{
+			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
+			int i2 = asBC_INTARG(l_bc);
+			if( i1 == i2 )     *(int*)&m_regs.valueRegister =  0;
+			else if( i1 < i2 ) *(int*)&m_regs.valueRegister = -1;
+			else               *(int*)&m_regs.valueRegister =  1;
+			if( i1 == i2 )
+				l_bc += *(int*)(l_bc+2) + 3;
+			else
+				l_bc += 3;
+		}
+		asVM_NEXT;
+
+	case asBC_CMPIiJNZ: asVM_OP(asBC_CMPIiJNZ)
+		{
+			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
+			int i2 = asBC_INTARG(l_bc);
+			if( i1 == i2 )     *(int*)&m_regs.valueRegister =  0;
+			else if( i1 < i2 ) *(int*)&m_regs.valueRegister = -1;
+			else               *(int*)&m_regs.valueRegister =  1;
+			if( i1 != i2 )
+				l_bc += *(int*)(l_bc+2) + 3;
+			else
+				l_bc += 3;
+		}
+		asVM_NEXT;
+
+	case asBC_CMPIiJS: asVM_OP(asBC_CMPIiJS)
+		{
+			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
+			int i2 = asBC_INTARG(l_bc);
+			if( i1 == i2 )     *(int*)&m_regs.valueRegister =  0;
+			else if( i1 < i2 ) *(int*)&m_regs.valueRegister = -1;
+			else               *(int*)&m_regs.valueRegister =  1;
+			if( i1 < i2 )
+				l_bc += *(int*)(l_bc+2) + 3;
+			else
+				l_bc += 3;
+		}
+		asVM_NEXT;
+
+	case asBC_CMPIiJNS: asVM_OP(asBC_CMPIiJNS)
+		{
+			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
+			int i2 = asBC_INTARG(l_bc);
+			if( i1 == i2 )     *(int*)&m_regs.valueRegister =  0;
+			else if( i1 < i2 ) *(int*)&m_regs.valueRegister = -1;
+			else               *(int*)&m_regs.valueRegister =  1;
+			if( i1 >= i2 )
+				l_bc += *(int*)(l_bc+2) + 3;
+			else
+				l_bc += 3;
+		}
+		asVM_NEXT;
+
+	case asBC_CMPIiJP: asVM_OP(asBC_CMPIiJP)
+		{
+			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
+			int i2 = asBC_INTARG(l_bc);
+			if( i1 == i2 )     *(int*)&m_regs.valueRegister =  0;
+			else if( i1 < i2 ) *(int*)&m_regs.valueRegister = -1;
+			else               *(int*)&m_regs.valueRegister =  1;
+			if( i1 > i2 )
+				l_bc += *(int*)(l_bc+2) + 3;
+			else
+				l_bc += 3;
+		}
+		asVM_NEXT;
+
+	case asBC_CMPIiJNP: asVM_OP(asBC_CMPIiJNP)
+		{
+			int i1 = *(int*)(l_fp - asBC_SWORDARG0(l_bc));
+			int i2 = asBC_INTARG(l_bc);
+			if( i1 == i2 )     *(int*)&m_regs.valueRegister =  0;
+			else if( i1 < i2 ) *(int*)&m_regs.valueRegister = -1;
+			else               *(int*)&m_regs.valueRegister =  1;
+			if( i1 <= i2 )
+				l_bc += *(int*)(l_bc+2) + 3;
+			else
+				l_bc += 3;
+		}
+		asVM_NEXT;
+
+	case asBC_CpyThisToV4: asVM_OP(asBC_CpyThisToV4)
+		{
+			// LoadThisR y
+			asBYTE *obj = *(asBYTE**)l_fp;
+
+			// Make sure the pointer is not null
+			if( obj == 0 )
+			{
+				// Need to move the values back to the context
+				m_regs.programPointer    = l_bc;
+				m_regs.stackPointer      = l_sp;
+				m_regs.stackFramePointer = l_fp;
+
+				// Raise exception
+				SetInternalException(TXT_NULL_POINTER_ACCESS);
+				return;
+			}
+
+			// RDR4 x
+			*(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc)) = *(asDWORD*)(obj + asBC_SWORDARG1(l_bc));
+			l_bc += 3;
+		}
+		asVM_NEXT;
+
+	case asBC_CpyVtoThis4: asVM_OP(asBC_CpyVtoThis4)
+		{
+			// LoadThisR y
+			asBYTE *obj = *(asBYTE**)l_fp;
+
+			// Make sure the pointer is not null
+			if( obj == 0 )
+			{
+				// Need to move the values back to the context
+				m_regs.programPointer    = l_bc;
+				m_regs.stackPointer      = l_sp;
+				m_regs.stackFramePointer = l_fp;
+
+				// Raise exception
+				SetInternalException(TXT_NULL_POINTER_ACCESS);
+				return;
+			}
+
+			// WRTV4 x
+			*(asDWORD*)(obj + asBC_SWORDARG1(l_bc)) = *(asDWORD*)(l_fp - asBC_SWORDARG0(l_bc));
+			l_bc += 3;
+		}
+		asVM_NEXT;
 
+#ifdef AS_USE_COMPUTED_GOTO
+	// All the unused byte codes lead to the same handler in the dispatch table
+	default: asVM_OP(invalid)
+		m_regs.programPointer    = l_bc;
+		m_regs.stackPointer      = l_sp;
+		m_regs.stackFramePointer = l_fp;
+
+		SetInternalException(TXT_UNRECOGNIZED_BYTE_CODE);
+		return;
+#else
 	// Don't let the optimizer optimize for size,
 	// since it requires extra conditions and jumps
-	case 201: l_bc = (asDWORD*)201; break;
-	case 202: l_bc = (asDWORD*)202; break;
-	case 203: l_bc = (asDWORD*)203; break;
-	case 204: l_bc = (asDWORD*)204; break;
-	case 205: l_bc = (asDWORD*)205; break;
-	case 206: l_bc = (asDWORD*)206; break;
-	case 207: l_bc = (asDWORD*)207; break;
-	case 208: l_bc = (asDWORD*)208; break;
 	case 209: l_bc = (asDWORD*)209; break;
 	case 210: l_bc = (asDWORD*)210; break;
 	case 211: l_bc = (asDWORD*)211; break;
@@ -4459,8 +4747,9 @@ void asCContext::ExecuteNext()
 	case 253: l_bc = (asDWORD*)253; break;
 	case 254: l_bc = (asDWORD*)254; break;
 	case 255: l_bc = (asDWORD*)255; break;
+#endif
 
-#ifdef AS_DEBUG
+#if defined(AS_DEBUG) && !defined(AS_USE_COMPUTED_GOTO)
 	default:
 		asASSERT(false);
 		SetInternalException(TXT_UNRECOGNIZED_BYTE_CODE);
@@ -4479,7 +4768,7 @@ void asCContext::ExecuteNext()
 		asDWORD instr = *(asBYTE*)old;
 		if( instr != asBC_JMP && instr != asBC_JMPP && (instr < asBC_JZ || instr > asBC_JNP) && instr != asBC_JLowZ && instr != asBC_JLowNZ &&
 			instr != asBC_CALL && instr != asBC_CALLBND && instr != asBC_CALLINTF && instr != asBC_RET && instr != asBC_ALLOC && instr != asBC_CallPtr &&
-			instr != asBC_JitEntry )
+			instr != asBC_JitEntry && (instr < asBC_CMPIiJZ || instr > asBC_CMPIiJNP) )
 		{
 			asASSERT( (l_bc - old) == asBCTypeSize[asBCInfo[instr].type] );
 		}
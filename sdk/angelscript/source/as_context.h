@@ -155,6 +155,8 @@ public:
 	void CallScriptFunction(asCScriptFunction *func);
 	void CallInterfaceMethod(asCScriptFunction *func);
 	void PrepareScriptFunction();
+	void ProfileFunctionEntry();
+	void ProfileFunctionExit();
 
 	bool ReserveStackSpace(asUINT size);
 
@@ -209,6 +211,17 @@ public:
 
 	asCArray<asPWORD> m_userData;
 
+	// The start time of the script functions in the call stack, recorded when asEP_PROFILE_FUNCTIONS is turned on.
+	// The depth is the length of the call stack when the function was entered, so entries of functions that
+	// were exited by an exception can be recognized and discarded
+	struct SProfileEntry
+	{
+		asCScriptFunction *func;
+		asUINT             depth;
+		asQWORD            start;
+	};
+	asCArray<SProfileEntry> m_profileStack;
+
 	// Registers available to JIT compiler functions
 	asSVMRegisters m_regs;
 };
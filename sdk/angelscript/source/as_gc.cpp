@@ -41,6 +41,7 @@
 #include "as_gc.h"
 #include "as_scriptengine.h"
 #include "as_scriptobject.h"
+#include "as_context.h"
 #include "as_texts.h"
 
 BEGIN_AS_NAMESPACE
@@ -56,10 +57,34 @@ asCGarbageCollector::asCGarbageCollector()
 	numDetected     = 0;
 	numAdded        = 0;
 	isProcessing    = false;
-
-	seqAtSweepStart[0] = 0;
-	seqAtSweepStart[1] = 0;
-	seqAtSweepStart[2] = 0;
+	gcMapCount      = 0;
+	gcMapCursor     = 0;
+	backgroundThread = 0;
+	runningThreads   = 0;
+	pausedThreads    = 0;
+
+	numTenured            = 0;
+	numNewSweeps          = 0;
+	numOldSearches        = 0;
+	numTenuredSearches    = 0;
+	numOldSweeps          = 0;
+	numOldDestroyed       = 0;
+	numTenuredDestroyed   = 0;
+	numNewPromoted        = 0;
+	numOldPromoted        = 0;
+	addedAtLastSearch     = 0;
+	tenuredAtLastSearch   = 0;
+	searchTenured         = true;
+	sweepTenured          = true;
+	tenuredGarbageFound   = false;
+	includeAllGenerations = false;
+
+	for( asUINT n = 0; n < asGC_PHASE_LAST; n++ )
+	{
+		phaseTicks[n]    = 0;
+		phaseMaxTicks[n] = 0;
+		phaseSteps[n]    = 0;
+	}
 
 	circularRefDetectCallbackFunc  = 0;
 	circularRefDetectCallbackParam = 0;
@@ -67,12 +92,6 @@ asCGarbageCollector::asCGarbageCollector()
 
 asCGarbageCollector::~asCGarbageCollector()
 {
-	// This local typedef is done to workaround a compiler error on
-	// MSVC6 when using the typedef declared in the class definition
-	typedef asSMapNode_t node_t;
-	for( asUINT n = 0; n < freeNodes.GetLength(); n++ )
-		asDELETE(freeNodes[n], node_t);
-	freeNodes.SetLength(0);
 }
 
 int asCGarbageCollector::AddScriptObjectToGC(void *obj, asCObjectType *objType)
@@ -84,7 +103,7 @@ int asCGarbageCollector::AddScriptObjectToGC(void *obj, asCObjectType *objType)
 	}
 
 	engine->CallObjectMethod(obj, objType->beh.addref);
-	asSObjTypePair ot = {obj, objType, 0};
+	asSObjTypePair ot = {obj, objType, 0, 0};
 
 	// Invoke the garbage collector to destroy a little garbage as new comes in
 	// This will maintain the number of objects in the GC at a maintainable level without
@@ -106,7 +125,8 @@ int asCGarbageCollector::AddScriptObjectToGC(void *obj, asCObjectType *objType)
 				// Run one step of DetectGarbage
 				if( gcOldObjects.GetLength() )
 				{
-					IdentifyGarbageWithCyclicRefs();
+					if( !IsDetectionLeftForBackground() )
+						IdentifyGarbageWithCyclicRefs();
 					DestroyOldGarbage();
 				}
 
@@ -127,6 +147,7 @@ int asCGarbageCollector::AddScriptObjectToGC(void *obj, asCObjectType *objType)
 	// another thread might be calling this method at the same time
 	ENTERCRITICALSECTION(gcCritical);
 	ot.seqNbr = numAdded++;
+	ot.entryPass = numNewSweeps;
 	gcNewObjects.PushLast(ot);
 	LEAVECRITICALSECTION(gcCritical);
 
@@ -198,6 +219,9 @@ int asCGarbageCollector::GarbageCollect(asDWORD flags, asUINT iterations)
 				destroyOldState = destroyGarbage_init;
 			}
 
+			// The full cycle searches and sweeps the tenured objects too
+			includeAllGenerations = true;
+
 			// The full cycle only works with the objects in the old list so that the
 			// set of objects scanned for garbage is fixed even if new objects are added
 			// by other threads in parallel.
@@ -223,10 +247,19 @@ int asCGarbageCollector::GarbageCollect(asDWORD flags, asUINT iterations)
 					break;
 			}
 
+			includeAllGenerations = false;
 			isProcessing = false;
 			LEAVECRITICALSECTION(gcCollecting);
 			return 0;
 		}
+		else if( flags & asGC_TIME_BUDGET )
+		{
+			int r = CollectWithinBudget(doDetect, doDestroy, iterations);
+
+			isProcessing = false;
+			LEAVECRITICALSECTION(gcCollecting);
+			return r;
+		}
 		else
 		{
 			while( iterations-- > 0 )
@@ -239,7 +272,7 @@ int asCGarbageCollector::GarbageCollect(asDWORD flags, asUINT iterations)
 				}
 
 				// Run another incremental step of the identification of cyclic references
-				if( doDetect && gcOldObjects.GetLength() > 0 )
+				if( doDetect && gcOldObjects.GetLength() > 0 && !IsDetectionLeftForBackground() )
 					IdentifyGarbageWithCyclicRefs();
 			}
 		}
@@ -289,6 +322,136 @@ void asCGarbageCollector::GetStatistics(asUINT *currentSize, asUINT *totalDestro
 		*totalNewDestroyed = numNewDestroyed;
 }
 
+int asCGarbageCollector::GetGenerationStatistics(asUINT generation, asUINT *currentSize, asUINT *totalDestroyed, asUINT *totalPromoted, asUINT *totalScans) const
+{
+	// As with GetStatistics the values are not protected by the critical sections
+	asUINT size, destroyed, promoted, scans;
+	switch( generation )
+	{
+	case 0:
+		size      = (asUINT)gcNewObjects.GetLength();
+		destroyed = numNewDestroyed;
+		promoted  = numNewPromoted;
+		scans     = numNewSweeps;
+		break;
+	case 1:
+		size      = (asUINT)gcOldObjects.GetLength() - numTenured;
+		destroyed = numOldDestroyed;
+		promoted  = numOldPromoted;
+		scans     = numOldSearches;
+		break;
+	case 2:
+		size      = numTenured;
+		destroyed = numTenuredDestroyed;
+		promoted  = 0;
+		scans     = numTenuredSearches;
+		break;
+	default:
+		return asINVALID_ARG;
+	}
+
+	if( currentSize )    *currentSize    = size;
+	if( totalDestroyed ) *totalDestroyed = destroyed;
+	if( totalPromoted )  *totalPromoted  = promoted;
+	if( totalScans )     *totalScans     = scans;
+
+	return asSUCCESS;
+}
+
+int asCGarbageCollector::GetPhaseStatistics(asEGCPhase phase, double *totalTime, double *maxStepTime, asQWORD *totalSteps) const
+{
+	if( asUINT(phase) >= asGC_PHASE_LAST )
+		return asINVALID_ARG;
+
+	// As with GetStatistics the values are not protected by the critical sections
+	double freq = double(asGetTimerFrequency());
+	if( totalTime )   *totalTime   = double(phaseTicks[phase]) / freq;
+	if( maxStepTime ) *maxStepTime = double(phaseMaxTicks[phase]) / freq;
+	if( totalSteps )  *totalSteps  = phaseSteps[phase];
+
+	return asSUCCESS;
+}
+
+int asCGarbageCollector::CollectWithinBudget(bool doDetect, bool doDestroy, asUINT microseconds)
+{
+	// This function will only be called within the critical section gcCollecting
+	asASSERT(isProcessing);
+
+	// The timer is read once after each step, both to measure the time of 
+	// the step and to stop as soon as possible after the budget is spent
+	asQWORD ticks = asGetTimerTicks();
+	asQWORD end   = ticks + asQWORD(microseconds) * asGetTimerFrequency() / 1000000;
+	for(;;)
+	{
+		int haveMore = 0;
+
+		// Destroy the garbage that we know of
+		if( doDestroy )
+		{
+			// The new objects that survive are moved to the old list after a few sweeps,
+			// so the work isn't completed until they have been searched for circular references
+			haveMore |= TimedStep(asGC_PHASE_DESTROY_NEW, &asCGarbageCollector::DestroyNewGarbage, &ticks);
+			haveMore |= gcNewObjects.GetLength() > 0 ? 1 : 0;
+			if( ticks >= end ) return 1;
+
+			haveMore |= TimedStep(asGC_PHASE_DESTROY_OLD, &asCGarbageCollector::DestroyOldGarbage, &ticks);
+			if( ticks >= end ) return 1;
+		}
+
+		// Run another incremental step of the identification of cyclic references
+		if( doDetect && gcOldObjects.GetLength() > 0 && !IsDetectionLeftForBackground() )
+		{
+			haveMore |= TimedStep(GetDetectPhase(), &asCGarbageCollector::IdentifyGarbageWithCyclicRefs, &ticks);
+			if( ticks >= end ) return 1;
+		}
+
+		// Return 0 to tell the application that the work was completed within the budget
+		if( !haveMore )
+			return 0;
+	}
+}
+
+int asCGarbageCollector::TimedStep(asEGCPhase phase, int (asCGarbageCollector::*step)(), asQWORD *ticks)
+{
+	int r = (this->*step)();
+
+	asQWORD now = asGetTimerTicks();
+	asQWORD elapsed = now - *ticks;
+	*ticks = now;
+
+	phaseTicks[phase] += elapsed;
+	if( elapsed > phaseMaxTicks[phase] )
+		phaseMaxTicks[phase] = elapsed;
+	phaseSteps[phase]++;
+
+	return r;
+}
+
+asEGCPhase asCGarbageCollector::GetDetectPhase() const
+{
+	switch( detectState )
+	{
+	case clearCounters_init:
+	case clearCounters_loop:
+		return asGC_PHASE_CLEAR_COUNTERS;
+	case buildMap_init:
+	case buildMap_loop:
+		return asGC_PHASE_BUILD_MAP;
+	case countReferences_init:
+	case countReferences_loop:
+		return asGC_PHASE_COUNT_REFERENCES;
+	case detectGarbage_init:
+	case detectGarbage_loop1:
+	case detectGarbage_loop2:
+		return asGC_PHASE_DETECT_GARBAGE;
+	case verifyUnmarked_init:
+	case verifyUnmarked_loop:
+		return asGC_PHASE_VERIFY_UNMARKED;
+	default:
+		return asGC_PHASE_BREAK_CIRCLES;
+	}
+}
+
 asCGarbageCollector::asSObjTypePair asCGarbageCollector::GetNewObjectAtIdx(int idx)
 {
 	// We need to protect this access with a critical section as
@@ -328,6 +491,14 @@ void asCGarbageCollector::RemoveOldObjectAtIdx(int idx)
 	// We need to protect this update with a critical section as
 	// another thread might be appending an object at the same time
 	ENTERCRITICALSECTION(gcCritical);
+	if( asUINT(idx) < numTenured )
+	{
+		// Keep the tenured objects at the start of the array by filling 
+		// the hole with the last tenured object, and that with the last object
+		numTenured--;
+		gcOldObjects[idx] = gcOldObjects[numTenured];
+		idx = (int)numTenured;
+	}
 	if( idx == (int)gcOldObjects.GetLength() - 1)
 		gcOldObjects.PopLast();
 	else
@@ -340,7 +511,9 @@ void asCGarbageCollector::MoveObjectToOldList(int idx)
 	// We need to protect this update with a critical section as
 	// another thread might be appending an object at the same time
 	ENTERCRITICALSECTION(gcCritical);
+	gcNewObjects[idx].entryPass = numOldSearches;
 	gcOldObjects.PushLast(gcNewObjects[idx]);
+	numNewPromoted++;
 	if( idx == (int)gcNewObjects.GetLength() - 1)
 		gcNewObjects.PopLast();
 	else
@@ -353,8 +526,26 @@ void asCGarbageCollector::MoveAllObjectsToOldList()
 	// We need to protect this update with a critical section as
 	// another thread might be appending an object at the same time
 	ENTERCRITICALSECTION(gcCritical);
+	for( asUINT n = 0; n < gcNewObjects.GetLength(); n++ )
+		gcNewObjects[n].entryPass = numOldSearches;
 	if( gcOldObjects.Concatenate(gcNewObjects) )
+	{
+		numNewPromoted += gcNewObjects.GetLength();
 		gcNewObjects.SetLength(0);
+	}
+	LEAVECRITICALSECTION(gcCritical);
+}
+
+void asCGarbageCollector::MoveObjectToTenuredList(int idx)
+{
+	// We need to protect this update with a critical section as
+	// another thread might be reading the objects at the same time
+	ENTERCRITICALSECTION(gcCritical);
+	asASSERT( asUINT(idx) >= numTenured );
+	asSObjTypePair gcObj = gcOldObjects[idx];
+	gcOldObjects[idx] = gcOldObjects[numTenured];
+	gcOldObjects[numTenured++] = gcObj;
+	numOldPromoted++;
 	LEAVECRITICALSECTION(gcCritical);
 }
 
@@ -373,11 +564,9 @@ int asCGarbageCollector::DestroyNewGarbage()
 			if( gcNewObjects.GetLength() == 0 )
 				return 0;
 
-			// Update the seqAtSweepStart which is used to determine when 
-			// to move an object from the new set to the old set
-			seqAtSweepStart[0] = seqAtSweepStart[1];
-			seqAtSweepStart[1] = seqAtSweepStart[2];
-			seqAtSweepStart[2] = numAdded;
+			// The number of sweeps is used to determine when to
+			// move an object from the new set to the old set
+			numNewSweeps++;
 
 			destroyNewIdx = (asUINT)-1;
 			destroyNewState = destroyGarbage_loop;
@@ -430,10 +619,9 @@ int asCGarbageCollector::DestroyNewGarbage()
 
 					destroyNewState = destroyGarbage_haveMore;
 				}
-				// Check if this object has been inspected 3 times already, and if so move it to the 
-				// set of old objects that are less likely to become garbage in a short time
-				// TODO: Is 3 really a good value? Should the number of times be dynamic? 
-				else if( gcObj.seqNbr < seqAtSweepStart[0] )
+				// Check if this object has been inspected enough times already, and if so move it to 
+				// the set of old objects that are less likely to become garbage in a short time
+				else if( numNewSweeps - gcObj.entryPass >= engine->ep.gcPromotionAge )
 				{
 					// We've already verified this object multiple times. It is likely
 					// to live for quite a long time so we'll move it to the list if old objects
@@ -526,7 +714,14 @@ int asCGarbageCollector::DestroyOldGarbage()
 			if( gcOldObjects.GetLength() == 0 )
 				return 0;
 
-			destroyOldIdx = (asUINT)-1;
+			// The tenured objects are only swept every few times, unless the
+			// previous search for circular references found garbage among them
+			numOldSweeps++;
+			sweepTenured = includeAllGenerations || tenuredGarbageFound ||
+			               (numOldSweeps % engine->ep.gcTenuredScanInterval) == 0;
+			tenuredGarbageFound = false;
+
+			destroyOldIdx = (sweepTenured ? 0 : numTenured) - 1;
 			destroyOldState = destroyGarbage_loop;
 		}
 		break;
@@ -558,6 +753,7 @@ int asCGarbageCollector::DestroyOldGarbage()
 
 					// Just remove the object, as we will not bother to destroy it
 					numDestroyed++;
+					if( destroyOldIdx < numTenured ) numTenuredDestroyed++; else numOldDestroyed++;
 					RemoveOldObjectAtIdx(destroyOldIdx);
 					destroyOldIdx--;
 				}
@@ -581,6 +777,7 @@ int asCGarbageCollector::DestroyOldGarbage()
 					if( !addRef )
 					{
 						numDestroyed++;
+						if( destroyOldIdx < numTenured ) numTenuredDestroyed++; else numOldDestroyed++;
 						RemoveOldObjectAtIdx(destroyOldIdx);
 						destroyOldIdx--;
 					}
@@ -593,6 +790,14 @@ int asCGarbageCollector::DestroyOldGarbage()
 
 					destroyOldState = destroyGarbage_haveMore;
 				}
+				// Check if this object has survived enough searches for circular references,
+				// and if so move it to the set of tenured objects that are searched less often
+				else if( engine->ep.gcTenureAge && destroyOldIdx >= numTenured &&
+				         numOldSearches - gcObj.entryPass >= engine->ep.gcTenureAge )
+				{
+					// The object that takes its place has already been visited in this sweep
+					MoveObjectToTenuredList(destroyOldIdx);
+				}
 
 				// Allow the application to work a little
 				return 1;
@@ -633,22 +838,21 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 		switch( detectState )
 		{
 		case clearCounters_init:
+			gcMapCursor = 0;
 			detectState = clearCounters_loop;
 		break;
 
 		case clearCounters_loop:
 		{
 			// Decrease reference counter for all objects removed from the map
-			asSMapNode<void*, asSIntTypePair> *cursor = 0;
-			gcMap.MoveFirst(&cursor);
-			if( cursor )
+			asSMapEntry *entry = MoveToNextInMap(&gcMapCursor);
+			if( entry )
 			{
-				void *obj = gcMap.GetKey(cursor);
-				asSIntTypePair it = gcMap.GetValue(cursor);
-
-				engine->CallObjectMethod(obj, it.type->beh.release);
-
-				ReturnNode(gcMap.Remove(cursor));
+				// The map isn't searched until it is empty again, so
+				// the slots don't have to be rearranged as they're freed
+				engine->CallObjectMethod(entry->obj, entry->it.type->beh.release);
+				entry->obj = 0;
+				gcMapCount--;
 
 				return 1;
 			}
@@ -658,8 +862,29 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 		break;
 
 		case buildMap_init:
-			detectIdx = 0;
+		{
+			// The tenured objects are only included every few searches, or when the heuristics
+			// tell that it is worth it. If no new objects have been added since the previous
+			// search, the application is not allocating so there is time for a complete search.
+			// If many objects have been tenured since the last time it is possible that they
+			// became garbage soon after, so then they are searched earlier too
+			numOldSearches++;
+			searchTenured = includeAllGenerations ||
+			                (numOldSearches % engine->ep.gcTenuredScanInterval) == 0 ||
+			                numAdded == addedAtLastSearch ||
+			                numTenured > tenuredAtLastSearch + tenuredAtLastSearch/2;
+			addedAtLastSearch = numAdded;
+			if( searchTenured )
+			{
+				numTenuredSearches++;
+				tenuredAtLastSearch = numTenured;
+			}
+
+			// Objects that are not included in the map are considered alive, so
+			// leaving out the tenured objects will not make any object seem dead
+			detectIdx = searchTenured ? 0 : numTenured;
 			detectState = buildMap_loop;
+		}
 		break;
 
 		case buildMap_loop:
@@ -688,14 +913,17 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 				{
 					asSIntTypePair it = {refCount-1, gcObj.type};
 
-					gcMap.Insert(GetNode(gcObj.obj, it));
-
-					// Increment the object's reference counter when putting it in the map
-					engine->CallObjectMethod(gcObj.obj, gcObj.type->beh.addref);
+					// If the map couldn't grow the object is left out, and is thus considered alive. The
+					// object may also be in the map already if it was moved within the list during the iteration
+					if( InsertInMap(gcObj.obj, it) )
+					{
+						// Increment the object's reference counter when putting it in the map
+						engine->CallObjectMethod(gcObj.obj, gcObj.type->beh.addref);
 
-					// Mark the object so that we can
-					// see if it has changed since read
-					engine->CallObjectMethod(gcObj.obj, gcObj.type->beh.gcSetFlag);
+						// Mark the object so that we can
+						// see if it has changed since read
+						engine->CallObjectMethod(gcObj.obj, gcObj.type->beh.gcSetFlag);
+					}
 				}
 
 				detectIdx++; 
@@ -710,7 +938,7 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 
 		case countReferences_init:
 		{
-			gcMap.MoveFirst(&gcMapCursor);
+			gcMapCursor = 0;
 			detectState = countReferences_loop;
 		}
 		break;
@@ -728,11 +956,12 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 
 			// Any new objects created after this step in the GC cycle won't be
 			// in the map, and is thus automatically considered alive.
-			if( gcMapCursor )
+			asSMapEntry *entry = MoveToNextInMap(&gcMapCursor);
+			if( entry )
 			{
-				void *obj = gcMap.GetKey(gcMapCursor);
-				asCObjectType *type = gcMap.GetValue(gcMapCursor).type;
-				gcMap.MoveNext(&gcMapCursor, gcMapCursor);
+				void *obj = entry->obj;
+				asCObjectType *type = entry->it.type;
+				gcMapCursor++;
 
 				if( engine->CallObjectMethodRetBool(obj, type->beh.gcGetFlag) )
 				{
@@ -749,7 +978,7 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 
 		case detectGarbage_init:
 		{
-			gcMap.MoveFirst(&gcMapCursor);
+			gcMapCursor = 0;
 			liveObjects.SetLength(0);
 			detectState = detectGarbage_loop1;
 		}
@@ -765,13 +994,13 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 			// references were not found in the map.
 
 			// Add all alive objects from the map to the liveObjects array
-			if( gcMapCursor )
+			asSMapEntry *entry = MoveToNextInMap(&gcMapCursor);
+			if( entry )
 			{
-				asSMapNode<void*, asSIntTypePair> *cursor = gcMapCursor;
-				gcMap.MoveNext(&gcMapCursor, gcMapCursor);
+				gcMapCursor++;
 
-				void *obj = gcMap.GetKey(cursor);
-				asSIntTypePair it = gcMap.GetValue(cursor);
+				void *obj = entry->obj;
+				asSIntTypePair it = entry->it;
 
 				bool gcFlag = engine->CallObjectMethodRetBool(obj, it.type->beh.gcGetFlag);
 				if( !gcFlag || it.i > 0 )
@@ -799,11 +1028,11 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 				asCObjectType *type = 0;
 
 				// Remove the object from the map to mark it as alive
-				asSMapNode<void*, asSIntTypePair> *cursor = 0;
-				if( gcMap.MoveTo(&cursor, gcObj) )
+				asSMapEntry *entry = FindInMap(gcObj);
+				if( entry )
 				{
-					type = gcMap.GetValue(cursor).type;
-					ReturnNode(gcMap.Remove(cursor));
+					type = entry->it.type;
+					RemoveFromMap(entry);
 
 					// We need to decrease the reference count again as we remove the object from the map
 					engine->CallObjectMethod(gcObj, type->beh.release);
@@ -821,7 +1050,7 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 		break;
 
 		case verifyUnmarked_init:
-			gcMap.MoveFirst(&gcMapCursor);
+			gcMapCursor = 0;
 			detectState = verifyUnmarked_loop;
 			break;
 
@@ -830,10 +1059,11 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 			// In this step we must make sure that none of the objects still in the map
 			// has been touched by the application. If they have then we must run the
 			// detectGarbage loop once more.
-			if( gcMapCursor )
+			asSMapEntry *entry = MoveToNextInMap(&gcMapCursor);
+			if( entry )
 			{
-				void *gcObj = gcMap.GetKey(gcMapCursor);
-				asCObjectType *type = gcMap.GetValue(gcMapCursor).type;
+				void *gcObj = entry->obj;
+				asCObjectType *type = entry->it.type;
 
 				bool gcFlag = engine->CallObjectMethodRetBool(gcObj, type->beh.gcGetFlag);
 				if( !gcFlag )
@@ -842,7 +1072,7 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 					detectState = detectGarbage_init;
 				}
 				else
-					gcMap.MoveNext(&gcMapCursor, gcMapCursor);
+					gcMapCursor++;
 
 				// Allow the application to work a little
 				return 1;
@@ -852,32 +1082,34 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 				// No unmarked object was touched, we can now be sure
 				// that objects that have gcCount == 0 really is garbage
 				detectState = breakCircles_init;
+
+				// The background thread must stop here, and leave the rest to the other threads
+				if( gcMapCount && backgroundThread )
+					return 1;
 			}
 		}
 		break;
 
 		case breakCircles_init:
 		{
-			gcMap.MoveFirst(&gcMapCursor);
+			gcMapCursor = 0;
 			detectState = breakCircles_loop;
 
 			// If the application has requested a callback for detected circular references,
 			// then make that callback now for all the objects in the list. This step is not
 			// done in incremental steps as it is only meant for debugging purposes and thus
 			// doesn't require interactivity
-			if (gcMapCursor && circularRefDetectCallbackFunc)
+			if (gcMapCount && circularRefDetectCallbackFunc)
 			{
-				while (gcMapCursor)
+				asSMapEntry *entry;
+				while ((entry = MoveToNextInMap(&gcMapCursor)) != 0)
 				{
-					void *gcObj = gcMap.GetKey(gcMapCursor);
-					asCObjectType *type = gcMap.GetValue(gcMapCursor).type;
-					circularRefDetectCallbackFunc(type, gcObj, circularRefDetectCallbackParam);
-
-					gcMap.MoveNext(&gcMapCursor, gcMapCursor);
+					circularRefDetectCallbackFunc(entry->it.type, entry->obj, circularRefDetectCallbackParam);
+					gcMapCursor++;
 				}
 
 				// Reset iterator
-				gcMap.MoveFirst(&gcMapCursor);
+				gcMapCursor = 0;
 			}
 		}
 		break;
@@ -889,11 +1121,12 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 			// kept alive through circular references. To be able to free
 			// these objects we need to force the breaking of the circle
 			// by having the objects release their references.
-			if( gcMapCursor )
+			asSMapEntry *entry = MoveToNextInMap(&gcMapCursor);
+			if( entry )
 			{
 				numDetected++;
-				void *gcObj = gcMap.GetKey(gcMapCursor);
-				asCObjectType *type = gcMap.GetValue(gcMapCursor).type;
+				void *gcObj = entry->obj;
+				asCObjectType *type = entry->it.type;
 				if( type->flags & asOBJ_SCRIPT_OBJECT )
 				{
 					// For script objects we must call the class destructor before
@@ -904,7 +1137,7 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 				}
 				engine->CallObjectMethod(gcObj, engine, type->beh.gcReleaseAllReferences);
 
-				gcMap.MoveNext(&gcMapCursor, gcMapCursor);
+				gcMapCursor++;
 
 				detectState = breakCircles_haveGarbage;
 
@@ -922,6 +1155,10 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 				}
 				else
 				{
+					// The tenured objects must be swept to destroy the garbage found among them
+					if( searchTenured )
+						tenuredGarbageFound = true;
+
 					// Restart the GC
 					detectState = clearCounters_init;
 					return 1;
@@ -935,35 +1172,368 @@ int asCGarbageCollector::IdentifyGarbageWithCyclicRefs()
 	UNREACHABLE_RETURN;
 }
 
-asCGarbageCollector::asSMapNode_t *asCGarbageCollector::GetNode(void *obj, asSIntTypePair it)
+int asCGarbageCollector::StartBackgroundDetection()
+{
+	ENTERCRITICALSECTION(gcBackground);
+	if( backgroundThread == 0 )
+	{
+		stopBackground.set(0);
+		backgroundThread = asStartThread(BackgroundDetectionThread, this);
+	}
+	bool isRunning = backgroundThread != 0;
+	LEAVECRITICALSECTION(gcBackground);
+
+	// The library doesn't support threads on this platform
+	return isRunning ? asSUCCESS : asNOT_SUPPORTED;
+}
+
+void asCGarbageCollector::StopBackgroundDetection()
+{
+	ENTERCRITICALSECTION(gcBackground);
+	if( backgroundThread )
+	{
+		stopBackground.set(1);
+		asJoinThread(backgroundThread);
+		backgroundThread = 0;
+	}
+	LEAVECRITICALSECTION(gcBackground);
+}
+
+bool asCGarbageCollector::IsBackgroundDetectionRunning() const
+{
+	return backgroundThread != 0;
+}
+
+bool asCGarbageCollector::IsDetectionLeftForBackground() const
 {
 	// This function will only be called within the critical section gcCollecting
 	asASSERT(isProcessing);
 
-	asSMapNode_t *node;
-	if( freeNodes.GetLength() )
-		node = freeNodes.PopLast();
-	else
+	// The circles can only be broken by the threads that call GarbageCollect
+	return backgroundThread && !(detectState >= breakCircles_init && gcMapCount > 0);
+}
+
+void asCGarbageCollector::BackgroundDetectionThread(void *param)
+{
+	asCGarbageCollector *gc = reinterpret_cast<asCGarbageCollector*>(param);
+	while( gc->RunBackgroundDetection() ) {}
+
+	// Free the thread local data
+	asCThreadManager::CleanupLocalData();
+}
+
+bool asCGarbageCollector::RunBackgroundDetection()
+{
+	if( stopBackground.get() )
+		return false;
+
+	// Wait a little before starting a new search, and while the objects with
+	// circular references are waiting for the other threads to destroy them
+	asUINT sleepTime = 10;
+
+	// The scripts must not modify the objects while the references are enumerated, so
+	// the batch is only done when all the threads that execute scripts have been paused
+	bool scriptsPaused = false;
+	if( !PauseScriptThreads(&scriptsPaused) )
 	{
-		node = asNEW(asSMapNode_t);
-		if( !node )
+		asSleepThread(sleepTime);
+		return true;
+	}
+
+	// Skip this if another thread is processing the garbage collector at the moment
+	if( TRYENTERCRITICALSECTION(gcCollecting) )
+	{
+		if( !isProcessing )
 		{
-			// Out of memory
+			isProcessing = true;
+
+			// Do a batch of steps before letting the other threads in again. The steps only
+			// call the AddRef, Release, GetRefCount, SetFlag, GetFlag and EnumReferences
+			// behaviours, and the Release never destroys the object, since the object will
+			// still be in the list of objects held by the garbage collector
+			for( asUINT n = 0; n < 100 && gcOldObjects.GetLength(); n++ )
+			{
+				if( detectState >= breakCircles_init && gcMapCount > 0 )
+					break;
+
+				if( IdentifyGarbageWithCyclicRefs() == 0 )
+				{
+					// The search is complete
+					sleepTime = 10;
+					break;
+				}
+
+				// Continue immediately with the next batch
+				sleepTime = 0;
+			}
+
+			isProcessing = false;
+		}
+
+		LEAVECRITICALSECTION(gcCollecting);
+	}
+
+	ResumeScriptThreads();
+
+	// Give the script threads a chance to run before they are paused again
+	if( sleepTime == 0 && scriptsPaused )
+		sleepTime = 1;
+
+	if( sleepTime )
+		asSleepThread(sleepTime);
+
+	return true;
+}
+
+bool asCGarbageCollector::PauseScriptThreads(bool *scriptsPaused)
+{
+	ENTERCRITICALSECTION(gcPause);
+	ENTERCRITICALSECTION(gcExecuting);
+
+	// Make the contexts check for the pause at the next safe point, i.e. at
+	// the next line or call to a script function. Contexts that start to
+	// execute from now on will either wait or check for the pause too
+	pauseRequested.set(1);
+	for( asUINT n = 0; n < executingContexts.GetLength(); n++ )
+		executingContexts[n]->m_regs.doProcessSuspend = true;
+
+	// Give up if the threads don't reach a safe point in a reasonable time, e.g. when a
+	// script is calling an application function that waits for something, or the script
+	// has been compiled without line cues and is looping without calling any functions
+	bool paused = true;
+	for( asUINT n = 0; pausedThreads < runningThreads; n++ )
+	{
+		if( n == 20 )
+		{
+			paused = false;
+			break;
+		}
+
+		LEAVECRITICALSECTION(gcExecuting);
+		asSleepThread(n < 10 ? 0 : 1);
+		ENTERCRITICALSECTION(gcExecuting);
+	}
+
+	*scriptsPaused = runningThreads > 0;
+	LEAVECRITICALSECTION(gcExecuting);
+
+	if( !paused )
+		ResumeScriptThreads();
+
+	return paused;
+}
+
+void asCGarbageCollector::ResumeScriptThreads()
+{
+	// The contexts turn off the processing of the safe
+	// points themselves when they see the pause is over
+	ENTERCRITICALSECTION(gcExecuting);
+	pauseRequested.set(0);
+	LEAVECRITICALSECTION(gcExecuting);
+
+	LEAVECRITICALSECTION(gcPause);
+}
+
+bool asCGarbageCollector::IsNestedExecution(asCContext *ctx, asCThreadLocalData *tld) const
+{
+	// The context is the last one in the list of active contexts
+	asASSERT( tld->activeContexts.GetLength() && tld->activeContexts[tld->activeContexts.GetLength()-1] == ctx );
+	UNUSED_VAR(ctx);
+
+	for( asUINT n = 0; n + 1 < tld->activeContexts.GetLength(); n++ )
+		if( tld->activeContexts[n]->GetEngine() == engine )
+			return true;
+
+	return false;
+}
+
+bool asCGarbageCollector::EnterScriptExecution(asCContext *ctx, asCThreadLocalData *tld)
+{
+	// The scripts only need to be paused for the background thread. The application
+	// must turn it on before executing scripts, so no registered context is missed
+	if( backgroundThread == 0 )
+		return false;
+
+	bool isNested = IsNestedExecution(ctx, tld);
+
+	ENTERCRITICALSECTION(gcExecuting);
+
+	if( !isNested )
+	{
+		// Don't start a new thread while the background thread is inspecting the objects.
+		// Nested contexts can't wait here, as the thread is already counted as running
+		while( pauseRequested.get() )
+		{
+			LEAVECRITICALSECTION(gcExecuting);
+			ENTERCRITICALSECTION(gcPause);
+			LEAVECRITICALSECTION(gcPause);
+			ENTERCRITICALSECTION(gcExecuting);
+		}
+
+		runningThreads++;
+	}
+
+	executingContexts.PushLast(ctx);
+	if( pauseRequested.get() )
+		ctx->m_regs.doProcessSuspend = true;
+
+	LEAVECRITICALSECTION(gcExecuting);
+
+	return true;
+}
+
+void asCGarbageCollector::LeaveScriptExecution(asCContext *ctx, asCThreadLocalData *tld)
+{
+	bool isNested = IsNestedExecution(ctx, tld);
+
+	ENTERCRITICALSECTION(gcExecuting);
+
+	executingContexts.RemoveValue(ctx);
+	if( !isNested )
+		runningThreads--;
+
+	LEAVECRITICALSECTION(gcExecuting);
+}
+
+void asCGarbageCollector::PauseAtSafePoint(asCContext *ctx)
+{
+	ENTERCRITICALSECTION(gcExecuting);
+
+	if( pauseRequested.get() )
+	{
+		// Wait until the background thread has completed the batch. The
+		// nested contexts in this thread are paused together with this one
+		pausedThreads++;
+		LEAVECRITICALSECTION(gcExecuting);
+		ENTERCRITICALSECTION(gcPause);
+		LEAVECRITICALSECTION(gcPause);
+		ENTERCRITICALSECTION(gcExecuting);
+		pausedThreads--;
+	}
+
+	// Turn off the processing of the safe points unless the context still needs it. The
+	// suspend flag is checked last as another thread may call Suspend at the same time
+	if( !pauseRequested.get() )
+	{
+		ctx->m_regs.doProcessSuspend = ctx->m_lineCallback;
+		if( ctx->m_doSuspend )
+			ctx->m_regs.doProcessSuspend = true;
+	}
+
+	LEAVECRITICALSECTION(gcExecuting);
+}
+
+asUINT asCGarbageCollector::GetMapSlot(void *obj) const
+{
+	// The lowest bits of the address are the same for all objects due to
+	// the alignment, so the address is mixed before taking the lowest bits
+	asPWORD h = reinterpret_cast<asPWORD>(obj) >> 3;
+	h ^= h >> 16;
+	h *= 0x45d9f3b;
+	h ^= h >> 16;
+	return asUINT(h) & (gcMap.GetLength() - 1);
+}
+
+asCGarbageCollector::asSMapEntry *asCGarbageCollector::FindInMap(void *obj)
+{
+	if( gcMapCount == 0 )
+		return 0;
+
+	for( asUINT n = GetMapSlot(obj); ; n = (n + 1) & (gcMap.GetLength() - 1) )
+	{
+		if( gcMap[n].obj == obj )
+			return &gcMap[n];
+		if( gcMap[n].obj == 0 )
 			return 0;
+	}
+}
+
+bool asCGarbageCollector::InsertInMap(void *obj, asSIntTypePair it)
+{
+	// This function will only be called within the critical section gcCollecting
+	asASSERT(isProcessing);
+
+	// Keep the map at most half full so the searches stay short
+	if( (gcMapCount + 1) * 2 > gcMap.GetLength() )
+	{
+		// The old entries are copied, as they are rehashed into a new array anyway
+		asCArray<asSMapEntry> old(gcMap);
+		asUINT length = gcMap.GetLength() ? gcMap.GetLength() * 2 : 64;
+		if( old.GetLength() != gcMap.GetLength() )
+		{
+			// Out of memory
+			return false;
+		}
+		gcMap.Allocate(length, false);
+		if( !gcMap.SetLength(length) )
+		{
+			// Out of memory. The old entries are put back
+			gcMap = old;
+			return false;
+		}
+
+		for( asUINT n = 0; n < length; n++ )
+			gcMap[n].obj = 0;
+
+		for( asUINT n = 0; n < old.GetLength(); n++ )
+		{
+			if( old[n].obj == 0 ) continue;
+
+			asUINT slot = GetMapSlot(old[n].obj);
+			while( gcMap[slot].obj )
+				slot = (slot + 1) & (length - 1);
+			gcMap[slot] = old[n];
 		}
 	}
-	
-	node->Init(obj, it);
-	return node;
+
+	asUINT slot = GetMapSlot(obj);
+	while( gcMap[slot].obj )
+	{
+		// The object is already in the map
+		if( gcMap[slot].obj == obj )
+			return false;
+		slot = (slot + 1) & (gcMap.GetLength() - 1);
+	}
+	gcMap[slot].obj = obj;
+	gcMap[slot].it  = it;
+	gcMapCount++;
+
+	return true;
 }
 
-void asCGarbageCollector::ReturnNode(asSMapNode_t *node)
+void asCGarbageCollector::RemoveFromMap(asSMapEntry *entry)
 {
 	// This function will only be called within the critical section gcCollecting
 	asASSERT(isProcessing);
 
-	if( node )
-		freeNodes.PushLast(node);
+	// Move the following entries back into the freed slot if that
+	// is closer to their own slot, so the searches still find them
+	asUINT mask = gcMap.GetLength() - 1;
+	asUINT free = asUINT(entry - gcMap.AddressOf());
+	for( asUINT n = (free + 1) & mask; gcMap[n].obj; n = (n + 1) & mask )
+	{
+		asUINT slot = GetMapSlot(gcMap[n].obj);
+		if( ((n - slot) & mask) >= ((n - free) & mask) )
+		{
+			gcMap[free] = gcMap[n];
+			free = n;
+		}
+	}
+
+	gcMap[free].obj = 0;
+	gcMapCount--;
+}
+
+asCGarbageCollector::asSMapEntry *asCGarbageCollector::MoveToNextInMap(asUINT *cursor)
+{
+	if( gcMapCount == 0 )
+		return 0;
+
+	for( ; *cursor < gcMap.GetLength(); (*cursor)++ )
+		if( gcMap[*cursor].obj )
+			return &gcMap[*cursor];
+
+	return 0;
 }
 
 void asCGarbageCollector::GCEnumCallback(void *reference)
@@ -974,18 +1544,17 @@ void asCGarbageCollector::GCEnumCallback(void *reference)
 	if( detectState == countReferences_loop )
 	{
 		// Find the reference in the map
-		asSMapNode<void*, asSIntTypePair> *cursor = 0;
-		if( gcMap.MoveTo(&cursor, reference) )
+		asSMapEntry *entry = FindInMap(reference);
+		if( entry )
 		{
 			// Decrease the counter in the map for the reference
-			gcMap.GetValue(cursor).i--;
+			entry->it.i--;
 		}
 	}
 	else if( detectState == detectGarbage_loop2 )
 	{
 		// Find the reference in the map
-		asSMapNode<void*, asSIntTypePair> *cursor = 0;
-		if( gcMap.MoveTo(&cursor, reference) )
+		if( FindInMap(reference) )
 		{
 			// Add the object to the list of objects to mark as alive
 			liveObjects.PushLast(reference);
@@ -42,13 +42,14 @@
 
 #include "as_config.h"
 #include "as_array.h"
-#include "as_map.h"
 #include "as_thread.h"
+#include "as_atomic.h"
 
 BEGIN_AS_NAMESPACE
 
 class asCScriptEngine;
 class asCObjectType;
+class asCContext;
 
 class asCGarbageCollector
 {
@@ -58,12 +59,28 @@ public:
 
 	int    GarbageCollect(asDWORD flags, asUINT iterations);
 	void   GetStatistics(asUINT *currentSize, asUINT *totalDestroyed, asUINT *totalDetected, asUINT *newObjects, asUINT *totalNewDestroyed) const;
+	int    GetGenerationStatistics(asUINT generation, asUINT *currentSize, asUINT *totalDestroyed, asUINT *totalPromoted, asUINT *totalScans) const;
+	int    GetPhaseStatistics(asEGCPhase phase, double *totalTime, double *maxStepTime, asQWORD *totalSteps) const;
 	void   GCEnumCallback(void *reference);
 	int    AddScriptObjectToGC(void *obj, asCObjectType *objType);
 	int    GetObjectInGC(asUINT idx, asUINT *seqNbr, void **obj, asITypeInfo **type);
 
 	int    ReportAndReleaseUndestroyedObjects();
 
+	// The detection of circular references can be done by a background thread, leaving
+	// only the breaking of the circles and the destruction of the objects to the threads
+	// that call GarbageCollect, so that the objects are never destroyed by the background
+	int    StartBackgroundDetection();
+	void   StopBackgroundDetection();
+	bool   IsBackgroundDetectionRunning() const;
+
+	// The background thread only inspects the objects while all the threads that execute scripts
+	// are paused at a safe point, so the contexts must tell when they start and stop executing
+	bool   EnterScriptExecution(asCContext *ctx, asCThreadLocalData *tld);
+	void   LeaveScriptExecution(asCContext *ctx, asCThreadLocalData *tld);
+	void   PauseAtSafePoint(asCContext *ctx);
+	bool   IsPauseRequested() const { return pauseRequested.get() != 0; }
+
 	asCScriptEngine *engine;
 
 	// Callback for when circular reference are detected
@@ -71,9 +88,9 @@ public:
 	void *              circularRefDetectCallbackParam;
 
 protected:
-	struct asSObjTypePair {void *obj; asCObjectType *type; asUINT seqNbr;};
+	struct asSObjTypePair {void *obj; asCObjectType *type; asUINT seqNbr; asUINT entryPass;};
 	struct asSIntTypePair {int i; asCObjectType *type;};
-	typedef asSMapNode<void*, asSIntTypePair> asSMapNode_t;
+	struct asSMapEntry {void *obj; asSIntTypePair it;};
 
 	enum egcDestroyState
 	{
@@ -108,18 +125,34 @@ protected:
 	void           RemoveNewObjectAtIdx(int idx);
 	void           RemoveOldObjectAtIdx(int idx);
 	void           MoveObjectToOldList(int idx);
+	void           MoveObjectToTenuredList(int idx);
 	void           MoveAllObjectsToOldList();
-
-	// Holds all the objects known by the garbage collector
+	bool           IsDetectionLeftForBackground() const;
+	int            CollectWithinBudget(bool doDetect, bool doDestroy, asUINT microseconds);
+	int            TimedStep(asEGCPhase phase, int (asCGarbageCollector::*step)(), asQWORD *ticks);
+	asEGCPhase     GetDetectPhase() const;
+	bool           RunBackgroundDetection();
+	bool           PauseScriptThreads(bool *scriptsPaused);
+	void           ResumeScriptThreads();
+	bool           IsNestedExecution(asCContext *ctx, asCThreadLocalData *tld) const;
+	static void    BackgroundDetectionThread(void *param);
+
+	// Holds all the objects known by the garbage collector. The first numTenured objects
+	// in the gcOldObjects array are the tenured objects, i.e. objects that have survived
+	// several searches for circular references, and that are thus searched less often
 	asCArray<asSObjTypePair>           gcNewObjects;
 	asCArray<asSObjTypePair>           gcOldObjects;
+	asUINT                             numTenured;
 
 	// This array temporarily holds references to objects known to be live objects
 	asCArray<void*>                    liveObjects;
 
 	// This map holds objects currently being searched for cyclic references, it also holds a 
-	// counter that gives the number of references to the object that the GC can't reach
-	asCMap<void*, asSIntTypePair>      gcMap;
+	// counter that gives the number of references to the object that the GC can't reach. It is
+	// a hash table with open addressing, as it is searched once for every reference that is
+	// enumerated. Free slots have a null object. The length is always a power of 2
+	asCArray<asSMapEntry>              gcMap;
+	asUINT                             gcMapCount;
 
 	// State variables
 	egcDestroyState                    destroyNewState;
@@ -132,18 +165,51 @@ protected:
 	asUINT                             detectIdx;
 	asUINT                             numDetected;
 	asUINT                             numAdded;
-	asUINT                             seqAtSweepStart[3];
-	asSMapNode_t                      *gcMapCursor;
+	asUINT                             numNewSweeps;
+	asUINT                             numOldSearches;
+	asUINT                             numTenuredSearches;
+	asUINT                             numOldSweeps;
+	asUINT                             numOldDestroyed;
+	asUINT                             numTenuredDestroyed;
+	asUINT                             numNewPromoted;
+	asUINT                             numOldPromoted;
+	asUINT                             addedAtLastSearch;
+	asUINT                             tenuredAtLastSearch;
+	bool                               searchTenured;
+	bool                               sweepTenured;
+	bool                               tenuredGarbageFound;
+	bool                               includeAllGenerations;
+	asUINT                             gcMapCursor;
 	bool                               isProcessing;
-
-	// We'll keep a pool of nodes to avoid allocating memory all the time
-	asSMapNode_t            *GetNode(void *obj, asSIntTypePair it);
-	void                     ReturnNode(asSMapNode_t *node);
-	asCArray<asSMapNode_t*>  freeNodes;
+	void                              *backgroundThread;
+	asCAtomic                          stopBackground;
+
+	// The contexts that are currently executing scripts, and the number of threads
+	// executing them. Nested contexts are paused together with the outermost one
+	asCArray<asCContext*>              executingContexts;
+	asUINT                             runningThreads;
+	asUINT                             pausedThreads;
+	asCAtomic                          pauseRequested;
+
+	// The time spent in each phase, measured while collecting with a time budget
+	asQWORD                            phaseTicks[asGC_PHASE_LAST];
+	asQWORD                            phaseMaxTicks[asGC_PHASE_LAST];
+	asQWORD                            phaseSteps[asGC_PHASE_LAST];
+
+	// Operations on the gcMap. The slots of the map are kept between the GC cycles
+	// to avoid allocating memory all the time. The cursor is the index of the slot
+	asUINT       GetMapSlot(void *obj) const;
+	asSMapEntry *FindInMap(void *obj);
+	bool         InsertInMap(void *obj, asSIntTypePair it);
+	void         RemoveFromMap(asSMapEntry *entry);
+	asSMapEntry *MoveToNextInMap(asUINT *cursor);
 
 	// Critical section for multithreaded access
 	DECLARECRITICALSECTION(gcCritical)   // Used for adding/removing objects
 	DECLARECRITICALSECTION(gcCollecting) // Used for processing
+	DECLARECRITICALSECTION(gcBackground) // Used for starting and stopping the background thread
+	DECLARECRITICALSECTION(gcExecuting)  // Used for registering the contexts that execute scripts
+	DECLARECRITICALSECTION(gcPause)      // Held by the background thread while the scripts are paused
 };
 
 END_AS_NAMESPACE
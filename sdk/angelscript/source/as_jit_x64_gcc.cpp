@@ -0,0 +1,963 @@
+/*
+   AngelCode Scripting Library
+   Copyright (c) 2003-2018 Andreas Jonsson
+
+   This software is provided 'as-is', without any express or implied
+   warranty. In no event will the authors be held liable for any
+   damages arising from the use of this software.
+
+   Permission is granted to anyone to use this software for any
+   purpose, including commercial applications, and to alter it and
+   redistribute it freely, subject to the following restrictions:
+
+   1. The origin of this software must not be misrepresented; you
+      must not claim that you wrote the original software. If you use
+      this software in a product, an acknowledgment in the product
+      documentation would be appreciated but is not required.
+
+   2. Altered source versions must be plainly marked as such, and
+      must not be misrepresented as being the original software.
+
+   3. This notice may not be removed or altered from any source
+      distribution.
+
+   The original version of this library can be located at:
+   http://www.angelcode.com/angelscript/
+
+   Andreas Jonsson
+   andreas@angelcode.com
+*/
+
+
+//
+// as_jit_x64_gcc.cpp
+//
+// A baseline JIT compiler for the AMD64 System V ABI used by gcc-based 64bit Unices
+//
+// Each bytecode instruction is translated into a fixed sequence of native
+// instructions. Instructions that are not translated, e.g. function calls,
+// return the control to the VM, which will then give the control back to
+// the JIT function at the next JitEntry instruction.
+//
+
+#include "as_config.h"
+#include "as_memory.h"
+#include "as_array.h"
+
+#ifdef AS_JIT_X64_GCC
+
+#include <stddef.h>     // offsetof()
+#include <string.h>     // memcpy()
+#include <sys/mman.h>   // mmap()
+
+#endif
+
+BEGIN_AS_NAMESPACE
+
+#ifdef AS_JIT_X64_GCC
+
+// The registers used by the generated code. Only the callee saved registers
+// are used to hold the VM registers, and the others are used as scratch
+enum asEX64Reg
+{
+	x64RAX = 0, x64RCX = 1, x64RDX = 2, x64RBX = 3,
+	x64RSP = 4, x64RBP = 5, x64RSI = 6, x64RDI = 7,
+	x64R8  = 8, x64R9  = 9, x64R10 = 10, x64R11 = 11,
+	x64R12 = 12, x64R13 = 13, x64R14 = 14, x64R15 = 15
+};
+
+enum asEX64XmmReg
+{
+	x64XMM0 = 0, x64XMM1 = 1, x64XMM2 = 2
+};
+
+// The condition codes for the Jcc, SETcc, and CMOVcc instructions
+enum asEX64Cond
+{
+	x64CC_B  = 0x2, x64CC_AE = 0x3, x64CC_E  = 0x4, x64CC_NE = 0x5,
+	x64CC_BE = 0x6, x64CC_A  = 0x7, x64CC_S  = 0x8, x64CC_NS = 0x9,
+	x64CC_P  = 0xA, x64CC_NP = 0xB, x64CC_L  = 0xC, x64CC_GE = 0xD,
+	x64CC_LE = 0xE, x64CC_G  = 0xF
+};
+
+// The VM registers are kept in these while the JIT function executes
+const int x64REG_FP   = x64RBX; // stackFramePointer
+const int x64REG_REGS = x64R12; // asSVMRegisters*
+const int x64REG_SP   = x64R13; // stackPointer
+
+const int x64OFS_PROGRAMPOINTER = (int)offsetof(asSVMRegisters, programPointer);
+const int x64OFS_STACKFRAME     = (int)offsetof(asSVMRegisters, stackFramePointer);
+const int x64OFS_STACKPOINTER   = (int)offsetof(asSVMRegisters, stackPointer);
+const int x64OFS_VALUEREGISTER  = (int)offsetof(asSVMRegisters, valueRegister);
+const int x64OFS_DOSUSPEND      = (int)offsetof(asSVMRegisters, doProcessSuspend);
+
+// The size of the header placed before the code in the executable memory
+const asUINT x64CODE_HEADER_SIZE = 16;
+
+// Minimal assembler for the instructions used by the JIT compiler
+class asCX64Assembler
+{
+public:
+	asCArray<asBYTE> code;
+
+	asUINT GetPos() const { return code.GetLength(); }
+
+	void Byte(asBYTE b) { code.PushLast(b); }
+	void Dword(asDWORD d) { for( int n = 0; n < 4; n++ ) Byte(asBYTE(d >> (n*8))); }
+	void Qword(asQWORD q) { for( int n = 0; n < 8; n++ ) Byte(asBYTE(q >> (n*8))); }
+
+	void PatchDword(asUINT pos, asDWORD d)
+	{
+		for( int n = 0; n < 4; n++ )
+			code[pos+n] = asBYTE(d >> (n*8));
+	}
+
+	// Emits the optional mandatory prefix, the REX prefix, and the opcode
+	void Opcode(int prefix, bool w, int reg, int rm, asBYTE op1, int op2 = -1)
+	{
+		if( prefix >= 0 )
+			Byte(asBYTE(prefix));
+		if( w || reg >= 8 || rm >= 8 )
+			Byte(asBYTE(0x40 | (w ? 8 : 0) | ((reg & 8) ? 4 : 0) | ((rm & 8) ? 1 : 0)));
+		Byte(op1);
+		if( op2 >= 0 )
+			Byte(asBYTE(op2));
+	}
+
+	// Instruction with a memory operand [base + disp]
+	void OpMem(int prefix, bool w, asBYTE op1, int op2, int reg, int base, int disp)
+	{
+		Opcode(prefix, w, reg, base, op1, op2);
+
+		// rbp and r13 can't be encoded without a displacement
+		int mod;
+		if( disp == 0 && (base & 7) != x64RBP )
+			mod = 0;
+		else if( disp >= -128 && disp <= 127 )
+			mod = 1;
+		else
+			mod = 2;
+
+		Byte(asBYTE((mod << 6) | ((reg & 7) << 3) | (base & 7)));
+
+		// rsp and r12 require the SIB byte
+		if( (base & 7) == x64RSP )
+			Byte(0x24);
+
+		if( mod == 1 )
+			Byte(asBYTE(disp));
+		else if( mod == 2 )
+			Dword(asDWORD(disp));
+	}
+
+	// Instruction with a register operand
+	void OpReg(int prefix, bool w, asBYTE op1, int op2, int reg, int rm)
+	{
+		Opcode(prefix, w, reg, rm, op1, op2);
+		Byte(asBYTE(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+	}
+
+	// General purpose instructions
+	void MovRegMem(bool w, int reg, int base, int disp)   { OpMem(-1, w, 0x8B, -1, reg, base, disp); }
+	void MovMemReg(bool w, int base, int disp, int reg)   { OpMem(-1, w, 0x89, -1, reg, base, disp); }
+	void MovMemImm(bool w, int base, int disp, asDWORD i) { OpMem(-1, w, 0xC7, -1, 0, base, disp); Dword(i); }
+	void MovRegReg(bool w, int dst, int src)              { OpReg(-1, w, 0x89, -1, src, dst); }
+	void MovRegImm32(int reg, asDWORD i)                  { Opcode(-1, false, 0, reg, asBYTE(0xB8 + (reg & 7))); Dword(i); }
+	void MovRegImm64(int reg, asQWORD i)                  { Opcode(-1, true, 0, reg, asBYTE(0xB8 + (reg & 7))); Qword(i); }
+	void MovzxRegMem8(int reg, int base, int disp)        { OpMem(-1, false, 0x0F, 0xB6, reg, base, disp); }
+	void MovzxRegMem16(int reg, int base, int disp)       { OpMem(-1, false, 0x0F, 0xB7, reg, base, disp); }
+	void MovsxRegMem8(int reg, int base, int disp)        { OpMem(-1, false, 0x0F, 0xBE, reg, base, disp); }
+	void MovsxRegMem16(int reg, int base, int disp)       { OpMem(-1, false, 0x0F, 0xBF, reg, base, disp); }
+	void MovsxdRegMem(int reg, int base, int disp)        { OpMem(-1, true, 0x63, -1, reg, base, disp); }
+	void Lea(int reg, int base, int disp)                 { OpMem(-1, true, 0x8D, -1, reg, base, disp); }
+
+	// op is one of 0x03 (add), 0x2B (sub), 0x23 (and), 0x0B (or), 0x33 (xor), 0x3B (cmp)
+	void AluRegMem(asBYTE op, bool w, int reg, int base, int disp) { OpMem(-1, w, op, -1, reg, base, disp); }
+	void AluRegReg(asBYTE op, bool w, int dst, int src)            { OpReg(-1, w, op, -1, dst, src); }
+	// ext is one of 0 (add), 5 (sub), 4 (and), 1 (or), 6 (xor), 7 (cmp)
+	void AluRegImm(int ext, bool w, int reg, asDWORD i)            { OpReg(-1, w, 0x81, -1, ext, reg); Dword(i); }
+	void AluMemImm(int ext, bool w, int base, int disp, asDWORD i) { OpMem(-1, w, 0x81, -1, ext, base, disp); Dword(i); }
+	void CmpMem8Imm(int base, int disp, asBYTE i)                  { OpMem(-1, false, 0x80, -1, 7, base, disp); Byte(i); }
+
+	void ImulRegMem(bool w, int reg, int base, int disp)  { OpMem(-1, w, 0x0F, 0xAF, reg, base, disp); }
+	void ImulRegRegImm(int dst, int src, asDWORD i)       { OpReg(-1, false, 0x69, -1, dst, src); Dword(i); }
+	// ext is one of 0 (inc), 1 (dec)
+	void IncDecMem(int ext, bool w, int base, int disp)   { OpMem(-1, w, 0xFF, -1, ext, base, disp); }
+	// ext is one of 2 (not), 3 (neg)
+	void NotNegMem(int ext, bool w, int base, int disp)   { OpMem(-1, w, 0xF7, -1, ext, base, disp); }
+	// ext is one of 6 (div), 7 (idiv)
+	void DivReg(int ext, int reg)                         { OpReg(-1, false, 0xF7, -1, ext, reg); }
+	void Cdq()                                            { Byte(0x99); }
+	// ext is one of 4 (shl), 5 (shr), 7 (sar)
+	void ShiftRegCl(int ext, int reg)                     { OpReg(-1, false, 0xD3, -1, ext, reg); }
+	void BtcRegImm(int reg, asBYTE i)                     { OpReg(-1, true, 0x0F, 0xBA, 7, reg); Byte(i); }
+	void TestRegReg(bool w, int a, int b)                 { OpReg(-1, w, 0x85, -1, b, a); }
+	void Setcc(asEX64Cond cc, int reg)                    { OpReg(-1, false, 0x0F, 0x90 | cc, 0, reg); }
+	void Cmovcc(asEX64Cond cc, int dst, int src)          { OpReg(-1, false, 0x0F, 0x40 | cc, dst, src); }
+
+	void Push(int reg) { if( reg >= 8 ) Byte(0x41); Byte(asBYTE(0x50 + (reg & 7))); }
+	void Pop(int reg)  { if( reg >= 8 ) Byte(0x41); Byte(asBYTE(0x58 + (reg & 7))); }
+	void Ret()         { Byte(0xC3); }
+	void JmpReg(int reg) { OpReg(-1, false, 0xFF, -1, 4, reg); }
+
+	// The jumps return the position of the rel32 so it can be patched later
+	asUINT Jmp()                { Byte(0xE9); Dword(0); return GetPos() - 4; }
+	asUINT Jcc(asEX64Cond cc)   { Byte(0x0F); Byte(asBYTE(0x80 | cc)); Dword(0); return GetPos() - 4; }
+	void   PatchRel32(asUINT pos, asUINT target) { PatchDword(pos, asDWORD(int(target) - int(pos + 4))); }
+
+	// SSE instructions. prefix is 0xF3 for single and 0xF2 for double precision
+	void MovsMem(int prefix, int xmm, int base, int disp)          { OpMem(prefix, false, 0x0F, 0x10, xmm, base, disp); }
+	void MovsToMem(int prefix, int base, int disp, int xmm)        { OpMem(prefix, false, 0x0F, 0x11, xmm, base, disp); }
+	// op is one of 0x58 (add), 0x59 (mul), 0x5C (sub), 0x5E (div)
+	void SseArithMem(int prefix, asBYTE op, int xmm, int base, int disp) { OpMem(prefix, false, 0x0F, op, xmm, base, disp); }
+	void SseArithReg(int prefix, asBYTE op, int dst, int src)      { OpReg(prefix, false, 0x0F, op, dst, src); }
+	void UcomisReg(int prefix, int a, int b)                       { OpReg(prefix == 0xF2 ? 0x66 : -1, false, 0x0F, 0x2E, a, b); }
+	void Cvtsi2sMem(int prefix, int xmm, int base, int disp)       { OpMem(prefix, false, 0x0F, 0x2A, xmm, base, disp); }
+	void Cvtts2siMem(int prefix, int reg, int base, int disp)      { OpMem(prefix, false, 0x0F, 0x2C, reg, base, disp); }
+	void Cvts2sMem(int prefix, int xmm, int base, int disp)        { OpMem(prefix, false, 0x0F, 0x5A, xmm, base, disp); }
+	void MovdXmmReg(int xmm, int reg)                              { OpReg(0x66, false, 0x0F, 0x6E, xmm, reg); }
+	void XorpsReg(int dst, int src)                                { OpReg(-1, false, 0x0F, 0x57, dst, src); }
+};
+
+// Translates the bytecode of a single script function
+class asCX64JITFunctionCompiler
+{
+public:
+	asCX64JITFunctionCompiler(asDWORD *byteCode, asUINT length);
+
+	int Compile(asJITFunction *output);
+
+protected:
+	struct SJump
+	{
+		asUINT codePos;
+		asUINT bcPos;
+	};
+
+	bool CompileInstruction(asUINT bcPos);
+	bool IsWorthEntering(asUINT bcPos);
+
+	// Emits the code that returns the control to the VM at the bytecode position
+	void EmitExit(asUINT bcPos);
+	void EmitExitIf(asEX64Cond cc, asUINT bcPos);
+	void EmitJump(int cc, asUINT bcPos);
+
+	void EmitIntCompare(asEX64Cond gt, asEX64Cond lt);
+	void EmitFloatCompare(int prefix);
+	void EmitPush(int reg, bool qword);
+
+	static int Var(short offset) { return -4 * int(offset); }
+
+	asDWORD            *byteCode;
+	asUINT              length;
+	asCX64Assembler     as;
+	asUINT              exitPos;
+	asCArray<int>       nativePos;
+	asCArray<bool>      supported;
+	asCArray<SJump>     jumps;
+	asCArray<SJump>     exits;
+};
+
+asCX64JITFunctionCompiler::asCX64JITFunctionCompiler(asDWORD *in_byteCode, asUINT in_length)
+{
+	byteCode = in_byteCode;
+	length   = in_length;
+	exitPos  = 0;
+}
+
+void asCX64JITFunctionCompiler::EmitExit(asUINT bcPos)
+{
+	as.MovRegImm64(x64RAX, (asQWORD)(asPWORD)(byteCode + bcPos));
+	as.PatchRel32(as.Jmp(), exitPos);
+}
+
+void asCX64JITFunctionCompiler::EmitExitIf(asEX64Cond cc, asUINT bcPos)
+{
+	// The exit stubs are placed after the function body
+	SJump exit = {as.Jcc(cc), bcPos};
+	exits.PushLast(exit);
+}
+
+void asCX64JITFunctionCompiler::EmitJump(int cc, asUINT bcPos)
+{
+	// The destination is resolved when all instructions have been translated
+	SJump jump = {cc < 0 ? as.Jmp() : as.Jcc(asEX64Cond(cc)), bcPos};
+	jumps.PushLast(jump);
+}
+
+void asCX64JITFunctionCompiler::EmitIntCompare(asEX64Cond gt, asEX64Cond lt)
+{
+	// The flags must already have been set by a cmp. The result, 0, -1, or 1, is left in ecx
+	as.Setcc(gt, x64RCX);
+	as.Setcc(lt, x64RDX);
+	as.AluRegReg(0x2B, false, x64RCX, x64RDX);
+	as.MovMemReg(false, x64REG_REGS, x64OFS_VALUEREGISTER, x64RCX);
+}
+
+void asCX64JITFunctionCompiler::EmitFloatCompare(int prefix)
+{
+	// Compares xmm0 with xmm1. The VM treats unordered values as greater than
+	as.MovRegImm32(x64RAX, 1);
+	as.MovRegImm32(x64RCX, asDWORD(-1));
+	as.AluRegReg(0x33, false, x64RDX, x64RDX);
+	as.UcomisReg(prefix, x64XMM0, x64XMM1);
+	as.Cmovcc(x64CC_B, x64RAX, x64RCX);
+	as.Cmovcc(x64CC_E, x64RAX, x64RDX);
+	as.MovRegImm32(x64RCX, 1);
+	as.Cmovcc(x64CC_P, x64RAX, x64RCX);
+	as.MovMemReg(false, x64REG_REGS, x64OFS_VALUEREGISTER, x64RAX);
+}
+
+void asCX64JITFunctionCompiler::EmitPush(int reg, bool qword)
+{
+	as.AluRegImm(5, true, x64REG_SP, qword ? 8 : 4);
+	as.MovMemReg(qword, x64REG_SP, 0, reg);
+}
+
+bool asCX64JITFunctionCompiler::CompileInstruction(asUINT bcPos)
+{
+	asDWORD *l_bc = byteCode + bcPos;
+	asEBCInstr op = asEBCInstr(*(asBYTE*)l_bc);
+
+	const int fp = x64REG_FP;
+	const int vr = x64OFS_VALUEREGISTER;
+
+	switch( op )
+	{
+	case asBC_JitEntry:
+		// The VM passes the control to the JIT function here
+		return true;
+
+	case asBC_SUSPEND:
+		// Let the VM handle the line callback and suspend requests
+		as.CmpMem8Imm(x64REG_REGS, x64OFS_DOSUSPEND, 0);
+		EmitExitIf(x64CC_NE, bcPos);
+		return true;
+
+	// Stack operations
+	case asBC_PopPtr:
+		as.AluRegImm(0, true, x64REG_SP, AS_PTR_SIZE*4);
+		return true;
+	case asBC_PshC4:
+		as.MovRegImm32(x64RAX, asBC_DWORDARG(l_bc));
+		EmitPush(x64RAX, false);
+		return true;
+	case asBC_PshV4:
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		EmitPush(x64RAX, false);
+		return true;
+	case asBC_PshC8:
+		as.MovRegImm64(x64RAX, asBC_QWORDARG(l_bc));
+		EmitPush(x64RAX, true);
+		return true;
+	case asBC_PshV8:
+	case asBC_PshVPtr:
+		as.MovRegMem(true, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		EmitPush(x64RAX, true);
+		return true;
+	case asBC_PSF:
+		as.Lea(x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		EmitPush(x64RAX, true);
+		return true;
+	case asBC_PshNull:
+		as.AluRegReg(0x33, false, x64RAX, x64RAX);
+		EmitPush(x64RAX, true);
+		return true;
+	case asBC_PGA:
+		as.MovRegImm64(x64RAX, asBC_PTRARG(l_bc));
+		EmitPush(x64RAX, true);
+		return true;
+
+	// Variables, globals, and the value register
+	case asBC_SetV1:
+	case asBC_SetV2:
+	case asBC_SetV4:
+		as.MovMemImm(false, fp, Var(asBC_SWORDARG0(l_bc)), asBC_DWORDARG(l_bc));
+		return true;
+	case asBC_SetV8:
+		as.MovRegImm64(x64RAX, asBC_QWORDARG(l_bc));
+		as.MovMemReg(true, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_CpyVtoV4:
+	case asBC_CpyVtoV8:
+		as.MovRegMem(op == asBC_CpyVtoV8, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovMemReg(op == asBC_CpyVtoV8, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_CpyVtoR4:
+	case asBC_CpyVtoR8:
+		as.MovRegMem(op == asBC_CpyVtoR8, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		as.MovMemReg(op == asBC_CpyVtoR8, x64REG_REGS, vr, x64RAX);
+		return true;
+	case asBC_CpyRtoV4:
+	case asBC_CpyRtoV8:
+		as.MovRegMem(op == asBC_CpyRtoV8, x64RAX, x64REG_REGS, vr);
+		as.MovMemReg(op == asBC_CpyRtoV8, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_CpyGtoV4:
+		as.MovRegImm64(x64RCX, asBC_PTRARG(l_bc));
+		as.MovRegMem(false, x64RAX, x64RCX, 0);
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_CpyVtoG4:
+		as.MovRegImm64(x64RCX, asBC_PTRARG(l_bc));
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		as.MovMemReg(false, x64RCX, 0, x64RAX);
+		return true;
+	case asBC_SetG4:
+		as.MovRegImm64(x64RCX, asBC_PTRARG(l_bc));
+		as.MovMemImm(false, x64RCX, 0, asBC_DWORDARG(l_bc+AS_PTR_SIZE));
+		return true;
+	case asBC_LdGRdR4:
+		as.MovRegImm64(x64RCX, asBC_PTRARG(l_bc));
+		as.MovMemReg(true, x64REG_REGS, vr, x64RCX);
+		as.MovRegMem(false, x64RAX, x64RCX, 0);
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_RDR4:
+	case asBC_RDR8:
+		as.MovRegMem(true, x64RCX, x64REG_REGS, vr);
+		as.MovRegMem(op == asBC_RDR8, x64RAX, x64RCX, 0);
+		as.MovMemReg(op == asBC_RDR8, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_WRTV4:
+	case asBC_WRTV8:
+		as.MovRegMem(true, x64RCX, x64REG_REGS, vr);
+		as.MovRegMem(op == asBC_WRTV8, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		as.MovMemReg(op == asBC_WRTV8, x64RCX, 0, x64RAX);
+		return true;
+	case asBC_INCi:
+	case asBC_DECi:
+		as.MovRegMem(true, x64RCX, x64REG_REGS, vr);
+		as.IncDecMem(op == asBC_INCi ? 0 : 1, false, x64RCX, 0);
+		return true;
+	case asBC_ClrHi:
+		as.AluMemImm(4, false, x64REG_REGS, vr, 0xFF);
+		return true;
+
+	// Properties of script objects
+	case asBC_LoadThisR:
+	case asBC_LoadRObjR:
+		as.MovRegMem(true, x64RAX, fp, op == asBC_LoadThisR ? 0 : Var(asBC_SWORDARG0(l_bc)));
+		as.TestRegReg(true, x64RAX, x64RAX);
+		EmitExitIf(x64CC_E, bcPos);
+		as.Lea(x64RAX, x64RAX, op == asBC_LoadThisR ? asBC_SWORDARG0(l_bc) : asBC_SWORDARG1(l_bc));
+		as.MovMemReg(true, x64REG_REGS, vr, x64RAX);
+		return true;
+	case asBC_LoadVObjR:
+		as.Lea(x64RAX, fp, Var(asBC_SWORDARG0(l_bc)) + asBC_SWORDARG1(l_bc));
+		as.MovMemReg(true, x64REG_REGS, vr, x64RAX);
+		return true;
+	case asBC_CpyThisToV4:
+	case asBC_CpyVtoThis4:
+		as.MovRegMem(true, x64RAX, fp, 0);
+		as.TestRegReg(true, x64RAX, x64RAX);
+		EmitExitIf(x64CC_E, bcPos);
+		if( op == asBC_CpyThisToV4 )
+		{
+			as.MovRegMem(false, x64RCX, x64RAX, asBC_SWORDARG1(l_bc));
+			as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RCX);
+		}
+		else
+		{
+			as.MovRegMem(false, x64RCX, fp, Var(asBC_SWORDARG0(l_bc)));
+			as.MovMemReg(false, x64RAX, asBC_SWORDARG1(l_bc), x64RCX);
+		}
+		return true;
+
+	// Integer math
+	case asBC_IncVi:
+	case asBC_DecVi:
+		as.IncDecMem(op == asBC_IncVi ? 0 : 1, false, fp, Var(asBC_SWORDARG0(l_bc)));
+		return true;
+	case asBC_NEGi:
+	case asBC_NEGi64:
+		as.NotNegMem(3, op == asBC_NEGi64, fp, Var(asBC_SWORDARG0(l_bc)));
+		return true;
+	case asBC_BNOT:
+	case asBC_BNOT64:
+		as.NotNegMem(2, op == asBC_BNOT64, fp, Var(asBC_SWORDARG0(l_bc)));
+		return true;
+	case asBC_NOT:
+		as.AluRegReg(0x33, false, x64RCX, x64RCX);
+		as.CmpMem8Imm(fp, Var(asBC_SWORDARG0(l_bc)), 0);
+		as.Setcc(x64CC_E, x64RCX);
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RCX);
+		return true;
+	case asBC_ADDi:   case asBC_SUBi:   case asBC_BAND:   case asBC_BOR:   case asBC_BXOR:
+	case asBC_ADDi64: case asBC_SUBi64: case asBC_BAND64: case asBC_BOR64: case asBC_BXOR64:
+		{
+			bool w = op >= asBC_ADDi64;
+			asBYTE alu = 0;
+			switch( op )
+			{
+			case asBC_ADDi: case asBC_ADDi64: alu = 0x03; break;
+			case asBC_SUBi: case asBC_SUBi64: alu = 0x2B; break;
+			case asBC_BAND: case asBC_BAND64: alu = 0x23; break;
+			case asBC_BOR:  case asBC_BOR64:  alu = 0x0B; break;
+			default:                          alu = 0x33; break;
+			}
+			as.MovRegMem(w, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+			as.AluRegMem(alu, w, x64RAX, fp, Var(asBC_SWORDARG2(l_bc)));
+			as.MovMemReg(w, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		}
+		return true;
+	case asBC_MULi:
+	case asBC_MULi64:
+		as.MovRegMem(op == asBC_MULi64, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.ImulRegMem(op == asBC_MULi64, x64RAX, fp, Var(asBC_SWORDARG2(l_bc)));
+		as.MovMemReg(op == asBC_MULi64, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_DIVi:
+	case asBC_MODi:
+	case asBC_DIVu:
+	case asBC_MODu:
+		// Division by zero, and the overflow of int(0x80000000)/-1 are raised by the VM
+		as.MovRegMem(false, x64RCX, fp, Var(asBC_SWORDARG2(l_bc)));
+		as.TestRegReg(false, x64RCX, x64RCX);
+		EmitExitIf(x64CC_E, bcPos);
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		if( op == asBC_DIVi || op == asBC_MODi )
+		{
+			as.AluRegImm(7, false, x64RCX, asDWORD(-1));
+			EmitExitIf(x64CC_E, bcPos);
+			as.Cdq();
+			as.DivReg(7, x64RCX);
+		}
+		else
+		{
+			as.AluRegReg(0x33, false, x64RDX, x64RDX);
+			as.DivReg(6, x64RCX);
+		}
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), (op == asBC_DIVi || op == asBC_DIVu) ? x64RAX : x64RDX);
+		return true;
+	case asBC_ADDIi:
+	case asBC_SUBIi:
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.AluRegImm(op == asBC_ADDIi ? 0 : 5, false, x64RAX, asBC_DWORDARG(l_bc+1));
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_MULIi:
+		as.MovRegMem(false, x64RCX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.ImulRegRegImm(x64RAX, x64RCX, asBC_DWORDARG(l_bc+1));
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_BSLL:
+	case asBC_BSRL:
+	case asBC_BSRA:
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovRegMem(false, x64RCX, fp, Var(asBC_SWORDARG2(l_bc)));
+		as.ShiftRegCl(op == asBC_BSLL ? 4 : op == asBC_BSRL ? 5 : 7, x64RAX);
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+
+	// Floating point math
+	case asBC_ADDf: case asBC_SUBf: case asBC_MULf:
+	case asBC_ADDd: case asBC_SUBd: case asBC_MULd:
+		{
+			int prefix = (op == asBC_ADDf || op == asBC_SUBf || op == asBC_MULf) ? 0xF3 : 0xF2;
+			asBYTE arith = (op == asBC_ADDf || op == asBC_ADDd) ? 0x58 : (op == asBC_SUBf || op == asBC_SUBd) ? 0x5C : 0x59;
+			as.MovsMem(prefix, x64XMM0, fp, Var(asBC_SWORDARG1(l_bc)));
+			as.SseArithMem(prefix, arith, x64XMM0, fp, Var(asBC_SWORDARG2(l_bc)));
+			as.MovsToMem(prefix, fp, Var(asBC_SWORDARG0(l_bc)), x64XMM0);
+		}
+		return true;
+	case asBC_DIVf:
+	case asBC_DIVd:
+		{
+			// Division by zero is raised by the VM
+			int prefix = op == asBC_DIVf ? 0xF3 : 0xF2;
+			as.MovsMem(prefix, x64XMM1, fp, Var(asBC_SWORDARG2(l_bc)));
+			as.XorpsReg(x64XMM2, x64XMM2);
+			as.UcomisReg(prefix, x64XMM1, x64XMM2);
+			EmitExitIf(x64CC_E, bcPos);
+			as.MovsMem(prefix, x64XMM0, fp, Var(asBC_SWORDARG1(l_bc)));
+			as.SseArithReg(prefix, 0x5E, x64XMM0, x64XMM1);
+			as.MovsToMem(prefix, fp, Var(asBC_SWORDARG0(l_bc)), x64XMM0);
+		}
+		return true;
+	case asBC_ADDIf:
+	case asBC_SUBIf:
+	case asBC_MULIf:
+		as.MovRegImm32(x64RAX, asBC_DWORDARG(l_bc+1));
+		as.MovdXmmReg(x64XMM1, x64RAX);
+		as.MovsMem(0xF3, x64XMM0, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.SseArithReg(0xF3, op == asBC_ADDIf ? 0x58 : op == asBC_SUBIf ? 0x5C : 0x59, x64XMM0, x64XMM1);
+		as.MovsToMem(0xF3, fp, Var(asBC_SWORDARG0(l_bc)), x64XMM0);
+		return true;
+	case asBC_NEGf:
+		as.AluMemImm(6, false, fp, Var(asBC_SWORDARG0(l_bc)), 0x80000000);
+		return true;
+	case asBC_NEGd:
+		as.MovRegMem(true, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		as.BtcRegImm(x64RAX, 63);
+		as.MovMemReg(true, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+
+	// Comparisons
+	case asBC_CMPi:
+	case asBC_CMPu:
+	case asBC_CMPi64:
+	case asBC_CMPu64:
+		{
+			bool w = op == asBC_CMPi64 || op == asBC_CMPu64;
+			as.MovRegMem(w, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+			as.AluRegReg(0x33, false, x64RCX, x64RCX);
+			as.AluRegReg(0x33, false, x64RDX, x64RDX);
+			as.AluRegMem(0x3B, w, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+			if( op == asBC_CMPi || op == asBC_CMPi64 )
+				EmitIntCompare(x64CC_G, x64CC_L);
+			else
+				EmitIntCompare(x64CC_A, x64CC_B);
+		}
+		return true;
+	case asBC_CMPIi:
+	case asBC_CMPIu:
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		as.AluRegReg(0x33, false, x64RCX, x64RCX);
+		as.AluRegReg(0x33, false, x64RDX, x64RDX);
+		as.AluRegImm(7, false, x64RAX, asBC_DWORDARG(l_bc));
+		if( op == asBC_CMPIi )
+			EmitIntCompare(x64CC_G, x64CC_L);
+		else
+			EmitIntCompare(x64CC_A, x64CC_B);
+		return true;
+	case asBC_CMPf:
+	case asBC_CMPd:
+		{
+			int prefix = op == asBC_CMPf ? 0xF3 : 0xF2;
+			as.MovsMem(prefix, x64XMM0, fp, Var(asBC_SWORDARG0(l_bc)));
+			as.MovsMem(prefix, x64XMM1, fp, Var(asBC_SWORDARG1(l_bc)));
+			EmitFloatCompare(prefix);
+		}
+		return true;
+	case asBC_CMPIf:
+		as.MovRegImm32(x64RAX, asBC_DWORDARG(l_bc));
+		as.MovdXmmReg(x64XMM1, x64RAX);
+		as.MovsMem(0xF3, x64XMM0, fp, Var(asBC_SWORDARG0(l_bc)));
+		EmitFloatCompare(0xF3);
+		return true;
+	case asBC_TZ:  case asBC_TNZ:
+	case asBC_TS:  case asBC_TNS:
+	case asBC_TP:  case asBC_TNP:
+		{
+			asEX64Cond cc = x64CC_E;
+			switch( op )
+			{
+			case asBC_TZ:  cc = x64CC_E;  break;
+			case asBC_TNZ: cc = x64CC_NE; break;
+			case asBC_TS:  cc = x64CC_L;  break;
+			case asBC_TNS: cc = x64CC_GE; break;
+			case asBC_TP:  cc = x64CC_G;  break;
+			default:       cc = x64CC_LE; break;
+			}
+			// The boolean is stored in the lower byte and the rest of the register is cleared
+			as.AluRegReg(0x33, false, x64RCX, x64RCX);
+			as.AluMemImm(7, false, x64REG_REGS, vr, 0);
+			as.Setcc(cc, x64RCX);
+			as.MovMemReg(true, x64REG_REGS, vr, x64RCX);
+		}
+		return true;
+
+	// Branches
+	case asBC_JMP:
+		EmitJump(-1, bcPos + asBC_INTARG(l_bc) + 2);
+		return true;
+	case asBC_JZ:  case asBC_JNZ:
+	case asBC_JS:  case asBC_JNS:
+	case asBC_JP:  case asBC_JNP:
+		{
+			asEX64Cond cc = x64CC_E;
+			switch( op )
+			{
+			case asBC_JZ:  cc = x64CC_E;  break;
+			case asBC_JNZ: cc = x64CC_NE; break;
+			case asBC_JS:  cc = x64CC_L;  break;
+			case asBC_JNS: cc = x64CC_GE; break;
+			case asBC_JP:  cc = x64CC_G;  break;
+			default:       cc = x64CC_LE; break;
+			}
+			as.AluMemImm(7, false, x64REG_REGS, vr, 0);
+			EmitJump(cc, bcPos + asBC_INTARG(l_bc) + 2);
+		}
+		return true;
+	case asBC_JLowZ:
+	case asBC_JLowNZ:
+		as.CmpMem8Imm(x64REG_REGS, vr, 0);
+		EmitJump(op == asBC_JLowZ ? x64CC_E : x64CC_NE, bcPos + asBC_INTARG(l_bc) + 2);
+		return true;
+	case asBC_CMPIiJZ:  case asBC_CMPIiJNZ:
+	case asBC_CMPIiJS:  case asBC_CMPIiJNS:
+	case asBC_CMPIiJP:  case asBC_CMPIiJNP:
+		{
+			asEX64Cond cc = x64CC_E;
+			switch( op )
+			{
+			case asBC_CMPIiJZ:  cc = x64CC_E;  break;
+			case asBC_CMPIiJNZ: cc = x64CC_NE; break;
+			case asBC_CMPIiJS:  cc = x64CC_L;  break;
+			case asBC_CMPIiJNS: cc = x64CC_GE; break;
+			case asBC_CMPIiJP:  cc = x64CC_G;  break;
+			default:            cc = x64CC_LE; break;
+			}
+			as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+			as.AluRegReg(0x33, false, x64RCX, x64RCX);
+			as.AluRegReg(0x33, false, x64RDX, x64RDX);
+			as.AluRegImm(7, false, x64RAX, asBC_DWORDARG(l_bc));
+			EmitIntCompare(x64CC_G, x64CC_L);
+			as.TestRegReg(false, x64RCX, x64RCX);
+			EmitJump(cc, bcPos + *(int*)(l_bc+2) + 3);
+		}
+		return true;
+
+	// Conversions
+	case asBC_iTOf:
+		as.Cvtsi2sMem(0xF3, x64XMM0, fp, Var(asBC_SWORDARG0(l_bc)));
+		as.MovsToMem(0xF3, fp, Var(asBC_SWORDARG0(l_bc)), x64XMM0);
+		return true;
+	case asBC_fTOi:
+		as.Cvtts2siMem(0xF3, x64RAX, fp, Var(asBC_SWORDARG0(l_bc)));
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_iTOd:
+		as.Cvtsi2sMem(0xF2, x64XMM0, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovsToMem(0xF2, fp, Var(asBC_SWORDARG0(l_bc)), x64XMM0);
+		return true;
+	case asBC_dTOi:
+		as.Cvtts2siMem(0xF2, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_fTOd:
+		as.Cvts2sMem(0xF3, x64XMM0, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovsToMem(0xF2, fp, Var(asBC_SWORDARG0(l_bc)), x64XMM0);
+		return true;
+	case asBC_dTOf:
+		as.Cvts2sMem(0xF2, x64XMM0, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovsToMem(0xF3, fp, Var(asBC_SWORDARG0(l_bc)), x64XMM0);
+		return true;
+	case asBC_sbTOi:
+	case asBC_swTOi:
+	case asBC_ubTOi:
+	case asBC_uwTOi:
+	case asBC_iTOb:
+	case asBC_iTOw:
+		{
+			int var = Var(asBC_SWORDARG0(l_bc));
+			if( op == asBC_sbTOi )                         as.MovsxRegMem8(x64RAX, fp, var);
+			else if( op == asBC_swTOi )                    as.MovsxRegMem16(x64RAX, fp, var);
+			else if( op == asBC_ubTOi || op == asBC_iTOb ) as.MovzxRegMem8(x64RAX, fp, var);
+			else                                           as.MovzxRegMem16(x64RAX, fp, var);
+			as.MovMemReg(false, fp, var, x64RAX);
+		}
+		return true;
+	case asBC_i64TOi:
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovMemReg(false, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_iTOi64:
+		as.MovsxdRegMem(x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovMemReg(true, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+	case asBC_uTOi64:
+		as.MovRegMem(false, x64RAX, fp, Var(asBC_SWORDARG1(l_bc)));
+		as.MovMemReg(true, fp, Var(asBC_SWORDARG0(l_bc)), x64RAX);
+		return true;
+
+	default:
+		// Everything else is executed by the VM
+		return false;
+	}
+}
+
+bool asCX64JITFunctionCompiler::IsWorthEntering(asUINT bcPos)
+{
+	// Passing the control between the VM and the JIT function costs about as
+	// much as interpreting a few instructions, so the entry is only used if
+	// the native code will execute a loop or a longer sequence of instructions
+	const int minInstructions = 5;
+
+	int count = 0;
+	for( asUINT pos = bcPos; pos < length; )
+	{
+		asEBCInstr op = asEBCInstr(*(asBYTE*)&byteCode[pos]);
+		if( !supported[pos] )
+			break;
+
+		if( op != asBC_JitEntry && op != asBC_SUSPEND && ++count >= minInstructions )
+			return true;
+
+		// A backwards jump is most likely a loop
+		if( op == asBC_JMP && asBC_INTARG(&byteCode[pos]) < 0 )
+			return true;
+		if( op >= asBC_CMPIiJZ && op <= asBC_CMPIiJNP && *(int*)&byteCode[pos+2] < 0 )
+			return true;
+		if( ((op >= asBC_JZ && op <= asBC_JNP) || op == asBC_JLowZ || op == asBC_JLowNZ) && asBC_INTARG(&byteCode[pos]) < 0 )
+			return true;
+
+		pos += asBCTypeSize[asBCInfo[op].type];
+	}
+
+	return false;
+}
+
+int asCX64JITFunctionCompiler::Compile(asJITFunction *output)
+{
+	// Function entry. The VM registers are loaded into the CPU
+	// registers, and then the code jumps to the position given
+	// by the argument from the JitEntry instruction
+	as.Push(x64RBX);
+	as.Push(x64R12);
+	as.Push(x64R13);
+	as.MovRegReg(true, x64REG_REGS, x64RDI);
+	as.MovRegMem(true, x64REG_FP, x64REG_REGS, x64OFS_STACKFRAME);
+	as.MovRegMem(true, x64REG_SP, x64REG_REGS, x64OFS_STACKPOINTER);
+	as.JmpReg(x64RSI);
+
+	// Common exit. rax holds the bytecode position where the VM will continue
+	exitPos = as.GetPos();
+	as.MovMemReg(true, x64REG_REGS, x64OFS_PROGRAMPOINTER, x64RAX);
+	as.MovMemReg(true, x64REG_REGS, x64OFS_STACKPOINTER, x64REG_SP);
+	as.Pop(x64R13);
+	as.Pop(x64R12);
+	as.Pop(x64RBX);
+	as.Ret();
+
+	// Translate each instruction. The ones that are not supported
+	// simply return the control to the VM at the same position
+	nativePos.SetLength(length);
+	supported.SetLength(length);
+	for( asUINT n = 0; n < length; n++ )
+	{
+		nativePos[n] = -1;
+		supported[n] = false;
+	}
+
+	asUINT pos;
+	for( pos = 0; pos < length; )
+	{
+		asEBCInstr op = asEBCInstr(*(asBYTE*)&byteCode[pos]);
+
+		nativePos[pos] = as.GetPos();
+		supported[pos] = CompileInstruction(pos);
+		if( !supported[pos] )
+			EmitExit(pos);
+
+		pos += asBCTypeSize[asBCInfo[op].type];
+	}
+
+	// Resolve the jumps between the instructions
+	for( asUINT n = 0; n < jumps.GetLength(); n++ )
+	{
+		asASSERT( jumps[n].bcPos < length && nativePos[jumps[n].bcPos] >= 0 );
+		if( jumps[n].bcPos >= length || nativePos[jumps[n].bcPos] < 0 )
+			return asERROR;
+		as.PatchRel32(jumps[n].codePos, nativePos[jumps[n].bcPos]);
+	}
+
+	// Add the exit stubs for the instructions that may need the VM to raise an exception
+	for( asUINT n = 0; n < exits.GetLength(); n++ )
+	{
+		as.PatchRel32(exits[n].codePos, as.GetPos());
+		EmitExit(exits[n].bcPos);
+	}
+
+	// Is there anything to gain from passing the control to the JIT function?
+	bool hasEntry = false;
+	for( pos = 0; pos < length; )
+	{
+		asEBCInstr op = asEBCInstr(*(asBYTE*)&byteCode[pos]);
+		asUINT next = pos + asBCTypeSize[asBCInfo[op].type];
+		if( op == asBC_JitEntry && IsWorthEntering(pos) )
+			hasEntry = true;
+		pos = next;
+	}
+	if( !hasEntry )
+		return asNOT_SUPPORTED;
+
+	// Copy the code to executable memory. The size of the
+	// allocation is stored in the header so it can be freed later
+	size_t size = x64CODE_HEADER_SIZE + as.code.GetLength();
+	void *mem = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if( mem == MAP_FAILED )
+		return asOUT_OF_MEMORY;
+	*(size_t*)mem = size;
+	asBYTE *code = (asBYTE*)mem + x64CODE_HEADER_SIZE;
+	memcpy(code, as.code.AddressOf(), as.code.GetLength());
+	if( mprotect(mem, size, PROT_READ | PROT_EXEC) != 0 )
+	{
+		munmap(mem, size);
+		return asERROR;
+	}
+
+	// Set the argument of each JitEntry to the address of the native code
+	// that continues the execution, or 0 if the VM should ignore the entry
+	for( pos = 0; pos < length; )
+	{
+		asEBCInstr op = asEBCInstr(*(asBYTE*)&byteCode[pos]);
+		asUINT next = pos + asBCTypeSize[asBCInfo[op].type];
+		if( op == asBC_JitEntry )
+		{
+			if( IsWorthEntering(pos) )
+				*(asPWORD*)&byteCode[pos+1] = (asPWORD)(code + nativePos[pos]);
+			else
+				*(asPWORD*)&byteCode[pos+1] = 0;
+		}
+		pos = next;
+	}
+
+	*output = (asJITFunction)code;
+
+	return asSUCCESS;
+}
+
+// The JIT compiler object that is registered with the engine
+class asCJITCompiler : public asIJITCompiler
+{
+public:
+	int CompileFunction(asIScriptFunction *function, asJITFunction *output)
+	{
+		*output = 0;
+
+		asUINT length;
+		asDWORD *byteCode = function->GetByteCode(&length);
+		if( byteCode == 0 )
+			return asINVALID_ARG;
+
+		asCX64JITFunctionCompiler compiler(byteCode, length);
+		return compiler.Compile(output);
+	}
+
+	void ReleaseJITFunction(asJITFunction func)
+	{
+		if( func == 0 )
+			return;
+
+		void *mem = (asBYTE*)func - x64CODE_HEADER_SIZE;
+		munmap(mem, *(size_t*)mem);
+	}
+};
+
+#endif // AS_JIT_X64_GCC
+
+// interface
+AS_API asIJITCompiler *asCreateJITCompiler()
+{
+#ifdef AS_JIT_X64_GCC
+	return asNEW(asCJITCompiler);
+#else
+	// There is no built-in JIT compiler for this platform
+	return 0;
+#endif
+}
+
+// interface
+AS_API void asDestroyJITCompiler(asIJITCompiler *jit)
+{
+#ifdef AS_JIT_X64_GCC
+	if( jit )
+		asDELETE(static_cast<asCJITCompiler*>(jit), asCJITCompiler);
+#else
+	UNUSED_VAR(jit);
+#endif
+}
+
+END_AS_NAMESPACE
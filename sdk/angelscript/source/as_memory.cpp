@@ -46,9 +46,16 @@
 #include "as_memory.h"
 #include "as_scriptnode.h"
 #include "as_bytecode.h"
+#include "as_thread.h"
 
 BEGIN_AS_NAMESPACE
 
+// Each thread keeps a small cache of free script nodes and byte instructions. The shared
+// pools in the memory manager are only accessed when the local cache is empty or full, and
+// then a whole batch of blocks is moved at a time so the lock is taken less frequently.
+static const asUINT LOCAL_POOL_MAX   = 256;
+static const asUINT LOCAL_POOL_BATCH = 64;
+
 #ifdef WIP_16BYTE_ALIGN
 
 // TODO: Add support for 16byte aligned application types (e.g. __m128). The following is a list of things that needs to be implemented:
@@ -183,47 +190,133 @@ void asFreeMem(void *mem)
 
 asCMemoryMgr::asCMemoryMgr()
 {
+#ifndef AS_NO_COMPILER
+	arenaOwner = 0;
+	arenaPos   = 0;
+	arenaEnd   = 0;
+#endif
+	maxPooledStackBlocks = 16;
+	stackBlocksAllocated = 0;
+	stackBlocksReused    = 0;
 }
 
 asCMemoryMgr::~asCMemoryMgr()
 {
+#ifndef AS_NO_COMPILER
+	EndBuildArena();
+#endif
 	FreeUnusedMemory();
+	FreeUnusedStackBlocks();
 }
 
 void asCMemoryMgr::FreeUnusedMemory()
 {
-	// It's necessary to protect the scriptNodePool from multiple 
-	// simultaneous accesses, as the parser is used by several methods
-	// that can be executed simultaneously.
+	// Release the blocks cached by the current thread too. The caches of
+	// other threads are released when those threads clean up their local data
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+	if( tld )
+	{
+		FreePool(tld->freeScriptNodes);
+		FreePool(tld->freeByteInstructions);
+	}
+
+	// It's necessary to protect the pools from multiple simultaneous
+	// accesses, as the parser is used by several methods that can be
+	// executed simultaneously.
 	ENTERCRITICALSECTION(cs);
 
-	int n;
-	for( n = 0; n < (signed)scriptNodePool.GetLength(); n++ )
-		userFree(scriptNodePool[n]);
-	scriptNodePool.Allocate(0, false);
+	FreePool(scriptNodePool);
+	FreePool(byteInstructionPool);
 
 	LEAVECRITICALSECTION(cs);
+}
 
-	// The engine already protects against multiple threads 
-	// compiling scripts simultaneously so this pool doesn't have 
-	// to be protected again.
-	for( n = 0; n < (signed)byteInstructionPool.GetLength(); n++ )
-		userFree(byteInstructionPool[n]);
-	byteInstructionPool.Allocate(0, false);
+// internal
+void asCMemoryMgr::FreePool(asCArray<void*> &pool)
+{
+	for( asUINT n = 0; n < pool.GetLength(); n++ )
+		userFree(pool[n]);
+	pool.Allocate(0, false);
 }
 
-void *asCMemoryMgr::AllocScriptNode()
+// internal
+void *asCMemoryMgr::AllocFromPool(asCArray<void*> *localPool, asCArray<void*> &sharedPool)
 {
-	ENTERCRITICALSECTION(cs);
+	if( localPool == 0 )
+	{
+		// Without a thread local cache the shared pool is used directly
+		void *ptr = 0;
+		ENTERCRITICALSECTION(cs);
+		if( sharedPool.GetLength() )
+			ptr = sharedPool.PopLast();
+		LEAVECRITICALSECTION(cs);
+		return ptr;
+	}
 
-	if( scriptNodePool.GetLength() )
+	if( localPool->GetLength() == 0 )
 	{
-		void *tRet = scriptNodePool.PopLast();
+		// Take a batch of blocks from the shared pool
+		ENTERCRITICALSECTION(cs);
+		asUINT count = sharedPool.GetLength() < LOCAL_POOL_BATCH ? sharedPool.GetLength() : LOCAL_POOL_BATCH;
+		if( count )
+		{
+			if( localPool->GetCapacity() < LOCAL_POOL_MAX )
+				localPool->Allocate(LOCAL_POOL_MAX, false);
+			for( asUINT n = 0; n < count; n++ )
+				localPool->PushLast(sharedPool.PopLast());
+		}
 		LEAVECRITICALSECTION(cs);
-		return tRet;
+
+		if( count == 0 )
+			return 0;
 	}
 
-	LEAVECRITICALSECTION(cs);
+	return localPool->PopLast();
+}
+
+// internal
+void asCMemoryMgr::ReturnToPool(void *ptr, asCArray<void*> *localPool, asCArray<void*> &sharedPool)
+{
+	if( localPool == 0 )
+	{
+		ENTERCRITICALSECTION(cs);
+
+		// Pre allocate memory for the array to avoid slow growth
+		if( sharedPool.GetLength() == 0 )
+			sharedPool.Allocate(100, 0);
+
+		sharedPool.PushLast(ptr);
+
+		LEAVECRITICALSECTION(cs);
+		return;
+	}
+
+	if( localPool->GetLength() >= LOCAL_POOL_MAX )
+	{
+		// Move a batch of blocks to the shared pool so other threads can use them
+		ENTERCRITICALSECTION(cs);
+		if( sharedPool.GetCapacity() < sharedPool.GetLength() + LOCAL_POOL_BATCH )
+			sharedPool.Allocate(sharedPool.GetLength()*2 + LOCAL_POOL_BATCH, true);
+		for( asUINT n = 0; n < LOCAL_POOL_BATCH; n++ )
+			sharedPool.PushLast(localPool->PopLast());
+		LEAVECRITICALSECTION(cs);
+	}
+	else if( localPool->GetCapacity() < LOCAL_POOL_MAX )
+		localPool->Allocate(LOCAL_POOL_MAX, true);
+
+	localPool->PushLast(ptr);
+}
+
+void *asCMemoryMgr::AllocScriptNode()
+{
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+#ifndef AS_NO_COMPILER
+	if( arenaOwner && arenaOwner == tld )
+		return AllocFromArena(arenaScriptNodes, sizeof(asCScriptNode));
+#endif
+	void *ptr = AllocFromPool(tld ? &tld->freeScriptNodes : 0, scriptNodePool);
+	if( ptr )
+		return ptr;
 
 #if defined(AS_DEBUG) 
 	return ((asALLOCFUNCDEBUG_t)(userAlloc))(sizeof(asCScriptNode), __FILE__, __LINE__);
@@ -234,23 +327,27 @@ void *asCMemoryMgr::AllocScriptNode()
 
 void asCMemoryMgr::FreeScriptNode(void *ptr)
 {
-	ENTERCRITICALSECTION(cs);
-
-	// Pre allocate memory for the array to avoid slow growth
-	if( scriptNodePool.GetLength() == 0 )
-		scriptNodePool.Allocate(100, 0);
-
-	scriptNodePool.PushLast(ptr);
-
-	LEAVECRITICALSECTION(cs);
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+#ifndef AS_NO_COMPILER
+	if( arenaOwner && arenaOwner == tld )
+	{
+		arenaScriptNodes.PushLast(ptr);
+		return;
+	}
+#endif
+	ReturnToPool(ptr, tld ? &tld->freeScriptNodes : 0, scriptNodePool);
 }
 
 #ifndef AS_NO_COMPILER
 
 void *asCMemoryMgr::AllocByteInstruction()
 {
-	if( byteInstructionPool.GetLength() )
-		return byteInstructionPool.PopLast();
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+	if( arenaOwner && arenaOwner == tld )
+		return AllocFromArena(arenaByteInstructions, sizeof(asCByteInstruction));
+	void *ptr = AllocFromPool(tld ? &tld->freeByteInstructions : 0, byteInstructionPool);
+	if( ptr )
+		return ptr;
 
 #if defined(AS_DEBUG) 
 	return ((asALLOCFUNCDEBUG_t)(userAlloc))(sizeof(asCByteInstruction), __FILE__, __LINE__);
@@ -261,15 +358,172 @@ void *asCMemoryMgr::AllocByteInstruction()
 
 void asCMemoryMgr::FreeByteInstruction(void *ptr)
 {
-	// Pre allocate memory for the array to avoid slow growth
-	if( byteInstructionPool.GetLength() == 0 )
-		byteInstructionPool.Allocate(100, 0);
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+	if( arenaOwner && arenaOwner == tld )
+	{
+		arenaByteInstructions.PushLast(ptr);
+		return;
+	}
+	ReturnToPool(ptr, tld ? &tld->freeByteInstructions : 0, byteInstructionPool);
+}
 
-	byteInstructionPool.PushLast(ptr);
+// The size of each memory chunk in the build arena
+static const size_t ARENA_CHUNK_SIZE = 64*1024;
+
+void asCMemoryMgr::BeginBuildArena()
+{
+	asASSERT( arenaOwner == 0 );
+
+	// Without thread local data the arena cannot tell the building thread from the others
+	arenaOwner = asCThreadManager::GetLocalData();
+}
+
+void asCMemoryMgr::EndBuildArena()
+{
+	if( arenaOwner == 0 )
+		return;
+
+	for( asUINT n = 0; n < arenaChunks.GetLength(); n++ )
+		userFree(arenaChunks[n]);
+	arenaChunks.Allocate(0, false);
+	arenaScriptNodes.Allocate(0, false);
+	arenaByteInstructions.Allocate(0, false);
+	arenaPos   = 0;
+	arenaEnd   = 0;
+	arenaOwner = 0;
+}
+
+// internal
+void *asCMemoryMgr::AllocFromArena(asCArray<void*> &arenaPool, size_t size)
+{
+	if( arenaPool.GetLength() )
+		return arenaPool.PopLast();
+
+	// Keep the blocks aligned for any type of member
+	size = (size + 15) & ~size_t(15);
+	if( arenaPos + size > arenaEnd )
+	{
+#if defined(AS_DEBUG)
+		arenaPos = (asBYTE*)((asALLOCFUNCDEBUG_t)(userAlloc))(ARENA_CHUNK_SIZE, __FILE__, __LINE__);
+#else
+		arenaPos = (asBYTE*)userAlloc(ARENA_CHUNK_SIZE);
+#endif
+		arenaEnd = arenaPos + ARENA_CHUNK_SIZE;
+		arenaChunks.PushLast(arenaPos);
+	}
+
+	void *ptr = arenaPos;
+	arenaPos += size;
+	return ptr;
 }
 
 #endif // AS_NO_COMPILER
 
+asDWORD *asCMemoryMgr::AllocStackBlock(asUINT size)
+{
+	ENTERCRITICALSECTION(stackBlockCs);
+
+	// The contexts always request the blocks in the same sizes, so
+	// it is enough to look for a block with exactly the same size
+	for( asUINT n = stackBlockPool.GetLength(); n-- > 0; )
+	{
+		if( stackBlockPool[n].size == size )
+		{
+			asDWORD *block = stackBlockPool[n].block;
+			stackBlockPool[n] = stackBlockPool[stackBlockPool.GetLength()-1];
+			stackBlockPool.PopLast();
+			stackBlocksReused++;
+
+			LEAVECRITICALSECTION(stackBlockCs);
+			return block;
+		}
+	}
+
+	stackBlocksAllocated++;
+
+	LEAVECRITICALSECTION(stackBlockCs);
+
+#ifndef WIP_16BYTE_ALIGN
+	return asNEWARRAY(asDWORD, size);
+#else
+	return asNEWARRAYALIGNED(asDWORD, size, MAX_TYPE_ALIGNMENT);
+#endif
+}
+
+void asCMemoryMgr::FreeStackBlock(asDWORD *block, asUINT size)
+{
+	ENTERCRITICALSECTION(stackBlockCs);
+
+	asUINT count = stackBlockPool.GetLength();
+	if( count < maxPooledStackBlocks )
+	{
+		SStackBlock entry = {block, size};
+		stackBlockPool.PushLast(entry);
+
+		// If the array couldn't grow the block must be freed instead
+		if( stackBlockPool.GetLength() > count )
+		{
+			LEAVECRITICALSECTION(stackBlockCs);
+			return;
+		}
+	}
+
+	LEAVECRITICALSECTION(stackBlockCs);
+
+#ifndef WIP_16BYTE_ALIGN
+	asDELETEARRAY(block);
+#else
+	asDELETEARRAYALIGNED(block);
+#endif
+}
+
+void asCMemoryMgr::FreeUnusedStackBlocks()
+{
+	ENTERCRITICALSECTION(stackBlockCs);
+
+	for( asUINT n = 0; n < stackBlockPool.GetLength(); n++ )
+	{
+#ifndef WIP_16BYTE_ALIGN
+		asDELETEARRAY(stackBlockPool[n].block);
+#else
+		asDELETEARRAYALIGNED(stackBlockPool[n].block);
+#endif
+	}
+	stackBlockPool.Allocate(0, false);
+
+	LEAVECRITICALSECTION(stackBlockCs);
+}
+
+void asCMemoryMgr::SetStackBlockPoolSize(asUINT maxBlocks)
+{
+	ENTERCRITICALSECTION(stackBlockCs);
+
+	maxPooledStackBlocks = maxBlocks;
+
+	// Free the blocks that no longer fit in the pool
+	while( stackBlockPool.GetLength() > maxPooledStackBlocks )
+	{
+#ifndef WIP_16BYTE_ALIGN
+		asDELETEARRAY(stackBlockPool.PopLast().block);
+#else
+		asDELETEARRAYALIGNED(stackBlockPool.PopLast().block);
+#endif
+	}
+
+	LEAVECRITICALSECTION(stackBlockCs);
+}
+
+void asCMemoryMgr::GetStackBlockStatistics(asUINT *totalAllocated, asUINT *totalReused, asUINT *currentlyPooled) const
+{
+	ENTERCRITICALSECTION(stackBlockCs);
+
+	if( totalAllocated )  *totalAllocated  = stackBlocksAllocated;
+	if( totalReused )     *totalReused     = stackBlocksReused;
+	if( currentlyPooled ) *currentlyPooled = stackBlockPool.GetLength();
+
+	LEAVECRITICALSECTION(stackBlockCs);
+}
+
 END_AS_NAMESPACE
 
 
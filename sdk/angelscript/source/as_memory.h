@@ -122,12 +122,56 @@ public:
 #ifndef AS_NO_COMPILER
 	void *AllocByteInstruction();
 	void FreeByteInstruction(void *ptr);
+
+	// While the build arena is active the script nodes and byte instructions
+	// needed by the building thread are taken from large memory chunks, and
+	// all of them are released at once when the arena is ended
+	void BeginBuildArena();
+	void EndBuildArena();
 #endif
 
+	// The stack blocks used by the contexts are kept in a pool
+	// when the contexts are destroyed so they can be reused
+	asDWORD *AllocStackBlock(asUINT size);
+	void     FreeStackBlock(asDWORD *block, asUINT size);
+	void     FreeUnusedStackBlocks();
+	void     SetStackBlockPoolSize(asUINT maxBlocks);
+	void     GetStackBlockStatistics(asUINT *totalAllocated, asUINT *totalReused, asUINT *currentlyPooled) const;
+
 protected:
+	void *AllocFromPool(asCArray<void*> *localPool, asCArray<void*> &sharedPool);
+	void  ReturnToPool(void *ptr, asCArray<void*> *localPool, asCArray<void*> &sharedPool);
+	static void FreePool(asCArray<void*> &pool);
+#ifndef AS_NO_COMPILER
+	void *AllocFromArena(asCArray<void*> &arenaPool, size_t size);
+#endif
+
+	// The shared pools receive the blocks that don't fit in the threads' local caches
 	DECLARECRITICALSECTION(cs)
 	asCArray<void *> scriptNodePool;
 	asCArray<void *> byteInstructionPool;
+
+#ifndef AS_NO_COMPILER
+	// Only the thread that owns the arena uses it. Blocks that are freed
+	// during the build are reused from the arena's own free lists
+	void            *arenaOwner;
+	asCArray<void *> arenaChunks;
+	asBYTE          *arenaPos;
+	asBYTE          *arenaEnd;
+	asCArray<void *> arenaScriptNodes;
+	asCArray<void *> arenaByteInstructions;
+#endif
+
+	struct SStackBlock
+	{
+		asDWORD *block;
+		asUINT   size;
+	};
+	DECLARECRITICALSECTION(mutable stackBlockCs)
+	asCArray<SStackBlock> stackBlockPool;
+	asUINT                maxPooledStackBlocks;
+	asUINT                stackBlocksAllocated;
+	asUINT                stackBlocksReused;
 };
 
 END_AS_NAMESPACE
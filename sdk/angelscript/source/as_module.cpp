@@ -60,6 +60,10 @@ asCModule::asCModule(const char *name, asCScriptEngine *engine)
 	accessMask = 1;
 
 	defaultNamespace = engine->nameSpaces[0];
+
+	incrementalNameSpace = 0;
+
+	deferredLoader = 0;
 }
 
 // internal
@@ -281,16 +285,30 @@ void asCModule::JITCompile()
 
 // interface
 int asCModule::Build()
+{
+	return InternalBuild(false);
+}
+
+// interface
+int asCModule::BuildIncremental()
+{
+	return InternalBuild(true);
+}
+
+// internal
+int asCModule::InternalBuild(bool incremental)
 {
 #ifdef AS_NO_COMPILER
+	UNUSED_VAR(incremental);
 	return asNOT_SUPPORTED;
 #else
 	TimeIt("asCModule::Build");
 
 	// Don't allow the module to be rebuilt if there are still
-	// external references that will need the previous code
+	// external references that will need the previous code. An
+	// incremental build keeps the types, so only the functions matter
 	// TODO: interface: The asIScriptModule must have a method for querying if the module is used
-	if( HasExternalReferences(false) )
+	if( incremental ? HasFunctionsInUse() : HasExternalReferences(false) )
 	{
 		engine->WriteMessage("", 0, 0, asMSGTYPE_ERROR, TXT_MODULE_IS_IN_USE);
 		return asMODULE_IS_IN_USE;
@@ -310,6 +328,38 @@ int asCModule::Build()
 		return asINVALID_CONFIGURATION;
 	}
 
+	// The builder is destroyed before the build is completed, so no
+	// script nodes or byte instructions will outlive the build arena
+	if( builder && engine->ep.useBuildArena )
+		engine->memoryMgr.BeginBuildArena();
+
+	if( incremental && builder )
+	{
+		// Compile only the functions that have been modified since the previous build.
+		// The global variables are not initialized again, as the module is kept
+		r = builder->BuildIncremental();
+		if( r <= 0 )
+		{
+			asDELETE(builder,asCBuilder);
+			builder = 0;
+
+			if( r < 0 )
+				InternalReset();
+
+			engine->PrepareEngine();
+			engine->BuildCompleted();
+			return r;
+		}
+
+		// The modifications require a full build
+		if( HasExternalReferences(false) )
+		{
+			engine->WriteMessage("", 0, 0, asMSGTYPE_ERROR, TXT_MODULE_IS_IN_USE);
+			engine->BuildCompleted();
+			return asMODULE_IS_IN_USE;
+		}
+	}
+
 	InternalReset();
 
 	if( !builder )
@@ -320,6 +370,8 @@ int asCModule::Build()
 
 	// Compile the script
 	r = builder->Build();
+	if( r >= 0 && incremental )
+		builder->SaveIncrementalBuild();
 	asDELETE(builder,asCBuilder);
 	builder = 0;
 
@@ -356,6 +408,16 @@ int asCModule::Build()
 #endif
 }
 
+// internal
+void asCModule::ResetIncrementalBuild()
+{
+	for( asUINT n = 0; n < incrementalSections.GetLength(); n++ )
+		asDELETE(incrementalSections[n], sIncrementalSection);
+	incrementalSections.SetLength(0);
+	incrementalConstants.SetLength(0);
+	incrementalNameSpace = 0;
+}
+
 // interface
 int asCModule::ResetGlobalVars(asIScriptContext *ctx)
 {
@@ -511,6 +573,29 @@ void asCModule::CallExit()
 	isGlobalVarInitialized = false;
 }
 
+// internal
+// Returns true if any function that an incremental build may compile again is still referenced
+bool asCModule::HasFunctionsInUse()
+{
+	asCSymbolTableIterator<asCGlobalProperty> it = scriptGlobals.List();
+	while( it )
+	{
+		if( (*it)->GetInitFunc() && (*it)->GetInitFunc()->externalRefCount.get() )
+			return true;
+		it++;
+	}
+
+	for( asUINT n = 0; n < scriptFunctions.GetLength(); n++ )
+	{
+		asCScriptFunction *func = scriptFunctions[n];
+		// The shared functions are not compiled again by an incremental build
+		if( func && func->externalRefCount.get() && !func->IsShared() )
+			return true;
+	}
+
+	return false;
+}
+
 // internal
 bool asCModule::HasExternalReferences(bool shuttingDown)
 {
@@ -640,6 +725,13 @@ void asCModule::InternalReset()
 {
 	CallExit();
 
+	// Functions that are still referenced from outside the module may be called after
+	// it has been discarded, so those must be loaded before the loader is destroyed
+	if( deferredLoader )
+		ResolveDeferredFunctions(HasExternalReferences(false));
+
+	ResetIncrementalBuild();
+
 	asUINT n;
 
 	// Remove all global functions
@@ -824,9 +916,13 @@ asIScriptFunction *asCModule::GetFunctionByName(const char *in_name) const
 		if( idxs.GetLength() != 1 )
 			return 0;
 
-		const asIScriptFunction *func = globalFunctions.Get(idxs[0]);
+		asCScriptFunction *func = const_cast<asCScriptFunction*>(globalFunctions.Get(idxs[0]));
 		if( func )
-			return const_cast<asIScriptFunction*>(func);
+		{
+			// Load the function now if it was deferred, rather than when it is called
+			func->LoadDeferredByteCode();
+			return func;
+		}
 
 		// Recursively search parent namespaces
 		ns = engine->GetParentNameSpace(ns);
@@ -915,7 +1011,7 @@ asIScriptFunction *asCModule::GetFunctionByDecl(const char *decl) const
 	// Search script functions for matching interface
 	while( ns )
 	{
-		asIScriptFunction *f = 0;
+		asCScriptFunction *f = 0;
 		const asCArray<unsigned int> &idxs = globalFunctions.GetIndexes(ns, func.name);
 		for( unsigned int n = 0; n < idxs.GetLength(); n++ )
 		{
@@ -947,7 +1043,11 @@ asIScriptFunction *asCModule::GetFunctionByDecl(const char *decl) const
 		}
 
 		if( f )
+		{
+			// Load the function now if it was deferred, rather than when it is called
+			f->LoadDeferredByteCode();
 			return f;
+		}
 		else
 		{
 			// Search for matching functions in the parent namespace
@@ -989,6 +1089,9 @@ int asCModule::RemoveGlobalVar(asUINT index)
 	if( !prop )
 		return asINVALID_ARG;
 
+	// The next incremental build must compile everything again
+	ResetIncrementalBuild();
+
 	// If the global variables have already been initialized 
 	// then uninitialize the variable before it is removed
 	if (isGlobalVarInitialized)
@@ -1545,6 +1648,7 @@ asCGlobalProperty *asCModule::AllocateGlobalProperty(const char *propName, const
 	asCGlobalProperty *prop = engine->AllocateGlobalProperty();
 	prop->name = propName;
 	prop->nameSpace = ns;
+	engine->InternName(prop->name);
 
 	// Allocate the memory for this property based on its type
 	prop->type = dt;
@@ -1589,6 +1693,9 @@ int asCModule::SaveByteCode(asIBinaryStream *out, bool stripDebugInfo) const
 	if( IsEmpty() )
 		return asERROR;
 
+	// The writer needs the translated bytecode of all functions
+	const_cast<asCModule*>(this)->ResolveDeferredFunctions(true);
+
 	asCWriter write(const_cast<asCModule*>(this), out, engine, stripDebugInfo);
 	return write.Write();
 #endif
@@ -1599,6 +1706,25 @@ int asCModule::LoadByteCode(asIBinaryStream *in, bool *wasDebugInfoStripped)
 {
 	if( in == 0 ) return asINVALID_ARG;
 
+	asCReader read(this, in, engine);
+	return InternalLoadByteCode(read, wasDebugInfoStripped);
+}
+
+// interface
+int asCModule::LoadByteCodeFromMemory(const void *data, size_t size, bool *wasDebugInfoStripped)
+{
+	if( data == 0 ) return asINVALID_ARG;
+
+	// The data is read directly from the buffer, so the application
+	// can map the file with the saved bytecode into memory and pass
+	// the pointer without first copying it into a stream
+	asCReader read(this, reinterpret_cast<const asBYTE*>(data), size, engine);
+	return InternalLoadByteCode(read, wasDebugInfoStripped);
+}
+
+// internal
+int asCModule::InternalLoadByteCode(asCReader &read, bool *wasDebugInfoStripped)
+{
 	// Don't allow the module to be rebuilt if there are still
 	// external references that will need the previous code
 	if( HasExternalReferences(false) )
@@ -1613,7 +1739,6 @@ int asCModule::LoadByteCode(asIBinaryStream *in, bool *wasDebugInfoStripped)
 	if( r < 0 )
 		return r;
 
-	asCReader read(this, in, engine);
 	r = read.Read(wasDebugInfoStripped);
 	if (r < 0)
 	{
@@ -1638,6 +1763,36 @@ int asCModule::LoadByteCode(asIBinaryStream *in, bool *wasDebugInfoStripped)
 	return r;
 }
 
+// internal
+void asCModule::ResolveDeferredFunctions(bool load)
+{
+	if( deferredLoader == 0 )
+		return;
+
+	for( asUINT n = 0; n < scriptFunctions.GetLength(); n++ )
+	{
+		asCScriptFunction *func = scriptFunctions[n];
+		if( func == 0 || func->funcType != asFUNC_SCRIPT || func->scriptData->deferredLoader != deferredLoader )
+			continue;
+
+		if( load )
+			func->LoadDeferredByteCode();
+
+		// If the function couldn't be loaded or won't be used anymore it is left without bytecode
+		if( func->scriptData->deferredLoader )
+		{
+			func->scriptData->deferredLoader = 0;
+			func->scriptData->deferredByteCode.Allocate(0, false);
+
+			// A function translated by a parallel load has no references yet
+			func->scriptData->byteCode.SetLength(0);
+		}
+	}
+
+	asDELETE(deferredLoader, asCReader);
+	deferredLoader = 0;
+}
+
 // interface
 int asCModule::CompileGlobalVar(const char *sectionName, const char *code, int lineOffset)
 {
@@ -1673,6 +1828,10 @@ int asCModule::CompileGlobalVar(const char *sectionName, const char *code, int l
 
 	engine->BuildCompleted();
 
+	// The next incremental build must compile everything again
+	if( r >= 0 )
+		ResetIncrementalBuild();
+
 	// Initialize the variable
 	if( r >= 0 && engine->ep.initGlobalVarsAfterBuild )
 	{
@@ -1746,6 +1905,10 @@ int asCModule::CompileFunction(const char *sectionName, const char *code, int li
 
 	engine->BuildCompleted();
 
+	// The next incremental build must compile everything again
+	if( r >= 0 && (compileFlags & asCOMP_ADD_TO_MODULE) )
+		ResetIncrementalBuild();
+
 	if( r >= 0 && outFunc && func )
 	{
 		// Return the function to the caller and add an external reference
@@ -1769,6 +1932,9 @@ int asCModule::RemoveFunction(asIScriptFunction *func)
 	int idx = globalFunctions.GetIndex(f);
 	if( idx >= 0 )
 	{
+		// The next incremental build must compile everything again
+		ResetIncrementalBuild();
+
 		globalFunctions.Erase(idx);
 		scriptFunctions.RemoveValue(f);
 		f->ReleaseInternal();
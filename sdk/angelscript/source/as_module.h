@@ -60,6 +60,7 @@ class asCContext;
 class asCConfigGroup;
 class asCTypedefType;
 class asCFuncdefType;
+class asCReader;
 struct asSNameSpace;
 
 struct sBindInfo
@@ -75,6 +76,33 @@ struct sObjectTypePair
 	asCObjectType *b;
 };
 
+// The position of a function compiled from a script section, so
+// BuildIncremental can find out if the function has been modified
+struct sIncrementalFunction
+{
+	int    funcId;
+	size_t declaredAtPos;
+	size_t bodyPos;
+	bool   canRecompile;
+	bool   canMove;
+};
+
+// A script section as it was in the previous call to BuildIncremental
+struct sIncrementalSection
+{
+	asCString                      name;
+	asCString                      code;
+	int                            lineOffset;
+	asCArray<sIncrementalFunction> functions;
+};
+
+// The value of a global constant that the compiler can use directly
+struct sIncrementalConstant
+{
+	asCGlobalProperty *property;
+	asQWORD            value;
+};
+
 
 // TODO: import: Remove function imports. When I have implemented function
 //               pointers the function imports should be deprecated.
@@ -86,12 +114,6 @@ struct sObjectTypePair
 //       With this separation it will be possible to compile the library without
 //       the compiler, thus giving a much smaller binary executable.
 
-// TODO: There should be a special compile option that will let the application
-//       recompile an already compiled script. The compiler should check if no
-//       destructive changes have been made (changing function signatures, etc)
-//       then it should simply replace the bytecode within the functions without
-//       changing the values of existing global properties, etc.
-
 class asCModule : public asIScriptModule
 {
 //-------------------------------------------
@@ -106,6 +128,7 @@ public:
 	// Compilation
 	virtual int         AddScriptSection(const char *name, const char *code, size_t codeLength, int lineOffset);
 	virtual int         Build();
+	virtual int         BuildIncremental();
 	virtual int         CompileFunction(const char *sectionName, const char *code, int lineOffset, asDWORD reserved, asIScriptFunction **outFunc);
 	virtual int         CompileGlobalVar(const char *sectionName, const char *code, int lineOffset);
 	virtual asDWORD     SetAccessMask(asDWORD accessMask);
@@ -158,6 +181,7 @@ public:
 	// Bytecode Saving/Loading
 	virtual int SaveByteCode(asIBinaryStream *out, bool stripDebugInfo) const;
 	virtual int LoadByteCode(asIBinaryStream *in, bool *wasDebugInfoStripped);
+	virtual int LoadByteCodeFromMemory(const void *data, size_t size, bool *wasDebugInfoStripped);
 
 	// User data
 	virtual void *SetUserData(void *data, asPWORD type);
@@ -177,8 +201,13 @@ public:
 	friend class asCRestore;
 
 	void InternalReset();
+	int  InternalBuild(bool incremental);
+	int  InternalLoadByteCode(asCReader &read, bool *wasDebugInfoStripped);
+	void ResolveDeferredFunctions(bool load);
+	void ResetIncrementalBuild();
 	bool IsEmpty() const;
 	bool HasExternalReferences(bool shuttingDown);
+	bool HasFunctionsInUse();
 
 	int  CallInit(asIScriptContext *ctx);
 	void CallExit();
@@ -235,6 +264,15 @@ public:
 	asCArray<asCTypeInfo*>       externalTypes; // doesn't increase ref count
 	// This array holds functions that have been explicitly declared with 'external'
 	asCArray<asCScriptFunction*> externalFunctions; // doesn't increase ref count
+
+	// This is what BuildIncremental needs to know about the previous build
+	asCArray<sIncrementalSection*>  incrementalSections;
+	asCArray<sIncrementalConstant>  incrementalConstants; // doesn't increase ref count
+	asSNameSpace                   *incrementalNameSpace;
+
+	// Holds what is needed to translate the functions that were loaded with
+	// asEP_LAZY_LOAD_FUNCTIONS and that haven't been called yet
+	asCReader                      *deferredLoader;
 };
 
 END_AS_NAMESPACE
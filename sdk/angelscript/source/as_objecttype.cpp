@@ -42,12 +42,14 @@
 #include "as_objecttype.h"
 #include "as_configgroup.h"
 #include "as_scriptengine.h"
+#include "as_scriptobject.h"
 
 BEGIN_AS_NAMESPACE
 
 asCObjectType::asCObjectType() : asCTypeInfo()
 {
 	derivedFrom = 0;
+	propertiesReordered = false;
 
 	acceptValueSubType = true;
 	acceptRefSubType   = true;
@@ -60,6 +62,7 @@ asCObjectType::asCObjectType() : asCTypeInfo()
 asCObjectType::asCObjectType(asCScriptEngine *in_engine) : asCTypeInfo(in_engine)
 {
 	derivedFrom  = 0;
+	propertiesReordered = false;
 
 	acceptValueSubType = true;
 	acceptRefSubType = true;
@@ -521,42 +524,66 @@ asCObjectProperty *asCObjectType::AddPropertyToClass(const asCString &propName,
 	}
 
 	prop->name        = propName;
+	engine->InternName(prop->name);
 	prop->type        = dt;
 	prop->isPrivate   = isPrivate;
 	prop->isProtected = isProtected;
 	prop->isInherited = isInherited;
 
-	int propSize;
+	// Non-POD value types can't be allocated inline,
+	// because there is a risk that the script might
+	// try to access the content without knowing that
+	// it hasn't been initialized yet.
+	if( dt.IsObject() && !(dt.GetTypeInfo()->flags & asOBJ_POD) && !dt.IsObjectHandle() )
+		prop->type.MakeReference(true);
+
+	// Funcdefs don't have a size, as they must always be stored as handles
+	asASSERT( !dt.IsFuncdef() || dt.IsObjectHandle() );
+
+	PlaceProperty(prop);
+
+	properties.PushLast(prop);
+
+	// Make sure the struct holds a reference to the config group where the object is registered
+	asCConfigGroup *group = engine->FindConfigGroupForTypeInfo(prop->type.GetTypeInfo());
+	if( group != 0 ) group->AddRef();
+
+	// Add reference to object types
+	asCTypeInfo *type = prop->type.GetTypeInfo();
+	if( type )
+		type->AddRefInternal();
+
+	return prop;
+}
+
+// internal
+int asCObjectType::GetPropertySize(const asCObjectProperty *prop) const
+{
+	const asCDataType &dt = prop->type;
 	if( dt.IsObject() )
 	{
-		// Non-POD value types can't be allocated inline,
-		// because there is a risk that the script might
-		// try to access the content without knowing that
-		// it hasn't been initialized yet.
+		// The non-POD value types are allocated separately, and only a pointer is stored in the object
 		if( dt.GetTypeInfo()->flags & asOBJ_POD )
-			propSize = dt.GetSizeInMemoryBytes();
-		else
-		{
-			propSize = dt.GetSizeOnStackDWords()*4;
-			if( !dt.IsObjectHandle() )
-				prop->type.MakeReference(true);
-		}
+			return dt.GetSizeInMemoryBytes();
+		return dt.GetSizeOnStackDWords()*4;
 	}
-	else if (dt.IsFuncdef())
-	{
-		// Funcdefs don't have a size, as they must always be stored as handles
-		asASSERT(dt.IsObjectHandle());
-		propSize = AS_PTR_SIZE * 4;
-	}
-	else
-		propSize = dt.GetSizeInMemoryBytes();
+	else if( dt.IsFuncdef() )
+		return AS_PTR_SIZE * 4;
+
+	return dt.GetSizeInMemoryBytes();
+}
+
+// internal
+void asCObjectType::PlaceProperty(asCObjectProperty *prop)
+{
+	int propSize = GetPropertySize(prop);
 
 	// Add extra bytes so that the property will be properly aligned
 #ifndef WIP_16BYTE_ALIGN
 	if( propSize == 2 && (size & 1) ) size += 1;
 	if( propSize > 2 && (size & 3) ) size += 4 - (size & 3);
 #else
-	asUINT alignment = dt.GetAlignment();
+	asUINT alignment = prop->type.GetAlignment();
 	const asUINT propSizeAlignmentDifference = size & (alignment-1);
 	if( propSizeAlignmentDifference != 0 )
 	{
@@ -568,19 +595,55 @@ asCObjectProperty *asCObjectType::AddPropertyToClass(const asCString &propName,
 
 	prop->byteOffset = size;
 	size += propSize;
+}
 
-	properties.PushLast(prop);
+// internal
+void asCObjectType::LayoutProperties()
+{
+	asASSERT( flags & asOBJ_SCRIPT_OBJECT );
 
-	// Make sure the struct holds a reference to the config group where the object is registered
-	asCConfigGroup *group = engine->FindConfigGroupForTypeInfo(prop->type.GetTypeInfo());
-	if( group != 0 ) group->AddRef();
+	// The inherited properties must keep the offsets from the base class,
+	// as the methods of the base class access them by these offsets
+	size = derivedFrom ? derivedFrom->size : sizeof(asCScriptObject);
+	asUINT n = 0;
+	for( ; n < properties.GetLength() && properties[n]->isInherited; n++ )
+	{
+		asASSERT( derivedFrom && n < derivedFrom->properties.GetLength() );
+		properties[n]->byteOffset = derivedFrom->properties[n]->byteOffset;
+	}
 
-	// Add reference to object types
-	asCTypeInfo *type = prop->type.GetTypeInfo();
-	if( type )
-		type->AddRefInternal();
+	if( !propertiesReordered )
+	{
+		// Place the properties in the order they were declared
+		for( ; n < properties.GetLength(); n++ )
+			PlaceProperty(properties[n]);
+		return;
+	}
 
-	return prop;
+	// Place the handles first, then the primitives and POD value types by size to
+	// avoid padding between them, and last the pointers to the value types that are
+	// allocated separately, as these are rarely accessed compared to the others.
+	// The properties array is kept in declaration order, only the offsets change
+	for( int group = 0; group < 5; group++ )
+	{
+		for( asUINT p = n; p < properties.GetLength(); p++ )
+		{
+			asCObjectProperty *prop = properties[p];
+			int propGroup;
+			if( prop->type.IsObjectHandle() )
+				propGroup = 0;
+			else if( prop->type.IsReference() )
+				propGroup = 4;
+			else
+			{
+				int propSize = GetPropertySize(prop);
+				propGroup = propSize >= 4 ? 1 : propSize == 2 ? 2 : 3;
+			}
+
+			if( propGroup == group )
+				PlaceProperty(prop);
+		}
+	}
 }
 
 // internal
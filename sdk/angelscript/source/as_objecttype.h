@@ -134,6 +134,7 @@ public:
 	bool IsInterface() const;
 
 	asCObjectProperty *AddPropertyToClass(const asCString &name, const asCDataType &dt, bool isPrivate, bool isProtected, bool isInherited);
+	void LayoutProperties();
 	void ReleaseAllProperties();
 
 #ifdef WIP_16BYTE_ALIGN
@@ -142,6 +143,9 @@ public:
 	asCArray<asCObjectProperty*> properties;
 	asCArray<int>                methods;
 
+	// Set if the properties of the script class have been reordered by size, see asEP_REORDER_CLASS_PROPERTIES
+	bool                         propertiesReordered;
+
 	// TODO: These are not used by template types. Should perhaps create a derived class to save memory on ordinary object types
 	asCArray<asCObjectType*>     interfaces;
 	asCArray<asUINT>             interfaceVFTOffsets;
@@ -164,6 +168,9 @@ protected:
 	friend class asCConfigGroup;
 	friend class asCModule;
 	asCObjectType();
+
+	int  GetPropertySize(const asCObjectProperty *prop) const;
+	void PlaceProperty(asCObjectProperty *prop);
 };
 
 END_AS_NAMESPACE
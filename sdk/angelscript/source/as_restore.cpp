@@ -51,31 +51,129 @@ BEGIN_AS_NAMESPACE
 asCReader::asCReader(asCModule* _module, asIBinaryStream* _stream, asCScriptEngine* _engine)
  : module(_module), stream(_stream), engine(_engine)
 {
+	memory = 0;
+	memorySize = 0;
+	memoryPos = 0;
 	error = false;
 	bytesRead = 0;
+	interfaceMatches = true;
+	recordedData = 0;
+	holdsReferences = false;
+	isLoadingInParallel = false;
+	bufferErrors = false;
+	deferredLockOwner = 0;
+	lastCompositeProp = 0;
+}
+
+asCReader::asCReader(asCModule* _module, const asBYTE* _memory, size_t _memorySize, asCScriptEngine* _engine)
+ : module(_module), stream(0), engine(_engine)
+{
+	memory = _memory;
+	memorySize = _memorySize;
+	memoryPos = 0;
+	error = false;
+	bytesRead = 0;
+	interfaceMatches = true;
+	recordedData = 0;
+	holdsReferences = false;
+	isLoadingInParallel = false;
+	bufferErrors = false;
+	deferredLockOwner = 0;
+	lastCompositeProp = 0;
+}
+
+asCReader::~asCReader()
+{
+	if( holdsReferences )
+	{
+		asUINT n;
+		for( n = 0; n < usedTypes.GetLength(); n++ )
+		{
+			if( usedTypes[n] == 0 ) continue;
+			asCConfigGroup *group = engine->FindConfigGroupForTypeInfo(usedTypes[n]);
+			if( group != 0 ) group->Release();
+			usedTypes[n]->ReleaseInternal();
+		}
+
+		for( n = 0; n < usedFunctions.GetLength(); n++ )
+		{
+			if( usedFunctions[n] == 0 ) continue;
+			asCConfigGroup *group = engine->FindConfigGroupForFunction(usedFunctions[n]->id);
+			if( group != 0 ) group->Release();
+			usedFunctions[n]->ReleaseInternal();
+		}
+
+		for( n = 0; n < usedGlobalProperties.GetLength(); n++ )
+		{
+			asSMapNode<void*, asCGlobalProperty*> *node;
+			if( engine->varAddressMap.MoveTo(&node, usedGlobalProperties[n]) )
+			{
+				asCConfigGroup *group = engine->FindConfigGroupForGlobalVar(node->value->id);
+				if( group != 0 ) group->Release();
+				node->value->Release();
+			}
+		}
+	}
+
+	// The string constants are normally released at the end of the load, but
+	// if the reader was kept for lazy loading it owns the string constants
+	for( asUINT n = 0; n < usedStringConstants.GetLength(); n++ )
+		engine->stringFactory->ReleaseStringConstant(usedStringConstants[n]);
 }
 
 int asCReader::ReadData(void *data, asUINT size)
 {
 	asASSERT(size == 1 || size == 2 || size == 4 || size == 8);
 	int ret = 0;
+	if( memory )
+	{
+		if( size > memorySize - memoryPos )
+			ret = -1;
+		else
+		{
+			// The data is stored in big endian order
 #if defined(AS_BIG_ENDIAN)
-	for( asUINT n = 0; ret >= 0 && n < size; n++ )
-		ret = stream->Read(((asBYTE*)data)+n, 1);
+			for( asUINT n = 0; n < size; n++ )
+				((asBYTE*)data)[n] = memory[memoryPos+n];
 #else
-	for( int n = size-1; ret >= 0 && n >= 0; n-- )
-		ret = stream->Read(((asBYTE*)data)+n, 1);
+			for( asUINT n = 0; n < size; n++ )
+				((asBYTE*)data)[n] = memory[memoryPos+size-1-n];
+#endif
+			memoryPos += size;
+		}
+	}
+	else
+	{
+#if defined(AS_BIG_ENDIAN)
+		for( asUINT n = 0; ret >= 0 && n < size; n++ )
+			ret = stream->Read(((asBYTE*)data)+n, 1);
+#else
+		for( int n = size-1; ret >= 0 && n >= 0; n-- )
+			ret = stream->Read(((asBYTE*)data)+n, 1);
 #endif
+	}
 	if (ret < 0)
 		Error(TXT_UNEXPECTED_END_OF_FILE);
+	else if( recordedData )
+	{
+		// Keep the bytes in the order they are stored in so they can be read again later
+		for( asUINT n = 0; n < size; n++ )
+#if defined(AS_BIG_ENDIAN)
+			recordedData->PushLast(((asBYTE*)data)[n]);
+#else
+			recordedData->PushLast(((asBYTE*)data)[size-1-n]);
+#endif
+	}
 	bytesRead += size;
 	return ret;
 }
 
-int asCReader::Read(bool *wasDebugInfoStripped)
+int asCReader::Read(bool *wasDebugInfoStripped, bool _isLoadingInParallel)
 {
 	TimeIt("asCReader::Read");
 
+	isLoadingInParallel = _isLoadingInParallel;
+
 	// Before starting the load, make sure that
 	// any existing resources have been freed
 	module->InternalReset();
@@ -108,8 +206,9 @@ int asCReader::Read(bool *wasDebugInfoStripped)
 		// Init system functions properly
 		engine->PrepareEngine();
 
-		// Initialize the global variables (unless requested not to)
-		if( engine->ep.initGlobalVarsAfterBuild )
+		// Initialize the global variables (unless requested not to). When loading in
+		// parallel this is done once the functions have been translated
+		if( engine->ep.initGlobalVarsAfterBuild && !isLoadingInParallel )
 			r = module->ResetGlobalVars(0);
 
 		if( wasDebugInfoStripped )
@@ -131,8 +230,25 @@ int asCReader::Error(const char *msg)
 	{
 		asCString str;
 		str.Format(msg, bytesRead);
-		engine->WriteMessage("", 0, 0, asMSGTYPE_ERROR, str.AddressOf());
 		error = true;
+
+		if( bufferErrors )
+		{
+			bufferedErrors.PushLast(str);
+			return asERROR;
+		}
+
+		engine->WriteMessage("", 0, 0, asMSGTYPE_ERROR, str.AddressOf());
+
+		// Tell the application why the bytecode may no longer be valid
+		if( !interfaceMatches )
+		{
+			if( changedConfigGroups.GetLength() )
+				str.Format(TXT_INTERFACE_DIFFERS_IN_GROUPS_s, changedConfigGroups.AddressOf());
+			else
+				str = TXT_INTERFACE_DIFFERS;
+			engine->WriteMessage("", 0, 0, asMSGTYPE_INFORMATION, str.AddressOf());
+		}
 	}
 
 	return asERROR;
@@ -151,6 +267,9 @@ int asCReader::ReadInner()
 	unsigned long i, count;
 	asCScriptFunction* func;
 
+	ReadInterfaceFingerprint();
+	if( error ) return asERROR;
+
 	// Read the flag as 1 byte even on platforms with 4byte booleans
 	noDebugInfo = ReadEncodedUInt() ? VALUE_OF_BOOLEAN_TRUE : 0;
 
@@ -398,6 +517,25 @@ int asCReader::ReadInner()
 			ReadTypeDeclaration(module->classTypes[i], 3);
 	}
 
+	// Determine the offsets of the class properties the same way the builder did. The base
+	// classes must be done before the derived classes, as these keep the offsets of the base
+	for( i = 0; i < module->classTypes.GetLength() && !error; ++i )
+	{
+		asCArray<asCObjectType*> hierarchy;
+		for( asCObjectType *ot = module->classTypes[i]; ot && !ot->IsInterface(); ot = ot->derivedFrom )
+		{
+			// The pre-existing shared classes have their offsets already
+			if( module->classTypes.IndexOf(ot) < 0 ||
+				existingShared.MoveTo(0, ot) ||
+				((ot->flags & asOBJ_SHARED) && module->externalTypes.IndexOf(ot) >= 0) )
+				break;
+			hierarchy.PushLast(ot);
+		}
+
+		while( hierarchy.GetLength() )
+			hierarchy.PopLast()->LayoutProperties();
+	}
+
 	if( error ) return asERROR;
 
 	// Read typedefs
@@ -622,8 +760,10 @@ int asCReader::ReadInner()
 
 	// Update the loaded bytecode to point to the correct types, property offsets,
 	// function ids, etc. This is basically a linking stage.
+	// The functions that were deferred are translated when they are first called
 	for( i = 0; i < module->scriptFunctions.GetLength() && !error; i++ )
-		if( module->scriptFunctions[i]->funcType == asFUNC_SCRIPT )
+		if( module->scriptFunctions[i]->funcType == asFUNC_SCRIPT &&
+			module->scriptFunctions[i]->scriptData->deferredByteCode.GetLength() == 0 )
 			TranslateFunction(module->scriptFunctions[i]);
 
 	asCSymbolTable<asCGlobalProperty>::iterator globIt = module->scriptGlobals.List();
@@ -637,6 +777,16 @@ int asCReader::ReadInner()
 
 	if( error ) return asERROR;
 
+	if( deferredFunctions.GetLength() )
+	{
+		module->deferredLoader = CreateDeferredLoader();
+		if( module->deferredLoader == 0 )
+		{
+			error = true;
+			return asOUT_OF_MEMORY;
+		}
+	}
+
 	// Add references for all functions (except for the pre-existing shared code)
 	for( i = 0; i < module->scriptFunctions.GetLength(); i++ )
 		if( !dontTranslate.MoveTo(0, module->scriptFunctions[i]) )
@@ -653,6 +803,33 @@ int asCReader::ReadInner()
 	return error ? asERROR : asSUCCESS;
 }
 
+void asCReader::ReadInterfaceFingerprint()
+{
+	TimeIt("asCReader::ReadInterfaceFingerprint");
+
+	asQWORD fingerprint = 0;
+	ReadData(&fingerprint, 8);
+	interfaceMatches = fingerprint == engine->GetInterfaceFingerprint();
+
+	// The digests of the individual config groups are only compared if the
+	// interface differs, so that a load failure can point out what changed
+	asUINT count = ReadEncodedUInt();
+	for( asUINT n = 0; n < count && !error; n++ )
+	{
+		asCString groupName;
+		ReadString(&groupName);
+		ReadData(&fingerprint, 8);
+
+		if( !interfaceMatches && groupName.GetLength() &&
+			engine->GetInterfaceFingerprint(groupName.AddressOf()) != fingerprint )
+		{
+			if( changedConfigGroups.GetLength() )
+				changedConfigGroups += ", ";
+			changedConfigGroups += "'" + groupName + "'";
+		}
+	}
+}
+
 void asCReader::ReadUsedStringConstants()
 {
 	TimeIt("asCReader::ReadUsedStringConstants");
@@ -814,7 +991,26 @@ void asCReader::ReadUsedFunctions()
 			{
 				asASSERT(c == 'a');
 
-				if( func.funcType == asFUNC_FUNCDEF )
+				// If the registered interface is the same as when the bytecode was saved
+				// the application function can be taken directly by its id. The signature
+				// is still compared in case the function was generated for a template instance
+				asUINT id = ReadEncodedUInt();
+				if( interfaceMatches && id < engine->scriptFunctions.GetLength() )
+				{
+					asCScriptFunction *f = engine->scriptFunctions[id];
+					if( f &&
+						f->funcType == func.funcType &&
+						f->objectType == func.objectType &&
+						f->name == func.name &&
+						func.IsSignatureExceptNameAndObjectTypeEqual(f) )
+						usedFunctions[n] = f;
+				}
+
+				if( usedFunctions[n] )
+				{
+					// Already found by its id, so there is no need to search for it
+				}
+				else if( func.funcType == asFUNC_FUNCDEF )
 				{
 					// This is a funcdef (registered or shared)
 					const asCArray<asCFuncdefType *> &funcs = engine->funcDefs;
@@ -1256,7 +1452,18 @@ asCScriptFunction *asCReader::ReadFunction(bool &isNew, bool addToModule, bool a
 				if (addToGC && !addToModule)
 					engine->gc.AddScriptObjectToGC(func, &engine->functionBehaviours);
 
-				ReadByteCode(func);
+				// When lazy loading, the bytes of the bytecode are only copied and the function is
+				// translated when it is first called. Shared functions are always translated
+				// immediately as they may be called from other modules after this one is discarded
+				if( (engine->ep.lazyLoadFunctions || isLoadingInParallel) && addToModule && !func->IsShared() )
+				{
+					recordedData = &func->scriptData->deferredByteCode;
+					ReadByteCode(skippedByteCode);
+					recordedData = 0;
+					deferredFunctions.PushLast(func);
+				}
+				else
+					ReadByteCode(func->scriptData->byteCode);
 
 				func->scriptData->variableSpace = ReadEncodedUInt();
 
@@ -2022,7 +2229,19 @@ void asCReader::ReadString(asCString* str)
 	{
 		len /= 2;
 		str->SetLength(len);
-		int r = stream->Read(str->AddressOf(), len);
+		int r = 0;
+		if( memory )
+		{
+			if( len > memorySize - memoryPos )
+				r = -1;
+			else
+			{
+				memcpy(str->AddressOf(), memory + memoryPos, len);
+				memoryPos += len;
+			}
+		}
+		else
+			r = stream->Read(str->AddressOf(), len);
 		if (r < 0)
 			Error(TXT_UNEXPECTED_END_OF_FILE);
 
@@ -2072,11 +2291,18 @@ void asCReader::ReadObjectProperty(asCObjectType *ot)
 	bool isPrivate = (flags & 1) ? true : false;
 	bool isProtected = (flags & 2) ? true : false;
 	bool isInherited = (flags & 4) ? true : false;
+	bool isReordered = (flags & 8) ? true : false;
 
 	// TODO: shared: If the type is shared and pre-existing, we should just
 	//               validate that the loaded methods match the original
 	if( !existingShared.MoveTo(0, ot) )
+	{
 		ot->AddPropertyToClass(name, dt, isPrivate, isProtected, isInherited);
+
+		// The offsets are determined by LayoutProperties once all properties have been loaded
+		if( isReordered )
+			ot->propertiesReordered = true;
+	}
 }
 
 void asCReader::ReadDataType(asCDataType *dt)
@@ -2310,16 +2536,14 @@ asCTypeInfo* asCReader::ReadTypeInfo()
 	return ot;
 }
 
-void asCReader::ReadByteCode(asCScriptFunction *func)
+void asCReader::ReadByteCode(asCArray<asDWORD> &byteCode)
 {
-	asASSERT( func->scriptData );
-
 	// Read number of instructions
 	asUINT total, numInstructions;
 	total = numInstructions = ReadEncodedUInt();
 
 	// Reserve some space for the instructions
-	func->scriptData->byteCode.AllocateNoConstruct(numInstructions, false);
+	byteCode.AllocateNoConstruct(numInstructions, false);
 
 	asUINT pos = 0;
 	while( numInstructions )
@@ -2329,21 +2553,21 @@ void asCReader::ReadByteCode(asCScriptFunction *func)
 
 		// Allocate the space for the instruction
 		asUINT len = asBCTypeSize[asBCInfo[b].type];
-		asUINT newSize = asUINT(func->scriptData->byteCode.GetLength()) + len;
-		if( func->scriptData->byteCode.GetCapacity() < newSize )
+		asUINT newSize = asUINT(byteCode.GetLength()) + len;
+		if( byteCode.GetCapacity() < newSize )
 		{
 			// Determine the average size of the loaded instructions and re-estimate the final size
 			asUINT size = asUINT(float(newSize) / (total - numInstructions) * total) + 1;
-			func->scriptData->byteCode.AllocateNoConstruct(size, true);
+			byteCode.AllocateNoConstruct(size, true);
 		}
-		if( !func->scriptData->byteCode.SetLengthNoConstruct(newSize) )
+		if( !byteCode.SetLengthNoConstruct(newSize) )
 		{
 			// Out of memory
 			error = true;
 			return;
 		}
 
-		asDWORD *bc = func->scriptData->byteCode.AddressOf() + pos;
+		asDWORD *bc = byteCode.AddressOf() + pos;
 		pos += len;
 
 		switch( asBCInfo[b].type )
@@ -2551,7 +2775,7 @@ void asCReader::ReadByteCode(asCScriptFunction *func)
 	}
 
 	// Correct the final size in case we over-estimated it
-	func->scriptData->byteCode.SetLengthNoConstruct(pos);
+	byteCode.SetLengthNoConstruct(pos);
 }
 
 void asCReader::ReadUsedTypeIds()
@@ -2649,9 +2873,180 @@ void asCReader::ReadUsedObjectProps()
 	}
 }
 
+asCReader *asCReader::CreateDeferredLoader()
+{
+	asCReader *loader = asNEW(asCReader)(module, (const asBYTE*)0, 0, engine);
+	if( loader == 0 )
+		return 0;
+
+	loader->noDebugInfo          = noDebugInfo;
+	loader->usedTypeIds          = usedTypeIds;
+	loader->usedTypes            = usedTypes;
+	loader->usedFunctions        = usedFunctions;
+	loader->usedGlobalProperties = usedGlobalProperties;
+	loader->usedObjectProperties = usedObjectProperties;
+
+	// The loader takes over the string constants so they are not released at the end of the load
+	loader->usedStringConstants  = usedStringConstants;
+	usedStringConstants.SetLength(0);
+
+	// Hold references to everything that the deferred functions may refer
+	// to, so nothing is removed before the functions have been translated
+	asUINT n;
+	for( n = 0; n < usedTypes.GetLength(); n++ )
+	{
+		if( usedTypes[n] == 0 ) continue;
+		usedTypes[n]->AddRefInternal();
+		asCConfigGroup *group = engine->FindConfigGroupForTypeInfo(usedTypes[n]);
+		if( group != 0 ) group->AddRef();
+	}
+
+	for( n = 0; n < usedFunctions.GetLength(); n++ )
+	{
+		if( usedFunctions[n] == 0 ) continue;
+		usedFunctions[n]->AddRefInternal();
+		asCConfigGroup *group = engine->FindConfigGroupForFunction(usedFunctions[n]->id);
+		if( group != 0 ) group->AddRef();
+	}
+
+	for( n = 0; n < usedGlobalProperties.GetLength(); n++ )
+	{
+		asSMapNode<void*, asCGlobalProperty*> *node;
+		if( engine->varAddressMap.MoveTo(&node, usedGlobalProperties[n]) )
+		{
+			node->value->AddRef();
+			asCConfigGroup *group = engine->FindConfigGroupForGlobalVar(node->value->id);
+			if( group != 0 ) group->AddRef();
+		}
+	}
+	loader->holdsReferences = true;
+
+	for( n = 0; n < deferredFunctions.GetLength(); n++ )
+		deferredFunctions[n]->scriptData->deferredLoader = loader;
+	loader->deferredFunctions = deferredFunctions;
+
+	return loader;
+}
+
+int asCReader::LoadDeferredFunction(asCScriptFunction *func)
+{
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+	if( tld == 0 )
+		return asOUT_OF_MEMORY;
+
+	// Only this thread can have stored itself as the owner, so the
+	// check is valid even though the lock isn't held when reading it
+	bool isNested = asAtomicLoadAcquire(deferredLockOwner) == tld;
+	if( !isNested )
+	{
+		ENTERCRITICALSECTION(deferredLock);
+		asAtomicStoreRelease(deferredLockOwner, tld);
+	}
+
+	// Another thread may have loaded the function while this one was waiting
+	if( func->scriptData->deferredLoader == 0 )
+	{
+		if( !isNested )
+		{
+			asAtomicStoreRelease(deferredLockOwner, (asCThreadLocalData*)0);
+			LEAVECRITICALSECTION(deferredLock);
+		}
+		return asSUCCESS;
+	}
+
+	// The function may already have been translated by TranslateDeferredFunctions
+	int r = asSUCCESS;
+	if( func->scriptData->deferredByteCode.GetLength() )
+		r = TranslateDeferredFunction(func);
+	if( r >= 0 && func->scriptData->byteCode.GetLength() == 0 )
+		r = asERROR;
+
+	if( r >= 0 )
+	{
+		func->AddReferences();
+
+		// The JIT compiler will ask for the bytecode, so the function is seen as loaded by this
+		// thread while it is compiled. The other threads keep waiting for the lock until the
+		// loader is cleared, which mustn't be seen by them before the JIT compiler is done
+		tld->loadingFunctions.PushLast(func);
+		func->JITCompile();
+		tld->loadingFunctions.PopLast();
+
+		asAtomicStoreRelease(func->scriptData->deferredLoader, (asCReader*)0);
+	}
+
+	if( !isNested )
+	{
+		asAtomicStoreRelease(deferredLockOwner, (asCThreadLocalData*)0);
+		LEAVECRITICALSECTION(deferredLock);
+	}
+	return r;
+}
+
+int asCReader::TranslateDeferredFunctions()
+{
+	ENTERCRITICALSECTION(deferredLock);
+	bufferErrors = true;
+
+	int r = asSUCCESS;
+	for( asUINT n = 0; n < deferredFunctions.GetLength(); n++ )
+	{
+		asCScriptFunction *func = deferredFunctions[n];
+		if( func->scriptData->deferredLoader == this &&
+			func->scriptData->deferredByteCode.GetLength() &&
+			TranslateDeferredFunction(func) < 0 )
+			r = asERROR;
+	}
+
+	bufferErrors = false;
+	LEAVECRITICALSECTION(deferredLock);
+	return r;
+}
+
+void asCReader::WriteBufferedErrors()
+{
+	for( asUINT n = 0; n < bufferedErrors.GetLength(); n++ )
+		engine->WriteMessage("", 0, 0, asMSGTYPE_ERROR, bufferedErrors[n].AddressOf());
+	bufferedErrors.SetLength(0);
+}
+
+// Decodes the bytes kept for the function and translates the bytecode, but doesn't
+// add the references, as that may call the application's string factory
+int asCReader::TranslateDeferredFunction(asCScriptFunction *func)
+{
+	error     = false;
+	bytesRead = 0;
+
+	memory     = func->scriptData->deferredByteCode.AddressOf();
+	memorySize = func->scriptData->deferredByteCode.GetLength();
+	memoryPos  = 0;
+
+	ReadByteCode(func->scriptData->byteCode);
+	if( !error && memoryPos != memorySize )
+		Error(TXT_INVALID_BYTECODE_d);
+	if( !error )
+		TranslateFunction(func);
+
+	memory     = 0;
+	memorySize = 0;
+	memoryPos  = 0;
+
+	// The bytes are removed even if the translation failed, so it isn't attempted again
+	func->scriptData->deferredByteCode.Allocate(0, false);
+	if( error )
+	{
+		func->scriptData->byteCode.SetLength(0);
+		return asERROR;
+	}
+
+	return asSUCCESS;
+}
+
 short asCReader::FindObjectPropOffset(asWORD index)
 {
-	static asCObjectProperty *lastCompositeProp = 0;
+	// A composite property is translated in two steps. The first gives the offset of the
+	// composite member, the second the offset of the property within the member. This
+	// is kept per reader, since several readers may be translating at the same time
 	if (lastCompositeProp)
 	{
 		if (index != 0)
@@ -2697,6 +3092,9 @@ void asCReader::TranslateFunction(asCScriptFunction *func)
 
 	asASSERT( func->scriptData );
 
+	// Don't let a previous function that failed to translate affect this one
+	lastCompositeProp = 0;
+
 	// Pre-compute the size of each instruction in order to translate jump offsets
 	asUINT n;
 	asDWORD *bc = func->scriptData->byteCode.AddressOf();
@@ -2747,7 +3145,9 @@ void asCReader::TranslateFunction(asCScriptFunction *func)
 			*(((short*)&bc[n])+1) = FindObjectPropOffset(*(((short*)&bc[n])+1));
 		}
 		else if( c == asBC_LoadRObjR ||
-			     c == asBC_LoadVObjR )
+			     c == asBC_LoadVObjR ||
+			     c == asBC_CpyThisToV4 ||
+			     c == asBC_CpyVtoThis4 )
 		{
 			// Translate the index to the type id
 			int *tid = (int*)&bc[n+2];
@@ -2930,6 +3330,25 @@ void asCReader::TranslateFunction(asCScriptFunction *func)
 			// The size is dword offset
 			bc[n+1] = size;
 		}
+		else if( c >= asBC_CMPIiJZ && c <= asBC_CMPIiJNP )
+		{
+			// The jump offset is stored in the second dword argument
+			int offset = int(bc[n+2]);
+
+			// Count the instruction sizes to the destination instruction
+			int size = 0;
+			if( offset >= 0 )
+				// If moving ahead, then start from next instruction
+				for( asUINT num = bcNum+1; offset-- > 0; num++ )
+					size += bcSizes[num];
+			else
+				// If moving backwards, then start at current instruction
+				for( asUINT num = bcNum; offset++ < 0; num-- )
+					size -= bcSizes[num];
+
+			// The size is dword offset
+			bc[n+2] = size;
+		}
 		else if( c == asBC_AllocMem )
 		{
 			// The size of the allocated memory is only known after all the elements has been seen.
@@ -3390,6 +3809,32 @@ void asCReader::CalculateStackNeeded(asCScriptFunction *func)
 
 			continue;
 		}
+		else if( bc >= asBC_CMPIiJZ && bc <= asBC_CMPIiJNP )
+		{
+			// The jump offset is stored in the second dword argument
+			int offset = *(int*)&func->scriptData->byteCode[pos+2];
+
+			// Add both paths to the code paths
+			pos += 3;
+			if( stackSize[pos] == -1 )
+			{
+				stackSize[pos] = currStackSize;
+				paths.PushLast(pos);
+			}
+			else
+				asASSERT(stackSize[pos] == currStackSize);
+
+			pos += offset;
+			if( stackSize[pos] == -1 )
+			{
+				stackSize[pos] = currStackSize;
+				paths.PushLast(pos);
+			}
+			else
+				asASSERT(stackSize[pos] == currStackSize);
+
+			continue;
+		}
 		else if( bc == asBC_JMPP )
 		{
 			pos++;
@@ -3784,6 +4229,8 @@ int asCWriter::Write()
 	// TODO: Should be possible to skip saving the typedefs. They are usually not needed after the script is compiled anyway
 	// TODO: Should be possible to skip saving constants. They are usually not needed after the script is compiled anyway
 
+	WriteInterfaceFingerprint();
+
 	// Write the flag as 1byte even on platforms with 4byte booleans
 	WriteEncodedInt64(stripDebugInfo ? 1 : 0);
 
@@ -3962,6 +4409,23 @@ int asCWriter::FindStringConstantIndex(void *str)
 	return index;
 }
 
+// The reader compares this with its own engine to determine if the
+// application functions can be found by id rather than by searching
+void asCWriter::WriteInterfaceFingerprint()
+{
+	asQWORD fingerprint = engine->GetInterfaceFingerprint();
+	WriteData(&fingerprint, 8);
+
+	WriteEncodedInt64(engine->configGroups.GetLength() + 1);
+	WriteString(&engine->defaultGroup.groupName);
+	WriteData(&engine->defaultGroup.fingerprint, 8);
+	for( asUINT n = 0; n < engine->configGroups.GetLength(); n++ )
+	{
+		WriteString(&engine->configGroups[n]->groupName);
+		WriteData(&engine->configGroups[n]->fingerprint, 8);
+	}
+}
+
 void asCWriter::WriteUsedStringConstants()
 {
 	TimeIt("asCWriter::WriteUsedStringConstants");
@@ -4005,6 +4469,11 @@ void asCWriter::WriteUsedFunctions()
 
 			WriteData(&c, 1);
 			WriteFunctionSignature(func);
+
+			// The id of application functions can be used directly
+			// if the reader's engine has the same registered interface
+			if( c == 'a' )
+				WriteEncodedInt64(func->id);
 		}
 		else
 		{
@@ -4394,7 +4863,7 @@ void asCWriter::WriteTypeDeclaration(asCTypeInfo *type, int phase)
 		WriteEncodedInt64(size);
 		for (asUINT n = 0; n < t->properties.GetLength(); n++)
 		{
-			WriteObjectProperty(t->properties[n]);
+			WriteObjectProperty(t, t->properties[n]);
 		}
 	}
 }
@@ -4507,7 +4976,7 @@ void asCWriter::WriteGlobalProperty(asCGlobalProperty* prop)
 	WriteFunction(prop->GetInitFunc());
 }
 
-void asCWriter::WriteObjectProperty(asCObjectProperty* prop)
+void asCWriter::WriteObjectProperty(asCObjectType *ot, asCObjectProperty* prop)
 {
 	WriteString(&prop->name);
 	WriteDataType(&prop->type);
@@ -4515,6 +4984,9 @@ void asCWriter::WriteObjectProperty(asCObjectProperty* prop)
 	if( prop->isPrivate ) flags |= 1;
 	if( prop->isProtected ) flags |= 2;
 	if( prop->isInherited ) flags |= 4;
+	// Only the offsets are stored differently, so the flag is
+	// left out for classes that keep the declaration order
+	if( ot->propertiesReordered && !prop->isInherited ) flags |= 8;
 	WriteEncodedInt64(flags);
 }
 
@@ -4950,7 +5422,9 @@ void asCWriter::WriteByteCode(asCScriptFunction *func)
 			*(int*)(tmpBC+1) = FindTypeIdIdx(*(int*)(tmpBC+1));
 		}
 		else if( c == asBC_LoadRObjR ||    // rW_W_DW_ARG
-			     c == asBC_LoadVObjR )     // rW_W_DW_ARG
+			     c == asBC_LoadVObjR ||    // rW_W_DW_ARG
+			     c == asBC_CpyThisToV4 ||  // rW_W_DW_ARG
+			     c == asBC_CpyVtoThis4 )   // rW_W_DW_ARG
 		{
 			asCObjectType *ot = engine->GetObjectTypeFromTypeId(*(int*)(tmpBC+2));
 			if( ot->flags & asOBJ_LIST_PATTERN )
@@ -5055,6 +5529,19 @@ void asCWriter::WriteByteCode(asCScriptFunction *func)
 			// Set the offset in number of instructions
 			*(int*)(tmpBC+1) = targetBcSeqNum - bcSeqNum;
 		}
+		else if( c >= asBC_CMPIiJZ && c <= asBC_CMPIiJNP ) // rW_DW_DW_ARG
+		{
+			// The jump offset is stored in the second dword argument
+			int offset = *(int*)(tmpBC+2);
+
+			// Determine instruction number for next instruction and destination
+			int bcSeqNum = bytecodeNbrByPos[asUINT(bc - startBC)] + 1;
+			asDWORD *targetBC = bc + 3 + offset;
+			int targetBcSeqNum = bytecodeNbrByPos[asUINT(targetBC - startBC)];
+
+			// Set the offset in number of instructions
+			*(int*)(tmpBC+2) = targetBcSeqNum - bcSeqNum;
+		}
 		else if( c == asBC_GETOBJ ||    // W_ARG
 			     c == asBC_GETOBJREF ||
 			     c == asBC_GETREF ||
@@ -49,20 +49,61 @@ class asCReader
 {
 public:
 	asCReader(asCModule *module, asIBinaryStream *stream, asCScriptEngine *engine);
+	asCReader(asCModule *module, const asBYTE *memory, size_t memorySize, asCScriptEngine *engine);
+	~asCReader();
 
-	int Read(bool *wasDebugInfoStripped);
+	// When loading multiple modules in parallel, the translation of the functions and
+	// the initialization of the global variables is left for after all modules are read
+	int Read(bool *wasDebugInfoStripped, bool isLoadingInParallel = false);
+
+	// Translates the bytecode of a function that was postponed with asEP_LAZY_LOAD_FUNCTIONS
+	int LoadDeferredFunction(asCScriptFunction *func);
+
+	// Translates all the postponed functions of the module. Can be called by any thread
+	// as nothing but the functions is modified. The error messages are kept until the
+	// owner of the module calls WriteBufferedErrors
+	int  TranslateDeferredFunctions();
+	void WriteBufferedErrors();
 
 protected:
 	asCModule       *module;
 	asIBinaryStream *stream;
 	asCScriptEngine *engine;
+
+	// When loading from memory the data is taken directly from the
+	// buffer instead of making a virtual call to the stream for each byte
+	const asBYTE    *memory;
+	size_t           memorySize;
+	size_t           memoryPos;
 	bool             noDebugInfo;
 	bool             error;
 	asUINT           bytesRead;
 
+	// Set if the bytecode was saved with the same registered
+	// interface, i.e. the application functions have the same ids
+	bool             interfaceMatches;
+	asCString        changedConfigGroups;
+
+	// With asEP_LAZY_LOAD_FUNCTIONS the bytes read for each function's bytecode are copied
+	// to the function, and after the load the tables needed to translate them are kept
+	// in a separate reader owned by the module until all the functions have been loaded
+	asCArray<asBYTE>             *recordedData;
+	asCArray<asDWORD>             skippedByteCode;
+	asCArray<asCScriptFunction*>  deferredFunctions;
+	bool                          holdsReferences;
+	bool                          isLoadingInParallel;
+	bool                          bufferErrors;
+	asCArray<asCString>           bufferedErrors;
+
+	// The JIT compiler may ask for the bytecode of other functions in the module while
+	// it compiles a loaded function, so the thread that holds the lock may enter it again
+	DECLARECRITICALSECTION(deferredLock)
+	asCThreadLocalData           *deferredLockOwner;
+
 	int                Error(const char *msg);
 
 	int                ReadInner();
+	void               ReadInterfaceFingerprint();
 
 	int                ReadData(void *data, asUINT size);
 	void               ReadString(asCString *str);
@@ -73,7 +114,7 @@ protected:
 	void               ReadDataType(asCDataType *dt);
 	asCTypeInfo       *ReadTypeInfo();
 	void               ReadTypeDeclaration(asCTypeInfo *ot, int phase, bool *isExternal = 0);
-	void               ReadByteCode(asCScriptFunction *func);
+	void               ReadByteCode(asCArray<asDWORD> &byteCode);
 	asWORD             ReadEncodedUInt16();
 	asUINT             ReadEncodedUInt();
 	asQWORD            ReadEncodedUInt64();
@@ -84,6 +125,9 @@ protected:
 	void ReadUsedStringConstants();
 	void ReadUsedObjectProps();
 
+	asCReader *CreateDeferredLoader();
+	int        TranslateDeferredFunction(asCScriptFunction *func);
+
 	asCTypeInfo *      FindType(int idx);
 	int                FindTypeId(int idx);
 	short              FindObjectPropOffset(asWORD index);
@@ -117,6 +161,7 @@ protected:
 		asCObjectProperty *prop;
 	};
 	asCArray<SObjProp> usedObjectProperties;
+	asCObjectProperty *lastCompositeProp;
 
 	asCMap<void*,bool>              existingShared;
 	asCMap<asCScriptFunction*,bool> dontTranslate;
@@ -172,11 +217,12 @@ protected:
 
 	int  WriteData(const void *data, asUINT size);
 
+	void WriteInterfaceFingerprint();
 	void WriteString(asCString *str);
 	void WriteFunction(asCScriptFunction *func);
 	void WriteFunctionSignature(asCScriptFunction *func);
 	void WriteGlobalProperty(asCGlobalProperty *prop);
-	void WriteObjectProperty(asCObjectProperty *prop);
+	void WriteObjectProperty(asCObjectType *ot, asCObjectProperty *prop);
 	void WriteDataType(const asCDataType *dt);
 	void WriteTypeInfo(asCTypeInfo *ot);
 	void WriteTypeDeclaration(asCTypeInfo *ot, int phase);
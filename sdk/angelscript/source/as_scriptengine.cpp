@@ -52,6 +52,7 @@
 #include "as_compiler.h"
 #include "as_bytecode.h"
 #include "as_debug.h"
+#include "as_restore.h"
 
 BEGIN_AS_NAMESPACE
 
@@ -115,6 +116,12 @@ AS_API const char * asGetLibraryOptions()
 #ifdef AS_NO_EXCEPTIONS
 		"AS_NO_EXCEPTIONS "
 #endif
+#ifdef AS_NO_THREADED_DISPATCH
+		"AS_NO_THREADED_DISPATCH "
+#endif
+#ifdef AS_NO_JIT
+		"AS_NO_JIT "
+#endif
 #ifdef WIP_16BYTE_ALIGN
 		"WIP_16BYTE_ALIGN "
 #endif
@@ -289,9 +296,9 @@ int asCScriptEngine::SetEngineProperty(asEEngineProp property, asPWORD value)
 	case asEP_MAX_STACK_SIZE:
 		if( value == 0 )
 		{
-			// Restore default: no limit and initially size 4KB
+			// Restore default: no limit and initially the size given by asEP_INIT_STACK_SIZE
 			ep.maximumContextStackSize = 0;
-			initialContextStackSize    = 1024;
+			initialContextStackSize    = ep.initContextStackSize;
 		}
 		else
 		{
@@ -304,6 +311,9 @@ int asCScriptEngine::SetEngineProperty(asEEngineProp property, asPWORD value)
 					initialContextStackSize = 1;
 			}
 		}
+
+		// The pooled stack blocks may no longer have the size the contexts will ask for
+		memoryMgr.FreeUnusedStackBlocks();
 		break;
 
 	case asEP_USE_CHARACTER_LITERALS:
@@ -426,6 +436,83 @@ int asCScriptEngine::SetEngineProperty(asEEngineProp property, asPWORD value)
 			ep.genericCallMode = (asUINT)value;
 		break;
 
+	case asEP_INIT_STACK_SIZE:
+		// The size is given in bytes, but we only store dwords
+		if( value < 4 )
+			ep.initContextStackSize = 1;
+		else if( value/4 > 0x10000000 )
+			ep.initContextStackSize = 0x10000000;
+		else
+			ep.initContextStackSize = (asUINT)value/4;
+
+		initialContextStackSize = ep.initContextStackSize;
+		if( ep.maximumContextStackSize && initialContextStackSize > ep.maximumContextStackSize )
+			initialContextStackSize = ep.maximumContextStackSize;
+
+		// The pooled stack blocks may no longer have the size the contexts will ask for
+		memoryMgr.FreeUnusedStackBlocks();
+		break;
+
+	case asEP_STACK_BLOCK_POOL_SIZE:
+		if( value > 0xFFFFFFFF )
+			ep.stackBlockPoolSize = 0xFFFFFFFF;
+		else
+			ep.stackBlockPoolSize = (asUINT)value;
+		memoryMgr.SetStackBlockPoolSize(ep.stackBlockPoolSize);
+		break;
+
+	case asEP_PROFILE_FUNCTIONS:
+		ep.profileFunctions = value ? true : false;
+		break;
+
+	case asEP_USE_BUILD_ARENA:
+		ep.useBuildArena = value ? true : false;
+		break;
+
+	case asEP_COMPILE_THREADS:
+		if( value > 64 )
+			ep.compileThreads = 64;
+		else
+			ep.compileThreads = (asUINT)value;
+		break;
+
+	case asEP_LAZY_LOAD_FUNCTIONS:
+		ep.lazyLoadFunctions = value ? true : false;
+		break;
+
+	case asEP_BACKGROUND_GARBAGE_COLLECT:
+		if( value )
+			return gc.StartBackgroundDetection();
+		gc.StopBackgroundDetection();
+		break;
+
+	case asEP_GC_PROMOTION_AGE:
+		if( value > 0xFFFF )
+			ep.gcPromotionAge = 0xFFFF;
+		else
+			ep.gcPromotionAge = (asUINT)value;
+		break;
+
+	case asEP_GC_TENURE_AGE:
+		if( value > 0xFFFF )
+			ep.gcTenureAge = 0xFFFF;
+		else
+			ep.gcTenureAge = (asUINT)value;
+		break;
+
+	case asEP_GC_TENURED_SCAN_INTERVAL:
+		if( value < 1 )
+			ep.gcTenuredScanInterval = 1;
+		else if( value > 0xFFFF )
+			ep.gcTenuredScanInterval = 0xFFFF;
+		else
+			ep.gcTenuredScanInterval = (asUINT)value;
+		break;
+
+	case asEP_REORDER_CLASS_PROPERTIES:
+		ep.reorderClassProperties = value ? true : false;
+		break;
+
 	default:
 		return asINVALID_ARG;
 	}
@@ -522,6 +609,39 @@ asPWORD asCScriptEngine::GetEngineProperty(asEEngineProp property) const
 	case asEP_GENERIC_CALL_MODE:
 		return ep.genericCallMode;
 
+	case asEP_INIT_STACK_SIZE:
+		return ep.initContextStackSize*4;
+
+	case asEP_STACK_BLOCK_POOL_SIZE:
+		return ep.stackBlockPoolSize;
+
+	case asEP_PROFILE_FUNCTIONS:
+		return ep.profileFunctions;
+
+	case asEP_USE_BUILD_ARENA:
+		return ep.useBuildArena;
+
+	case asEP_COMPILE_THREADS:
+		return ep.compileThreads;
+
+	case asEP_LAZY_LOAD_FUNCTIONS:
+		return ep.lazyLoadFunctions;
+
+	case asEP_BACKGROUND_GARBAGE_COLLECT:
+		return gc.IsBackgroundDetectionRunning();
+
+	case asEP_GC_PROMOTION_AGE:
+		return ep.gcPromotionAge;
+
+	case asEP_GC_TENURE_AGE:
+		return ep.gcTenureAge;
+
+	case asEP_GC_TENURED_SCAN_INTERVAL:
+		return ep.gcTenuredScanInterval;
+
+	case asEP_REORDER_CLASS_PROPERTIES:
+		return ep.reorderClassProperties;
+
 	default:
 		return 0;
 	}
@@ -588,8 +708,20 @@ asCScriptEngine::asCScriptEngine()
 		ep.heredocTrimMode               = 1;         // 0 = never trim, 1 = don't trim on single line, 2 = trim initial and final empty line
 		ep.maxNestedCalls                = 100;
 		ep.genericCallMode               = 1;         // 0 = old (pre 2.33.0) behavior where generic ignored auto handles, 1 = treat handles like in native call
+		ep.initContextStackSize          = 1024;      // 4 KB (1024 * sizeof(asDWORD))
+		ep.stackBlockPoolSize            = 16;        // 0 = stack blocks are freed when the contexts are destroyed
+		ep.profileFunctions              = false;
+		ep.useBuildArena                 = false;
+		ep.compileThreads                = 0;
+		ep.lazyLoadFunctions             = false;
+		ep.gcPromotionAge                = 3;
+		ep.gcTenureAge                   = 4;         // 0 = old objects are never tenured
+		ep.gcTenuredScanInterval         = 8;
+		ep.reorderClassProperties        = false;
 	}
 
+	memoryMgr.SetStackBlockPoolSize(ep.stackBlockPoolSize);
+
 	gc.engine = this;
 	tok.engine = this;
 
@@ -597,6 +729,8 @@ asCScriptEngine::asCScriptEngine()
 	stringFactory = 0;
 	configFailed = false;
 	isPrepared = false;
+	isInterfaceFingerprintValid = false;
+	interfaceFingerprint = 0;
 	isBuilding = false;
 	deferValidationOfTemplateTypes = false;
 	lastModule = 0;
@@ -942,6 +1076,12 @@ asCModule *asCScriptEngine::FindNewOwnerForSharedFunc(asCScriptFunction *in_func
 	return in_func->module;
 }
 
+// interface
+void asCScriptEngine::GetContextStackStatistics(asUINT *totalAllocated, asUINT *totalReused, asUINT *currentlyPooled) const
+{
+	memoryMgr.GetStackBlockStatistics(totalAllocated, totalReused, currentlyPooled);
+}
+
 // interface
 void asCScriptEngine::ReturnContext(asIScriptContext *ctx)
 {
@@ -983,6 +1123,9 @@ int asCScriptEngine::Release() const
 // interface
 int asCScriptEngine::ShutDownAndRelease()
 {
+	// The objects must not be accessed by the background thread while they are destroyed
+	gc.StopBackgroundDetection();
+
 	// Do a full garbage collection cycle to clean up any object that may still hold on to the engine
 	GarbageCollect();
 
@@ -1302,6 +1445,144 @@ asIScriptModule *asCScriptEngine::GetModuleByIndex(asUINT index) const
 	return mod;
 }
 
+// internal
+struct sParallelLoad
+{
+	asCArray<asCModule*> *modules;
+	asCArray<int>        *results;
+	asUINT                nextModule;
+	DECLARECRITICALSECTION(lock)
+};
+
+// internal
+static void TranslateModules(sParallelLoad *load)
+{
+	for(;;)
+	{
+		ENTERCRITICALSECTION(load->lock);
+		asUINT n = load->nextModule++;
+		LEAVECRITICALSECTION(load->lock);
+
+		if( n >= load->modules->GetLength() )
+			break;
+
+		asCModule *mod = (*load->modules)[n];
+		if( (*load->results)[n] >= 0 && mod->deferredLoader )
+			(*load->results)[n] = mod->deferredLoader->TranslateDeferredFunctions();
+	}
+}
+
+// internal
+static void TranslateModulesThread(void *param)
+{
+	TranslateModules(reinterpret_cast<sParallelLoad*>(param));
+
+	// Free the thread local data, including the memory blocks cached for the thread
+	asCThreadManager::CleanupLocalData();
+}
+
+// interface
+int asCScriptEngine::LoadByteCodeForModules(asIScriptModule **modules, asIBinaryStream **streams, asUINT count, asUINT numThreads, int *results)
+{
+	if( count == 0 ) return asSUCCESS;
+	if( modules == 0 || streams == 0 ) return asINVALID_ARG;
+
+	int r = RequestBuild();
+	if( r < 0 )
+		return r;
+
+	asCArray<asCModule*> mods;
+	asCArray<int>        res;
+	mods.Allocate(count, false);
+	res.Allocate(count, false);
+	if( mods.GetCapacity() < count || res.GetCapacity() < count )
+	{
+		BuildCompleted();
+		return asOUT_OF_MEMORY;
+	}
+
+	// The modules are read one at a time, as this adds the types and functions
+	// to the engine. Only the bytecode of the functions is kept for later
+	for( asUINT n = 0; n < count; n++ )
+	{
+		asCModule *mod = reinterpret_cast<asCModule*>(modules[n]);
+		mods.PushLast(mod);
+
+		if( mod == 0 || streams[n] == 0 )
+		{
+			res.PushLast(asINVALID_ARG);
+			continue;
+		}
+
+		if( mod->HasExternalReferences(false) )
+		{
+			WriteMessage("", 0, 0, asMSGTYPE_ERROR, TXT_MODULE_IS_IN_USE);
+			res.PushLast(asMODULE_IS_IN_USE);
+			continue;
+		}
+
+		asCReader read(mod, streams[n], this);
+		r = read.Read(0, true);
+		if( r >= 0 )
+			mod->JITCompile();
+		res.PushLast(r);
+	}
+
+	// The bytecode of the functions doesn't depend on other modules so it can be translated
+	// in parallel. With asEP_LAZY_LOAD_FUNCTIONS this is left for the first call instead
+	if( !ep.lazyLoadFunctions )
+	{
+		sParallelLoad load;
+		load.modules    = &mods;
+		load.results    = &res;
+		load.nextModule = 0;
+
+		asCArray<void*> threads;
+		for( asUINT t = 1; t < numThreads && t < count; t++ )
+		{
+			void *thread = asStartThread(TranslateModulesThread, &load);
+			if( thread == 0 )
+				break;
+			threads.PushLast(thread);
+		}
+
+		// The calling thread translates its share of the modules too
+		TranslateModules(&load);
+
+		for( asUINT t = 0; t < threads.GetLength(); t++ )
+			asJoinThread(threads[t]);
+	}
+
+	// Adding the references may call the string factory, and initializing
+	// the global variables executes scripts, so this is done one module at
+	// a time in the order they were given
+	r = asSUCCESS;
+	for( asUINT n = 0; n < count; n++ )
+	{
+		asCModule *mod = mods[n];
+		if( mod && mod->deferredLoader )
+		{
+			mod->deferredLoader->WriteBufferedErrors();
+			if( res[n] < 0 )
+				mod->InternalReset();
+			else if( !ep.lazyLoadFunctions )
+				mod->ResolveDeferredFunctions(true);
+		}
+
+		if( res[n] >= 0 && ep.initGlobalVarsAfterBuild )
+			res[n] = mod->ResetGlobalVars(0);
+
+		if( results )
+			results[n] = res[n];
+		if( res[n] < 0 )
+			r = asERROR;
+	}
+
+	BuildCompleted();
+
+	return r;
+}
+
 // internal
 int asCScriptEngine::GetFactoryIdByDecl(const asCObjectType *ot, const char *decl)
 {
@@ -1423,6 +1704,9 @@ int asCScriptEngine::CreateContext(asIScriptContext **context, bool isInternal)
 // interface
 int asCScriptEngine::RegisterObjectProperty(const char *obj, const char *declaration, int byteOffset, int compositeOffset, bool isCompositeIndirect)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	int r;
 	asCDataType dt;
 	asCBuilder bld(this, 0);
@@ -1463,6 +1747,7 @@ int asCScriptEngine::RegisterObjectProperty(const char *obj, const char *declara
 		return ConfigError(asOUT_OF_MEMORY, "RegisterObjectProperty", obj, declaration);
 
 	prop->name                = name;
+	InternName(prop->name);
 	prop->type                = type;
 	prop->byteOffset          = byteOffset;
 	prop->isPrivate           = false;
@@ -1491,6 +1776,9 @@ int asCScriptEngine::RegisterObjectProperty(const char *obj, const char *declara
 // interface
 int asCScriptEngine::RegisterInterface(const char *name)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	if( name == 0 ) return ConfigError(asINVALID_NAME, "RegisterInterface", 0, 0);
 
 	// Verify if the name has been registered as a type already
@@ -1553,6 +1841,9 @@ int asCScriptEngine::RegisterInterface(const char *name)
 // interface
 int asCScriptEngine::RegisterInterfaceMethod(const char *intf, const char *declaration)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	// Verify that the correct config group is set.
 	if( currentGroup->FindType(intf) == 0 )
 		return ConfigError(asWRONG_CONFIG_GROUP, "RegisterInterfaceMethod", intf, declaration);
@@ -1606,6 +1897,9 @@ int asCScriptEngine::RegisterInterfaceMethod(const char *intf, const char *decla
 
 int asCScriptEngine::RegisterObjectType(const char *name, int byteSize, asDWORD flags)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	int r;
 
 	isPrepared = false;
@@ -1904,6 +2198,9 @@ int asCScriptEngine::RegisterObjectType(const char *name, int byteSize, asDWORD
 // interface
 int asCScriptEngine::RegisterObjectBehaviour(const char *datatype, asEBehaviours behaviour, const char *decl, const asSFuncPtr &funcPointer, asDWORD callConv, void *auxiliary, int compositeOffset, bool isCompositeIndirect)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	if( datatype == 0 ) return ConfigError(asINVALID_ARG, "RegisterObjectBehaviour", datatype, decl);
 
 	// Determine the object type
@@ -2514,6 +2811,9 @@ int asCScriptEngine::AddBehaviourFunction(asCScriptFunction &func, asSSystemFunc
 // interface
 int asCScriptEngine::RegisterGlobalProperty(const char *declaration, void *pointer)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	// Don't accept a null pointer
 	if( pointer == 0 )
 		return ConfigError(asINVALID_ARG, "RegisterGlobalProperty", declaration, 0);
@@ -2533,6 +2833,7 @@ int asCScriptEngine::RegisterGlobalProperty(const char *declaration, void *point
 	// Store the property info
 	asCGlobalProperty *prop = AllocateGlobalProperty();
 	prop->name        = name;
+	InternName(prop->name);
 	prop->nameSpace   = defaultNamespace;
 	prop->type        = type;
 	prop->accessMask  = defaultAccessMask;
@@ -2675,6 +2976,9 @@ int asCScriptEngine::GetGlobalPropertyIndexByDecl(const char *decl) const
 // interface
 int asCScriptEngine::RegisterObjectMethod(const char *obj, const char *declaration, const asSFuncPtr &funcPointer, asDWORD callConv, void *auxiliary, int compositeOffset, bool isCompositeIndirect)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	if( obj == 0 )
 		return ConfigError(asINVALID_ARG, "RegisterObjectMethod", obj, declaration);
 
@@ -2842,6 +3146,9 @@ int asCScriptEngine::RegisterMethodToObjectType(asCObjectType *objectType, const
 // interface
 int asCScriptEngine::RegisterGlobalFunction(const char *declaration, const asSFuncPtr &funcPointer, asDWORD callConv, void *auxiliary)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 #ifdef AS_MAX_PORTABILITY
 	if( callConv != asCALL_GENERIC )
 		return ConfigError(asNOT_SUPPORTED, "RegisterGlobalFunction", declaration, 0);
@@ -3135,6 +3442,9 @@ int asCScriptEngine::ConfigError(int err, const char *funcName, const char *arg1
 // interface
 int asCScriptEngine::RegisterDefaultArrayType(const char *type)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	asCBuilder bld(this, 0);
 	asCDataType dt;
 	int r = bld.ParseDataType(type, &dt, defaultNamespace);
@@ -3162,6 +3472,9 @@ int asCScriptEngine::GetDefaultArrayTypeId() const
 // interface
 int asCScriptEngine::RegisterStringFactory(const char *datatype, asIStringFactory *factory)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	if (factory == 0)
 		return ConfigError(asINVALID_ARG, "RegisterStringFactory", datatype, 0);
 
@@ -3273,12 +3586,30 @@ int asCScriptEngine::RequestBuild()
 // internal
 void asCScriptEngine::BuildCompleted()
 {
+#ifndef AS_NO_COMPILER
+	// Release all the memory that was taken from the build arena
+	memoryMgr.EndBuildArena();
+#endif
+
 	// Always free up pooled memory after a completed build
 	memoryMgr.FreeUnusedMemory();
 
+	// Free the names that are no longer used by any function or property
+	ENTERCRITICALSECTION(nameTableLock);
+	nameTable.Purge();
+	LEAVECRITICALSECTION(nameTableLock);
+
 	isBuilding = false;
 }
 
+// internal
+void asCScriptEngine::InternName(asCString &name)
+{
+	ENTERCRITICALSECTION(nameTableLock);
+	nameTable.Intern(name);
+	LEAVECRITICALSECTION(nameTableLock);
+}
+
 void asCScriptEngine::RemoveTemplateInstanceType(asCObjectType *t)
 {
 	// If there is a module that still owns the generated type, then don't remove it
@@ -4626,6 +4957,18 @@ void asCScriptEngine::GetGCStatistics(asUINT *currentSize, asUINT *totalDestroye
 	gc.GetStatistics(currentSize, totalDestroyed, totalDetected, newObjects, totalNewDestroyed);
 }
 
+// interface
+int asCScriptEngine::GetGCGenerationStatistics(asUINT generation, asUINT *currentSize, asUINT *totalDestroyed, asUINT *totalPromoted, asUINT *totalScans) const
+{
+	return gc.GetGenerationStatistics(generation, currentSize, totalDestroyed, totalPromoted, totalScans);
+}
+
+// interface
+int asCScriptEngine::GetGCPhaseStatistics(asEGCPhase phase, double *totalTime, double *maxStepTime, asQWORD *totalSteps) const
+{
+	return gc.GetPhaseStatistics(phase, totalTime, maxStepTime, totalSteps);
+}
+
 // interface
 void asCScriptEngine::GCEnumCallback(void *reference)
 {
@@ -4690,8 +5033,9 @@ int asCScriptEngine::GetTypeIdFromDataType(const asCDataType &dtIn) const
 	int typeId = -1;
 	asCTypeInfo *ot = dtIn.GetTypeInfo();
 	asASSERT(ot != &functionBehaviours);
-	// Object's hold the typeId themselves
-	typeId = ot->typeId;
+	// Object's hold the typeId themselves. The compiler threads may
+	// be asking for the same type id when compiling in parallel
+	typeId = asAtomicLoadAcquire(ot->typeId);
 
 	if( typeId == -1 )
 	{
@@ -4705,10 +5049,12 @@ int asCScriptEngine::GetTypeIdFromDataType(const asCDataType &dtIn) const
 			else if( ot->flags & asOBJ_ENUM ) {} // TODO: Should we have a specific bit for this?
 			else typeId |= asTYPEID_APPOBJECT;
 
-			ot->typeId = typeId;
+			asAtomicStoreRelease(ot->typeId, typeId);
 
 			mapTypeIdToTypeInfo.Insert(typeId, ot);
 		}
+		else
+			typeId = ot->typeId;
 		RELEASEEXCLUSIVE(engineRWLock);
 	}
 
@@ -5376,6 +5722,7 @@ int asCScriptEngine::BeginConfigGroup(const char *groupName)
 
 	configGroups.PushLast(group);
 	currentGroup = group;
+	isInterfaceFingerprintValid = false;
 
 	return 0;
 }
@@ -5434,12 +5781,68 @@ int asCScriptEngine::RemoveConfigGroup(const char *groupName)
 			group->RemoveConfiguration(this);
 
 			asDELETE(group,asCConfigGroup);
+			isInterfaceFingerprintValid = false;
 		}
 	}
 
 	return 0;
 }
 
+// interface
+asQWORD asCScriptEngine::GetInterfaceFingerprint(const char *groupName) const
+{
+	ENTERCRITICALSECTION(fingerprintLock);
+
+	// The fingerprint is calculated on demand and kept until something new is registered
+	if( !isInterfaceFingerprintValid )
+		const_cast<asCScriptEngine*>(this)->UpdateInterfaceFingerprint();
+
+	asQWORD fingerprint = 0;
+	if( groupName == 0 )
+		fingerprint = interfaceFingerprint;
+	else if( defaultGroup.groupName == groupName )
+		fingerprint = defaultGroup.fingerprint;
+	else
+	{
+		for( asUINT n = 0; n < configGroups.GetLength(); n++ )
+			if( configGroups[n]->groupName == groupName )
+			{
+				fingerprint = configGroups[n]->fingerprint;
+				break;
+			}
+	}
+
+	LEAVECRITICALSECTION(fingerprintLock);
+
+	return fingerprint;
+}
+
+// internal
+void asCScriptEngine::UpdateInterfaceFingerprint()
+{
+	defaultGroup.CalculateFingerprint(this);
+	asQWORD hash = defaultGroup.fingerprint;
+	for( asUINT n = 0; n < configGroups.GetLength(); n++ )
+	{
+		configGroups[n]->CalculateFingerprint(this);
+
+		// Hash the bytes in the same order on all platforms
+		char bytes[8];
+		for( int b = 0; b < 8; b++ )
+			bytes[b] = char(configGroups[n]->fingerprint >> (b*8));
+		hash = asStringHash64(bytes, 8, hash);
+	}
+
+	// The default array and the string type are not part of any group
+	asCString decl = defaultArrayObjectType ? defaultArrayObjectType->name : asCString();
+	hash = asStringHash64(decl.AddressOf(), decl.GetLength() + 1, hash);
+	decl = stringType.Format(nameSpaces[0], true);
+	hash = asStringHash64(decl.AddressOf(), decl.GetLength() + 1, hash);
+
+	interfaceFingerprint = hash;
+	isInterfaceFingerprintValid = true;
+}
+
 asCConfigGroup *asCScriptEngine::FindConfigGroupForFunction(int funcId) const
 {
 	for( asUINT n = 0; n < configGroups.GetLength(); n++ )
@@ -5517,6 +5920,10 @@ int asCScriptEngine::GetNextScriptFunctionId()
 
 void asCScriptEngine::AddScriptFunction(asCScriptFunction *func)
 {
+	InternName(func->name);
+	for( asUINT n = 0; n < func->parameterNames.GetLength(); n++ )
+		InternName(func->parameterNames[n]);
+
 	// Update the internal arrays with the function id that is now used
 	if( freeScriptFunctionIds.GetLength() && freeScriptFunctionIds[freeScriptFunctionIds.GetLength()-1] == func->id )
 		freeScriptFunctionIds.PopLast();
@@ -5606,6 +6013,9 @@ void asCScriptEngine::RemoveFuncdef(asCFuncdefType *funcdef)
 // interface
 int asCScriptEngine::RegisterFuncdef(const char *decl)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	if( decl == 0 ) return ConfigError(asINVALID_ARG, "RegisterFuncdef", decl, 0);
 
 	// Parse the function declaration
@@ -5750,6 +6160,9 @@ asCFuncdefType *asCScriptEngine::FindMatchingFuncdef(asCScriptFunction *func, as
 // TODO: typedef: Accept complex types for the typedefs
 int asCScriptEngine::RegisterTypedef(const char *type, const char *decl)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	if( type == 0 ) return ConfigError(asINVALID_NAME, "RegisterTypedef", type, decl);
 
 	// Verify if the name has been registered as a type already
@@ -5840,6 +6253,9 @@ asITypeInfo *asCScriptEngine::GetTypedefByIndex(asUINT index) const
 // interface
 int asCScriptEngine::RegisterEnum(const char *name)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	//	Check the name
 	if( NULL == name )
 		return ConfigError(asINVALID_NAME, "RegisterEnum", name, 0);
@@ -5895,6 +6311,9 @@ int asCScriptEngine::RegisterEnum(const char *name)
 // interface
 int asCScriptEngine::RegisterEnumValue(const char *typeName, const char *valueName, int value)
 {
+	// The registered interface is changing
+	isInterfaceFingerprintValid = false;
+
 	// Verify that the correct config group is used
 	if( currentGroup->FindType(typeName) == 0 )
 		return ConfigError(asWRONG_CONFIG_GROUP, "RegisterEnumValue", typeName, valueName);
@@ -6030,6 +6449,20 @@ asIScriptFunction *asCScriptEngine::GetFunctionById(int funcId) const
 	return GetScriptFunction(funcId);
 }
 
+// interface
+void asCScriptEngine::ResetProfileData()
+{
+	for( asUINT n = 0; n < scriptFunctions.GetLength(); n++ )
+	{
+		asCScriptFunction *func = scriptFunctions[n];
+		if( func )
+		{
+			func->profileCallCount = 0;
+			func->profileTime      = 0;
+		}
+	}
+}
+
 // internal
 bool asCScriptEngine::IsTemplateType(const char *name) const
 {
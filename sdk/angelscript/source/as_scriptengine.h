@@ -137,6 +137,7 @@ public:
 	virtual int         BeginConfigGroup(const char *groupName);
 	virtual int         EndConfigGroup();
 	virtual int         RemoveConfigGroup(const char *groupName);
+	virtual asQWORD     GetInterfaceFingerprint(const char *groupName = 0) const;
 	virtual asDWORD     SetDefaultAccessMask(asDWORD defaultMask);
 	virtual int         SetDefaultNamespace(const char *nameSpace);
 	virtual const char *GetDefaultNamespace() const;
@@ -146,9 +147,11 @@ public:
 	virtual int              DiscardModule(const char *module);
 	virtual asUINT           GetModuleCount() const;
 	virtual asIScriptModule *GetModuleByIndex(asUINT index) const;
+	virtual int              LoadByteCodeForModules(asIScriptModule **modules, asIBinaryStream **streams, asUINT count, asUINT numThreads, int *results);
 
 	// Script functions
 	virtual asIScriptFunction *GetFunctionById(int funcId) const;
+	virtual void               ResetProfileData();
 
 	// Type identification
 	virtual int            GetTypeIdByDecl(const char *decl) const;
@@ -174,6 +177,7 @@ public:
 	virtual asIScriptContext *RequestContext();
 	virtual void              ReturnContext(asIScriptContext *ctx);
 	virtual int               SetContextCallbacks(asREQUESTCONTEXTFUNC_t requestCtx, asRETURNCONTEXTFUNC_t returnCtx, void *param = 0);
+	virtual void              GetContextStackStatistics(asUINT *totalAllocated, asUINT *totalReused = 0, asUINT *currentlyPooled = 0) const;
 
 	// String interpretation
 	virtual asETokenClass ParseToken(const char *string, size_t stringLength = 0, asUINT *tokenLength = 0) const;
@@ -181,6 +185,8 @@ public:
 	// Garbage collection
 	virtual int  GarbageCollect(asDWORD flags = asGC_FULL_CYCLE, asUINT numIterations = 1);
 	virtual void GetGCStatistics(asUINT *currentSize, asUINT *totalDestroyed, asUINT *totalDetected, asUINT *newObjects, asUINT *totalNewDestroyed) const;
+	virtual int  GetGCGenerationStatistics(asUINT generation, asUINT *currentSize, asUINT *totalDestroyed, asUINT *totalPromoted, asUINT *totalScans) const;
+	virtual int  GetGCPhaseStatistics(asEGCPhase phase, double *totalTime, double *maxStepTime, asQWORD *totalSteps) const;
 	virtual int  NotifyGarbageCollectorOfNewObject(void *obj, asITypeInfo *type);
 	virtual int  GetObjectInGC(asUINT idx, asUINT *seqNbr, void **obj = 0, asITypeInfo **type = 0);
 	virtual void GCEnumCallback(void *reference);
@@ -256,9 +262,18 @@ public:
 	int  RequestBuild();
 	void BuildCompleted();
 
+	void InternName(asCString &name);
+
 	void PrepareEngine();
 	bool isPrepared;
 
+	// The fingerprint may be requested by several threads loading bytecode at the same time,
+	// so it is calculated and read within the critical section fingerprintLock
+	void UpdateInterfaceFingerprint();
+	asQWORD interfaceFingerprint;
+	bool    isInterfaceFingerprintValid;
+	DECLARECRITICALSECTION(mutable fingerprintLock)
+
 	int CreateContext(asIScriptContext **context, bool isInternal);
 
 	asCTypeInfo *GetRegisteredType(const asCString &name, asSNameSpace *ns) const;
@@ -321,6 +336,11 @@ public:
 //===========================================================
 	asCMemoryMgr memoryMgr;
 
+	// Identifiers are interned so equal names share the same memory and can be compared by pointer
+	// Synchronized with nameTableLock
+	asCAtomTable nameTable;
+	DECLARECRITICALSECTION(nameTableLock)
+
 	asUINT initialContextStackSize;
 
 	asCObjectType   *defaultArrayObjectType;
@@ -501,6 +521,16 @@ public:
 		int    heredocTrimMode;
 		asUINT maxNestedCalls;
 		asUINT genericCallMode;
+		asUINT initContextStackSize;
+		asUINT stackBlockPoolSize;
+		bool   profileFunctions;
+		bool   useBuildArena;
+		asUINT compileThreads;
+		bool   lazyLoadFunctions;
+		asUINT gcPromotionAge;
+		asUINT gcTenureAge;
+		asUINT gcTenuredScanInterval;
+		bool   reorderClassProperties;
 	} ep;
 
 	// Callbacks
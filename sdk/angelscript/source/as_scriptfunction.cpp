@@ -47,6 +47,8 @@
 #include "as_scriptnode.h"
 #include "as_builder.h"
 #include "as_scriptcode.h"
+#include "as_thread.h"
+#include "as_restore.h"
 
 #include <cstdlib> // qsort
 
@@ -363,6 +365,8 @@ asCScriptFunction::asCScriptFunction(asCScriptEngine *engine, asCModule *mod, as
 	signatureId            = 0;
 	dontCleanUpOnException = false;
 	vfTableIdx             = -1;
+	profileCallCount       = 0;
+	profileTime            = 0;
 	gcFlag                 = false;
 	userData               = 0;
 	id                     = 0;
@@ -392,6 +396,7 @@ void asCScriptFunction::AllocateScriptFunctionData()
 	scriptData->scriptSectionIdx = -1;
 	scriptData->declaredAt       = 0;
 	scriptData->jitFunction      = 0;
+	scriptData->deferredLoader   = 0;
 }
 
 void asCScriptFunction::DeallocateScriptFunctionData()
@@ -406,6 +411,30 @@ void asCScriptFunction::DeallocateScriptFunctionData()
 	scriptData = 0;
 }
 
+// Removes the compiled bytecode so the function can be compiled again
+void asCScriptFunction::ResetScriptFunctionData()
+{
+	if( !scriptData ) return;
+
+	// The references are only held while there is bytecode
+	ReleaseReferences();
+
+	scriptData->byteCode.SetLength(0);
+	scriptData->variableSpace = 0;
+	scriptData->objVariableTypes.SetLength(0);
+	scriptData->objVariablePos.SetLength(0);
+	scriptData->objVariablesOnHeap = 0;
+	scriptData->objVariableInfo.SetLength(0);
+	scriptData->stackNeeded = 0;
+
+	for( asUINT n = 0; n < scriptData->variables.GetLength(); n++ )
+		asDELETE(scriptData->variables[n],asSScriptVariable);
+	scriptData->variables.SetLength(0);
+
+	scriptData->lineNumbers.SetLength(0);
+	scriptData->sectionIdxs.SetLength(0);
+}
+
 // internal
 asCScriptFunction::~asCScriptFunction()
 {
@@ -826,6 +855,15 @@ asCString asCScriptFunction::GetDeclarationStr(bool includeObjectName, bool incl
 	return str;
 }
 
+// interface
+void asCScriptFunction::GetProfileData(asQWORD *callCount, double *totalTime) const
+{
+	if( callCount )
+		*callCount = profileCallCount;
+	if( totalTime )
+		*totalTime = double(profileTime) / double(asGetTimerFrequency());
+}
+
 // interface
 int asCScriptFunction::FindNextLineWithCode(int line) const
 {
@@ -1509,6 +1547,13 @@ asDWORD asCScriptFunction::GetAccessMask() const
 	return accessMask;
 }
 
+// The lazily loaded functions that are being JIT compiled are seen as loaded by the thread that compiles them
+static bool IsLoadingOnThisThread(asCScriptFunction *func)
+{
+	asCThreadLocalData *tld = asCThreadManager::GetLocalData();
+	return tld && tld->loadingFunctions.IndexOf(func) >= 0;
+}
+
 // internal
 void asCScriptFunction::JITCompile()
 {
@@ -1521,6 +1566,10 @@ void asCScriptFunction::JITCompile()
 	if( !jit )
 		return;
 
+	// Functions that haven't been loaded yet are compiled when they are loaded
+	if( scriptData->deferredLoader && !IsLoadingOnThisThread(this) )
+		return;
+
 	// Make sure the function has been compiled with JitEntry instructions
 	// For functions that has JitEntry this will be a quick test
 	asUINT length;
@@ -1561,11 +1610,31 @@ void asCScriptFunction::JITCompile()
 		asASSERT( scriptData->jitFunction == 0 );
 }
 
+// internal
+int asCScriptFunction::LoadDeferredByteCode()
+{
+	if( scriptData == 0 )
+		return asSUCCESS;
+
+	// The loader is cleared when the function has been loaded and JIT compiled
+	asCReader *loader = asAtomicLoadAcquire(scriptData->deferredLoader);
+	if( loader == 0 )
+		return asSUCCESS;
+
+	// The JIT compiler asks for the bytecode while the function is being loaded
+	if( IsLoadingOnThisThread(this) )
+		return asSUCCESS;
+
+	return loader->LoadDeferredFunction(this);
+}
+
 // interface
 asDWORD *asCScriptFunction::GetByteCode(asUINT *length)
 {
 	if( scriptData == 0 ) return 0;
 
+	LoadDeferredByteCode();
+
 	if( length )
 		*length = (asUINT)scriptData->byteCode.GetLength();
 
@@ -54,6 +54,7 @@ class asCConfigGroup;
 class asCGlobalProperty;
 class asCScriptNode;
 class asCFuncdefType;
+class asCReader;
 struct asSNameSpace;
 
 struct asSScriptVariable
@@ -184,6 +185,7 @@ public:
 	int                  GetVar(asUINT index, const char **name, int *typeId = 0) const;
 	const char *         GetVarDecl(asUINT index, bool includeNamespace = false) const;
 	int                  FindNextLineWithCode(int line) const;
+	void                 GetProfileData(asQWORD *callCount, double *totalTime) const;
 
 	// For JIT compilation
 	asDWORD             *GetByteCode(asUINT *length = 0);
@@ -248,11 +250,14 @@ public:
 
 	void      JITCompile();
 
+	int       LoadDeferredByteCode();
+
 	void      AddReferences();
 	void      ReleaseReferences();
 
 	void      AllocateScriptFunctionData();
 	void      DeallocateScriptFunctionData();
+	void      ResetScriptFunctionData();
 
 	asCGlobalProperty *GetPropertyByGlobalVarPtr(void *gvarPtr);
 
@@ -342,6 +347,11 @@ public:
 		int                             declaredAt;
 		// Store position/index pairs if the bytecode is compiled from multiple script sections
 		asCArray<int>                   sectionIdxs;
+
+		// Set when the module was loaded with asEP_LAZY_LOAD_FUNCTIONS until the function is
+		// first called. Until then the bytecode is kept as it was stored in the saved bytecode
+		asCReader                      *deferredLoader;
+		asCArray<asBYTE>                deferredByteCode;
 	};
 	ScriptFunctionData          *scriptData;
 
@@ -353,6 +363,11 @@ public:
 
 	// Used by asFUNC_SYSTEM
 	asSSystemFunctionInterface  *sysFuncIntf;
+
+	// Updated by the contexts when asEP_PROFILE_FUNCTIONS is turned on. The time is
+	// measured in timer ticks. The counters are not synchronized between threads
+	asQWORD                      profileCallCount;
+	asQWORD                      profileTime;
 };
 
 const char * const DELEGATE_FACTORY = "$dlgte";
@@ -41,6 +41,17 @@
 #include "as_string.h"
 #include "as_string_util.h"
 
+// The header of the interned strings. It is followed by the null terminated characters.
+struct asCString::SAtom
+{
+	int                 refCount;
+	unsigned int        hash;
+	const asCAtomTable *table;
+};
+
+// The byte in the local buffer that marks the dynamic buffer as an interned atom
+static const int ATOM_FLAG = 11;
+
 asCString::asCString()
 {
 	length = 0;
@@ -53,7 +64,14 @@ asCString::asCString(const asCString &str)
 	length = 0;
 	local[0] = 0;
 
-	Assign(str.AddressOf(), str.length);
+	if( str.IsInterned() )
+	{
+		// Share the same memory
+		asAtomicInc(str.GetAtom()->refCount);
+		SetAtom(str.GetAtom(), str.length);
+	}
+	else
+		Assign(str.AddressOf(), str.length);
 }
 
 #ifdef AS_CAN_USE_CPP11
@@ -69,6 +87,7 @@ asCString::asCString(asCString &&str)
 	{
 		dynamic = str.dynamic;
 		length = str.length;
+		local[ATOM_FLAG] = str.local[ATOM_FLAG];
 	}
 
 	str.dynamic = 0;
@@ -103,7 +122,9 @@ asCString::asCString(char ch)
 
 asCString::~asCString()
 {
-	if( length > 11 && dynamic )
+	if( IsInterned() )
+		ReleaseAtom();
+	else if( length > 11 && dynamic )
 	{
 		asDELETEARRAY(dynamic);
 	}
@@ -111,6 +132,10 @@ asCString::~asCString()
 
 char *asCString::AddressOf()
 {
+	// The memory of interned strings is shared, so it cannot be modified
+	if( IsInterned() )
+		Unshare(true);
+
 	if( length <= 11 )
 		return local;
 	else
@@ -139,6 +164,9 @@ void asCString::Allocate(size_t len, bool keepData)
 	// of these options, and it turned out that the current choice is what best balanced
 	// the number of allocations against the size of the allocations.
 
+	if( IsInterned() )
+		Unshare(keepData);
+
 	if( len > 11 && len > length )
 	{
 		// Allocate a new dynamic buffer if the new one is larger than the old
@@ -161,6 +189,7 @@ void asCString::Allocate(size_t len, bool keepData)
 		}
 
 		dynamic = buf;
+		local[ATOM_FLAG] = 0;
 	}
 	else if( len <= 11 && length > 11 )
 	{
@@ -198,7 +227,22 @@ asCString &asCString::operator =(const char *str)
 
 asCString &asCString::operator =(const asCString &str)
 {
-	Assign(str.AddressOf(), str.length);
+	if( str.IsInterned() )
+	{
+		if( this == &str || IsSameAtom(str) )
+			return *this;
+
+		asAtomicInc(str.GetAtom()->refCount);
+		if( IsInterned() )
+			ReleaseAtom();
+		else if( length > 11 )
+		{
+			asDELETEARRAY(dynamic);
+		}
+		SetAtom(str.GetAtom(), str.length);
+	}
+	else
+		Assign(str.AddressOf(), str.length);
 
 	return *this;
 }
@@ -208,7 +252,9 @@ asCString &asCString::operator =(asCString &&str)
 {
 	if( this != &str )
 	{
-		if( length > 11 && dynamic )
+		if( IsInterned() )
+			ReleaseAtom();
+		else if( length > 11 && dynamic )
 		{
 			asDELETEARRAY(dynamic);
 		}
@@ -224,6 +270,7 @@ asCString &asCString::operator =(asCString &&str)
 		{
 			dynamic = str.dynamic;
 			length = str.length;
+			local[ATOM_FLAG] = str.local[ATOM_FLAG];
 		}
 
 		str.dynamic = 0;
@@ -356,6 +403,89 @@ int asCString::Compare(const char *str, size_t len) const
 	return asCompareStrings(AddressOf(), length, str, len);
 }
 
+bool asCString::IsInterned() const
+{
+	return length > 11 && local[ATOM_FLAG] != 0;
+}
+
+// Returns true if both strings are known to share the same memory
+bool asCString::IsSameAtom(const asCString &other) const
+{
+	return IsInterned() && other.IsInterned() && dynamic == other.dynamic;
+}
+
+// Returns 1 if both strings share the same atom, -1 if they have different atoms from
+// the same table, i.e. they are known to be different, and 0 if they must be compared
+int asCString::CompareAtoms(const asCString &other) const
+{
+	if( !IsInterned() || !other.IsInterned() )
+		return 0;
+	if( dynamic == other.dynamic )
+		return 1;
+	if( GetAtom()->table && GetAtom()->table == other.GetAtom()->table )
+		return -1;
+	return 0;
+}
+
+unsigned int asCString::GetHash() const
+{
+	// The hash of interned strings is computed only once
+	if( IsInterned() )
+		return GetAtom()->hash;
+
+	return asStringHash(AddressOf(), length);
+}
+
+asCString::SAtom *asCString::GetAtom() const
+{
+	asASSERT( IsInterned() );
+	return reinterpret_cast<SAtom*>(dynamic) - 1;
+}
+
+// The caller must already hold a reference to the atom for this string
+void asCString::SetAtom(SAtom *atom, size_t len)
+{
+	dynamic = reinterpret_cast<char*>(atom + 1);
+	length = (unsigned int)len;
+	local[ATOM_FLAG] = 1;
+}
+
+void asCString::ReleaseAtom()
+{
+	SAtom *atom = GetAtom();
+	if( asAtomicDec(atom->refCount) == 0 )
+	{
+		asDELETEARRAY(reinterpret_cast<char*>(atom));
+	}
+
+	length = 0;
+	local[0] = 0;
+}
+
+// Give the string its own copy of the memory
+void asCString::Unshare(bool keepData)
+{
+	asASSERT( IsInterned() );
+
+	size_t len = length;
+	char *buf = asNEWARRAY(char, len+1);
+	if( buf == 0 )
+	{
+		// Out of memory. Return without modifying anything
+		return;
+	}
+
+	if( keepData )
+		memcpy(buf, dynamic, len+1);
+	else
+		buf[0] = 0;
+
+	ReleaseAtom();
+	dynamic = buf;
+	length = (unsigned int)len;
+	local[ATOM_FLAG] = 0;
+}
+
 size_t asCString::RecalculateLength()
 {
 	SetLength(strlen(AddressOf()));
@@ -402,12 +532,17 @@ bool operator !=(const asCString &a, const char *b)
 
 bool operator ==(const asCString &a, const asCString &b)
 {
+	int atoms = a.CompareAtoms(b);
+	if( atoms != 0 )
+		return atoms > 0;
+	if( a.GetLength() != b.GetLength() )
+		return false;
 	return a.Compare(b) == 0;
 }
 
 bool operator !=(const asCString &a, const asCString &b)
 {
-	return a.Compare(b) != 0;
+	return !(a == b);
 }
 
 bool operator ==(const char *a, const asCString &b)
@@ -485,3 +620,174 @@ bool asCStringPointer::operator<(const asCStringPointer& other) const
 {
 	return asCompareStrings(AddressOf(), GetLength(), other.AddressOf(), other.GetLength()) < 0;
 }
+
+//-----------------------------------------------------------------------------
+// Atom table
+
+asCAtomTable::asCAtomTable()
+{
+	slots    = 0;
+	numSlots = 0;
+	numAtoms = 0;
+}
+
+asCAtomTable::~asCAtomTable()
+{
+	for( unsigned int n = 0; n < numSlots; n++ )
+	{
+		asCString::SAtom *atom = slots[n];
+		if( atom == 0 )
+			continue;
+
+		// Strings that outlive the table can no longer be
+		// known to be different just because the atoms differ
+		atom->table = 0;
+		if( asAtomicDec(atom->refCount) == 0 )
+		{
+			asDELETEARRAY(reinterpret_cast<char*>(atom));
+		}
+	}
+
+	if( slots )
+	{
+		asDELETEARRAY(slots);
+	}
+}
+
+void asCAtomTable::Intern(asCString &str)
+{
+	// Short strings are stored in the local buffer and
+	// strings that are already interned have nothing to gain
+	if( str.GetLength() <= 11 || str.IsInterned() )
+		return;
+
+	const char  *chars = const_cast<const asCString&>(str).AddressOf();
+	size_t       len   = str.GetLength();
+
+	// The atoms are compared by their null terminated content
+	if( strlen(chars) != len )
+		return;
+
+	unsigned int hash = asStringHash(chars, len);
+
+	if( numSlots )
+	{
+		unsigned int mask = numSlots - 1;
+		for( unsigned int n = hash & mask; slots[n]; n = (n + 1) & mask )
+		{
+			asCString::SAtom *atom = slots[n];
+			if( atom->hash == hash && memcmp(atom + 1, chars, len + 1) == 0 )
+			{
+				asAtomicInc(atom->refCount);
+				asDELETEARRAY(str.dynamic);
+				str.SetAtom(atom, len);
+				return;
+			}
+		}
+	}
+
+	// Add a new atom. The table holds one reference and the string the other
+	char *mem = asNEWARRAY(char, sizeof(asCString::SAtom) + len + 1);
+	if( mem == 0 )
+	{
+		// Out of memory. The string is simply not interned
+		return;
+	}
+
+	// Keep the table at most half full so the probe sequences stay short
+	if( (numAtoms + 1) * 2 > numSlots && !Grow() )
+	{
+		asDELETEARRAY(mem);
+		return;
+	}
+
+	asCString::SAtom *atom = reinterpret_cast<asCString::SAtom*>(mem);
+	atom->refCount = 2;
+	atom->hash     = hash;
+	atom->table    = this;
+	memcpy(atom + 1, chars, len + 1);
+	Insert(atom);
+
+	asDELETEARRAY(str.dynamic);
+	str.SetAtom(atom, len);
+}
+
+void asCAtomTable::Purge()
+{
+	// Only the table holds a reference to the atoms with a reference count of 1, so no
+	// other thread can be adding references to them. The table itself is protected by the owner.
+	for( unsigned int n = 0; n < numSlots; )
+	{
+		if( slots[n] && slots[n]->refCount == 1 )
+		{
+			asDELETEARRAY(reinterpret_cast<char*>(slots[n]));
+
+			// Another atom may be moved into this slot so it must be checked again
+			Remove(n);
+			continue;
+		}
+		n++;
+	}
+}
+
+void asCAtomTable::Insert(asCString::SAtom *atom)
+{
+	unsigned int mask = numSlots - 1;
+	unsigned int n = atom->hash & mask;
+	while( slots[n] )
+		n = (n + 1) & mask;
+	slots[n] = atom;
+	numAtoms++;
+}
+
+void asCAtomTable::Remove(unsigned int slot)
+{
+	numAtoms--;
+
+	// Move back the following atoms that would otherwise no longer
+	// be found, since an empty slot terminates the probe sequence
+	unsigned int mask = numSlots - 1;
+	unsigned int next = slot;
+	for(;;)
+	{
+		next = (next + 1) & mask;
+		if( slots[next] == 0 )
+			break;
+
+		// Atoms whose preferred slot is cyclically in (slot, next] can stay where they are
+		unsigned int home = slots[next]->hash & mask;
+		if( slot <= next ? (slot < home && home <= next) : (slot < home || home <= next) )
+			continue;
+
+		slots[slot] = slots[next];
+		slot = next;
+	}
+
+	slots[slot] = 0;
+}
+
+bool asCAtomTable::Grow()
+{
+	asCString::SAtom **oldSlots = slots;
+	unsigned int oldNumSlots = numSlots;
+
+	unsigned int newNumSlots = numSlots ? numSlots * 2 : 64;
+	asCString::SAtom **newSlots = asNEWARRAY(asCString::SAtom*, newNumSlots);
+	if( newSlots == 0 )
+		return false;
+	memset(newSlots, 0, sizeof(asCString::SAtom*) * newNumSlots);
+
+	slots    = newSlots;
+	numSlots = newNumSlots;
+	numAtoms = 0;
+	for( unsigned int n = 0; n < oldNumSlots; n++ )
+		if( oldSlots[n] )
+			Insert(oldSlots[n]);
+
+	if( oldSlots )
+	{
+		asDELETEARRAY(oldSlots);
+	}
+
+	return true;
+}
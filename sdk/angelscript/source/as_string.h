@@ -29,8 +29,9 @@
 */
 
 // This class has been designed to be easy to use, but not necessarily efficiency.
-// It doesn't use shared string memory, or reference counting. It keeps track of
-// string length, memory size. It also makes sure that the string is null-terminated.
+// It keeps track of string length, memory size. It also makes sure that the string
+// is null-terminated. Strings are normally not shared, but strings that have been
+// interned in an asCAtomTable share the same reference counted memory until modified.
 
 #ifndef AS_STRING_H
 #define AS_STRING_H
@@ -84,13 +85,58 @@ public:
 	const char &operator[](size_t index) const;
 	size_t RecalculateLength();
 
+	// Interned strings with the same content and from the same table share the same memory
+	bool IsInterned() const;
+	int  CompareAtoms(const asCString &other) const;
+	bool IsSameAtom(const asCString &other) const;
+	unsigned int GetHash() const;
+
 protected:
+	friend class asCAtomTable;
+	struct SAtom;
+
+	SAtom *GetAtom() const;
+	void   SetAtom(SAtom *atom, size_t len);
+	void   ReleaseAtom();
+	void   Unshare(bool keepData);
+
 	unsigned int length;
 	union
 	{
 		char *dynamic;
 		char local[12];
 	};
+	// When the dynamic buffer is used, the last byte of the
+	// local buffer tells if it is owned by an interned atom
+};
+
+// Table of interned strings. The table keeps one reference to each atom so the
+// atom lives as long as the table or any string using it. Only strings longer than
+// the local buffer of asCString are interned, as shorter strings don't allocate memory.
+// The table is not thread safe. The owner must serialize the calls.
+class asCAtomTable
+{
+public:
+	asCAtomTable();
+	~asCAtomTable();
+
+	// Make the string share the memory with all other equal strings interned in the table
+	void Intern(asCString &str);
+
+	// Free the atoms that are no longer used by any string
+	void Purge();
+
+	unsigned int GetAtomCount() const { return numAtoms; }
+
+protected:
+	void Insert(asCString::SAtom *atom);
+	void Remove(unsigned int slot);
+	bool Grow();
+
+	// Open addressing with linear probing. The size is always a power of 2
+	asCString::SAtom **slots;
+	unsigned int       numSlots;
+	unsigned int       numAtoms;
 };
 
 // Helper functions
@@ -74,6 +74,30 @@ int asCompareStrings(const char *str1, size_t len1, const char *str2, size_t len
 	return result;
 }
 
+// FNV-1a hash
+asUINT asStringHash(const char *str, size_t len)
+{
+	asUINT hash = 2166136261u;
+	for( size_t n = 0; n < len; n++ )
+	{
+		hash ^= (asBYTE)str[n];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+// The 64bit variant can be chained by passing the previous
+// result as the initial hash for the next piece of data
+asQWORD asStringHash64(const char *str, size_t len, asQWORD hash)
+{
+	for( size_t n = 0; n < len; n++ )
+	{
+		hash ^= (asBYTE)str[n];
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
 double asStringScanDouble(const char *string, size_t *numScanned)
 {
 	// I decided to do my own implementation of strtod() because this function
@@ -37,6 +37,8 @@
 BEGIN_AS_NAMESPACE
 
 int     asCompareStrings(const char *str1, size_t len1, const char *str2, size_t len2);
+asUINT  asStringHash(const char *str, size_t len);
+asQWORD asStringHash64(const char *str, size_t len, asQWORD hash = 14695981039346656037ULL);
 
 double  asStringScanDouble(const char *string, size_t *numScanned);
 asQWORD asStringScanUInt64(const char *string, int base, size_t *numScanned, bool *overflow);
@@ -44,7 +44,6 @@
 #include "as_config.h"
 #include "as_memory.h"
 #include "as_string.h"
-#include "as_map.h"
 #include "as_datatype.h"
 #include "as_namespace.h"
 
@@ -100,7 +99,7 @@ private:
 
 // Symbol table mapping namespace + name to symbols
 // The structure keeps the entries indexed in an array so the indices will not change
-// There is also a map for a quick lookup. The map supports multiple entries with the same name
+// There is also a hash index for a quick lookup. The index supports multiple entries with the same name
 template<class T>
 class asCSymbolTable
 {
@@ -109,6 +108,7 @@ public:
 	typedef asCSymbolTableIterator<T, const T> const_iterator;
 
 	asCSymbolTable(asUINT initialCapacity = 0);
+	~asCSymbolTable();
 
 	int      GetFirstIndex(const asSNameSpace *ns, const asCString &name, const asIFilter &comparator) const;
 	int      GetFirstIndex(const asSNameSpace *ns, const asCString &name) const;
@@ -140,18 +140,43 @@ public:
 	const_iterator List() const;
 
 private:
-	// Don't allow assignment
+	// Don't allow copying or assignment
+	asCSymbolTable(const asCSymbolTable<T> &other);
 	asCSymbolTable<T>& operator=(const asCSymbolTable<T> &other) { return *this; }
 
 	friend class asCSymbolTableIterator<T, T>;
 	friend class asCSymbolTableIterator<T, const T>;
 
+	// All the entries with the same namespace and name
+	struct SKeyEntries
+	{
+		asSNameSpaceNamePair key;
+		asCArray<asUINT>     indexes;
+	};
+
+	// The slots of the hash index. The hash is kept in the slot so most
+	// probes can be resolved without comparing the names. A slot with a
+	// null pointer is empty. The number of slots is always a power of 2.
+	struct SSlot
+	{
+		asUINT       hash;
+		SKeyEntries *entries;
+	};
+
 	void GetKey(const T *entry, asSNameSpaceNamePair &key) const;
 	bool CheckIdx(asUINT idx) const;
 
-	asCMap<asSNameSpaceNamePair, asCArray<asUINT> > m_map;
-	asCArray<T*>                                    m_entries;
-	unsigned int                                    m_size;
+	static asUINT GetHash(const asSNameSpace *ns, const asCString &name);
+	int           FindSlot(const asSNameSpace *ns, const asCString &name, asUINT hash) const;
+	void          InsertSlot(asUINT hash, SKeyEntries *entries);
+	void          EraseSlot(asUINT slot);
+	void          GrowIndex();
+	void          ClearIndex();
+
+	asCArray<SSlot> m_slots;
+	asUINT          m_numKeys;
+	asCArray<T*>    m_entries;
+	unsigned int    m_size;
 };
 
 
@@ -160,12 +185,16 @@ private:
 template<class T>
 void asCSymbolTable<T>::SwapWith(asCSymbolTable<T> &other)
 {
-	m_map.SwapWith(other.m_map);
+	m_slots.SwapWith(other.m_slots);
 	m_entries.SwapWith(other.m_entries);
 
 	asUINT tmp = m_size;
 	m_size = other.m_size;
 	other.m_size = tmp;
+
+	tmp = m_numKeys;
+	m_numKeys = other.m_numKeys;
+	other.m_numKeys = tmp;
 }
 
 
@@ -176,7 +205,16 @@ void asCSymbolTable<T>::SwapWith(asCSymbolTable<T> &other)
 template<class T>
 asCSymbolTable<T>::asCSymbolTable(asUINT initialCapacity) : m_entries(initialCapacity)
 {
-	m_size = 0;
+	m_size    = 0;
+	m_numKeys = 0;
+}
+
+// Destructor
+// ATTENTION: The contained symbols are not released. This is up to the client
+template<class T>
+asCSymbolTable<T>::~asCSymbolTable()
+{
+	ClearIndex();
 }
 
 
@@ -187,12 +225,10 @@ int asCSymbolTable<T>::GetFirstIndex(
         const asCString &name,
         const asIFilter &filter) const
 {
-	asSNameSpaceNamePair key(ns, name);
-
-	asSMapNode<asSNameSpaceNamePair, asCArray<asUINT> > *cursor;
-	if( m_map.MoveTo(&cursor, key) )
+	int slot = FindSlot(ns, name, GetHash(ns, name));
+	if( slot >= 0 )
 	{
-		const asCArray<asUINT> &arr = m_map.GetValue(cursor);
+		const asCArray<asUINT> &arr = m_slots[slot].entries->indexes;
 		for( asUINT n = 0; n < arr.GetLength(); n++ )
 		{
 			T *entry = m_entries[arr[n]];
@@ -209,11 +245,9 @@ int asCSymbolTable<T>::GetFirstIndex(
 template<class T>
 const asCArray<asUINT> &asCSymbolTable<T>::GetIndexes(const asSNameSpace *ns, const asCString &name) const
 {
-	asSNameSpaceNamePair key(ns, name);
-
-	asSMapNode<asSNameSpaceNamePair, asCArray<asUINT> > *cursor;
-	if( m_map.MoveTo(&cursor, key) )
-		return m_map.GetValue(cursor);
+	int slot = FindSlot(ns, name, GetHash(ns, name));
+	if( slot >= 0 )
+		return m_slots[slot].entries->indexes;
 
 	static asCArray<asUINT> dummy;
 	return dummy;
@@ -236,11 +270,9 @@ T* asCSymbolTable<T>::GetFirst(const asSNameSpace *ns, const asCString &name, co
 template<class T>
 int asCSymbolTable<T>::GetFirstIndex(const asSNameSpace *ns, const asCString &name) const
 {
-	asSNameSpaceNamePair key(ns, name);
-
-	asSMapNode<asSNameSpaceNamePair, asCArray<asUINT> > *cursor;
-	if( m_map.MoveTo(&cursor, key) )
-		return m_map.GetValue(cursor)[0];
+	int slot = FindSlot(ns, name, GetHash(ns, name));
+	if( slot >= 0 )
+		return m_slots[slot].entries->indexes[0];
 
 	return -1;
 }
@@ -323,7 +355,7 @@ template<class T>
 void asCSymbolTable<T>::Clear()
 {
 	m_entries.SetLength(0);
-	m_map.EraseAll();
+	ClearIndex();
 	m_size = 0;
 }
 
@@ -337,7 +369,7 @@ void asCSymbolTable<T>::Allocate(asUINT elemCnt, bool keepData)
 	asASSERT( elemCnt >= m_entries.GetLength() );
 	m_entries.Allocate(elemCnt, keepData);
 	if( !keepData )
-		m_map.EraseAll();
+		ClearIndex();
 }
 
 
@@ -356,17 +388,17 @@ bool asCSymbolTable<T>::Erase(asUINT idx)
 	if( !entry )
 		return false;
 
-	// Remove the symbol from the lookup map
+	// Remove the symbol from the lookup index
 	asSNameSpaceNamePair key;
 	GetKey(entry, key);
 
-	asSMapNode<asSNameSpaceNamePair, asCArray<asUINT> > *cursor;
-	if( m_map.MoveTo(&cursor, key) )
+	int slot = FindSlot(key.ns, key.name, GetHash(key.ns, key.name));
+	if( slot >= 0 )
 	{
-		asCArray<asUINT> &arr = m_map.GetValue(cursor);
+		asCArray<asUINT> &arr = m_slots[slot].entries->indexes;
 		arr.RemoveValue(idx);
 		if( arr.GetLength() == 0 )
-			m_map.Erase(cursor);
+			EraseSlot(slot);
 	}
 	else
 		asASSERT(false);
@@ -380,12 +412,13 @@ bool asCSymbolTable<T>::Erase(asUINT idx)
 		int prevIdx = int(m_entries.GetLength()-1);
 		m_entries[idx] = m_entries.PopLast();
 		
-		// Update the index in the lookup map
+		// Update the index in the lookup index
 		entry = m_entries[idx];
 		GetKey(entry, key);
-		if( m_map.MoveTo(&cursor, key) )
+		slot = FindSlot(key.ns, key.name, GetHash(key.ns, key.name));
+		if( slot >= 0 )
 		{
-			asCArray<asUINT> &arr = m_map.GetValue(cursor);
+			asCArray<asUINT> &arr = m_slots[slot].entries->indexes;
 			arr[arr.IndexOf(prevIdx)] = idx;
 		}
 		else
@@ -406,14 +439,16 @@ asUINT asCSymbolTable<T>::Put(T *entry)
 	asSNameSpaceNamePair key;
 	GetKey(entry, key);
 
-	asSMapNode<asSNameSpaceNamePair, asCArray<asUINT> > *cursor;
-	if( m_map.MoveTo(&cursor, key) )
-		m_map.GetValue(cursor).PushLast(idx);
+	asUINT hash = GetHash(key.ns, key.name);
+	int slot = FindSlot(key.ns, key.name, hash);
+	if( slot >= 0 )
+		m_slots[slot].entries->indexes.PushLast(idx);
 	else
 	{
-		asCArray<asUINT> arr(1);
-		arr.PushLast(idx);
-		m_map.Insert(key, arr);
+		SKeyEntries *entries = asNEW(SKeyEntries);
+		entries->key = key;
+		entries->indexes.PushLast(idx);
+		InsertSlot(hash, entries);
 	}
 
 	m_entries.PushLast(entry);
@@ -434,6 +469,136 @@ void asCSymbolTable<T>::GetKey(const T *entry, asSNameSpaceNamePair &key) const
 
 
 
+template<class T>
+asUINT asCSymbolTable<T>::GetHash(const asSNameSpace *ns, const asCString &name)
+{
+	// Mix the namespace pointer into the hash of the name
+	asPWORD nsBits = asPWORD(ns);
+	asUINT hash = name.GetHash();
+	hash ^= asUINT(nsBits) ^ asUINT((nsBits >> 16) >> 16);
+	hash *= 0x9E3779B1u;
+	return hash ^ (hash >> 15);
+}
+
+
+
+
+// Returns the slot holding the key, or -1 if the key is not in the index
+template<class T>
+int asCSymbolTable<T>::FindSlot(const asSNameSpace *ns, const asCString &name, asUINT hash) const
+{
+	asUINT numSlots = m_slots.GetLength();
+	if( numSlots == 0 )
+		return -1;
+
+	asUINT mask = numSlots - 1;
+	for( asUINT slot = hash & mask; ; slot = (slot + 1) & mask )
+	{
+		const SSlot &s = m_slots[slot];
+		if( s.entries == 0 )
+			return -1;
+		if( s.hash == hash && s.entries->key.ns == ns && s.entries->key.name == name )
+			return int(slot);
+	}
+}
+
+
+
+
+// The key must not already be in the index
+template<class T>
+void asCSymbolTable<T>::InsertSlot(asUINT hash, SKeyEntries *entries)
+{
+	// Keep the index at most half full so the probe sequences stay short
+	if( (m_numKeys + 1) * 2 > m_slots.GetLength() )
+		GrowIndex();
+
+	asUINT mask = m_slots.GetLength() - 1;
+	asUINT slot = hash & mask;
+	while( m_slots[slot].entries )
+		slot = (slot + 1) & mask;
+
+	m_slots[slot].hash    = hash;
+	m_slots[slot].entries = entries;
+	m_numKeys++;
+}
+
+
+
+
+template<class T>
+void asCSymbolTable<T>::EraseSlot(asUINT slot)
+{
+	asDELETE(m_slots[slot].entries, SKeyEntries);
+	m_numKeys--;
+
+	// Move back the following keys that would otherwise no longer
+	// be found, since an empty slot terminates the probe sequence
+	asUINT mask = m_slots.GetLength() - 1;
+	asUINT next = slot;
+	for(;;)
+	{
+		next = (next + 1) & mask;
+		if( m_slots[next].entries == 0 )
+			break;
+
+		// Keys whose preferred slot is cyclically in (slot, next] can stay where they are
+		asUINT home = m_slots[next].hash & mask;
+		if( slot <= next ? (slot < home && home <= next) : (slot < home || home <= next) )
+			continue;
+
+		m_slots[slot] = m_slots[next];
+		slot = next;
+	}
+
+	m_slots[slot].entries = 0;
+}
+
+
+
+
+template<class T>
+void asCSymbolTable<T>::GrowIndex()
+{
+	// The old slots are copied, as the index is rehashed into a new array anyway
+	asCArray<SSlot> oldSlots(m_slots);
+
+	asUINT numSlots = oldSlots.GetLength() ? oldSlots.GetLength() * 2 : 16;
+	SSlot empty = {0, 0};
+	m_slots.Allocate(numSlots, false);
+	for( asUINT n = 0; n < numSlots; n++ )
+		m_slots.PushLast(empty);
+
+	asUINT mask = numSlots - 1;
+	for( asUINT n = 0; n < oldSlots.GetLength(); n++ )
+	{
+		if( oldSlots[n].entries == 0 )
+			continue;
+
+		asUINT slot = oldSlots[n].hash & mask;
+		while( m_slots[slot].entries )
+			slot = (slot + 1) & mask;
+		m_slots[slot] = oldSlots[n];
+	}
+}
+
+
+
+
+template<class T>
+void asCSymbolTable<T>::ClearIndex()
+{
+	for( asUINT n = 0; n < m_slots.GetLength(); n++ )
+		if( m_slots[n].entries )
+			asDELETE(m_slots[n].entries, SKeyEntries);
+
+	m_slots.Allocate(0, false);
+	m_numKeys = 0;
+}
+
+
+
+
 template<class T>
 asUINT asCSymbolTable<T>::GetSize() const
 {
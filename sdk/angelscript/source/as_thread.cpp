@@ -39,6 +39,18 @@
 #include "as_config.h"
 #include "as_thread.h"
 #include "as_atomic.h"
+#include "as_memory.h"
+
+#if defined(AS_XBOX360)
+	#include <xtl.h>
+#elif defined(AS_WIN)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#else
+	#include <time.h>
+#endif
 
 BEGIN_AS_NAMESPACE
 
@@ -315,10 +327,16 @@ asCThreadLocalData *asCThreadManager::GetLocalData()
 
 asCThreadLocalData::asCThreadLocalData()
 {
+	compileJob = 0;
 }
 
 asCThreadLocalData::~asCThreadLocalData()
 {
+	asUINT n;
+	for( n = 0; n < freeScriptNodes.GetLength(); n++ )
+		userFree(freeScriptNodes[n]);
+	for( n = 0; n < freeByteInstructions.GetLength(); n++ )
+		userFree(freeByteInstructions[n]);
 }
 
 //=========================================================================
@@ -464,5 +482,166 @@ void asCThreadReadWriteLock::ReleaseShared()
 
 //========================================================================
 
+#if defined(AS_XBOX360) || defined(AS_WIN)
+
+asQWORD asGetTimerTicks()
+{
+	LARGE_INTEGER ticks;
+	QueryPerformanceCounter(&ticks);
+	return asQWORD(ticks.QuadPart);
+}
+
+asQWORD asGetTimerFrequency()
+{
+	LARGE_INTEGER freq;
+	QueryPerformanceFrequency(&freq);
+	return asQWORD(freq.QuadPart);
+}
+
+#elif defined(CLOCK_MONOTONIC)
+
+asQWORD asGetTimerTicks()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return asQWORD(ts.tv_sec)*1000000000 + asQWORD(ts.tv_nsec);
+}
+
+asQWORD asGetTimerFrequency()
+{
+	return 1000000000;
+}
+
+#else
+
+// Fallback for platforms without a monotonic clock
+asQWORD asGetTimerTicks()
+{
+	return asQWORD(clock());
+}
+
+asQWORD asGetTimerFrequency()
+{
+	return CLOCKS_PER_SEC;
+}
+
+#endif
+
+//========================================================================
+
+#if !defined(AS_NO_THREADS) && defined(AS_POSIX_THREADS)
+
+struct sThreadStart
+{
+	asTHREADFUNC_t func;
+	void          *param;
+	pthread_t      thread;
+};
+
+static void *ThreadEntry(void *param)
+{
+	sThreadStart *start = reinterpret_cast<sThreadStart*>(param);
+	start->func(start->param);
+	return 0;
+}
+
+void *asStartThread(asTHREADFUNC_t func, void *param)
+{
+	sThreadStart *start = asNEW(sThreadStart);
+	if( start == 0 )
+		return 0;
+
+	start->func  = func;
+	start->param = param;
+	if( pthread_create(&start->thread, 0, ThreadEntry, start) != 0 )
+	{
+		asDELETE(start, sThreadStart);
+		return 0;
+	}
+
+	return start;
+}
+
+void asJoinThread(void *thread)
+{
+	sThreadStart *start = reinterpret_cast<sThreadStart*>(thread);
+	pthread_join(start->thread, 0);
+	asDELETE(start, sThreadStart);
+}
+
+void asSleepThread(asUINT milliseconds)
+{
+	timespec ts;
+	ts.tv_sec  = milliseconds / 1000;
+	ts.tv_nsec = long(milliseconds % 1000) * 1000000;
+	nanosleep(&ts, 0);
+}
+
+#elif !defined(AS_NO_THREADS) && defined(AS_WINDOWS_THREADS) && !(defined(_MSC_VER) && (WINAPI_FAMILY & WINAPI_FAMILY_PHONE_APP))
+
+struct sThreadStart
+{
+	asTHREADFUNC_t func;
+	void          *param;
+	HANDLE         thread;
+};
+
+static DWORD WINAPI ThreadEntry(LPVOID param)
+{
+	sThreadStart *start = reinterpret_cast<sThreadStart*>(param);
+	start->func(start->param);
+	return 0;
+}
+
+void *asStartThread(asTHREADFUNC_t func, void *param)
+{
+	sThreadStart *start = asNEW(sThreadStart);
+	if( start == 0 )
+		return 0;
+
+	start->func   = func;
+	start->param  = param;
+	start->thread = CreateThread(0, 0, ThreadEntry, start, 0, 0);
+	if( start->thread == 0 )
+	{
+		asDELETE(start, sThreadStart);
+		return 0;
+	}
+
+	return start;
+}
+
+void asJoinThread(void *thread)
+{
+	sThreadStart *start = reinterpret_cast<sThreadStart*>(thread);
+	WaitForSingleObject(start->thread, INFINITE);
+	CloseHandle(start->thread);
+	asDELETE(start, sThreadStart);
+}
+
+void asSleepThread(asUINT milliseconds)
+{
+	Sleep(milliseconds);
+}
+
+#else
+
+void *asStartThread(asTHREADFUNC_t, void *)
+{
+	return 0;
+}
+
+void asJoinThread(void *)
+{
+}
+
+void asSleepThread(asUINT)
+{
+}
+
+#endif
+
+//========================================================================
+
 END_AS_NAMESPACE
 
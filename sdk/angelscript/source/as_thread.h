@@ -89,6 +89,8 @@ protected:
 //======================================================================
 
 class asIScriptContext;
+class asCScriptFunction;
+struct sCompileJob;
 
 class asCThreadLocalData
 {
@@ -96,6 +98,19 @@ public:
 	asCArray<asIScriptContext *> activeContexts;
 	asCString string;
 
+	// Memory blocks cached for this thread by asCMemoryMgr, so the
+	// shared pools in the engine don't have to be locked every time
+	asCArray<void *> freeScriptNodes;
+	asCArray<void *> freeByteInstructions;
+
+	// The function that asCBuilder is compiling on this thread
+	// when compiling the functions with multiple threads
+	sCompileJob *compileJob;
+
+	// The lazily loaded functions that are being JIT compiled by this
+	// thread, which must see them as loaded before the other threads
+	asCArray<asCScriptFunction *> loadingFunctions;
+
 protected:
 	friend class asCThreadManager;
 
@@ -103,6 +118,19 @@ protected:
 	~asCThreadLocalData();
 };
 
+//======================================================================
+
+// High resolution timer used for profiling the script functions
+asQWORD asGetTimerTicks();
+asQWORD asGetTimerFrequency();
+
+// Threads started by the library itself. asStartThread returns
+// null if the library doesn't support threads on the platform
+typedef void (*asTHREADFUNC_t)(void *param);
+void *asStartThread(asTHREADFUNC_t func, void *param);
+void  asJoinThread(void *thread);
+void  asSleepThread(asUINT milliseconds);
+
 END_AS_NAMESPACE
 
 #endif
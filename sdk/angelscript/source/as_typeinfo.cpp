@@ -214,7 +214,8 @@ asUINT asCTypeInfo::GetSize() const
 // interface
 int asCTypeInfo::GetTypeId() const
 {
-	if (typeId == -1)
+	int id = asAtomicLoadAcquire(typeId);
+	if (id == -1)
 	{
 		// We need a non const pointer to create the asCDataType object.
 		// We're not breaking anything here because this function is not
@@ -222,10 +223,10 @@ int asCTypeInfo::GetTypeId() const
 		asCTypeInfo *ot = const_cast<asCTypeInfo*>(this);
 
 		// The engine will define the typeId for this object type
-		engine->GetTypeIdFromDataType(asCDataType::CreateType(ot, false));
+		id = engine->GetTypeIdFromDataType(asCDataType::CreateType(ot, false));
 	}
 
-	return typeId;
+	return id;
 }
 
 // interface
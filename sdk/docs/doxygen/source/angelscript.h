@@ -208,6 +208,28 @@ enum asEEngineProp
 	asEP_MAX_NESTED_CALLS                   = 27,
 	//! Define how generic calling convention treats handles: 0 - ignore auto handles, 1 - treat them the same way as native calling convention. Default: 1
 	asEP_GENERIC_CALL_MODE                  = 28,
+	//! Initial stack size in bytes for script contexts. Default: 4096.
+	asEP_INIT_STACK_SIZE                    = 29,
+	//! Maximum number of stack blocks the engine keeps for reuse by new contexts. Default: 16.
+	asEP_STACK_BLOCK_POOL_SIZE              = 30,
+	//! Set to true to record the number of calls and the execution time of each script function. Default: false.
+	asEP_PROFILE_FUNCTIONS                  = 31,
+	//! Set to true to allocate the compiler's temporary memory from an arena that is released at once when the build completes. Default: false.
+	asEP_USE_BUILD_ARENA                    = 32,
+	//! Number of threads used to compile the function bodies when building a module. 0 or 1 compiles them on the calling thread. Default: 0.
+	asEP_COMPILE_THREADS                    = 33,
+	//! Set to true to postpone the translation of the loaded bytecode for each function until it is first called. Default: false.
+	asEP_LAZY_LOAD_FUNCTIONS                = 34,
+	//! Set to true to let a background thread search for objects with circular references. Default: false.
+	asEP_BACKGROUND_GARBAGE_COLLECT         = 35,
+	//! Number of sweeps a new object must survive before the garbage collector moves it to the old generation. Default: 3.
+	asEP_GC_PROMOTION_AGE                   = 36,
+	//! Number of searches for circular references an old object must survive before it is moved to the tenured generation. 0 disables the tenured generation. Default: 4.
+	asEP_GC_TENURE_AGE                      = 37,
+	//! The tenured generation is included in every Nth search for circular references. Default: 8.
+	asEP_GC_TENURED_SCAN_INTERVAL           = 38,
+	//! Set to true to let the compiler order the properties of script classes by size to reduce the size of the objects. Default: false.
+	asEP_REORDER_CLASS_PROPERTIES           = 39,
 
 	asEP_LAST_PROPERTY
 };
@@ -427,7 +449,33 @@ enum asEGCFlags
 	//! Destroy known garbage
 	asGC_DESTROY_GARBAGE = 4,
 	//! Detect garbage with circular references
-	asGC_DETECT_GARBAGE  = 8
+	asGC_DETECT_GARBAGE  = 8,
+	//! Interpret the number of iterations as a time budget in microseconds
+	asGC_TIME_BUDGET     = 16
+};
+
+// Garbage collector phases
+//! \brief Garbage collector phases.
+enum asEGCPhase
+{
+	//! Destroying garbage among the new objects
+	asGC_PHASE_DESTROY_NEW      = 0,
+	//! Destroying garbage among the old objects
+	asGC_PHASE_DESTROY_OLD      = 1,
+	//! Clearing the map from the previous search for circular references
+	asGC_PHASE_CLEAR_COUNTERS   = 2,
+	//! Building the map of objects to search for circular references
+	asGC_PHASE_BUILD_MAP        = 3,
+	//! Counting the references between the objects in the map
+	asGC_PHASE_COUNT_REFERENCES = 4,
+	//! Removing the live objects from the map
+	asGC_PHASE_DETECT_GARBAGE   = 5,
+	//! Verifying that the remaining objects weren't touched by the application
+	asGC_PHASE_VERIFY_UNMARKED  = 6,
+	//! Breaking the circular references of the garbage
+	asGC_PHASE_BREAK_CIRCLES    = 7,
+
+	asGC_PHASE_LAST
 };
 
 // Token classes
@@ -945,6 +993,23 @@ extern "C"
 	//!
 	//! The object can be used for weak reference flags.
 	AS_API asILockableSharedBool *asCreateLockableSharedBool();
+	//! \brief Create the built-in JIT compiler
+	//! \return A new JIT compiler, or null if there is no built-in JIT compiler for the platform.
+	//!
+	//! The built-in JIT compiler translates the simple instructions, e.g. arithmetics,
+	//! comparisons and branches, into native code, and lets the VM execute the rest.
+	//! It is currently only available for 64bit Linux, Mac OS X and BSD, and can be
+	//! excluded from the library by defining AS_NO_JIT.
+	//!
+	//! The scripts must be compiled with \ref asEP_INCLUDE_JIT_INSTRUCTIONS for the JIT compiler to be used.
+	//!
+	//! \see \ref doc_adv_jit
+	AS_API asIJITCompiler        *asCreateJITCompiler();
+	//! \brief Destroy the built-in JIT compiler
+	//! \param[in] jit The JIT compiler returned by \ref asCreateJITCompiler.
+	//!
+	//! The JIT compiler must not be destroyed until the engines that use it have been released.
+	AS_API void                   asDestroyJITCompiler(asIJITCompiler *jit);
 }
 #endif // ANGELSCRIPT_DLL_MANUAL_IMPORT
 
@@ -1580,6 +1645,21 @@ public:
 	//!
 	//! \see \ref doc_adv_dynamic_config
 	virtual int         RemoveConfigGroup(const char *groupName) = 0;
+	//! \brief Returns a digest of the registered application interface.
+	//! \param[in] groupName The name of the configuration group, or null for the entire interface.
+	//! \return The digest, or 0 if the configuration group doesn't exist.
+	//!
+	//! The digest is calculated from the declarations of the registered types, functions, 
+	//! properties, behaviours, funcdefs, enums, and typedefs, in the order they were registered. 
+	//! It doesn't depend on the addresses of the application functions, so two processes that 
+	//! register the same interface in the same order will get the same digest. Use an empty 
+	//! string to get the digest of the entities registered outside any configuration group.
+	//!
+	//! The digest is stored with the saved bytecode, so when it matches the interface in the engine
+	//! that loads the bytecode the used functions can be resolved without searching for them.
+	//!
+	//! \see \ref doc_adv_precompile
+	virtual asQWORD     GetInterfaceFingerprint(const char *groupName = 0) const = 0;
 	//! \brief Sets the access mask that should be used for subsequent registered entities.
 	//! \param[in] defaultMask The default access bit mask.
 	//! \return The previous default mask.
@@ -1634,6 +1714,31 @@ public:
 	//! \param[in] index The index of the module.
 	//! \return A pointer to the module or null on error.
 	virtual asIScriptModule *GetModuleByIndex(asUINT index) const = 0;
+	//! \brief Load pre-compiled byte code into multiple modules.
+	//!
+	//! \param[in] modules The modules that will receive the byte code.
+	//! \param[in] streams The input streams, one for each module.
+	//! \param[in] count The number of modules.
+	//! \param[in] numThreads The number of threads to use, including the calling thread.
+	//! \param[out] results Optional array that receives the result of each module.
+	//! \return A negative value on error.
+	//! \retval asINVALID_ARG The modules or the streams weren't specified.
+	//! \retval asBUILD_IN_PROGRESS Another thread is currently building.
+	//! \retval asOUT_OF_MEMORY The engine ran out of memory.
+	//! \retval asERROR The byte code of at least one of the modules couldn't be loaded.
+	//!
+	//! This method gives the same result as calling \ref asIScriptModule::LoadByteCode "LoadByteCode" 
+	//! for each of the modules in turn, but the translation of the byte code of the functions, which 
+	//! is usually the most costly part of the load, is done by up to numThreads threads at the same time. 
+	//! The types and functions are still added to the engine one module at a time in the given order, as 
+	//! is the initialization of the global variables, so the modules may share entities with each other.
+	//!
+	//! If a module fails to load the others are not affected. The result of each module is then returned 
+	//! in the results array, with the same values as LoadByteCode would return. The library must be 
+	//! compiled with support for threads for more than one thread to be used.
+	//!
+	//! \see \ref doc_adv_precompile
+	virtual int              LoadByteCodeForModules(asIScriptModule **modules, asIBinaryStream **streams, asUINT count, asUINT numThreads = 0, int *results = 0) = 0;
 	//! \}
 
 	// Script functions
@@ -1646,6 +1751,12 @@ public:
 	//!
 	//! This does not increment the reference count of the returned function interface.
 	virtual asIScriptFunction *GetFunctionById(int funcId) const = 0;
+	//! \brief Clears the profile data of all functions.
+	//!
+	//! Sets the call count and the execution time of all functions to zero.
+	//!
+	//! \see \ref asEP_PROFILE_FUNCTIONS, \ref asIScriptFunction::GetProfileData
+	virtual void               ResetProfileData() = 0;
 	//! \}
 
 	// Type identification
@@ -1861,6 +1972,16 @@ public:
 	//! when building modules, or to detect script exceptions that may occur in 
 	//! script class destructors when called from the garbage collector.
 	virtual int                    SetContextCallbacks(asREQUESTCONTEXTFUNC_t requestCtx, asRETURNCONTEXTFUNC_t returnCtx, void *param = 0) = 0;
+	//! \brief Returns statistics on the stack memory used by the contexts.
+	//! \param[out] totalAllocated The number of stack blocks that have been allocated from the memory manager.
+	//! \param[out] totalReused The number of times a stack block has been reused from the engine's pool.
+	//! \param[out] currentlyPooled The number of stack blocks currently kept in the pool.
+	//!
+	//! When a context is destroyed its stack blocks are returned to the engine, which keeps up to 
+	//! \ref asEP_STACK_BLOCK_POOL_SIZE blocks for reuse by other contexts. If the totalAllocated
+	//! counter doesn't increase while the application executes scripts, then the execution
+	//! doesn't allocate any memory for the context stacks.
+	virtual void                   GetContextStackStatistics(asUINT *totalAllocated, asUINT *totalReused = 0, asUINT *currentlyPooled = 0) const = 0;
 	//! \}
 
 	// String interpretation
@@ -1885,7 +2006,7 @@ public:
 
 	//! \brief Perform garbage collection.
 	//! \param[in] flags Set to a combination of the \ref asEGCFlags.
-	//! \param[in] numIterations The number of iterations to perform when not doing a full cycle
+	//! \param[in] numIterations The number of iterations to perform when not doing a full cycle, or the time budget in microseconds with \ref asGC_TIME_BUDGET.
 	//! \return 1 if the cycle wasn't completed, 0 if it was.
 	//!
 	//! This method will free script objects that can no longer be reached. When the engine 
@@ -1899,6 +2020,12 @@ public:
 	//! out the garbage collection time over a large period, thus not impacting the responsiveness 
 	//! of the application.
 	//!
+	//! With \ref asGC_TIME_BUDGET the garbage collector stops between two steps as soon as the 
+	//! given number of microseconds has been spent, instead of after a fixed number of iterations. 
+	//! It returns 0 if it ran out of work before the budget was spent. A single step is never 
+	//! interrupted, so the budget may be exceeded by the time of one step. While collecting with
+	//! a time budget the time spent in each phase is measured, see \ref GetGCPhaseStatistics.
+	//!
 	//! \see \ref doc_gc
 	virtual int  GarbageCollect(asDWORD flags = asGC_FULL_CYCLE, asUINT numIterations = 1) = 0;
 	//! \brief Obtain statistics from the garbage collector.
@@ -1914,6 +2041,33 @@ public:
 	//!
 	//! \see \ref doc_gc
 	virtual void GetGCStatistics(asUINT *currentSize, asUINT *totalDestroyed = 0, asUINT *totalDetected = 0, asUINT *newObjects = 0, asUINT *totalNewDestroyed = 0) const = 0;
+	//! \brief Obtain statistics for one of the generations of the garbage collector.
+	//! \param[in] generation 0 for the new objects, 1 for the old objects, and 2 for the tenured objects.
+	//! \param[out] currentSize The current number of objects in the generation.
+	//! \param[out] totalDestroyed The total number of objects destroyed while in the generation.
+	//! \param[out] totalPromoted The total number of objects moved from the generation to the next.
+	//! \param[out] totalScans The number of times the generation has been swept (new objects) or searched for circular references (old and tenured objects).
+	//! \return A negative value on error.
+	//! \retval asINVALID_ARG The generation is not valid.
+	//!
+	//! The values can be used to tune \ref asEP_GC_PROMOTION_AGE, \ref asEP_GC_TENURE_AGE, and \ref asEP_GC_TENURED_SCAN_INTERVAL
+	//! for the application.
+	//!
+	//! \see \ref doc_gc
+	virtual int  GetGCGenerationStatistics(asUINT generation, asUINT *currentSize, asUINT *totalDestroyed = 0, asUINT *totalPromoted = 0, asUINT *totalScans = 0) const = 0;
+	//! \brief Obtain the time spent in one of the phases of the garbage collector.
+	//! \param[in] phase The phase of the garbage collector.
+	//! \param[out] totalTime The total time in seconds spent in the phase.
+	//! \param[out] maxStepTime The longest time in seconds spent in a single step of the phase.
+	//! \param[out] totalSteps The number of steps executed in the phase.
+	//! \return A negative value on error.
+	//! \retval asINVALID_ARG The phase is not valid.
+	//!
+	//! The time is only measured while the garbage collector is invoked with \ref asGC_TIME_BUDGET. 
+	//! The longest time of a single step tells how much the time budget may be exceeded.
+	//!
+	//! \see \ref doc_gc
+	virtual int  GetGCPhaseStatistics(asEGCPhase phase, double *totalTime, double *maxStepTime = 0, asQWORD *totalSteps = 0) const = 0;
 	//! \brief Notify the garbage collector of a new object that needs to be managed.
 	//! \param[in] obj A pointer to the newly created object.
 	//! \param[in] type The type of the object.
@@ -2206,6 +2360,31 @@ public:
 	//!
 	//! \see \ref doc_compile_script
 	virtual int         Build() = 0;
+	//! \brief Build the previously added script sections, compiling only the functions that have been modified.
+	//! \return A negative value on error
+	//! \retval asINVALID_CONFIGURATION The engine configuration is invalid.
+	//! \retval asERROR The script failed to build.
+	//! \retval asBUILD_IN_PROGRESS Another thread is currently building. 
+	//! \retval asINIT_GLOBAL_VARS_FAILED It was not possible to initialize at least one of the global variables.
+	//! \retval asNOT_SUPPORTED Compiler support is disabled in the engine.
+	//! \retval asMODULE_IS_IN_USE The code in the module is still being used and and cannot be removed. 
+	//!
+	//! This method is meant for reloading scripts while the application is running. The application adds all
+	//! the script sections again, just as for \ref Build, and the module compares them with the sections from the 
+	//! previous call to BuildIncremental. If only the bodies of some functions or class methods have been modified, 
+	//! then only these functions are compiled again. The other functions keep their bytecode, the functions that
+	//! have just moved get their line numbers updated, and the global variables keep their values.
+	//!
+	//! Whenever the modifications cannot be compiled this way, the method does a full build just like \ref Build. 
+	//! This happens on the first call, when the declarations of the functions, classes, or global variables have
+	//! changed, when a class or variable has been moved to another line, when a modified function is a constructor, 
+	//! shared, or declares lambda functions, and when the module has been modified with \ref CompileFunction,
+	//! \ref CompileGlobalVar, \ref RemoveFunction, or \ref RemoveGlobalVar since the previous call. 
+	//!
+	//! If the engine configuration has changed since the previous build the application should call \ref Build instead.
+	//!
+	//! \see \ref doc_compile_script
+	virtual int         BuildIncremental() = 0;
 	//! \brief Compile a single function.
 	//! \param[in] sectionName The name of the script section
 	//! \param[in] code The script code buffer
@@ -2573,6 +2752,25 @@ public:
 	//!
 	//! \see \ref doc_adv_precompile
 	virtual int LoadByteCode(asIBinaryStream *in, bool *wasDebugInfoStripped = 0) = 0;
+	//! \brief Load pre-compiled byte code from a memory buffer.
+	//!
+	//! \param[in] data A pointer to the saved byte code.
+	//! \param[in] size The size of the buffer in bytes.
+	//! \param[out] wasDebugInfoStripped Set to true if the byte code was saved without debug information.
+	//! \return A negative value on error.
+	//! \retval asINVALID_ARG The buffer wasn't specified.
+	//! \retval asBUILD_IN_PROGRESS Another thread is currently building.
+	//! \retval asOUT_OF_MEMORY The engine ran out of memory while loading the byte code.
+	//! \retval asMODULE_IS_IN_USE The code in the module is still being used and and cannot be removed. 
+	//! \retval asERROR It was not possible to load the byte code.
+	//!
+	//! This method works like \ref asIScriptModule::LoadByteCode "LoadByteCode", except that the byte code 
+	//! is read directly from the buffer. This is faster than going through an \ref asIBinaryStream, and the
+	//! application can map the file with the saved byte code into memory and pass the mapped address without
+	//! first copying the content. The buffer is only accessed during the call and can be released afterwards.
+	//!
+	//! \see \ref doc_adv_precompile
+	virtual int LoadByteCodeFromMemory(const void *data, size_t size, bool *wasDebugInfoStripped = 0) = 0;
 	//! \}
 
 	// User data
@@ -3865,6 +4063,13 @@ public:
 	//! \param[in] line A line number
 	//! \return The number of the next line with code, or a negative value if the line is outside the function.
 	virtual int              FindNextLineWithCode(int line) const = 0;
+	//! \brief Returns the profile data of the function
+	//! \param[out] callCount The number of times the function has been called.
+	//! \param[out] totalTime The accumulated time in seconds spent in the function, including the functions it called.
+	//!
+	//! The profile data is only recorded while the engine property \ref asEP_PROFILE_FUNCTIONS is turned on.
+	//! Calls that are exited by a script exception are counted, but their time is not included.
+	virtual void             GetProfileData(asQWORD *callCount, double *totalTime = 0) const = 0;
 	//! \}
 
 	//! \name JIT compilation
@@ -4614,8 +4819,24 @@ enum asEBCInstr
 	asBC_POWu64			= 199,
 	//! \brief Call registered function with single 32bit integer argument. Suspend further execution if requested.
 	asBC_Thiscall1		= 200,
-
-	asBC_MAXBYTECODE	= 201,
+	//! \brief Compare int variable with constant and jump to a relative position if equal
+	asBC_CMPIiJZ		= 201,
+	//! \brief Compare int variable with constant and jump to a relative position if not equal
+	asBC_CMPIiJNZ		= 202,
+	//! \brief Compare int variable with constant and jump to a relative position if less
+	asBC_CMPIiJS		= 203,
+	//! \brief Compare int variable with constant and jump to a relative position if greater or equal
+	asBC_CMPIiJNS		= 204,
+	//! \brief Compare int variable with constant and jump to a relative position if greater
+	asBC_CMPIiJP		= 205,
+	//! \brief Compare int variable with constant and jump to a relative position if less or equal
+	asBC_CMPIiJNP		= 206,
+	//! \brief Copy a 32bit value from a property of the object pointed to by the variable 0 to a variable
+	asBC_CpyThisToV4	= 207,
+	//! \brief Copy a 32bit value from a variable to a property of the object pointed to by the variable 0
+	asBC_CpyVtoThis4	= 208,
+
+	asBC_MAXBYTECODE	= 209,
 
 	// Temporary tokens. Can't be output to the final program
 	asBC_VarDecl		= 251,
@@ -4946,15 +5167,15 @@ const asSBCInfo asBCInfo[256] =
 	asBCINFO(POWi64,	wW_rW_rW_ARG,	0),
 	asBCINFO(POWu64,	wW_rW_rW_ARG,	0),
 	asBCINFO(Thiscall1, DW_ARG,			-AS_PTR_SIZE-1),
+	asBCINFO(CMPIiJZ,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJNZ,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJS,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJNS,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJP,	rW_DW_DW_ARG,	0),
+	asBCINFO(CMPIiJNP,	rW_DW_DW_ARG,	0),
+	asBCINFO(CpyThisToV4, rW_W_DW_ARG,	0),
+	asBCINFO(CpyVtoThis4, rW_W_DW_ARG,	0),
 
-	asBCINFO_DUMMY(201),
-	asBCINFO_DUMMY(202),
-	asBCINFO_DUMMY(203),
-	asBCINFO_DUMMY(204),
-	asBCINFO_DUMMY(205),
-	asBCINFO_DUMMY(206),
-	asBCINFO_DUMMY(207),
-	asBCINFO_DUMMY(208),
 	asBCINFO_DUMMY(209),
 	asBCINFO_DUMMY(210),
 	asBCINFO_DUMMY(211),
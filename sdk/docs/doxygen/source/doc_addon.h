@@ -12,6 +12,7 @@ This page gives a brief description of the add-ons that you'll find in the /sdk/
  - \subpage doc_addon_build
  - \subpage doc_addon_ctxmgr
  - \subpage doc_addon_debugger
+ - \subpage doc_addon_profiler
  - \subpage doc_addon_serializer
  - \subpage doc_addon_helpers
  - \subpage doc_addon_autowrap
@@ -341,6 +342,119 @@ int ExecuteWithDebug(asIScriptContext *ctx)
 
 
 
+\page doc_addon_profiler Profiler
+
+<b>Path:</b> /sdk/add_on/profiler/
+
+The <code>CProfiler</code> is a sampling profiler that can be left on while the application is running 
+normally. A background thread periodically requests a sample from each of the registered contexts by 
+setting a flag. The context's own thread then records its call stack at the next line cue. Between the 
+samples the line callback only checks the flag, so the scripts execute with very little overhead.
+
+The samples are aggregated into inclusive and exclusive counts per function and per line. The samples
+can also be exported in the collapsed stack format that is used by flame graph tools, e.g. flamegraph.pl.
+
+The profiler sets the line callback of the contexts when they are added, so the contexts must be added 
+and removed by the thread that executes them. If the application has a line callback of its own it can 
+be given to AddContext, and the profiler will call it on each line cue and restore it when the context 
+is removed. The profiler cannot be used together with the \ref doc_addon_debugger "debugger" on the 
+same context. The scripts must be compiled with line cues, 
+i.e. \ref asEP_BUILD_WITHOUT_LINE_CUES must not be turned on. Time spent in application functions is 
+attributed to the script line that called the function.
+
+\section doc_addon_profiler_1 Public C++ interface
+
+\code
+class CProfiler
+{
+public:
+  CProfiler();
+  virtual ~CProfiler();
+
+  // The signature of the application's own line callback, if it has one
+  typedef void (*LINECALLBACK_t)(asIScriptContext *ctx, void *param);
+
+  // Add a context that should be sampled. The profiler holds a reference to
+  // the context until it is removed. This must be called by the thread that
+  // executes the context, while the context is not executing, as it sets the
+  // line callback. If the application uses a line callback of its own, it
+  // must be given here so the profiler can call it on each line cue.
+  int  AddContext(asIScriptContext *ctx, LINECALLBACK_t prevCallback = 0, void *prevParam = 0);
+
+  // Remove a context from the profiler. The application's own line callback
+  // is restored. The same restrictions as for AddContext apply.
+  void RemoveContext(asIScriptContext *ctx);
+
+  // Start and stop the background thread that periodically requests samples.
+  // The interval is given in microseconds.
+  int  Start(asUINT intervalMicroSeconds = 1000);
+  void Stop();
+  bool IsRunning() const;
+
+  // Request a sample of each registered context that is currently executing. The
+  // sample is taken by the context at the next line cue. This is called by the
+  // background thread, but the application can call it too, e.g. once per frame.
+  // It is safe to call from any thread.
+  void RequestSample();
+
+  // Discard all samples taken so far
+  void Reset();
+
+  // The aggregated results. Inclusive counts are the number of samples where the
+  // function or line was anywhere in the call stack, exclusive counts are the
+  // number of samples where it was at the top of the call stack. The results
+  // are sorted by the exclusive count, then the inclusive count.
+  struct SFunctionStats
+  {
+    std::string function;
+    asUINT      inclusive;
+    asUINT      exclusive;
+  };
+  struct SLineStats
+  {
+    std::string function;
+    std::string section;
+    int         line;
+    asUINT      inclusive;
+    asUINT      exclusive;
+  };
+  asUINT GetSampleCount() const;
+  void   GetFunctionStats(std::vector<SFunctionStats> &stats) const;
+  void   GetLineStats(std::vector<SLineStats> &stats) const;
+
+  // Export the samples in the collapsed stack format, i.e. one line per unique
+  // call stack with the frames separated by ';' from the outermost to the
+  // innermost, followed by the number of samples.
+  std::string GetCollapsedStacks() const;
+  int         SaveCollapsedStacks(const char *filename) const;
+};
+\endcode
+
+\section doc_addon_profiler_2 Example usage
+
+\code
+CProfiler profiler;
+void RunGame(asIScriptContext *ctx)
+{
+  // Take a sample every millisecond
+  profiler.AddContext(ctx);
+  profiler.Start(1000);
+
+  // Run the scripts as usual
+  ...
+
+  // Write the result so it can be viewed with flamegraph.pl
+  profiler.Stop();
+  profiler.SaveCollapsedStacks("profile.folded");
+  profiler.RemoveContext(ctx);
+}
+\endcode
+
+
+
+
+
+
 \page doc_addon_ctxmgr Context manager
 
 <b>Path:</b> /sdk/add_on/contextmgr/
@@ -1680,6 +1794,13 @@ public:
   // Add a pre-processor define for conditional compilation
   void DefineWord(const char *word);
 
+  // Set the directory where the compiled bytecode is cached between builds.
+  // An empty string or null turns off the cache, which is the default.
+  void SetBytecodeCacheDirectory(const char *directory);
+
+  // Returns true if the last call to BuildModule loaded the bytecode from the cache
+  bool WasLoadedFromCache() const;
+
   // Enumerate included script sections
   unsigned int GetSectionCount() const;
   string       GetSectionName(unsigned int idx) const;
@@ -1832,6 +1953,33 @@ if( r >= 0 )
 
 
 
+\section doc_addon_build_cache Bytecode cache
+
+If the same scripts are built every time the application starts, the compilation can be skipped by 
+telling the builder where it can store the compiled bytecode with SetBytecodeCacheDirectory(). The
+builder will then save the bytecode of each module it builds to a file named after the module in 
+that directory, and the next time the module is built the bytecode is loaded from the file instead.
+
+The stored bytecode is only used if it was compiled from exactly the same pre-processed script sections, 
+with the same library version, engine properties, and registered application interface. If anything
+of that has changed the script is compiled again and the file is updated. WasLoadedFromCache() tells
+if the last build used the stored bytecode.
+
+\code
+CScriptBuilder builder;
+builder.SetBytecodeCacheDirectory("cache");
+int r = builder.StartNewModule(engine, "my module");
+if( r >= 0 )
+  r = builder.AddSectionFromFile("script.as");
+if( r >= 0 )
+  r = builder.BuildModule();
+\endcode
+
+\see \ref doc_adv_precompile
+
+
+
+
 \page doc_addon_autowrap Automatic wrapper functions
 
 <b>Path:</b> /sdk/add_on/autowrapper/aswrappedcall.h
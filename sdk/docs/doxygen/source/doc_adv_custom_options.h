@@ -129,6 +129,14 @@ When this option is set to true the compiler will accept identifiers that contai
 value higher than 127. This permits the use of international characters in the identifiers as the script 
 can be encoded in UTF-8 format and compiler normally.
 
+\ref asEP_REORDER_CLASS_PROPERTIES
+
+When this option is set to true the compiler will not place the properties of script classes in the order they are 
+declared. The handles are placed first, then the primitives and the POD value types from the largest to the smallest, 
+and last the pointers to the value types that are allocated separately. This avoids padding between the properties so 
+the objects become smaller, and keeps the properties that are accessed often closer together. The properties are still 
+enumerated in the declaration order, and the offsets are the same when the bytecode is saved and loaded again. Inherited
+properties always keep the offsets they have in the base class.
 
 
 
@@ -161,6 +169,72 @@ limit to 1MB doesn't mean the stack will grow exactly to 1MB, but you can be cer
 
 Whenever a context attempts to grow the stack more than it is allowed, it will abort the execution and return a 'stack overflow' script 
 exception.
+
+\ref asEP_INIT_STACK_SIZE
+
+The size in bytes of the first stack block that is allocated for a context. When the stack needs to grow, the context allocates new 
+blocks that are twice as large as the previous one. If the typical scripts need more stack space than the default 4KB, then this
+option can be used to make sure a single block is enough.
+
+\ref asEP_STACK_BLOCK_POOL_SIZE
+
+The stack blocks of destroyed contexts are kept by the engine so they can be reused by new contexts without allocating memory. This 
+is useful when the application creates short lived contexts, e.g. for event callbacks. This option sets the maximum number of blocks 
+that are kept. Set it to 0 to free the stack blocks as soon as the contexts are destroyed. The effect can be verified with
+\ref asIScriptEngine::GetContextStackStatistics "GetContextStackStatistics".
+
+\ref asEP_PROFILE_FUNCTIONS
+
+When turned on the contexts will count the calls to each script function and measure the time spent in them. This allows the 
+application to find the script functions that are worth optimizing without attaching a debugger. The data is retrieved with 
+\ref asIScriptFunction::GetProfileData "GetProfileData" and cleared with \ref asIScriptEngine::ResetProfileData "ResetProfileData". 
+The measured time includes the time spent in called functions, and time while the context is suspended. When the option is turned 
+off the overhead is limited to a single check per function call and return.
+
+\ref asEP_USE_BUILD_ARENA
+
+When turned on the script nodes and byte instructions created while building a module are allocated from large memory chunks 
+that are all released together when the build completes, instead of allocating and freeing each of them individually. This 
+reduces the time spent in the memory allocator when building large scripts, at the cost of a higher peak memory usage during 
+the build. The option has no effect on the compiled bytecode.
+
+\ref asEP_COMPILE_THREADS
+
+When set to 2 or more, the bodies of the script functions are compiled by this number of threads, with the thread that builds the
+module being one of them. Functions that need to add something to the engine, e.g. a new template instance or a lambda function,
+are compiled afterwards on the building thread in the order they were declared, so the function ids and the compiler messages
+are the same as when compiling with a single thread. The string factory is only called by one thread at a time. The library must
+be compiled with support for threads for the option to have any effect.
+
+\ref asEP_LAZY_LOAD_FUNCTIONS
+
+When turned on the bytecode of the functions loaded with \ref asIScriptModule::LoadByteCode "LoadByteCode" is not 
+translated until the function is called for the first time. The load will be quicker and use less memory when
+only a part of the functions are used, at the cost of a small delay on the first call of each function. Shared 
+functions and the initialization of the global variables are always loaded immediately. If the JIT compiler is
+used the functions are compiled when they are translated.
+
+\ref asEP_BACKGROUND_GARBAGE_COLLECT
+
+When turned on the engine starts a thread that searches for objects kept alive only by circular references, so 
+that the threads calling \ref asIScriptEngine::GarbageCollect "GarbageCollect", or running scripts with 
+\ref asEP_AUTO_GARBAGE_COLLECT, no longer spend time on this. The circular references that are found are still 
+broken, and the objects destroyed, by these threads the next time they call the garbage collector, so the objects 
+are never destroyed by the background thread. The \ref doc_gc_object "behaviours for the garbage collector" of the 
+registered types must be thread safe. Setting the property returns asNOT_SUPPORTED if the library doesn't support 
+threads on the platform.
+
+The background thread only inspects the objects while all the threads that execute scripts are paused at a safe point, 
+i.e. at the start of a new line or a call to a script function, so the option must be turned on before any script is 
+executed. A search that has to wait too long for the scripts to pause, e.g. because a script is calling an application 
+function that blocks, is postponed until later. The application must not modify the objects held by the garbage 
+collector in other threads while no script is executing in them.
+
+\ref asEP_GC_PROMOTION_AGE, \ref asEP_GC_TENURE_AGE, \ref asEP_GC_TENURED_SCAN_INTERVAL
+
+These options control how quickly objects are moved between the \ref doc_gc_generations "generations of the garbage collector", 
+and how often the tenured objects are searched for circular references. Setting the tenure age to 0 disables the tenured generation
+so that all old objects are searched every time.
  
 \ref asEP_BUILD_WITHOUT_LINE_CUES
  
@@ -2,8 +2,10 @@
 
 \page doc_adv_jit How to build a JIT compiler
 
-AngelScript doesn't provide a built-in JIT compiler, instead it permits an external JIT compiler to be implemented 
-through a public interface.
+AngelScript permits an external JIT compiler to be implemented through a public interface. On 64bit Linux, Mac OS X and 
+BSD the library also provides a simple built-in JIT compiler, created with \ref asCreateJITCompiler, that translates 
+the arithmetic, comparison and branch instructions into native code and leaves the rest to the VM. It can be used as is, 
+or as a reference for implementing a more complete JIT compiler.
 
 To use JIT compilation, the scripts must be compiled with a few extra instructions that provide hints to the JIT compiler
 and also entry points so that the VM will know when to pass control to the JIT compiled function. By default this is 
@@ -216,7 +218,12 @@ Load the address to a property of a value object into the value register. Substi
 
  - \ref asBC_LoadVObjR
 
- 
+Copy a 32bit value between a variable and a property of the object pointed to by variable 0. Substitutes the sequence LoadThisR, RDR4 and LoadThisR, WRTV4.
+
+ - \ref asBC_CpyThisToV4
+ - \ref asBC_CpyVtoThis4
+
+
 
 
 
@@ -432,6 +439,15 @@ Make a jump to a relative position depending on the value in the value register
  - \ref asBC_JLowZ
  - \ref asBC_JLowNZ
 
+Compare an int variable with a constant and make a jump to a relative position depending on the result
+
+ - \ref asBC_CMPIiJZ
+ - \ref asBC_CMPIiJNZ
+ - \ref asBC_CMPIiJS
+ - \ref asBC_CMPIiJNS
+ - \ref asBC_CMPIiJP
+ - \ref asBC_CMPIiJNP
+
 Call an application registered function
 
  - \ref asBC_CALLSYS
@@ -42,12 +42,49 @@ protected:
 \endcode
 
 
+If the saved bytecode is already in memory, or if the file can be mapped into memory, e.g. with mmap, then the
+\ref asIScriptModule::LoadByteCodeFromMemory "LoadByteCodeFromMemory" method can be used instead. This reads 
+the bytecode directly from the buffer, which avoids both the intermediate copy and the call to the stream for 
+each value.
+
+\code
+// Map the file with the saved bytecode and load it directly from the mapped pages
+int fd = open("script.asbc", O_RDONLY);
+struct stat st;
+fstat(fd, &st);
+void *data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+int r = mod->LoadByteCodeFromMemory(data, st.st_size);
+munmap(data, st.st_size);
+close(fd);
+\endcode
+
+When the scripts have many functions of which only a few are called in each session, the engine property 
+\ref asEP_LAZY_LOAD_FUNCTIONS can be turned on before loading the bytecode. The bytecode of each function is then
+kept as it was stored and is only translated when the function is called for the first time, or when it is
+retrieved with \ref asIScriptModule::GetFunctionByDecl "GetFunctionByDecl". The functions that are never called
+never take up the memory of the translated bytecode.
+
+When the bytecode of several modules is loaded at startup, the application can load them all with a single call 
+to \ref asIScriptEngine::LoadByteCodeForModules "LoadByteCodeForModules". The modules are still read one after 
+the other, but the bytecode of their functions is translated by multiple threads. 
+
+\code
+asIScriptModule *mods[2] = {engine->GetModule("a", asGM_ALWAYS_CREATE), engine->GetModule("b", asGM_ALWAYS_CREATE)};
+asIBinaryStream *streams[2] = {&streamA, &streamB};
+int results[2];
+int r = engine->LoadByteCodeForModules(mods, streams, 2, 4, results);
+\endcode
+
 \see \ref doc_samples_asbuild
 
 \section doc_adv_precompile_1 Things to remember
 
  - All the objects, methods, properties, etc, used when compiling the bytecode must also be registered
    when loading the precompiled bytecode, otherwise the load will fail when not finding the correct entity.
+   The saved bytecode holds the \ref asIScriptEngine::GetInterfaceFingerprint "fingerprint" of the registered
+   interface, and if the load fails the engine will tell which configuration groups have changed since the bytecode
+   was saved. When the fingerprint matches, the registered functions are found directly by their id, so registering
+   the interface in the same order in the offline compiler and in the application makes the loading faster.
 
  - The script engine doesn't perform validation of the pre-compiled bytecode, so the application is
    responsible for authenticating the source. If this authentication isn't performed by the application
@@ -30,6 +30,8 @@
  - \ref asGetLibraryVersion
  - \ref asGetLibraryOptions
  - \ref asCreateLockableSharedBool
+ - \ref asCreateJITCompiler
+ - \ref asDestroyJITCompiler
  - \ref asGetTypeTraits
 
 
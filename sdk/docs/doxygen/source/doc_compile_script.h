@@ -96,6 +96,11 @@ this support and more. It is a helper class for loading files, perform a pre-pro
 and then building the module. You can a see an example of how to use the script builder
 in \ref doc_hello_world.
 
+If the application reloads the scripts while running, e.g. to let the script writer see the effect of
+the changes immediately, it can use \ref asIScriptModule::BuildIncremental "BuildIncremental" instead 
+of Build. The script sections are added again in the same way, but only the functions whose bodies have
+been modified since the previous call are compiled again, and the global variables keep their values.
+
 
 \see \ref doc_adv_precompile
 
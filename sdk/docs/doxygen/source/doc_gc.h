@@ -21,6 +21,11 @@ requiring the entire application to halt. For this reason, it is recommended tha
 asIScriptEngine::GarbageCollect "GarbageCollect"(\ref asGC_ONE_STEP) is made at least once during the normal event processing.
 The number of calls that should be made depends on how much garbage is created.
 
+As the time each step takes depends on the phase of the garbage collector and on the objects, it may be easier to
+give the garbage collector a time budget instead, e.g. \ref asIScriptEngine::GarbageCollect "GarbageCollect"(\ref asGC_ONE_STEP | 
+\ref asGC_TIME_BUDGET, 500) to let it work for half a millisecond each frame. The time spent in each phase is then measured 
+and can be obtained with \ref asIScriptEngine::GetGCPhaseStatistics "GetGCPhaseStatistics".
+
 If the scripts produce a lot of garbage but only a low number of garbage with circular references, the application can make a 
 call to \ref asIScriptEngine::GarbageCollect "GarbageCollect"(\ref asGC_FULL_CYCLE | \ref asGC_DESTROY_GARBAGE), which will 
 only destroy the known garbage without trying to detect circular references. This call is relatively fast as the garbage 
@@ -35,12 +40,30 @@ needed, it can easily be turned off with a call to \ref asIScriptEngine::SetEngi
 
 \see \ref doc_memory
 
+\section doc_gc_generations Generations
+
+The garbage collector divides the objects into three generations. New objects are only checked for having no 
+references outside the garbage collector, which is quick. After surviving \ref asEP_GC_PROMOTION_AGE sweeps they 
+are moved to the old generation, which is also searched for circular references. Old objects that survive 
+\ref asEP_GC_TENURE_AGE searches are in turn moved to the tenured generation, which is only included in every 
+Nth search as given by \ref asEP_GC_TENURED_SCAN_INTERVAL, so that long lived objects are not searched over and 
+over again. The tenured generation is also included when no new objects have been added since the previous search, 
+i.e. when the application isn't allocating any objects, or when it has grown by more than half since it was last 
+searched. A full cycle always includes all generations.
+
+The statistics for each generation can be obtained with \ref asIScriptEngine::GetGCGenerationStatistics "GetGCGenerationStatistics"
+to help tune these properties for the application.
+
 \section doc_gc_threads Garbage collection and multi-threading
 
 The garbage collector itself is thread safe, but in order to be able to safely use the garbage collector in a multi-threaded
 environment the application must make sure all the objects that may be in the garbage collector has thread safe implementations
 of \ref doc_gc_object "the GC behaviours". 
 
+With \ref asEP_BACKGROUND_GARBAGE_COLLECT the engine can also do the search for circular references in a thread of 
+its own, which avoids the longer pauses the search may cause for the threads that call the garbage collector. The
+application will then only spend time on destroying the garbage.
+
 \see \ref doc_reg_gcref_4
 
 
@@ -12,6 +12,7 @@ namespace TestManyFuncs { void Test(); }
 namespace TestComplex { void Test(); }
 namespace TestRebuild { void Test(); }
 namespace TestHugeAPI { void Test(); }
+namespace TestMultiThread { void Test(); }
 
 void DetectMemoryLeaks()
 {
@@ -40,6 +41,7 @@ int main(int argc, char **argv)
 	TestComplex::Test();
 	TestRebuild::Test();
 	TestHugeAPI::Test();
+	TestMultiThread::Test();
 	
 	printf("--------------------------------------------\n");
 	printf("Press any key to quit.\n");
@@ -99,6 +99,30 @@ void Test()
 	time = GetSystemTimer() - time;
 	printf("Time = %f secs\n", time);
 
+	////////////////////////////////////////////
+	printf("\nLoading from memory...\n");
+
+	time = GetSystemTimer();
+
+	mod2 = engine->GetModule(0, asGM_ALWAYS_CREATE);
+	mod2->LoadByteCodeFromMemory(&stream.buffer[0], stream.buffer.size());
+
+	time = GetSystemTimer() - time;
+	printf("Time = %f secs\n", time);
+
+	////////////////////////////////////////////
+	printf("\nLoading lazily...\n");
+
+	engine->SetEngineProperty(asEP_LAZY_LOAD_FUNCTIONS, true);
+
+	time = GetSystemTimer();
+
+	mod2 = engine->GetModule(0, asGM_ALWAYS_CREATE);
+	mod2->LoadByteCodeFromMemory(&stream.buffer[0], stream.buffer.size());
+
+	time = GetSystemTimer() - time;
+	printf("Time = %f secs\n", time);
+
 	engine->Release();
 }
 
@@ -0,0 +1,227 @@
+//
+// Test author: Andreas Jonsson
+//
+
+#include "utils.h"
+#include "memory_stream.h"
+#include <string>
+#include <vector>
+#include <thread>
+using std::string;
+using std::vector;
+using std::thread;
+
+namespace TestMultiThread
+{
+
+#define TESTNAME "TestMultiThread"
+
+// Each module gets a mix of expressions, control flow and function calls
+static const char *scriptFunc =
+"int Func%d(int a, float b)                                  \n"
+"{                                                           \n"
+"   int[] arr(4);                                            \n"
+"   string s = 'value ' + a;                                 \n"
+"   for( int n = 0; n < 4; n++ )                             \n"
+"   {                                                        \n"
+"      arr[n] = a * n + int(b);                              \n"
+"      if( arr[n] > 10 ) s += 'x'; else s += 'y';            \n"
+"   }                                                        \n"
+"   return arr[0] + arr[3] + s.length();                     \n"
+"}                                                           \n";
+
+static const int numThreads = 4;
+
+#ifdef _DEBUG
+static const int numModulesPerThread = 2;
+static const int numFuncs            = 10;
+#else
+static const int numModulesPerThread = 8;
+static const int numFuncs            = 1000;
+#endif
+
+static string script;
+
+static asIScriptEngine *CreateEngine()
+{
+	asIScriptEngine *engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
+
+	static COutStream out;
+	engine->SetMessageCallback(asMETHOD(COutStream,Callback), &out, asCALL_THISCALL);
+
+	RegisterScriptArray(engine, true);
+	RegisterStdString(engine);
+
+	return engine;
+}
+
+static void BuildModules(asIScriptEngine *engine, int threadIdx)
+{
+	for( int n = 0; n < numModulesPerThread; n++ )
+	{
+		char name[50];
+		sprintf(name, "mod_%d_%d", threadIdx, n);
+
+		asIScriptModule *mod = engine->GetModule(name, asGM_ALWAYS_CREATE);
+		mod->AddScriptSection(TESTNAME, script.c_str(), script.size(), 0);
+
+		// The engine only compiles one module at a time, so the
+		// other threads have to wait for their turn to build
+		int r;
+		while( (r = mod->Build()) == asBUILD_IN_PROGRESS )
+			std::this_thread::yield();
+		if( r < 0 )
+			printf("Build failed\n");
+	}
+
+	asThreadCleanup();
+}
+
+static void BuildWithOwnEngine(int threadIdx)
+{
+	asIScriptEngine *engine = CreateEngine();
+	BuildModules(engine, threadIdx);
+	engine->ShutDownAndRelease();
+}
+
+void Test()
+{
+	printf("---------------------------------------------\n");
+	printf("%s\n\n", TESTNAME);
+
+	asPrepareMultithread();
+
+	////////////////////////////////////////////
+	printf("\nGenerating...\n");
+
+	script = "";
+	for( int n = 0; n < numFuncs; n++ )
+	{
+		char buf[1000];
+		sprintf(buf, scriptFunc, n);
+		script += buf;
+	}
+
+	////////////////////////////////////////////
+	printf("\nBuilding in a single thread...\n");
+
+	asIScriptEngine *engine = CreateEngine();
+
+	double time = GetSystemTimer();
+
+	for( int t = 0; t < numThreads; t++ )
+		BuildModules(engine, t);
+
+	time = GetSystemTimer() - time;
+	printf("Time = %f secs\n", time);
+
+	engine->ShutDownAndRelease();
+
+	////////////////////////////////////////////
+	printf("\nBuilding with %d threads sharing one engine...\n", numThreads);
+
+	engine = CreateEngine();
+
+	time = GetSystemTimer();
+
+	vector<thread> threads;
+	for( int t = 0; t < numThreads; t++ )
+		threads.push_back(thread(BuildModules, engine, t));
+	for( int t = 0; t < numThreads; t++ )
+		threads[t].join();
+
+	time = GetSystemTimer() - time;
+	printf("Time = %f secs\n", time);
+
+	engine->ShutDownAndRelease();
+
+	////////////////////////////////////////////
+	printf("\nBuilding with %d threads with one engine each...\n", numThreads);
+
+	time = GetSystemTimer();
+
+	threads.clear();
+	for( int t = 0; t < numThreads; t++ )
+		threads.push_back(thread(BuildWithOwnEngine, t));
+	for( int t = 0; t < numThreads; t++ )
+		threads[t].join();
+
+	time = GetSystemTimer() - time;
+	printf("Time = %f secs\n", time);
+
+	////////////////////////////////////////////
+	printf("\nSaving...\n");
+
+	const int numModules = numThreads * numModulesPerThread;
+
+	engine = CreateEngine();
+	BuildModules(engine, 0);
+
+	vector<CBytecodeStream*> streams;
+	for( int n = 0; n < numModules; n++ )
+	{
+		// All modules hold the same code, so the bytecode of the first one is reused
+		CBytecodeStream *stream = new CBytecodeStream("");
+		engine->GetModuleByIndex(0)->SaveByteCode(stream);
+		streams.push_back(stream);
+	}
+
+	engine->ShutDownAndRelease();
+
+	////////////////////////////////////////////
+	printf("\nLoading one module at a time...\n");
+
+	engine = CreateEngine();
+
+	time = GetSystemTimer();
+
+	for( int n = 0; n < numModules; n++ )
+	{
+		char name[50];
+		sprintf(name, "mod_%d", n);
+		streams[n]->Restart();
+		if( engine->GetModule(name, asGM_ALWAYS_CREATE)->LoadByteCode(streams[n]) < 0 )
+			printf("Load failed\n");
+	}
+
+	time = GetSystemTimer() - time;
+	printf("Time = %f secs\n", time);
+
+	engine->ShutDownAndRelease();
+
+	////////////////////////////////////////////
+	printf("\nLoading all modules with %d threads...\n", numThreads);
+
+	engine = CreateEngine();
+
+	vector<asIScriptModule*> mods;
+	vector<asIBinaryStream*> ins;
+	for( int n = 0; n < numModules; n++ )
+	{
+		char name[50];
+		sprintf(name, "mod_%d", n);
+		streams[n]->Restart();
+		mods.push_back(engine->GetModule(name, asGM_ALWAYS_CREATE));
+		ins.push_back(streams[n]);
+	}
+
+	time = GetSystemTimer();
+
+	if( engine->LoadByteCodeForModules(&mods[0], &ins[0], numModules, numThreads) < 0 )
+		printf("Load failed\n");
+
+	time = GetSystemTimer() - time;
+	printf("Time = %f secs\n", time);
+
+	engine->ShutDownAndRelease();
+
+	for( int n = 0; n < numModules; n++ )
+		delete streams[n];
+
+	asUnprepareMultithread();
+}
+
+} // namespace
+
+
+
@@ -97,6 +97,50 @@ void Test()
 		printf("Time average = %f secs\n", time/iterations);
 	}
 
+	////////////////////////////////////////////
+	printf("\nBuilding incrementally...\n");
+
+	time = GetSystemTimer();
+
+	for( int n = 0; n < iterations && r >= 0; n++ )
+	{
+		// Only the body of the global function is modified between the builds,
+		// so it is the only function that needs to be compiled again
+		string script =
+			"Test t; \n"
+			"void globalFunc() { \n";
+		script += (n & 1) ? "  for( uint n = 0; n < 20; n++ ) \n" : "  for( uint n = 0; n < 10; n++ ) \n";
+		script +=
+			"    t.children[n].doSomething(); \n"
+			"} \n"
+			"class Test { \n"
+			"  Test @next; \n"
+			"  array<Test@> children; \n"
+			"  void doSomething() { if( t is this ) doSomethingElse(); } \n"
+			"  void doSomethingElse() { globalFunc(); } \n"
+			"  Test() {} \n"
+			"  Test @opAssign() { return this; } \n"
+			"} \n"
+			"void main() { \n"
+			"  for( uint n = 0; n < 10; n++ ) \n"
+			"    t.children.insertLast(Test()); \n"
+			"} \n";
+
+		asIScriptModule *mod = engine->GetModule(0, asGM_CREATE_IF_NOT_EXISTS);
+		mod->AddScriptSection(TESTNAME, script.c_str(), script.size());
+		r = mod->BuildIncremental();
+	}
+
+	time = GetSystemTimer() - time;
+
+	if( r != 0 )
+		printf("Build failed\n");
+	else
+	{
+		printf("Time = %f secs\n", time);
+		printf("Time average = %f secs\n", time/iterations);
+	}
+
 	engine->Release();
 }
 
@@ -65,6 +65,7 @@ namespace TestCustomMem         { bool Test(); }
 namespace TestGeneric           { bool Test(); }
 namespace TestDebug             { bool Test(); }
 namespace TestSuspend           { bool Test(); }
+namespace TestJIT               { bool Test(); }
 namespace TestConstProperty     { bool Test(); }
 namespace TestConstObject       { bool Test(); }
 namespace TestOutput            { bool Test(); }
@@ -164,6 +165,7 @@ namespace Test_Addon_ScriptMath    { bool Test(); }
 namespace Test_Addon_ScriptBuilder { bool Test(); }
 namespace Test_Addon_Dictionary    { bool Test(); }
 namespace Test_Addon_Debugger      { bool Test(); }
+namespace Test_Addon_Profiler      { bool Test(); }
 namespace Test_Addon_WeakRef       { bool Test(); }
 namespace Test_Addon_ScriptGrid    { bool Test(); }
 namespace Test_Addon_ContextMgr    { bool Test(); }
@@ -232,6 +234,7 @@ int allTests()
 	if( Test_Addon_ScriptGrid::Test()    ) goto failed; else PRINTF("-- Test_Addon_ScriptGrid passed\n");
 	if( Test_Addon_WeakRef::Test()       ) goto failed; else PRINTF("-- Test_Addon_WeakRef passed\n");
 	if( Test_Addon_Debugger::Test()      ) goto failed; else PRINTF("-- Test_Addon_Debugger passed\n");
+	if( Test_Addon_Profiler::Test()      ) goto failed; else PRINTF("-- Test_Addon_Profiler passed\n");
 	if( Test_Addon_ScriptBuilder::Test() ) goto failed; else PRINTF("-- Test_Addon_ScriptBuilder passed\n");
 	if( Test_Addon_ScriptMath::Test()    ) goto failed; else PRINTF("-- Test_Addon_ScriptMath passed\n");
 	if( Test_Addon_Serializer::Test()    ) goto failed; else PRINTF("-- Test_Addon_Serializer passed\n");
@@ -269,6 +272,7 @@ int allTests()
 	if( TestArrayObject::Test()         ) goto failed; else PRINTF("-- TestArrayObject passed\n");
 	if( TestCompiler::Test()            ) goto failed; else PRINTF("-- TestCompiler passed\n");
 	if( TestOptimize()                  ) goto failed; else PRINTF("-- TestOptimize passed\n");
+	if( TestJIT::Test()                 ) goto failed; else PRINTF("-- TestJIT passed\n");
 	if( TestConversion::Test()          ) goto failed; else PRINTF("-- TestConversion passed\n");
 	if( TestRegisterType::Test()        ) goto failed; else PRINTF("-- TestRegisterType passed\n");
 	if( TestRefArgument::Test()         ) goto failed; else PRINTF("-- TestRefArgument passed\n");
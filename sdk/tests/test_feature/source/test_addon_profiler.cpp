@@ -0,0 +1,206 @@
+#include "utils.h"
+#if AS_CAN_USE_CPP11
+#include "../../../add_on/profiler/profiler.h"
+#endif
+
+using namespace std;
+
+namespace Test_Addon_Profiler
+{
+
+#if AS_CAN_USE_CPP11
+static CProfiler *profiler = 0;
+
+static void RequestSample(asIScriptGeneric *)
+{
+	profiler->RequestSample();
+}
+
+static void GetSampleCount(asIScriptGeneric *gen)
+{
+	gen->SetReturnDWord(profiler->GetSampleCount());
+}
+
+static void AppLineCallback(asIScriptContext *, void *param)
+{
+	(*(int*)param)++;
+}
+#endif
+
+bool Test()
+{
+#if !defined(AS_CAN_USE_CPP11)
+	PRINTF("Skipped due to lack of C++11 support\n");
+	return false;
+#else
+
+	bool fail = false;
+	int r;
+	COutStream out;
+
+	if( strstr(asGetLibraryOptions(), "AS_MAX_PORTABILITY") )
+	{
+		PRINTF("Skipped due to AS_MAX_PORTABILITY\n");
+		return false;
+	}
+
+	asIScriptEngine *engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
+	engine->SetMessageCallback(asMETHOD(COutStream, Callback), &out, asCALL_THISCALL);
+	engine->RegisterGlobalFunction("void sample()", asFUNCTION(RequestSample), asCALL_GENERIC);
+	engine->RegisterGlobalFunction("uint sampleCount()", asFUNCTION(GetSampleCount), asCALL_GENERIC);
+
+	asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+	mod->AddScriptSection("test",
+		"void main()                    \n" // 1
+		"{                              \n" // 2
+		"  for( int n = 0; n < 5; n++ ) \n" // 3
+		"    inner();                   \n" // 4
+		"  sample();                    \n" // 5
+		"  int x = 0;                   \n" // 6
+		"}                              \n" // 7
+		"void inner()                   \n" // 8
+		"{                              \n" // 9
+		"  sample();                    \n" // 10
+		"  int a = 1;                   \n" // 11
+		"}                              \n" // 12
+		"void spin()                    \n"
+		"{                              \n"
+		"  for( int n = 0; n < 100000000 && sampleCount() < 10; n++ ) \n"
+		"    inner2(n);                 \n"
+		"}                              \n"
+		"int inner2(int n)              \n"
+		"{                              \n"
+		"  return n * 2;                \n"
+		"}                              \n");
+	r = mod->Build();
+	if( r < 0 )
+		TEST_FAILED;
+
+	// Samples requested at known locations
+	{
+		profiler = new CProfiler();
+		asIScriptContext *ctx = engine->CreateContext();
+		profiler->AddContext(ctx);
+
+		ctx->Prepare(mod->GetFunctionByName("main"));
+		r = ctx->Execute();
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		if( profiler->GetSampleCount() != 6 )
+		{
+			PRINTF("Sample count: %d\n", profiler->GetSampleCount());
+			TEST_FAILED;
+		}
+
+		vector<CProfiler::SFunctionStats> funcs;
+		profiler->GetFunctionStats(funcs);
+		if( funcs.size() != 2 ||
+			funcs[0].function != "void inner()" || funcs[0].exclusive != 5 || funcs[0].inclusive != 5 ||
+			funcs[1].function != "void main()" || funcs[1].exclusive != 1 || funcs[1].inclusive != 6 )
+			TEST_FAILED;
+
+		vector<CProfiler::SLineStats> lines;
+		profiler->GetLineStats(lines);
+		if( lines.size() != 3 ||
+			lines[0].line != 11 || lines[0].exclusive != 5 || lines[0].section != "test" ||
+			lines[1].line != 6 || lines[1].exclusive != 1 || lines[1].inclusive != 1 ||
+			lines[2].line != 4 || lines[2].exclusive != 0 || lines[2].inclusive != 5 )
+			TEST_FAILED;
+
+		string stacks = profiler->GetCollapsedStacks();
+		if( stacks != "void main() 1\n"
+		              "void main();void inner() 5\n" )
+		{
+			PRINTF("%s", stacks.c_str());
+			TEST_FAILED;
+		}
+
+		// No sample is taken unless requested, and requests made
+		// while the context is not executing are ignored
+		profiler->Reset();
+		profiler->RequestSample();
+		ctx->Prepare(mod->GetFunctionByName("inner2"));
+		ctx->SetArgDWord(0, 1);
+		r = ctx->Execute();
+		if( r != asEXECUTION_FINISHED || profiler->GetSampleCount() != 0 )
+			TEST_FAILED;
+
+		profiler->RemoveContext(ctx);
+		ctx->Release();
+		delete profiler;
+		profiler = 0;
+	}
+
+	// Samples requested by the background thread
+	{
+		profiler = new CProfiler();
+		asIScriptContext *ctx = engine->CreateContext();
+		profiler->AddContext(ctx);
+		r = profiler->Start(100);
+		if( r < 0 || !profiler->IsRunning() )
+			TEST_FAILED;
+
+		ctx->Prepare(mod->GetFunctionByName("spin"));
+		r = ctx->Execute();
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		profiler->Stop();
+		if( profiler->IsRunning() )
+			TEST_FAILED;
+
+		if( profiler->GetSampleCount() < 10 )
+			TEST_FAILED;
+
+		string stacks = profiler->GetCollapsedStacks();
+		if( stacks.find("void spin()") != 0 )
+		{
+			PRINTF("%s", stacks.c_str());
+			TEST_FAILED;
+		}
+
+		// The profiler releases the context when destroyed
+		ctx->Release();
+		delete profiler;
+		profiler = 0;
+	}
+
+	// The application's own line callback is called too, and restored when the context is removed
+	{
+		profiler = new CProfiler();
+		asIScriptContext *ctx = engine->CreateContext();
+		int lines = 0;
+		r = profiler->AddContext(ctx, AppLineCallback, &lines);
+		if( r < 0 )
+			TEST_FAILED;
+
+		ctx->Prepare(mod->GetFunctionByName("main"));
+		r = ctx->Execute();
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+		if( profiler->GetSampleCount() != 6 || lines == 0 )
+			TEST_FAILED;
+
+		profiler->RemoveContext(ctx);
+		lines = 0;
+		ctx->Prepare(mod->GetFunctionByName("main"));
+		r = ctx->Execute();
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+		if( profiler->GetSampleCount() != 6 || lines == 0 )
+			TEST_FAILED;
+
+		ctx->Release();
+		delete profiler;
+		profiler = 0;
+	}
+
+	engine->ShutDownAndRelease();
+
+	return fail;
+#endif
+}
+
+} // namespace
+
@@ -433,6 +433,76 @@ bool Test()
 		}
 	}
 
+	// Test the bytecode cache
+	{
+		engine->SetMessageCallback(asMETHOD(COutStream, Callback), &out, asCALL_THISCALL);
+
+		const char *cacheScript =
+			"[cached] \n"
+			"int func() { return 42; } \n";
+
+		// The first build compiles the script and stores the bytecode
+		CScriptBuilder builder;
+		builder.SetBytecodeCacheDirectory(".");
+		builder.StartNewModule(engine, "cache");
+		builder.AddSectionFromMemory("cache", cacheScript);
+		r = builder.BuildModule();
+		if( r < 0 || builder.WasLoadedFromCache() )
+			TEST_FAILED;
+
+		// The next build with the same script loads the stored bytecode
+		builder.StartNewModule(engine, "cache");
+		builder.AddSectionFromMemory("cache", cacheScript);
+		r = builder.BuildModule();
+		if( r < 0 || !builder.WasLoadedFromCache() )
+			TEST_FAILED;
+
+		asIScriptFunction *func = engine->GetModule("cache")->GetFunctionByName("func");
+		if( func == 0 )
+			TEST_FAILED;
+		else
+		{
+#if AS_PROCESS_METADATA == 1
+			vector<string> metadata = builder.GetMetadataForFunc(func);
+			if( metadata.size() != 1 || metadata[0] != "cached" )
+				TEST_FAILED;
+#endif
+			asIScriptContext *ctx = engine->CreateContext();
+			ctx->Prepare(func);
+			r = ctx->Execute();
+			if( r != asEXECUTION_FINISHED || ctx->GetReturnDWord() != 42 )
+				TEST_FAILED;
+			ctx->Release();
+		}
+
+		// A modified script must be compiled again
+		builder.StartNewModule(engine, "cache");
+		builder.AddSectionFromMemory("cache", "int func() { return 1; } \n");
+		r = builder.BuildModule();
+		if( r < 0 || builder.WasLoadedFromCache() )
+			TEST_FAILED;
+
+		// The cache now holds the bytecode of the modified script
+		builder.StartNewModule(engine, "cache");
+		builder.AddSectionFromMemory("cache", "int func() { return 1; } \n");
+		r = builder.BuildModule();
+		if( r < 0 || !builder.WasLoadedFromCache() )
+			TEST_FAILED;
+
+		// A change in the application interface invalidates the cache
+		static int cacheValue = 0;
+		engine->RegisterGlobalProperty("int cacheValue", &cacheValue);
+
+		builder.StartNewModule(engine, "cache");
+		builder.AddSectionFromMemory("cache", "int func() { return 1; } \n");
+		r = builder.BuildModule();
+		if( r < 0 || builder.WasLoadedFromCache() )
+			TEST_FAILED;
+
+		engine->DiscardModule("cache");
+		remove("./cache.asbc");
+	}
+
 	engine->Release();
 
 	return fail;
@@ -174,6 +174,264 @@ bool Test()
 	COutStream out;
 	asIScriptModule *mod;
 
+	// Test that overload resolution that is reused within a build still gives the right match
+	{
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+		bout.buffer = "";
+
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"int f(int8 a) { return 1; } \n"
+			"int f(float a) { return 2; } \n"
+			"int f(double a) { return 3; } \n"
+			"void main() \n"
+			"{ \n"
+			"  int8 a = 0; float b = 0; double c = 0; \n"
+			"  assert( f(a) == 1 ); \n"
+			"  assert( f(b) == 2 ); \n"
+			"  assert( f(a) == 1 ); \n"
+			"  assert( f(c) == 3 ); \n"
+			"  assert( f(b) == 2 ); \n"
+			"  assert( f(int8(1)) == 1 ); \n"
+			"  assert( f(1.0f) == 2 ); \n"
+			"  assert( f(1.0) == 3 ); \n"
+			"} \n"
+			"void g(int a, float b) {} \n"
+			"void g(float a, int b) {} \n"
+			"void err() \n"
+			"{ \n"
+			"  int i = 0; \n"
+			"  g(i, i); \n"
+			"  g(i, i); \n"
+			"} \n");
+		r = mod->Build();
+		if( r >= 0 )
+			TEST_FAILED;
+
+		// The error must be reported for each call
+		if( bout.buffer != "test (18, 1) : Info    : Compiling void err()\n"
+		                   "test (21, 3) : Error   : Multiple matching signatures to 'g(int, int)'\n"
+		                   "test (21, 3) : Info    : void g(int a, float b)\n"
+		                   "test (21, 3) : Info    : void g(float a, int b)\n"
+		                   "test (22, 3) : Error   : Multiple matching signatures to 'g(int, int)'\n"
+		                   "test (22, 3) : Info    : void g(int a, float b)\n"
+		                   "test (22, 3) : Info    : void g(float a, int b)\n" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+		bout.buffer = "";
+
+		mod->AddScriptSection("test",
+			"int f(int8 a) { return 1; } \n"
+			"int f(float a) { return 2; } \n"
+			"int f(double a) { return 3; } \n"
+			"void main() \n"
+			"{ \n"
+			"  int8 a = 0; float b = 0; double c = 0; \n"
+			"  assert( f(a) == 1 ); \n"
+			"  assert( f(b) == 2 ); \n"
+			"  assert( f(a) == 1 ); \n"
+			"  assert( f(c) == 3 ); \n"
+			"  assert( f(b) == 2 ); \n"
+			"  assert( f(int8(1)) == 1 ); \n"
+			"  assert( f(1.0f) == 2 ); \n"
+			"  assert( f(1.0) == 3 ); \n"
+			"} \n");
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "main();", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		if( bout.buffer != "" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
+	// Test building with the build arena
+	{
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		bout.buffer = "";
+
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+
+		r = engine->SetEngineProperty(asEP_USE_BUILD_ARENA, true);
+		if( r < 0 || engine->GetEngineProperty(asEP_USE_BUILD_ARENA) != 1 )
+			TEST_FAILED;
+
+		// A failed build must release the arena too
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"int func() { return undefined; } \n");
+		r = mod->Build();
+		if( r >= 0 )
+			TEST_FAILED;
+
+		if( bout.buffer != "test (1, 1) : Info    : Compiling int func()\n"
+		                   "test (1, 21) : Error   : No matching symbol 'undefined'\n" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+		bout.buffer = "";
+
+		// Enough code to need more than one chunk from the arena
+		string script = "int sum() { int s = 0; \n";
+		for( int n = 0; n < 500; n++ )
+		{
+			char buf[50];
+			snprintf(buf, sizeof(buf), "  s += (%d * 2 + 1) / 1; \n", n);
+			script += buf;
+		}
+		script += "  return s; } \n";
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script.c_str());
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		asIScriptContext *ctx = engine->CreateContext();
+		ctx->Prepare(mod->GetFunctionByName("sum"));
+		r = ctx->Execute();
+		if( r != asEXECUTION_FINISHED || ctx->GetReturnDWord() != 250000 )
+			TEST_FAILED;
+		ctx->Release();
+
+		// Other ways of compiling don't use the arena, but must still work with it turned on
+		r = ExecuteString(engine, "assert( sum() == 250000 );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		if( bout.buffer != "" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
+	// Test compiling the functions with multiple threads
+	// The function ids and the messages must be the same as with a single thread
+	{
+		string script =
+			"funcdef int CB(int); \n"
+			"class C { int a = 1; array<int> b = {1, 2}; string s = 'c'; } \n"
+			"int def(int a, int b = 10) { return a + b; } \n"
+			"int useArray() { array<int> a = {1, 2, 3}; return a.length(); } \n"
+			"int useLambda() { CB @cb = function(a) { return a * 2; }; return cb(4); } \n"
+			"int twice(int a) { return a * 2; } \n"
+			"int useFuncPtr() { CB @cb = @twice; return cb(5); } \n"
+			"string useString() { return 'a' + 'b'; } \n"
+			"int useClass() { C c; return c.a + c.b[1] + c.s.length(); } \n";
+		for( int n = 0; n < 50; n++ )
+		{
+			char buf[200];
+			snprintf(buf, sizeof(buf), "int func%d(int a) { int[] arr = {a, %d}; string s = 's%d'; return arr[0] + arr[1] + def(a) + s.length(); } \n", n, n, n);
+			script += buf;
+		}
+		script +=
+			"void main() { \n"
+			"  assert( def(1) == 11 ); \n"
+			"  assert( useArray() == 3 ); \n"
+			"  assert( useLambda() == 8 ); \n"
+			"  assert( useFuncPtr() == 10 ); \n"
+			"  assert( useString() == 'ab' ); \n"
+			"  assert( useClass() == 4 ); \n"
+			"  assert( func49(1) == 1 + 49 + 11 + 3 ); \n"
+			"} \n";
+
+		const char *invalid =
+			"int f1() { return 1; } \n"
+			"int f2() { int a = 1.5f; return undefined; } \n"
+			"int f3() { array<float> a; return a.length() + undefined3; } \n"
+			"int f4() { int b = 2.5f; return b; } \n"
+			"int f5() { return undefined2; } \n";
+
+		string ids[2], messages[2];
+		for( int threads = 0; threads < 2; threads++ )
+		{
+			engine = asCreateScriptEngine();
+			engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+			bout.buffer = "";
+
+			RegisterScriptArray(engine, true);
+			RegisterStdString(engine);
+			engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+
+			r = engine->SetEngineProperty(asEP_COMPILE_THREADS, threads ? 4 : 0);
+			if( r < 0 || engine->GetEngineProperty(asEP_COMPILE_THREADS) != asPWORD(threads ? 4 : 0) )
+				TEST_FAILED;
+
+			mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+			mod->AddScriptSection("test", script.c_str());
+			r = mod->Build();
+			if( r < 0 )
+				TEST_FAILED;
+
+			for( asUINT n = 0; n < mod->GetFunctionCount(); n++ )
+			{
+				asIScriptFunction *func = mod->GetFunctionByIndex(n);
+				char buf[20];
+				snprintf(buf, sizeof(buf), "%d ", func->GetId());
+				ids[threads] += buf;
+				ids[threads] += func->GetDeclaration();
+				ids[threads] += "\n";
+			}
+
+			r = ExecuteString(engine, "main();", mod);
+			if( r != asEXECUTION_FINISHED )
+				TEST_FAILED;
+
+			if( bout.buffer != "" )
+			{
+				PRINTF("%s", bout.buffer.c_str());
+				TEST_FAILED;
+			}
+
+			mod = engine->GetModule("invalid", asGM_ALWAYS_CREATE);
+			mod->AddScriptSection("invalid", invalid);
+			r = mod->Build();
+			if( r >= 0 )
+				TEST_FAILED;
+			messages[threads] = bout.buffer;
+			bout.buffer = "";
+
+			engine->ShutDownAndRelease();
+		}
+
+		if( ids[0] != ids[1] )
+		{
+			PRINTF("%s\n%s", ids[0].c_str(), ids[1].c_str());
+			TEST_FAILED;
+		}
+
+		if( messages[0] != messages[1] ||
+			messages[1] != "invalid (2, 1) : Info    : Compiling int f2()\n"
+			               "invalid (2, 20) : Warning : Implicit conversion of value is not exact\n"
+			               "invalid (2, 33) : Error   : No matching symbol 'undefined'\n"
+			               "invalid (3, 1) : Info    : Compiling int f3()\n"
+			               "invalid (3, 48) : Error   : No matching symbol 'undefined3'\n"
+			               "invalid (4, 1) : Info    : Compiling int f4()\n"
+			               "invalid (4, 20) : Warning : Implicit conversion of value is not exact\n"
+			               "invalid (5, 1) : Info    : Compiling int f5()\n"
+			               "invalid (5, 19) : Error   : No matching symbol 'undefined2'\n" )
+		{
+			PRINTF("%s\n%s", messages[0].c_str(), messages[1].c_str());
+			TEST_FAILED;
+		}
+	}
+
 	// Test invalid code
 	// https://www.gamedev.net/forums/topic/696243-strange-code-works-normally/
 	{
@@ -232,6 +232,74 @@ bool Test()
 		engine->Release();
 	}
 
+	// Test profiling of script functions
+	{
+		asIScriptEngine *engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
+		engine->SetEngineProperty(asEP_PROFILE_FUNCTIONS, true);
+		if( engine->GetEngineProperty(asEP_PROFILE_FUNCTIONS) != 1 )
+			TEST_FAILED;
+
+		asIScriptModule *mod = engine->GetModule("Test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"int fib(int n) { if( n < 2 ) return n; return fib(n-1) + fib(n-2); } \n"
+			"void thrw(int n) { if( n == 0 ) { int a = 0; a = 1/a; } thrw(n-1); } \n"
+			"void main() { fib(10); } \n");
+		int r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		asIScriptFunction *mainFunc = mod->GetFunctionByName("main");
+		asIScriptFunction *fibFunc  = mod->GetFunctionByName("fib");
+		asIScriptFunction *thrwFunc = mod->GetFunctionByName("thrw");
+		asIScriptContext *ctx = engine->CreateContext();
+
+		ctx->Prepare(mainFunc);
+		if( ctx->Execute() != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		asQWORD count = 0;
+		double time = 0;
+		fibFunc->GetProfileData(&count, &time);
+		if( count != 177 || time <= 0 )
+			TEST_FAILED;
+		mainFunc->GetProfileData(&count, &time);
+		if( count != 1 || time <= 0 )
+			TEST_FAILED;
+
+		// Functions that are exited by an exception are counted, but their time isn't
+		ctx->Prepare(thrwFunc);
+		ctx->SetArgDWord(0, 5);
+		if( ctx->Execute() != asEXECUTION_EXCEPTION )
+			TEST_FAILED;
+		thrwFunc->GetProfileData(&count, &time);
+		if( count != 6 || time != 0 )
+			TEST_FAILED;
+
+		ctx->Prepare(mainFunc);
+		if( ctx->Execute() != asEXECUTION_FINISHED )
+			TEST_FAILED;
+		fibFunc->GetProfileData(&count);
+		if( count != 354 )
+			TEST_FAILED;
+
+		engine->ResetProfileData();
+		fibFunc->GetProfileData(&count, &time);
+		if( count != 0 || time != 0 )
+			TEST_FAILED;
+
+		// Nothing is recorded when the profiling is turned off
+		engine->SetEngineProperty(asEP_PROFILE_FUNCTIONS, false);
+		ctx->Prepare(mainFunc);
+		if( ctx->Execute() != asEXECUTION_FINISHED )
+			TEST_FAILED;
+		fibFunc->GetProfileData(&count, &time);
+		if( count != 0 || time != 0 )
+			TEST_FAILED;
+
+		ctx->Release();
+		engine->ShutDownAndRelease();
+	}
+
 	// Test FindNextLineWithCode
 	// Reported by Scott Bean
 	{
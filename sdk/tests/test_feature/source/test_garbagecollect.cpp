@@ -1,5 +1,11 @@
 
 #include "utils.h"
+#include <time.h>
+#ifdef AS_CAN_USE_CPP11
+#include <thread>
+#include <chrono>
+#include <atomic>
+#endif
 
 namespace TestGarbageCollect
 {
@@ -70,6 +76,33 @@ void CircularRefDetected(asITypeInfo *type, const void *obj, void * /* user para
 	typeFound += type->GetName();
 }
 
+#ifdef AS_CAN_USE_CPP11
+// Executes the script a few times while the background thread searches for circular references
+void ModifyObjectsInThread(asIScriptFunction *func, int seed, int *result, std::atomic<int> *running)
+{
+	asIScriptContext *ctx = func->GetEngine()->CreateContext();
+	*result = 0;
+	for( int n = 0; n < 2 && *result >= 0; n++ )
+	{
+		int r = ctx->Prepare(func);
+		if( r >= 0 )
+		{
+			ctx->SetArgDWord(0, seed);
+			r = ctx->Execute();
+		}
+		if( r == asEXECUTION_FINISHED )
+			*result += (int)ctx->GetReturnDWord();
+		else
+			*result = -1;
+	}
+	ctx->Release();
+	(*running)--;
+
+	// Free the thread local data before the thread ends
+	asThreadCleanup();
+}
+#endif
+
 bool Test()
 {
 	bool fail = false;
@@ -120,6 +153,299 @@ bool Test()
 		engine->ShutDownAndRelease();
 	}
 
+	// Test the search for circular references in a background thread
+	{
+		asIScriptEngine *engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(COutStream, Callback), &out, asCALL_THISCALL);
+		engine->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
+
+		r = engine->SetEngineProperty(asEP_BACKGROUND_GARBAGE_COLLECT, true);
+		if( strstr(asGetLibraryOptions(), "AS_NO_THREADS") )
+		{
+			if( r != asNOT_SUPPORTED )
+				TEST_FAILED;
+		}
+		else
+		{
+			if( r < 0 || engine->GetEngineProperty(asEP_BACKGROUND_GARBAGE_COLLECT) != 1 )
+				TEST_FAILED;
+
+			asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+			mod->AddScriptSection("test",
+				"class testclass \n"
+				"{ \n"
+				"  testclass @next; \n"
+				"} \n"
+				"testclass @keep; \n"
+				"void main() \n"
+				"{ \n"
+				"  for( int n = 0; n < 100; n++ ) \n"
+				"  { \n"
+				"    testclass a; \n"
+				"    @a.next = testclass(); \n"
+				"    @a.next.next = @a; \n"
+				"  } \n"
+				"  @keep = testclass(); \n"
+				"  @keep.next = keep; \n"
+				"}\n");
+			r = mod->Build();
+			if (r < 0)
+				TEST_FAILED;
+
+			r = ExecuteString(engine, "main()", mod);
+			if (r != asEXECUTION_FINISHED)
+				TEST_FAILED;
+
+			// The garbage is destroyed by this thread once the background thread has found it
+			asUINT currentSize = 0;
+			asUINT totalDetected = 0;
+			time_t start = time(0);
+			do
+			{
+				engine->GarbageCollect(asGC_ONE_STEP, 10);
+				engine->GetGCStatistics(&currentSize, 0, &totalDetected);
+			} while( currentSize > 1 && time(0) - start < 30 );
+
+			if( currentSize != 1 || totalDetected != 200 )
+				TEST_FAILED;
+
+			engine->SetEngineProperty(asEP_BACKGROUND_GARBAGE_COLLECT, false);
+			if( engine->GetEngineProperty(asEP_BACKGROUND_GARBAGE_COLLECT) != 0 )
+				TEST_FAILED;
+
+			// The engine must stop the thread itself when it is shut down
+			engine->SetEngineProperty(asEP_BACKGROUND_GARBAGE_COLLECT, true);
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
+	// Test scripts modifying arrays and handles in several threads while the background thread
+	// searches for circular references. The background thread must only enumerate the references
+	// while the scripts are paused, or it may walk the buffer of an array that is being resized
+#ifndef AS_CAN_USE_CPP11
+	PRINTF("Skipped the test of background garbage collection with multiple threads as it requires C++11\n");
+#else
+	if( strstr(asGetLibraryOptions(), "AS_NO_THREADS") )
+		PRINTF("Skipped the test of background garbage collection with multiple threads due to AS_NO_THREADS\n");
+	else
+	{
+		asIScriptEngine *engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(COutStream, Callback), &out, asCALL_THISCALL);
+		engine->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
+		RegisterScriptArray(engine, true);
+		r = engine->SetEngineProperty(asEP_BACKGROUND_GARBAGE_COLLECT, true);
+		if( r < 0 )
+			TEST_FAILED;
+
+		asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"class node \n"
+			"{ \n"
+			"  node @next; \n"
+			"  array<node@> children; \n"
+			"  array<int> data; \n"
+			"} \n"
+			"int main(int seed) \n"
+			"{ \n"
+			"  array<node@> nodes; \n"
+			"  int sum = 0; \n"
+			"  for( int i = 0; i < 1000; i++ ) \n"
+			"  { \n"
+			"    node n; \n"
+			"    n.data.resize((i + seed) % 50); \n"
+			"    n.children.resize(i % 7); \n"
+			"    for( uint c = 0; c < n.children.length(); c++ ) \n"
+			"      @n.children[c] = n; \n"
+			"    if( nodes.length() > 0 ) \n"
+			"    { \n"
+			"      node @old = nodes[(i * 13) % nodes.length()]; \n"
+			"      @old.next = n; \n"
+			"      old.children.resize((i + seed) % 11); \n"
+			"      @n.next = old; \n"
+			"    } \n"
+			"    nodes.insertLast(n); \n"
+			"    if( nodes.length() > 200 ) \n"
+			"      nodes.removeAt(0); \n"
+			"    sum += n.data.length(); \n"
+			"  } \n"
+			"  return sum; \n"
+			"}\n");
+		r = mod->Build();
+		if (r < 0)
+			TEST_FAILED;
+
+		asIScriptFunction *func = mod->GetFunctionByName("main");
+		int results[4];
+		std::thread threads[4];
+		std::atomic<int> running(4);
+		for( int n = 0; n < 4; n++ )
+			threads[n] = std::thread(ModifyObjectsInThread, func, n, &results[n], &running);
+
+		// This thread breaks the circles that the background thread finds and destroys the objects,
+		// leaving some time between the calls for the background search. The objects that the scripts
+		// keep alive for a while are moved to the old generation, which the background thread searches
+		asUINT currentSize = 0;
+		asUINT totalDetected = 0;
+		time_t start = time(0);
+		do
+		{
+			engine->GarbageCollect(asGC_ONE_STEP, 100);
+			engine->GetGCStatistics(&currentSize, 0, &totalDetected);
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		} while( (running > 0 || currentSize > 0) && time(0) - start < 30 );
+
+		for( int n = 0; n < 4; n++ )
+			threads[n].join();
+
+		// Each execution sums 0 to 49 twenty times
+		for( int n = 0; n < 4; n++ )
+			if( results[n] != 2*20*1225 )
+				TEST_FAILED;
+
+		if( currentSize != 0 || totalDetected == 0 )
+			TEST_FAILED;
+
+		engine->ShutDownAndRelease();
+	}
+#endif
+
+	// Test the generations of the garbage collector
+	{
+		asIScriptEngine *engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(COutStream, Callback), &out, asCALL_THISCALL);
+		engine->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
+		engine->SetEngineProperty(asEP_GC_PROMOTION_AGE, 1);
+		engine->SetEngineProperty(asEP_GC_TENURE_AGE, 2);
+		engine->SetEngineProperty(asEP_GC_TENURED_SCAN_INTERVAL, 4);
+		if( engine->GetEngineProperty(asEP_GC_PROMOTION_AGE) != 1 ||
+			engine->GetEngineProperty(asEP_GC_TENURE_AGE) != 2 ||
+			engine->GetEngineProperty(asEP_GC_TENURED_SCAN_INTERVAL) != 4 )
+			TEST_FAILED;
+
+		asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"class testclass \n"
+			"{ \n"
+			"  testclass @next; \n"
+			"} \n"
+			"testclass @keep; \n"
+			"void main() \n"
+			"{ \n"
+			"  @keep = testclass(); \n"
+			"  @keep.next = keep; \n"
+			"}\n");
+		r = mod->Build();
+		if (r < 0)
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "main()", mod);
+		if (r != asEXECUTION_FINISHED)
+			TEST_FAILED;
+
+		// The live object is moved to the old generation and then to the tenured generation
+		asUINT tenured = 0;
+		for( int n = 0; n < 1000 && tenured == 0; n++ )
+		{
+			engine->GarbageCollect(asGC_ONE_STEP);
+			engine->GetGCGenerationStatistics(2, &tenured);
+		}
+
+		asUINT currentSize, totalDestroyed, totalPromoted, totalScans;
+		r = engine->GetGCGenerationStatistics(0, &currentSize, &totalDestroyed, &totalPromoted, &totalScans);
+		if( r < 0 || currentSize != 0 || totalPromoted != 1 || totalScans == 0 )
+			TEST_FAILED;
+		r = engine->GetGCGenerationStatistics(1, &currentSize, &totalDestroyed, &totalPromoted, &totalScans);
+		if( r < 0 || currentSize != 0 || totalPromoted != 1 || totalScans < 2 )
+			TEST_FAILED;
+		r = engine->GetGCGenerationStatistics(2, &currentSize, &totalDestroyed, &totalPromoted);
+		if( r < 0 || currentSize != 1 || totalDestroyed != 0 || totalPromoted != 0 )
+			TEST_FAILED;
+		if( engine->GetGCGenerationStatistics(3, &currentSize) != asINVALID_ARG )
+			TEST_FAILED;
+
+		// The circular reference is still found when the tenured object becomes garbage
+		r = ExecuteString(engine, "@keep = null;", mod);
+		if (r != asEXECUTION_FINISHED)
+			TEST_FAILED;
+
+		for( int n = 0; n < 1000 && tenured != 0; n++ )
+		{
+			engine->GarbageCollect(asGC_ONE_STEP);
+			engine->GetGCGenerationStatistics(2, &tenured);
+		}
+
+		asUINT totalDetected;
+		engine->GetGCStatistics(&currentSize, 0, &totalDetected);
+		if( currentSize != 0 || totalDetected != 1 )
+			TEST_FAILED;
+		engine->GetGCGenerationStatistics(2, &currentSize, &totalDestroyed, 0, &totalScans);
+		if( currentSize != 0 || totalDestroyed != 1 || totalScans == 0 )
+			TEST_FAILED;
+
+		engine->ShutDownAndRelease();
+	}
+
+	// Test the garbage collection with a time budget
+	{
+		asIScriptEngine *engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(COutStream, Callback), &out, asCALL_THISCALL);
+		engine->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
+
+		asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"class testclass \n"
+			"{ \n"
+			"  testclass @next; \n"
+			"} \n"
+			"void main() \n"
+			"{ \n"
+			"  for( int n = 0; n < 1000; n++ ) \n"
+			"  { \n"
+			"    testclass a; \n"
+			"    @a.next = testclass(); \n"
+			"    @a.next.next = @a; \n"
+			"  } \n"
+			"}\n");
+		r = mod->Build();
+		if (r < 0)
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "main()", mod);
+		if (r != asEXECUTION_FINISHED)
+			TEST_FAILED;
+
+		// A budget of a single microsecond is not enough to destroy the garbage
+		r = engine->GarbageCollect(asGC_ONE_STEP | asGC_TIME_BUDGET, 1);
+		if( r != 1 )
+			TEST_FAILED;
+
+		// The garbage collector returns 0 when all work is done within the budget
+		for( int n = 0; n < 10000 && r == 1; n++ )
+			r = engine->GarbageCollect(asGC_ONE_STEP | asGC_TIME_BUDGET, 1000);
+		if( r != 0 )
+			TEST_FAILED;
+
+		asUINT currentSize, totalDetected;
+		engine->GetGCStatistics(&currentSize, 0, &totalDetected);
+		if( currentSize != 0 || totalDetected != 2000 )
+			TEST_FAILED;
+
+		// All the phases have been executed
+		for( asUINT phase = 0; phase < asGC_PHASE_LAST; phase++ )
+		{
+			double totalTime = -1, maxStepTime = -1;
+			asQWORD totalSteps = 0;
+			r = engine->GetGCPhaseStatistics(asEGCPhase(phase), &totalTime, &maxStepTime, &totalSteps);
+			if( r < 0 || totalSteps == 0 || totalTime < 0 || maxStepTime < 0 || maxStepTime > totalTime )
+				TEST_FAILED;
+		}
+		if( engine->GetGCPhaseStatistics(asGC_PHASE_LAST, 0) != asINVALID_ARG )
+			TEST_FAILED;
+
+		engine->ShutDownAndRelease();
+	}
+
 	// Test scenario where class destructor aborts the context
 	{
 		asIScriptEngine *engine = asCreateScriptEngine();
@@ -339,6 +339,55 @@ bool Test()
 		engine->Release();
 	}
 
+	// Test calling the same interface method on objects that list the interfaces in different orders
+	{
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+		RegisterScriptArray(engine, true);
+
+		mod = engine->GetModule(0, asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"interface IA { int a(); } \n"
+			"interface IB { int b(); } \n"
+			"interface IC { int c(); } \n"
+			"class X : IA, IB, IC { int a() { return 1; } int b() { return 2; } int c() { return 3; } } \n"
+			"class Y : IC, IB, IA { int a() { return 10; } int b() { return 20; } int c() { return 30; } } \n"
+			"class Z : IC { int c() { return 300; } } \n"
+			"class W : X { int b() { return 2000; } } \n"
+			"int test() \n"
+			"{ \n"
+			"  IA@[] as = { X(), Y(), X(), X(), Y(), W() }; \n"
+			"  IC@[] cs = { X(), Y(), Z(), Z(), X(), W() }; \n"
+			"  int r = 0; \n"
+			"  for( uint n = 0; n < as.length(); n++ ) \n"
+			"  { \n"
+			"    r += as[n].a() + cast<IB>(as[n]).b(); \n"
+			"    r += cs[n].c(); \n"
+			"  } \n"
+			"  return r; \n"
+			"} \n");
+
+		bout.buffer = "";
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		if( bout.buffer != "" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		// as: X=1+2, Y=10+20, X, X, Y, W=1+2000 -> 3+30+3+3+30+2001 = 2070
+		// cs: X=3, Y=30, Z=300, Z=300, X=3, W=3 -> 639
+		r = ExecuteString(engine, "assert( test() == 2709 );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		engine->ShutDownAndRelease();
+	}
+
 	// Success
 	return fail;
 }
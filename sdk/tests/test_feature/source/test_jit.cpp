@@ -0,0 +1,367 @@
+//
+// Tests the built-in JIT compiler
+//
+
+#include "utils.h"
+
+namespace TestJIT
+{
+
+// Wraps the built-in JIT compiler to count the number of compiled functions
+class CCountingJIT : public asIJITCompiler
+{
+public:
+	CCountingJIT(asIJITCompiler *in_jit) : jit(in_jit), compiled(0) {}
+
+	int CompileFunction(asIScriptFunction *function, asJITFunction *output)
+	{
+		int r = jit->CompileFunction(function, output);
+		if( r >= 0 )
+			compiled++;
+		return r;
+	}
+
+	void ReleaseJITFunction(asJITFunction func)
+	{
+		jit->ReleaseJITFunction(func);
+	}
+
+	asIJITCompiler *jit;
+	int             compiled;
+};
+
+static const char *script =
+"int intMath(int a, int b)                               \n"
+"{                                                       \n"
+"  int r = 0;                                            \n"
+"  for( int n = 0; n < 100; n++ )                        \n"
+"  {                                                     \n"
+"    r += a*n - b;                                       \n"
+"    r ^= (r << 3) | (r >> 2);                           \n"
+"    r = r & 0xFFFF;                                     \n"
+"    if( n % 7 == 3 ) r -= n / 3;                        \n"
+"    uint u = uint(r) >>> 1;                             \n"
+"    r += int(u / 3 + u % 5);                            \n"
+"    r = -r * 3;                                         \n"
+"    r = ~r;                                             \n"
+"  }                                                     \n"
+"  return r;                                             \n"
+"}                                                       \n"
+"int64 int64Math(int64 a, int64 b)                       \n"
+"{                                                       \n"
+"  int64 r = 1;                                          \n"
+"  for( int n = 0; n < 50; n++ )                         \n"
+"  {                                                     \n"
+"    r = r * a + b - n;                                  \n"
+"    r = (r & 0xFFFFFFFFFF) | (r ^ b);                   \n"
+"    if( r > a ) r = -r;                                 \n"
+"  }                                                     \n"
+"  return r;                                             \n"
+"}                                                       \n"
+"float floatMath(float a, float b)                       \n"
+"{                                                       \n"
+"  float r = 0;                                          \n"
+"  for( int n = 1; n <= 100; n++ )                       \n"
+"  {                                                     \n"
+"    r += a * n - b / n;                                 \n"
+"    r = r * 0.5f + 1.5f;                                \n"
+"    if( r > 100 ) r -= 50.25f;                          \n"
+"    if( r < -10 ) r = -r;                               \n"
+"  }                                                     \n"
+"  return r;                                             \n"
+"}                                                       \n"
+"double doubleMath(double a, double b)                   \n"
+"{                                                       \n"
+"  double r = 0;                                         \n"
+"  for( int n = 1; n <= 100; n++ )                       \n"
+"  {                                                     \n"
+"    r += a * n - b / n;                                 \n"
+"    r = -r * 0.75;                                      \n"
+"    if( r >= 1000 ) r -= 999;                           \n"
+"  }                                                     \n"
+"  return r;                                             \n"
+"}                                                       \n"
+"int conversions(int a)                                  \n"
+"{                                                       \n"
+"  float f = a;                                          \n"
+"  double d = f * 2.5f;                                  \n"
+"  int8 i8 = int8(a);                                    \n"
+"  int16 i16 = int16(a * 100);                           \n"
+"  uint8 u8 = uint8(a);                                  \n"
+"  uint16 u16 = uint16(a * 1000);                        \n"
+"  int64 i64 = a;                                        \n"
+"  uint64 u64 = uint(a);                                 \n"
+"  float f2 = float(d);                                  \n"
+"  return int(d) + int(f2) + i8 + i16 + u8 + u16 +       \n"
+"         int(i64 + int64(u64));                         \n"
+"}                                                       \n"
+"bool logic(int a, int b)                                \n"
+"{                                                       \n"
+"  bool r = a < b;                                       \n"
+"  r = r != (a >= b);                                    \n"
+"  r = r && !(a == b);                                   \n"
+"  if( a > 0 && b > 0 ) r = !r;                          \n"
+"  return r;                                             \n"
+"}                                                       \n"
+"int fib(int n)                                          \n"
+"{                                                       \n"
+"  if( n < 2 ) return n;                                 \n"
+"  return fib(n-1) + fib(n-2);                           \n"
+"}                                                       \n"
+"int g = 0;                                              \n"
+"float gf = 0;                                           \n"
+"class C                                                 \n"
+"{                                                       \n"
+"  int a = 0;                                            \n"
+"  int b = 1;                                            \n"
+"  float f = 0;                                          \n"
+"  int run(int n)                                        \n"
+"  {                                                     \n"
+"    for( int i = 0; i < n; i++ )                        \n"
+"    {                                                   \n"
+"      a += i;                                           \n"
+"      b = b * 3 % 1001;                                 \n"
+"      f += 0.5f;                                        \n"
+"      g++;                                              \n"
+"      gf = f;                                           \n"
+"    }                                                   \n"
+"    return a + b;                                       \n"
+"  }                                                     \n"
+"}                                                       \n"
+"int classes()                                           \n"
+"{                                                       \n"
+"  C c;                                                  \n"
+"  int r = c.run(100);                                   \n"
+"  return r + int(c.f) + g + int(gf);                    \n"
+"}                                                       \n"
+"int divide(int a, int b, int c)                         \n"
+"{                                                       \n"
+"  int r = 0;                                            \n"
+"  for( int n = b; n <= c; n++ )                         \n"
+"    r += a / n + a % n;                                 \n"
+"  return r;                                             \n"
+"}                                                       \n"
+"int loop(int n)                                         \n"
+"{                                                       \n"
+"  int r = 0;                                            \n"
+"  for( int i = 0; i < n; i++ )                          \n"
+"    r += i;                                             \n"
+"  return r;                                             \n"
+"}                                                       \n";
+
+static const char *tests[] =
+{
+	"int r = intMath(13, 7); assert( r == %d );",
+	"int64 r = int64Math(31, 17); assert( int(r) == %d );",
+	"float r = floatMath(1.5f, 3.25f); assert( int(r*1000) == %d );",
+	"double r = doubleMath(1.5, 3.25); assert( int(r*1000) == %d );",
+	"int r = conversions(123456) + conversions(-7); assert( r == %d );",
+	"int r = 0; for( int a = -2; a <= 2; a++ ) for( int b = -2; b <= 2; b++ ) r = r*2 + (logic(a,b) ? 1 : 0); assert( r == %d );",
+	"int r = fib(20); assert( r == %d );",
+	"g = 0; gf = 0; int r = classes(); assert( r == %d );",
+	0
+};
+
+static CBufferedOutStream bout;
+static int lineCount = 0;
+void LineCallback(asIScriptContext *ctx, void *)
+{
+	// Suspend the execution a few times to verify
+	// that the JIT function can be resumed correctly
+	if( ++lineCount % 50 == 0 )
+		ctx->Suspend();
+}
+
+asIScriptEngine *CreateEngine(asIJITCompiler *jit)
+{
+	asIScriptEngine *engine = asCreateScriptEngine();
+	engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+	engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+	if( jit )
+	{
+		engine->SetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS, true);
+		engine->SetJITCompiler(jit);
+	}
+	return engine;
+}
+
+bool Test()
+{
+	bool fail = false;
+	int r;
+
+	asIJITCompiler *builtIn = asCreateJITCompiler();
+	if( builtIn == 0 )
+	{
+		PRINTF("TestJIT is skipped because there is no built-in JIT compiler for this platform\n");
+		return false;
+	}
+
+	CCountingJIT jit(builtIn);
+
+	// Run the scripts without JIT to get the expected values
+	int expected[8] = {0};
+	{
+		asIScriptEngine *engine = CreateEngine(0);
+		asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script);
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		asIScriptContext *ctx = engine->CreateContext();
+		const char *decls[] = {"int intMath(int, int)", "int64 int64Math(int64, int64)", "float floatMath(float, float)", "double doubleMath(double, double)"};
+		for( int n = 0; n < 4; n++ )
+		{
+			ctx->Prepare(mod->GetFunctionByDecl(decls[n]));
+			if( n == 0 )      { ctx->SetArgDWord(0, 13); ctx->SetArgDWord(1, 7); }
+			else if( n == 1 ) { ctx->SetArgQWord(0, 31); ctx->SetArgQWord(1, 17); }
+			else if( n == 2 ) { ctx->SetArgFloat(0, 1.5f); ctx->SetArgFloat(1, 3.25f); }
+			else              { ctx->SetArgDouble(0, 1.5); ctx->SetArgDouble(1, 3.25); }
+			r = ctx->Execute();
+			if( r != asEXECUTION_FINISHED )
+				TEST_FAILED;
+			if( n == 0 )      expected[n] = (int)ctx->GetReturnDWord();
+			else if( n == 1 ) expected[n] = (int)(asINT64)ctx->GetReturnQWord();
+			else if( n == 2 ) expected[n] = (int)(ctx->GetReturnFloat()*1000);
+			else              expected[n] = (int)(ctx->GetReturnDouble()*1000);
+		}
+		ctx->Release();
+
+		// The rest of the expected values are easier to verify directly
+		r = ExecuteString(engine, "assert( conversions(123456) + conversions(-7) != 0 );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		int val = 0;
+		engine->RegisterGlobalProperty("int val", &val);
+		const char *exprs[] = {"val = conversions(123456) + conversions(-7);",
+		                       "val = 0; for( int a = -2; a <= 2; a++ ) for( int b = -2; b <= 2; b++ ) val = val*2 + (logic(a,b) ? 1 : 0);",
+		                       "val = fib(20);",
+		                       "g = 0; gf = 0; val = classes();"};
+		for( int n = 0; n < 4; n++ )
+		{
+			r = ExecuteString(engine, exprs[n], mod);
+			if( r != asEXECUTION_FINISHED )
+				TEST_FAILED;
+			expected[4+n] = val;
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
+	if( expected[6] != 6765 )
+		TEST_FAILED;
+
+	// Compare the results with the JIT compiled functions
+	{
+		char buf[512];
+		asIScriptEngine *engine = CreateEngine(&jit);
+		asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script);
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		// All the script functions have something for the JIT compiler to do
+		if( jit.compiled < 10 )
+			TEST_FAILED;
+
+		for( int n = 0; tests[n]; n++ )
+		{
+			snprintf(buf, sizeof(buf), tests[n], expected[n]);
+			r = ExecuteString(engine, buf, mod);
+			if( r != asEXECUTION_FINISHED )
+			{
+				PRINTF("%s\n", buf);
+				TEST_FAILED;
+			}
+		}
+
+		// Exceptions raised in JIT compiled code must be reported by the VM
+		asIScriptContext *ctx = engine->CreateContext();
+		r = ExecuteString(engine, "int r = divide(100, -5, 5);", mod, ctx);
+		if( r != asEXECUTION_EXCEPTION )
+			TEST_FAILED;
+		else
+		{
+			if( std::string(ctx->GetExceptionString()) != "Divide by zero" )
+				TEST_FAILED;
+			if( std::string(ctx->GetExceptionFunction()->GetName()) != "divide" )
+				TEST_FAILED;
+			if( ctx->GetExceptionLineNumber() != 108 )
+				TEST_FAILED;
+		}
+		int sum = 0;
+		for( int n = -5; n <= 10; n++ )
+			if( n != 0 ) sum += 1000 / n + 1000 % n;
+		snprintf(buf, sizeof(buf), "int r = divide(1000, -5, -1) + divide(1000, 1, 10); assert( r == %d );", sum);
+		r = ExecuteString(engine, buf, mod, ctx);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// The line callback and suspend must work in loops executed by the JIT function
+		lineCount = 0;
+		ctx->SetLineCallback(asFUNCTION(LineCallback), 0, asCALL_CDECL);
+		r = ctx->Prepare(mod->GetFunctionByName("loop"));
+		if( r < 0 )
+			TEST_FAILED;
+		ctx->SetArgDWord(0, 1000);
+		int suspends = 0;
+		while( (r = ctx->Execute()) == asEXECUTION_SUSPENDED )
+			suspends++;
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+		if( ctx->GetReturnDWord() != 499500 )
+			TEST_FAILED;
+		if( suspends < 10 )
+			TEST_FAILED;
+		ctx->ClearLineCallback();
+		ctx->Release();
+
+		// Saving the bytecode must not store the native entry points, and
+		// the loaded bytecode must be compiled again by the JIT compiler
+		CBytecodeStream stream(__FILE__"1");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+
+		engine->ShutDownAndRelease();
+
+		engine = CreateEngine(&jit);
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		jit.compiled = 0;
+		r = mod->LoadByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		if( jit.compiled < 10 )
+			TEST_FAILED;
+
+		for( int n = 0; tests[n]; n++ )
+		{
+			snprintf(buf, sizeof(buf), tests[n], expected[n]);
+			r = ExecuteString(engine, buf, mod);
+			if( r != asEXECUTION_FINISHED )
+			{
+				PRINTF("%s\n", buf);
+				TEST_FAILED;
+			}
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
+	if( bout.buffer != "" )
+	{
+		PRINTF("%s", bout.buffer.c_str());
+		TEST_FAILED;
+	}
+
+	// The JIT compiler must outlive the engines that use it
+	asDestroyJITCompiler(builtIn);
+
+	return fail;
+}
+
+} // namespace
+
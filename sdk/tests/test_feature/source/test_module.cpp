@@ -544,6 +544,158 @@ bool Test()
 			TEST_FAILED;
 	}
 
+	// Test incremental builds, where only the modified functions are compiled again
+	{
+		asIScriptEngine *engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+		bout.buffer = "";
+
+		const char *scriptA =
+			"int g = 1;                        \n"
+			"const int C = 3;                  \n"
+			"class T                           \n"
+			"{                                 \n"
+			"  int v = 2;                      \n"
+			"  int get() { return v + C; }     \n"
+			"}                                 \n"
+			"int funcA() { return 10; }        \n";
+		const char *scriptB =
+			"int funcB()                       \n"
+			"{                                 \n"
+			"  return funcA() + 1;             \n"
+			"}                                 \n"
+			"int funcC()                       \n"
+			"{                                 \n"
+			"  switch( g ) { case C: return 1; } \n"
+			"  return T().get();               \n"
+			"}                                 \n"
+			"int funcD(int a)                  \n"
+			"{                                 \n"
+			"  return 10 / a;                  \n"
+			"}                                 \n";
+
+		// The first build compiles everything
+		asIScriptModule *mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("a", scriptA);
+		mod->AddScriptSection("b", scriptB);
+		r = mod->BuildIncremental();
+		if( r < 0 )
+			TEST_FAILED;
+
+		int idB = mod->GetFunctionByName("funcB")->GetId();
+		int idD = mod->GetFunctionByName("funcD")->GetId();
+		r = ExecuteString(engine, "assert( funcB() == 11 ); assert( funcC() == 5 ); g = 3;", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// Nothing is compiled and the global variables keep their values when the code is the same
+		mod->AddScriptSection("a", scriptA);
+		mod->AddScriptSection("b", scriptB);
+		r = mod->BuildIncremental();
+		if( r < 0 )
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "assert( g == 3 ); assert( funcC() == 1 );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// Modify the bodies of a function and a method, and move the following functions down a line
+		mod->AddScriptSection("a",
+			"int g = 1;                        \n"
+			"const int C = 3;                  \n"
+			"class T                           \n"
+			"{                                 \n"
+			"  int v = 2;                      \n"
+			"  int get() { return v * C; }     \n"
+			"}                                 \n"
+			"int funcA() { return 10; }        \n");
+		mod->AddScriptSection("b",
+			"int funcB()                       \n"
+			"{                                 \n"
+			"  int b = funcA();                \n"
+			"  return b + 2;                   \n"
+			"}                                 \n"
+			"int funcC()                       \n"
+			"{                                 \n"
+			"  switch( g ) { case C: return 2; } \n"
+			"  return T().get();               \n"
+			"}                                 \n"
+			"int funcD(int a)                  \n"
+			"{                                 \n"
+			"  return 10 / a;                  \n"
+			"}                                 \n");
+		r = mod->BuildIncremental();
+		if( r < 0 )
+			TEST_FAILED;
+
+		if( mod->GetFunctionByName("funcB")->GetId() != idB ||
+			mod->GetFunctionByName("funcD")->GetId() != idD )
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "assert( g == 3 ); assert( funcB() == 12 ); assert( funcC() == 2 ); g = 0; assert( funcC() == 6 );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// The function that was only moved must report the new line number
+		asIScriptContext *ctx = engine->CreateContext();
+		r = ExecuteString(engine, "funcD(0);", mod, ctx);
+		if( r != asEXECUTION_EXCEPTION || ctx->GetExceptionLineNumber() != 13 )
+			TEST_FAILED;
+		ctx->Release();
+
+		// Changing a declaration requires a full build, which initializes the global variables again
+		mod->AddScriptSection("a", scriptA);
+		mod->AddScriptSection("b",
+			"int funcB()                       \n"
+			"{                                 \n"
+			"  return funcA() + 1;             \n"
+			"}                                 \n"
+			"int funcC(int a = 0)              \n"
+			"{                                 \n"
+			"  switch( g ) { case C: return 1; } \n"
+			"  return T().get();               \n"
+			"}                                 \n");
+		r = mod->BuildIncremental();
+		if( r < 0 )
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "assert( g == 1 ); assert( funcC() == 5 );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		if( bout.buffer != "" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		// A failed incremental build leaves the module empty, just like a failed build
+		mod->AddScriptSection("a", scriptA);
+		mod->AddScriptSection("b",
+			"int funcB()                       \n"
+			"{                                 \n"
+			"  return funcX() + 1;             \n"
+			"}                                 \n"
+			"int funcC(int a = 0)              \n"
+			"{                                 \n"
+			"  switch( g ) { case C: return 1; } \n"
+			"  return T().get();               \n"
+			"}                                 \n");
+		r = mod->BuildIncremental();
+		if( r >= 0 || mod->GetFunctionCount() != 0 )
+			TEST_FAILED;
+
+		if( bout.buffer != "b (1, 1) : Info    : Compiling int funcB()\n"
+		                   "b (3, 10) : Error   : No matching symbol 'funcX'\n" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
 	// Success
 	return fail;
 }
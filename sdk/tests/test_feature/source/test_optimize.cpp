@@ -946,19 +946,101 @@ bool TestOptimize()
 		asBYTE expect[] = 
 			{	
 				asBC_SUSPEND,asBC_SetV4,asBC_JMP,asBC_SUSPEND,
-				asBC_SUSPEND,asBC_CMPIi,asBC_JP,asBC_CMPIi,asBC_JZ,asBC_CMPIi,asBC_JZ,asBC_JMP,
+				asBC_SUSPEND,asBC_CMPIiJP,asBC_CMPIiJZ,asBC_CMPIiJZ,asBC_JMP,
 				asBC_SUSPEND,asBC_PshC4,asBC_CALL,
 				asBC_SUSPEND,asBC_JMP,
 				asBC_SUSPEND,asBC_PshC4,asBC_CALL,
 				asBC_SUSPEND,asBC_JMP,
 				asBC_SUSPEND,asBC_PshC4,asBC_CALL,
-				asBC_SUSPEND,asBC_SUSPEND,asBC_IncVi,asBC_SUSPEND,asBC_CMPIi,asBC_JS,
+				asBC_SUSPEND,asBC_SUSPEND,asBC_IncVi,asBC_SUSPEND,asBC_CMPIiJS,
 				asBC_SUSPEND,asBC_RET
 			};
 		if( !ValidateByteCode(func, expect) )
 			TEST_FAILED;
 	}
 
+	// Test the combined compare and jump instructions for all conditions
+	{
+		const char *script =
+			"int cond(int a)           \n"
+			"{                         \n"
+			"  int c = 0;              \n"
+			"  if( a == 3 )  c += 1;   \n"
+			"  if( a != 3 )  c += 2;   \n"
+			"  if( a < 3 )   c += 4;   \n"
+			"  if( a >= 3 )  c += 8;   \n"
+			"  if( a > 3 )   c += 16;  \n"
+			"  if( a <= 3 )  c += 32;  \n"
+			"  if( a < -3 )  c += 64;  \n"
+			"  return c;               \n"
+			"}                         \n"
+			"int loop()                \n"
+			"{                         \n"
+			"  int s = 0;              \n"
+			"  for( int n = 0; n < 10; n++ ) \n"
+			"    s += n;               \n"
+			"  return s;               \n"
+			"}                         \n";
+		mod = engine->GetModule("Test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script);
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "assert( cond(2) == 38 ); \n"
+		                          "assert( cond(3) == 41 ); \n"
+		                          "assert( cond(4) == 26 ); \n"
+		                          "assert( cond(-4) == 102 ); \n"
+		                          "assert( loop() == 45 ); \n", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+	}
+
+	// Test the combined instructions for copying values between variables and class members
+	{
+		const char *script =
+			"class C                         \n"
+			"{                               \n"
+			"  int a = 1;                    \n"
+			"  float f = 0.5f;               \n"
+			"  int b;                        \n"
+			"  int get() { return a; }       \n"
+			"  void set(int v) { a = v; }    \n"
+			"  int run()                     \n"
+			"  {                             \n"
+			"    for( b = 0; b < 5; b++ )    \n"
+			"      a += b;                   \n"
+			"    f = f * 2;                  \n"
+			"    int c = b = a;              \n"
+			"    return a + b + c;           \n"
+			"  }                             \n"
+			"}                               \n";
+		mod = engine->GetModule("Test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script);
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		asITypeInfo *type = mod->GetTypeInfoByName("C");
+		asIScriptFunction *func = type->GetMethodByName("get", false);
+		asBYTE expect[] =
+			{
+				asBC_SUSPEND,asBC_CpyThisToV4,asBC_CpyVtoR4,asBC_RET
+			};
+		if( !ValidateByteCode(func, expect) )
+			TEST_FAILED;
+
+		r = ExecuteString(engine, "C c; \n"
+		                          "assert( c.get() == 1 ); \n"
+		                          "c.set(7); \n"
+		                          "assert( c.a == 7 ); \n"
+		                          "assert( c.run() == 51 ); \n"
+		                          "assert( c.b == 17 ); \n"
+		                          "assert( c.f == 1 ); \n", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+	}
+
 	// Validate bytecode sequence for a class constructor that sets a member
 	{
 		const char *script = 
@@ -977,7 +1059,7 @@ bool TestOptimize()
 			TEST_FAILED;
 		asBYTE expect[] = 
 			{	
-				asBC_SUSPEND,asBC_SetV4,asBC_LoadThisR,asBC_WRTV4,asBC_SUSPEND,asBC_RET
+				asBC_SUSPEND,asBC_SetV4,asBC_CpyVtoThis4,asBC_SUSPEND,asBC_RET
 			};
 		if( !ValidateByteCode(func, expect) )
 			TEST_FAILED;
@@ -6,9 +6,17 @@
 
 #include <memory>
 #include <vector>
+#include <sstream>
 #include "utils.h"
 #include "../../../add_on/scriptarray/scriptarray.h"
 #include "../../../add_on/scripthandle/scripthandle.h"
+#ifdef AS_CAN_USE_CPP11
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+#endif
 
 
 namespace TestSaveLoad
@@ -388,6 +396,102 @@ void NGUIWidgetCastGeneric(asIScriptGeneric *gen)
 
 NGUISymbol symbol_inst;
 
+static void GetValue_gen(asIScriptGeneric *gen)
+{
+	gen->SetReturnDWord(42);
+}
+
+// Value type with composite properties, i.e. properties of a member
+struct SCompositeInner
+{
+	int c;
+	int d;
+};
+struct SCompositeOuter
+{
+	asINT64         filler;
+	SCompositeInner b;
+	int             e;
+};
+
+#ifdef AS_CAN_USE_CPP11
+// Slow JIT compiler, so the other threads have time to call the function while it is compiled
+class CSlowJIT : public asIJITCompiler
+{
+public:
+	CSlowJIT() : jit(asCreateJITCompiler()), compiled(0), missingByteCode(0), runWhileCompiled(0) {}
+	~CSlowJIT() { if( jit ) asDestroyJITCompiler(jit); }
+
+	int CompileFunction(asIScriptFunction *function, asJITFunction *output)
+	{
+		asUINT length;
+		if( function->GetByteCode(&length) == 0 || length == 0 )
+			missingByteCode++;
+		compiled++;
+
+		// The JIT compiler may look at the other functions of the module too,
+		// which loads them while this function is still being loaded
+		asIScriptModule *mod = function->GetModule();
+		for( asUINT n = 0; mod && n < mod->GetFunctionCount(); n++ )
+			mod->GetFunctionByIndex(n)->GetByteCode();
+
+		lock.lock();
+		compiling.push_back(function);
+		lock.unlock();
+
+		this_thread::sleep_for(chrono::milliseconds(20));
+
+		int r = jit ? jit->CompileFunction(function, output) : asNOT_SUPPORTED;
+
+		lock.lock();
+		compiling.erase(find(compiling.begin(), compiling.end(), function));
+		lock.unlock();
+		return r;
+	}
+
+	// Called by the script functions when they start to execute
+	void Enter(asIScriptFunction *function)
+	{
+		lock.lock();
+		if( find(compiling.begin(), compiling.end(), function) != compiling.end() )
+			runWhileCompiled++;
+		lock.unlock();
+	}
+
+	void ReleaseJITFunction(asJITFunction func)
+	{
+		if( jit )
+			jit->ReleaseJITFunction(func);
+	}
+
+	asIJITCompiler             *jit;
+	atomic<int>                 compiled;
+	atomic<int>                 missingByteCode;
+	atomic<int>                 runWhileCompiled;
+	mutex                       lock;
+	vector<asIScriptFunction *> compiling;
+};
+
+static void EnterSlowJIT(asIScriptGeneric *gen)
+{
+	asIScriptContext *ctx = asGetActiveContext();
+	reinterpret_cast<CSlowJIT*>(gen->GetAuxiliary())->Enter(ctx->GetFunction());
+}
+
+static void CallLazyFunction(asIScriptFunction *func, int *result)
+{
+	asIScriptContext *ctx = func->GetEngine()->CreateContext();
+	int r = ctx->Prepare(func);
+	if( r >= 0 )
+		r = ctx->Execute();
+	*result = r == asEXECUTION_FINISHED ? (int)ctx->GetReturnDWord() : -1;
+	ctx->Release();
+
+	// Free the thread local data before the thread ends
+	asThreadCleanup();
+}
+#endif
+
 bool Test()
 {
 	int r;
@@ -396,6 +500,563 @@ bool Test()
 	asIScriptEngine* engine;
 	asIScriptModule* mod;
 
+	// Test saving and loading script classes with reordered properties
+	{
+		const char *script =
+			"class Base \n"
+			"{ \n"
+			"  int8 a; string s; double d; int8 b; Base @h; \n"
+			"} \n"
+			"class Derived : Base \n"
+			"{ \n"
+			"  int16 c; string t; int8 e; int f; \n"
+			"} \n"
+			"void main() \n"
+			"{ \n"
+			"  Derived o; \n"
+			"  o.a = 1; o.s = 's'; o.d = 3.5; o.b = 2; @o.h = o; \n"
+			"  o.c = 3; o.t = 't'; o.e = 4; o.f = 5; \n"
+			"  assert( o.a == 1 && o.s == 's' && o.d == 3.5 && o.b == 2 && o.h is o ); \n"
+			"  assert( o.c == 3 && o.t == 't' && o.e == 4 && o.f == 5 ); \n"
+			"  @o.h = null; \n"
+			"} \n";
+
+		asIScriptEngine *engines[2];
+		for( int n = 0; n < 2; n++ )
+		{
+			engines[n] = asCreateScriptEngine();
+			engines[n]->SetMessageCallback(asMETHOD(COutStream, Callback), &out, asCALL_THISCALL);
+			engines[n]->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+			RegisterStdString(engines[n]);
+		}
+
+		// Compare with the layout in declaration order
+		mod = engines[0]->GetModule("declared", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script);
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+		asUINT declaredSize = mod->GetTypeInfoByName("Base")->GetSize();
+
+		engines[0]->SetEngineProperty(asEP_REORDER_CLASS_PROPERTIES, true);
+		mod = engines[0]->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script);
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		r = ExecuteString(engines[0], "main()", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// The padding between the properties is removed, but they are still enumerated in declaration order
+		asITypeInfo *base = mod->GetTypeInfoByName("Base");
+		asITypeInfo *derived = mod->GetTypeInfoByName("Derived");
+		if( base->GetSize() >= declaredSize )
+			TEST_FAILED;
+		const char *name = 0;
+		base->GetProperty(0, &name);
+		if( name == 0 || std::string(name) != "a" )
+			TEST_FAILED;
+
+		// The inherited properties keep the offsets from the base class
+		for( asUINT n = 0; n < base->GetPropertyCount(); n++ )
+		{
+			int baseOffset = 0, derivedOffset = 0;
+			base->GetProperty(n, 0, 0, 0, 0, &baseOffset);
+			derived->GetProperty(n, 0, 0, 0, 0, &derivedOffset);
+			if( baseOffset != derivedOffset )
+				TEST_FAILED;
+		}
+
+		CBytecodeStream stream("test");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+
+		// The loaded classes get the same offsets even though the engine doesn't reorder the properties
+		asIScriptModule *mod2 = engines[1]->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod2->LoadByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+
+		const char *types[] = {"Base", "Derived"};
+		for( int t = 0; t < 2; t++ )
+		{
+			asITypeInfo *orig = mod->GetTypeInfoByName(types[t]);
+			asITypeInfo *loaded = mod2->GetTypeInfoByName(types[t]);
+			if( loaded == 0 || loaded->GetSize() != orig->GetSize() || loaded->GetPropertyCount() != orig->GetPropertyCount() )
+			{
+				TEST_FAILED;
+				continue;
+			}
+			for( asUINT n = 0; n < orig->GetPropertyCount(); n++ )
+			{
+				int origOffset = 0, loadedOffset = 0;
+				orig->GetProperty(n, 0, 0, 0, 0, &origOffset);
+				loaded->GetProperty(n, 0, 0, 0, 0, &loadedOffset);
+				if( origOffset != loadedOffset )
+					TEST_FAILED;
+			}
+		}
+
+		r = ExecuteString(engines[1], "main()", mod2);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		engines[0]->ShutDownAndRelease();
+		engines[1]->ShutDownAndRelease();
+	}
+
+	// Test the fingerprint of the registered interface
+	{
+		asIScriptEngine *engines[3];
+		for( int n = 0; n < 3; n++ )
+		{
+			engines[n] = asCreateScriptEngine();
+			engines[n]->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+			RegisterScriptArray(engines[n], false);
+			engines[n]->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+			engines[n]->BeginConfigGroup("grp");
+			if( n < 2 )
+				engines[n]->RegisterGlobalFunction("int GetValue()", asFUNCTION(GetValue_gen), asCALL_GENERIC);
+			else
+				engines[n]->RegisterGlobalFunction("int GetValue(int)", asFUNCTION(GetValue_gen), asCALL_GENERIC);
+			engines[n]->EndConfigGroup();
+		}
+		bout.buffer = "";
+
+		// The same interface gives the same fingerprint
+		if( engines[0]->GetInterfaceFingerprint() != engines[1]->GetInterfaceFingerprint() )
+			TEST_FAILED;
+		if( engines[0]->GetInterfaceFingerprint("grp") != engines[1]->GetInterfaceFingerprint("grp") )
+			TEST_FAILED;
+		if( engines[0]->GetInterfaceFingerprint() == engines[2]->GetInterfaceFingerprint() )
+			TEST_FAILED;
+		if( engines[0]->GetInterfaceFingerprint("") != engines[2]->GetInterfaceFingerprint("") )
+			TEST_FAILED;
+		if( engines[0]->GetInterfaceFingerprint("grp") == engines[2]->GetInterfaceFingerprint("grp") )
+			TEST_FAILED;
+		if( engines[0]->GetInterfaceFingerprint("nogrp") != 0 )
+			TEST_FAILED;
+
+		mod = engines[0]->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"int main() { array<int> a = {GetValue()}; return a[0]; } \n");
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		CBytecodeStream stream(__FILE__"fp");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+
+		// The application functions are found by their id in the engine with the same interface
+		mod = engines[1]->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		r = ExecuteString(engines[1], "assert( main() == 42 );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// The changed config group is reported if the bytecode cannot be loaded
+		stream.Restart();
+		mod = engines[2]->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCode(&stream);
+		if( r >= 0 )
+			TEST_FAILED;
+
+		if( bout.buffer != " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 178\n"
+		                   " (0, 0) : Info    : The registered application interface differs from when the bytecode was saved. Changed config groups: 'grp'\n" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		for( int n = 0; n < 3; n++ )
+			engines[n]->ShutDownAndRelease();
+	}
+
+	// Test loading the bytecode directly from memory
+	{
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+		RegisterStdString(engine);
+		bout.buffer = "";
+
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"class C { string s = 'hello'; } \n"
+			"string main() { C c; return c.s + ' world'; } \n");
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		CBytecodeStream stream(__FILE__"mem");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCodeFromMemory(&stream.buffer[0], stream.buffer.size());
+		if( r < 0 )
+			TEST_FAILED;
+		r = ExecuteString(engine, "assert( main() == 'hello world' );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// A truncated buffer must not be read beyond its end
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCodeFromMemory(&stream.buffer[0], stream.buffer.size() / 2);
+		if( r >= 0 )
+			TEST_FAILED;
+		if( bout.buffer.find("Unexpected end of file") == std::string::npos )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		if( mod->LoadByteCodeFromMemory(0, 0) != asINVALID_ARG )
+			TEST_FAILED;
+
+		engine->ShutDownAndRelease();
+	}
+
+	// Test lazy loading of the functions
+	{
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+		RegisterStdString(engine);
+		bout.buffer = "";
+
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"string g = 'hello'; \n"
+			"int count = 1; \n"
+			"funcdef int CB(int); \n"
+			"interface I { int f(); } \n"
+			"class Base : I { int f() { return 1; } } \n"
+			"class Derived : Base { int f() override { return 2 + Base::f(); } } \n"
+			"int twice(int a) { return a*2; } \n"
+			"int unused() { return count + 41; } \n"
+			"CB @getCB() { return function(int a) { return a + count; }; } \n"
+			"string main() { I @i = Derived(); return g + ' ' + twice(i.f()) + ' ' + getCB()(1); } \n");
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		CBytecodeStream stream(__FILE__"lazy");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+
+		// Load the module normally and save it again to have something to compare with
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		CBytecodeStream eager(__FILE__"eager");
+		mod->SaveByteCode(&eager);
+
+		engine->SetEngineProperty(asEP_LAZY_LOAD_FUNCTIONS, true);
+		if( engine->GetEngineProperty(asEP_LAZY_LOAD_FUNCTIONS) != 1 )
+			TEST_FAILED;
+
+		stream.Restart();
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		r = ExecuteString(engine, "assert( main() == 'hello 6 2' );", mod);
+		if( r != asEXECUTION_FINISHED )
+			TEST_FAILED;
+
+		// Saving the module must load the functions that haven't been called
+		CBytecodeStream lazy(__FILE__"lazy2");
+		r = mod->SaveByteCode(&lazy);
+		if( r < 0 || lazy.buffer != eager.buffer )
+			TEST_FAILED;
+
+		// A function that is referenced by the application must
+		// still work after the module has been discarded
+		stream.Restart();
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		asIScriptFunction *func = 0;
+		for( asUINT n = 0; n < mod->GetFunctionCount(); n++ )
+			if( std::string(mod->GetFunctionByIndex(n)->GetName()) == "unused" )
+				func = mod->GetFunctionByIndex(n);
+		if( func == 0 )
+			TEST_FAILED;
+		else
+		{
+			func->AddRef();
+			mod->Discard();
+
+			asIScriptContext *ctx = engine->CreateContext();
+			r = ctx->Prepare(func);
+			if( r >= 0 )
+				r = ctx->Execute();
+			if( r != asEXECUTION_FINISHED || ctx->GetReturnDWord() != 42 )
+				TEST_FAILED;
+			ctx->Release();
+			func->Release();
+		}
+
+		if( bout.buffer != "" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
+	// Test several threads making the first call to the same lazily loaded function.
+	// The functions must be JIT compiled once, and not be run before they have been
+#ifndef AS_CAN_USE_CPP11
+	PRINTF("Skipped the test of lazy loading with multiple threads as it requires C++11\n");
+#else
+	if( strstr(asGetLibraryOptions(), "AS_NO_THREADS") )
+		PRINTF("Skipped the test of lazy loading with multiple threads due to AS_NO_THREADS\n");
+	else
+	{
+		CSlowJIT jit;
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->SetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS, true);
+		engine->SetJITCompiler(&jit);
+		engine->RegisterGlobalFunction("void enter()", asFUNCTION(EnterSlowJIT), asCALL_GENERIC, &jit);
+		bout.buffer = "";
+
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"int calc(int a) \n"
+			"{ \n"
+			"  enter(); \n"
+			"  int r = 0; \n"
+			"  for( int n = 0; n < 1000; n++ ) \n"
+			"    r = (r + a*n) & 0xFFFF; \n"
+			"  return r; \n"
+			"} \n"
+			"int main() { enter(); return calc(3) + calc(5); } \n");
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+		asIScriptFunction *func = mod->GetFunctionByName("main");
+		int expected = -1;
+		CallLazyFunction(func, &expected);
+
+		CBytecodeStream stream(__FILE__"threads");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+
+		engine->SetEngineProperty(asEP_LAZY_LOAD_FUNCTIONS, true);
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		r = mod->LoadByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		jit.compiled = 0;
+
+		// main is loaded by the context's Prepare, and calc by the JIT compiler while it compiles main
+		func = mod->GetFunctionByName("main");
+		int results[4];
+		thread threads[4];
+		for( int n = 0; n < 4; n++ )
+			threads[n] = thread(CallLazyFunction, func, &results[n]);
+		for( int n = 0; n < 4; n++ )
+			threads[n].join();
+		engine->GetModule("test")->Discard();
+
+		for( int n = 0; n < 4; n++ )
+			if( results[n] != expected )
+				TEST_FAILED;
+		if( jit.compiled != 2 || jit.missingByteCode != 0 || jit.runWhileCompiled != 0 )
+			TEST_FAILED;
+
+		if( bout.buffer != "" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		engine->ShutDownAndRelease();
+	}
+#endif
+
+	// Test loading multiple modules with parallel translation of the functions
+	{
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+		RegisterStdString(engine);
+		bout.buffer = "";
+
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test",
+			"shared class S { int v = 3; } \n"
+			"string g = 'hello'; \n"
+			"S s; \n"
+			"class C { int f(int a) { return a + s.v; } } \n"
+			"int twice(int a) { return a*2; } \n"
+			"string main() { C c; return g + ' ' + twice(c.f(1)); } \n");
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		CBytecodeStream stream(__FILE__"parallel");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		engine->DiscardModule("test");
+
+		// The third stream is cut short so its module fails to load
+		CBytecodeStream streams[4] = {__FILE__"1", __FILE__"2", __FILE__"3", __FILE__"4"};
+		const char *names[4] = {"mod0", "mod1", "mod2", "mod3"};
+		asIScriptModule *mods[4];
+		asIBinaryStream *ins[4];
+		for( asUINT n = 0; n < 4; n++ )
+		{
+			streams[n].buffer = stream.buffer;
+			if( n == 2 )
+				streams[n].buffer.resize(stream.buffer.size() / 2);
+			mods[n] = engine->GetModule(names[n], asGM_ALWAYS_CREATE);
+			ins[n] = &streams[n];
+		}
+
+		for( int lazy = 0; lazy < 2; lazy++ )
+		{
+			engine->SetEngineProperty(asEP_LAZY_LOAD_FUNCTIONS, lazy);
+			bout.buffer = "";
+
+			int results[4];
+			for( asUINT n = 0; n < 4; n++ )
+				streams[n].Restart();
+			r = engine->LoadByteCodeForModules(mods, ins, 4, 3, results);
+			if( r != asERROR )
+				TEST_FAILED;
+			if( results[0] < 0 || results[1] < 0 || results[2] >= 0 || results[3] < 0 )
+				TEST_FAILED;
+			if( mods[2]->GetFunctionCount() != 0 )
+				TEST_FAILED;
+
+			for( asUINT n = 0; n < 4; n++ )
+			{
+				if( n == 2 ) continue;
+				r = ExecuteString(engine, "assert( main() == 'hello 8' );", mods[n]);
+				if( r != asEXECUTION_FINISHED )
+					TEST_FAILED;
+
+				// The loaded module must be the same as the one that was saved
+				CBytecodeStream out(__FILE__"out");
+				mods[n]->SaveByteCode(&out);
+				if( out.buffer != stream.buffer )
+					TEST_FAILED;
+			}
+
+			if( bout.buffer != " (0, 0) : Error   : Unexpected end of file\n" )
+			{
+				PRINTF("%s", bout.buffer.c_str());
+				TEST_FAILED;
+			}
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
+	// Test loading multiple modules in parallel when the functions access composite properties.
+	// The translation of a composite property spans two consecutive property lookups, which
+	// must not be mixed up between the modules that are translated at the same time
+	{
+		engine = asCreateScriptEngine();
+		engine->SetMessageCallback(asMETHOD(CBufferedOutStream, Callback), &bout, asCALL_THISCALL);
+		engine->RegisterGlobalFunction("void assert(bool)", asFUNCTION(Assert), asCALL_GENERIC);
+		bout.buffer = "";
+
+		r = engine->RegisterObjectType("outer", sizeof(SCompositeOuter), asOBJ_VALUE | asOBJ_POD | asOBJ_APP_CLASS | asOBJ_APP_CLASS_ALLINTS); assert( r >= 0 );
+		r = engine->RegisterObjectProperty("outer", "int c", asOFFSET(SCompositeInner, c), asOFFSET(SCompositeOuter, b), false); assert( r >= 0 );
+		r = engine->RegisterObjectProperty("outer", "int d", asOFFSET(SCompositeInner, d), asOFFSET(SCompositeOuter, b), false); assert( r >= 0 );
+		r = engine->RegisterObjectProperty("outer", "int e", asOFFSET(SCompositeOuter, e)); assert( r >= 0 );
+
+		// Many small functions so the translation of the modules overlaps
+		string script = "class C { outer a; } \n";
+		for( int n = 0; n < 20; n++ )
+		{
+			stringstream f;
+			f << "int f" << n << "(C @o) { o.a.c = " << n << "; o.a.e = 1; o.a.d = o.a.c + o.a.e; return o.a.d; } \n";
+			script += f.str();
+		}
+		script += "int main() { C o; int s = 0; \n";
+		for( int n = 0; n < 20; n++ )
+		{
+			stringstream f;
+			f << "s += f" << n << "(o); \n";
+			script += f.str();
+		}
+		script += "return s; } \n";
+
+		mod = engine->GetModule("test", asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("test", script.c_str());
+		r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+
+		CBytecodeStream stream(__FILE__"composite");
+		r = mod->SaveByteCode(&stream);
+		if( r < 0 )
+			TEST_FAILED;
+		engine->DiscardModule("test");
+
+		const asUINT count = 6;
+		CBytecodeStream streams[count] = {__FILE__"1", __FILE__"2", __FILE__"3", __FILE__"4", __FILE__"5", __FILE__"6"};
+		asIScriptModule *mods[count];
+		asIBinaryStream *ins[count];
+		int results[count];
+		for( asUINT n = 0; n < count; n++ )
+		{
+			stringstream name;
+			name << "mod" << n;
+			streams[n].buffer = stream.buffer;
+			mods[n] = engine->GetModule(name.str().c_str(), asGM_ALWAYS_CREATE);
+			ins[n] = &streams[n];
+		}
+
+		r = engine->LoadByteCodeForModules(mods, ins, count, 4, results);
+		if( r < 0 )
+			TEST_FAILED;
+
+		for( asUINT n = 0; n < count; n++ )
+		{
+			if( results[n] < 0 )
+				TEST_FAILED;
+
+			// sum(n+1) for n = 0..19
+			r = ExecuteString(engine, "assert( main() == 210 );", mods[n]);
+			if( r != asEXECUTION_FINISHED )
+				TEST_FAILED;
+
+			CBytecodeStream out(__FILE__"out");
+			mods[n]->SaveByteCode(&out);
+			if( out.buffer != stream.buffer )
+				TEST_FAILED;
+		}
+
+		if( bout.buffer != "" )
+		{
+			PRINTF("%s", bout.buffer.c_str());
+			TEST_FAILED;
+		}
+
+		engine->ShutDownAndRelease();
+	}
+
 	// Test same function in different namespaces
 	// https://www.gamedev.net/forums/topic/697445-loadbytecode-fails-when-there-is-a-function-with-the-same-name-in-the-namespace/
 	{
@@ -984,7 +1645,7 @@ bool Test()
 		else
 		{
 			asDWORD crc32 = ComputeCRC32(&bc.buffer[0], asUINT(bc.buffer.size()));
-			if (crc32 != 0xA8C5F3A8)
+			if (crc32 != 0x59D5038)
 			{
 				PRINTF("The saved byte code has different checksum than the expected. Got 0x%X\n", crc32);
 				TEST_FAILED;
@@ -1039,7 +1700,7 @@ bool Test()
 			TEST_FAILED;
 
 		asDWORD crc32 = ComputeCRC32(&bc.buffer[0], asUINT(bc.buffer.size()));
-		if (crc32 != 0x7543FBC9)
+		if (crc32 != 0xEBEE5B6A)
 		{
 			PRINTF("The saved byte code has different checksum than the expected. Got 0x%X\n", crc32);
 			TEST_FAILED;
@@ -1101,7 +1762,7 @@ bool Test()
 			TEST_FAILED;
 
 		asDWORD crc = ComputeCRC32(&bc.buffer[0], asUINT(bc.buffer.size()));
-		if (crc != 2834877814u)
+		if (crc != 1065797861u)
 		{
 			PRINTF("Wrong checksum. Got %u\n", crc);
 			TEST_FAILED;
@@ -1281,7 +1942,7 @@ bool Test()
 
 		engine->ShutDownAndRelease();
 
-		if( bout.buffer != "config (53, 0) : Warning : Cannot register template callback without the actual implementation\n" )
+		if( bout.buffer != "config (64, 0) : Warning : Cannot register template callback without the actual implementation\n" )
 		{
 			PRINTF("%s", bout.buffer.c_str());
 			TEST_FAILED;
@@ -1343,6 +2004,17 @@ bool Test()
 					"ep 26 1\n"
 					"ep 27 100\n"
 					"ep 28 1\n"
+					"ep 29 4096\n"
+					"ep 30 16\n"
+					"ep 31 0\n"
+					"ep 32 0\n"
+					"ep 33 0\n"
+					"ep 34 0\n"
+					"ep 35 0\n"
+					"ep 36 3\n"
+					"ep 37 4\n"
+					"ep 38 8\n"
+					"ep 39 0\n"
 					"\n"
 					"// Enums\n"
 					"\n"
@@ -1550,7 +2222,8 @@ bool Test()
 			TEST_FAILED;
 		
 		if( bout.buffer != " (0, 0) : Error   : Template type 'typeof' doesn't exist\n"
-						   " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 124\n" )
+						   " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 142\n"
+						   " (0, 0) : Info    : The registered application interface differs from when the bytecode was saved\n" )
 		{
 			PRINTF("%s", bout.buffer.c_str());
 			TEST_FAILED;
@@ -1942,26 +2615,26 @@ bool Test()
 		mod->SaveByteCode(&stream2, true);
 
 #ifndef STREAM_TO_FILE
-		if (stream.buffer.size() != 2127)
+		if (stream.buffer.size() != 2170)
 			PRINTF("The saved byte code is not of the expected size. It is %d bytes\n", (int)stream.buffer.size());
 		asUINT zeroes = stream.CountZeroes();
-		if (zeroes != 517)
+		if (zeroes != 518)
 		{
 			PRINTF("The saved byte code contains a different amount of zeroes than the expected. Counted %d\n", zeroes);
 			// Mac OS X PPC has more zeroes, probably due to the bool type being 4 bytes
 		}
 		asDWORD crc32 = ComputeCRC32(&stream.buffer[0], asUINT(stream.buffer.size()));
-		if( crc32 != 0xEB0E50A4)
+		if( crc32 != 0x25021818)
 		{
 			PRINTF("The saved byte code has different checksum than the expected. Got 0x%X\n", crc32);
 			TEST_FAILED;
 		}
 
 		// Without debug info
-		if (stream2.buffer.size() != 1767)
+		if (stream2.buffer.size() != 1810)
 			PRINTF("The saved byte code without debug info is not of the expected size. It is %d bytes\n", (int)stream2.buffer.size());
 		zeroes = stream2.CountZeroes();
-		if (zeroes != 407)
+		if (zeroes != 408)
 			PRINTF("The saved byte code without debug info contains a different amount of zeroes than the expected. Counted %d\n", zeroes);
 #endif
 		// Test loading without releasing the engine first
@@ -2032,7 +2705,7 @@ bool Test()
 		mod->SaveByteCode(&streamTiny, true);
 		engine->Release();
 
-		asBYTE expected[] = {0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x66,0x02,0x66,0x00,0x40,0x50,0x00,0x00,0x01,0x00,0x00,0x00,0x02,0x3F,0x0A,0x00,0x00,0x00,0x00,0x01,0x72,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
+		asBYTE expected[] = {0x5F,0x4F,0x97,0x85,0x30,0xD2,0xAC,0xF0,0x01,0x00,0x9D,0x50,0xC9,0x2D,0xBA,0x4C,0x73,0xCC,0x01,0x00,0x00,0x00,0x00,0x00,0x01,0x66,0x02,0x66,0x00,0x40,0x50,0x00,0x00,0x01,0x00,0x00,0x00,0x02,0x3F,0x0A,0x00,0x00,0x00,0x00,0x01,0x72,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00};
 		bool match = true;
 		for( asUINT n = 0; n < streamTiny.buffer.size(); n++ )
 			if( streamTiny.buffer[n] != expected[n] )
@@ -2869,7 +3542,8 @@ bool Test()
 			TEST_FAILED;
 
 		if( bout.buffer != " (0, 0) : Error   : Attempting to instantiate invalid template type 'tmpl<int>'\n"
-			               " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 111\n" )
+			               " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 130\n"
+			               " (0, 0) : Info    : The registered application interface differs from when the bytecode was saved\n" )
 		{
 			PRINTF("%s", bout.buffer.c_str());
 			TEST_FAILED;
@@ -3186,7 +3860,8 @@ bool TestAndrewPrice()
 			TEST_FAILED;
 
 		if( bout.buffer != " (0, 0) : Error   : Template type 'array' doesn't exist\n"
-			               " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 13\n" )
+			               " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 31\n"
+			               " (0, 0) : Info    : The registered application interface differs from when the bytecode was saved\n" )
 		{
 			PRINTF("%s", bout.buffer.c_str());
 			TEST_FAILED;
@@ -3200,7 +3875,8 @@ bool TestAndrewPrice()
 			TEST_FAILED;
 
 		if( bout.buffer != " (0, 0) : Error   : Object type 'char_ptr' doesn't exist\n"
-						   " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 20\n" )
+						   " (0, 0) : Error   : LoadByteCode failed. The bytecode is invalid. Number of bytes read from stream: 38\n"
+						   " (0, 0) : Info    : The registered application interface differs from when the bytecode was saved\n" )
 		{
 			PRINTF("%s", bout.buffer.c_str());
 			TEST_FAILED;
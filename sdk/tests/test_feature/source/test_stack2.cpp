@@ -264,7 +264,58 @@ bool Test()
 			TEST_FAILED;
 		}
 		ctx->Release();
-		
+
+		engine->Release();
+	}
+
+	// The stack blocks of destroyed contexts are reused by new contexts
+	{
+		engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
+		engine->SetEngineProperty(asEP_INIT_STACK_SIZE, 8192);
+		if( engine->GetEngineProperty(asEP_INIT_STACK_SIZE) != 8192 )
+			TEST_FAILED;
+		if( engine->GetEngineProperty(asEP_STACK_BLOCK_POOL_SIZE) != 16 )
+			TEST_FAILED;
+
+		mod = engine->GetModule(0, asGM_ALWAYS_CREATE);
+		mod->AddScriptSection("script", "int func(int a) { return a + 1; }");
+		int r = mod->Build();
+		if( r < 0 )
+			TEST_FAILED;
+		asIScriptFunction *func = mod->GetFunctionByName("func");
+
+		for( int n = 0; n < 10; n++ )
+		{
+			asIScriptContext *ctx = engine->CreateContext();
+			ctx->Prepare(func);
+			ctx->SetArgDWord(0, n);
+			r = ctx->Execute();
+			if( r != asEXECUTION_FINISHED || ctx->GetReturnDWord() != asDWORD(n + 1) )
+				TEST_FAILED;
+			ctx->Release();
+		}
+
+		asUINT allocated = 0, reused = 0, pooled = 0;
+		engine->GetContextStackStatistics(&allocated, &reused, &pooled);
+		if( allocated != 1 || reused != 9 || pooled != 1 )
+		{
+			PRINTF("allocated: %d, reused: %d, pooled: %d\n", allocated, reused, pooled);
+			TEST_FAILED;
+		}
+
+		// Disabling the pool frees the blocks that were kept
+		engine->SetEngineProperty(asEP_STACK_BLOCK_POOL_SIZE, 0);
+		engine->GetContextStackStatistics(&allocated, &reused, &pooled);
+		if( pooled != 0 )
+			TEST_FAILED;
+
+		asIScriptContext *ctx = engine->CreateContext();
+		ctx->Prepare(func);
+		ctx->Release();
+		engine->GetContextStackStatistics(&allocated, &reused, &pooled);
+		if( allocated != 2 || pooled != 0 )
+			TEST_FAILED;
+
 		engine->Release();
 	}
 
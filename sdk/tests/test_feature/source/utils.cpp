@@ -15,6 +15,9 @@
 #pragma warning (disable:4786)
 #endif
 #include <map>
+#ifdef AS_CAN_USE_CPP11
+#include <mutex>
+#endif
 
 using namespace std;
 
@@ -62,6 +65,14 @@ static asQWORD sumAllocSize     = 0;
 static map<void*,size_t> memSize;
 static map<void*,int> memCount;
 
+#ifdef AS_CAN_USE_CPP11
+// The engine allocates memory from several threads when compiling or loading in parallel
+static mutex memLock;
+#define LOCKMEM() lock_guard<mutex> memGuard(memLock)
+#else
+#define LOCKMEM()
+#endif
+
 #ifdef TRACK_SIZES
 static map<size_t,int> meanSize;
 #endif
@@ -98,6 +109,8 @@ void *MyAllocWithStats(size_t size, const char *file, int line)
 	UNUSED_VAR(line);
 	UNUSED_VAR(file);
 
+	LOCKMEM();
+
 	// Allocate the memory
 	void *ptr = malloc(size);
 #if !defined(__psp2__) && !defined(__CELLOS_LV2__)
@@ -154,6 +167,8 @@ void *MyAllocWithStats(size_t size, const char *file, int line)
 
 void MyFreeWithStats(void *address)
 {
+	LOCKMEM();
+
 #if !defined(__psp2__) && !defined(__CELLOS_LV2__)
 	// Count the number of deallocations made
 	numFrees++;
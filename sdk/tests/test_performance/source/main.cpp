@@ -25,8 +25,10 @@ namespace TestArray        { void Test(double *times); }
 namespace TestGlobalVar    { void Test(double *time); }
 namespace TestClassProp    { void Test(double *time); }
 namespace TestRetObj       { void Test(double *times); }
+namespace TestJIT          { void Test(double *times); }
+namespace TestGC           { void Test(double *times); }
 
-const int NUM_TESTS = 25;
+const int NUM_TESTS = 30;
 
 // Times for 2.32.0 (64bit, Intel i7)
 double testTimesOrig[NUM_TESTS] = 
@@ -55,7 +57,13 @@ double testTimesOrig[NUM_TESTS] =
 0.206,  // ClassProp
 0.845,  // RetObj.1
 0.430,  // RetObj.2
-0.133   // RetObj.3
+0.133,  // RetObj.3
+// The tests below didn't exist in these versions, so there are no times to compare with
+0,      // JIT.1
+0,      // JIT.2
+0,      // GC.1
+0,      // GC.2
+0       // GC.3
 };
 
 // Times for 2.32.1 WIP (64bit, Intel i7) (localized optimizations)
@@ -85,7 +93,13 @@ double testTimesOrig2[NUM_TESTS] =
 	0.206,  // ClassProp
 	0.845,  // RetObj.1
 	0.430,  // RetObj.2
-	0.132   // RetObj.3
+	0.132,  // RetObj.3
+	// The tests below didn't exist in these versions, so there are no times to compare with
+	0,      // JIT.1
+	0,      // JIT.2
+	0,      // GC.1
+	0,      // GC.2
+	0       // GC.3
 };
 
 double testTimesBest[NUM_TESTS];
@@ -135,6 +149,8 @@ int main(int argc, char **argv)
 		TestGlobalVar::Test(&testTimes[20]); printf("."); fflush(stdout);
 		TestClassProp::Test(&testTimes[21]); printf("."); fflush(stdout);
 		TestRetObj::Test(&testTimes[22]); printf("."); fflush(stdout);
+		TestJIT::Test(&testTimes[25]); printf("."); fflush(stdout);
+		TestGC::Test(&testTimes[27]); printf("."); fflush(stdout);
 
 		for( int t = 0; t < NUM_TESTS; t++ )
 		{
@@ -170,6 +186,11 @@ int main(int argc, char **argv)
 	printf("RetObj.1       %.3f    %.3f    %.3f%s\n", testTimesOrig[22], testTimesOrig2[22], testTimesBest[22], testTimesBest[22] < testTimesOrig2[22] ? " +" : " -");
 	printf("RetObj.2       %.3f    %.3f    %.3f%s\n", testTimesOrig[23], testTimesOrig2[23], testTimesBest[23], testTimesBest[23] < testTimesOrig2[23] ? " +" : " -");
 	printf("RetObj.3       %.3f    %.3f    %.3f%s\n", testTimesOrig[24], testTimesOrig2[24], testTimesBest[24], testTimesBest[24] < testTimesOrig2[24] ? " +" : " -");
+	printf("JIT.1            -        -      %.3f\n", testTimesBest[25]);
+	printf("JIT.2            -        -      %.3f\n", testTimesBest[26]);
+	printf("GC.1             -        -      %.3f\n", testTimesBest[27]);
+	printf("GC.2             -        -      %.3f\n", testTimesBest[28]);
+	printf("GC.3             -        -      %.3f\n", testTimesBest[29]);
 
 	printf("--------------------------------------------\n");
 	printf("Press any key to quit.\n");
@@ -0,0 +1,97 @@
+//
+// Test author: Andreas Jonsson
+//
+
+#include "utils.h"
+
+namespace TestGC
+{
+
+#define TESTNAME "TestGC"
+
+// A ring of objects that reference each other in both directions. The ring is
+// kept alive by the global variable, so the garbage collector has to search
+// all the objects for circular references without finding any garbage
+static const char *script =
+"class Node                             \n"
+"{                                      \n"
+"    Node @next;                        \n"
+"    Node @prev;                        \n"
+"}                                      \n"
+"Node @ring;                            \n"
+"void Build(int count)                  \n"
+"{                                      \n"
+"    @ring = Node();                    \n"
+"    Node @last = ring;                 \n"
+"    for( int n = 1; n < count; n++ )   \n"
+"    {                                  \n"
+"        Node node;                     \n"
+"        @node.prev = last;             \n"
+"        @last.next = node;             \n"
+"        @last = node;                  \n"
+"    }                                  \n"
+"    @last.next = ring;                 \n"
+"    @ring.prev = last;                 \n"
+"}                                      \n"
+"void Clear()                           \n"
+"{                                      \n"
+"    @ring.next = null;                 \n"
+"    @ring = null;                      \n"
+"}                                      \n";
+
+void Test(double *testTimes)
+{
+	asIScriptEngine *engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
+
+	COutStream out;
+	engine->SetMessageCallback(asMETHOD(COutStream,Callback), &out, asCALL_THISCALL);
+	engine->SetEngineProperty(asEP_AUTO_GARBAGE_COLLECT, false);
+
+	asIScriptModule *mod = engine->GetModule(0, asGM_ALWAYS_CREATE);
+	mod->AddScriptSection(TESTNAME, script, strlen(script), 0);
+	mod->Build();
+
+#ifndef _DEBUG
+	asIScriptContext *ctx = engine->CreateContext();
+
+	// The number of cycles is chosen so each test visits the same number of
+	// objects in total. The time only grows if the cost per object grows too
+	static const int liveObjects[3] = {1000, 10000, 100000};
+	for( int n = 0; n < 3; n++ )
+	{
+		ctx->Prepare(mod->GetFunctionByDecl("void Build(int)"));
+		ctx->SetArgDWord(0, liveObjects[n]);
+		int r = ctx->Execute();
+		if( r != asEXECUTION_FINISHED )
+			printf("Execution didn't terminate with asEXECUTION_FINISHED\n");
+
+		// The first cycle moves the new objects to the list of old objects
+		engine->GarbageCollect(asGC_FULL_CYCLE);
+
+		int cycles = 1000000 / liveObjects[n];
+
+		double time = GetSystemTimer();
+
+		for( int c = 0; c < cycles; c++ )
+			engine->GarbageCollect(asGC_FULL_CYCLE);
+
+		time = GetSystemTimer() - time;
+
+		asUINT currentSize;
+		engine->GetGCStatistics(&currentSize);
+		if( currentSize != asUINT(liveObjects[n]) )
+			printf("The GC holds %d objects, expected %d\n", currentSize, liveObjects[n]);
+		else
+			testTimes[n] = time;
+
+		ctx->Prepare(mod->GetFunctionByDecl("void Clear()"));
+		ctx->Execute();
+		engine->GarbageCollect(asGC_FULL_CYCLE);
+	}
+
+	ctx->Release();
+#endif
+	engine->Release();
+}
+
+} // namespace
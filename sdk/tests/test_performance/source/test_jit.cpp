@@ -0,0 +1,104 @@
+//
+// Test author: Andreas Jonsson
+//
+
+#include "utils.h"
+
+namespace TestJIT
+{
+
+#define TESTNAME "TestJIT"
+
+// The same scripts as in TestBasic2 and TestFib, so the
+// times can be compared with those of the interpreter
+static const char *script =
+"void TestBasic2()                      \n"
+"{                                      \n"
+"    float a = 1, b = 2, c = 3;         \n"
+"    int i = 0;                         \n"
+"                                       \n"
+"    for ( i = 0; i < 10000000; i++ )   \n"
+"    {                                  \n"
+"       a = a + b * c;                  \n"
+"       if( a == 0 )                    \n"
+"         a = 100.0f;                   \n"
+"       if( b == 1 )                    \n"
+"         b = 2;                        \n"
+"    }                                  \n"
+"}                                      \n"
+"                                       \n"
+"int fibR(int n)                        \n"
+"{                                      \n"
+"    if (n < 2) return n;               \n"
+"    return (fibR(n-2) + fibR(n-1));    \n"
+"}                                      \n";
+
+void Test(double *testTimes)
+{
+	asIJITCompiler *jit = asCreateJITCompiler();
+	if( jit == 0 )
+	{
+		// There is no built-in JIT compiler for this platform
+		return;
+	}
+
+ 	asIScriptEngine *engine = asCreateScriptEngine(ANGELSCRIPT_VERSION);
+	engine->SetEngineProperty(asEP_BUILD_WITHOUT_LINE_CUES, true);
+	engine->SetEngineProperty(asEP_INCLUDE_JIT_INSTRUCTIONS, true);
+	engine->SetJITCompiler(jit);
+
+	COutStream out;
+	engine->SetMessageCallback(asMETHOD(COutStream,Callback), &out, asCALL_THISCALL);
+
+	asIScriptModule *mod = engine->GetModule(0, asGM_ALWAYS_CREATE);
+	mod->AddScriptSection(TESTNAME, script, strlen(script), 0);
+	mod->Build();
+
+#ifndef _DEBUG
+	asIScriptContext *ctx = engine->CreateContext();
+
+	for( int n = 0; n < 2; n++ )
+	{
+		if( n == 0 )
+			ctx->Prepare(mod->GetFunctionByDecl("void TestBasic2()"));
+		else
+		{
+			ctx->Prepare(mod->GetFunctionByDecl("int fibR(int)"));
+			ctx->SetArgDWord(0, 35);
+		}
+
+		double time = GetSystemTimer();
+
+		int r = ctx->Execute();
+
+		time = GetSystemTimer() - time;
+
+		if( r != asEXECUTION_FINISHED )
+		{
+			printf("Execution didn't terminate with asEXECUTION_FINISHED\n");
+			if( r == asEXECUTION_EXCEPTION )
+			{
+				printf("Script exception\n");
+				asIScriptFunction *func = ctx->GetExceptionFunction();
+				printf("Func: %s\n", func->GetName());
+				printf("Line: %d\n", ctx->GetExceptionLineNumber());
+				printf("Desc: %s\n", ctx->GetExceptionString());
+			}
+		}
+		else
+			testTimes[n] = time;
+
+		// Verify the result
+		if( n == 1 && ctx->GetReturnDWord() != 9227465 )
+			printf("Didn't get the expected fibonacci value, got %d\n", (int)ctx->GetReturnDWord());
+	}
+
+	ctx->Release();
+#endif
+	engine->Release();
+
+	// The JIT compiler must outlive the engine
+	asDestroyJITCompiler(jit);
+}
+
+} // namespace